@@ -0,0 +1,48 @@
+/**
+ * Boot timeline recorder for PICO-DOOM
+ *
+ * Each init phase is timestamped with time_us_64() (microseconds since
+ * reset) on the core that runs it, and the whole timeline is printed once
+ * the first frame is up. Each core appends only to its own table, so
+ * core 1 can record its phases while core 0 keeps booting.
+ */
+
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOT_TIMELINE_MAX_PHASES 16   // Per core
+
+/**
+ * Start a phase on the calling core
+ * name: string literal, kept by pointer
+ * Returns a handle for boot_phase_end, or -1 if the table is full
+ */
+int boot_phase_begin(const char *name);
+
+/**
+ * End a phase started with boot_phase_begin
+ */
+void boot_phase_end(int phase);
+
+/**
+ * Record an instant (a zero-length phase), e.g. "first frame"
+ */
+void boot_mark(const char *name);
+
+/**
+ * Print both cores' phases in start order, with the time from reset to
+ * the last recorded event
+ */
+void boot_timeline_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOT_TIMELINE_H
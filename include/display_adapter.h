@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "frame_pacer.h"
 
 // Display configuration
 #define DISPLAY_WIDTH  320
@@ -15,22 +16,90 @@
 #define DOOM_WIDTH     320
 #define DOOM_HEIGHT    200
 
-// Color format: RGB565
+// Framebuffers in the swap chain (3 = triple buffering)
+#define DISPLAY_MAX_BUFFERS 3
+
+// Precomputed palettes: PLAYPAL's 14 palettes at Doom's 5 gamma levels
+#define DISPLAY_NUM_PALETTES 14
+#define DISPLAY_NUM_GAMMA    5
+
+// Dirty tracking tiles (Doom area is 10x25 tiles)
+#define DISPLAY_TILE_W    32
+#define DISPLAY_TILE_H    8
+#define DISPLAY_TILE_COLS (DOOM_WIDTH / DISPLAY_TILE_W)
+#define DISPLAY_TILE_ROWS (DOOM_HEIGHT / DISPLAY_TILE_H)
+
+// Panel color format: RGB565
 typedef uint16_t pixel_t;
 
+// Framebuffer memory layout
+typedef enum {
+    DISPLAY_LAYOUT_ROW_MAJOR = 0,   // data[y * width + x]
+    DISPLAY_LAYOUT_COLUMN_MAJOR,    // data[x * height + y], columns contiguous
+} display_layout_t;
+
+// Color format on the SPI bus
+typedef enum {
+    DISPLAY_COLOR_RGB565 = 0,       // COLMOD 0x55, 2 bytes per pixel
+    DISPLAY_COLOR_RGB444,           // COLMOD 0x53, 3 bytes per 2 pixels
+} display_color_mode_t;
+
 // Frame buffer type
+// Holds 8-bit palette indices, as Doom renders them; core 1 expands each
+// scanline to RGB565 through the palette on its way to the panel.
+// Pixel (x, y) is at data[x * x_step + y * y_step] in either layout.
 typedef struct {
-    pixel_t *data;
+    uint8_t *data;
     uint16_t width;
     uint16_t height;
+    uint16_t x_step;          // Offset between horizontally adjacent pixels
+    uint16_t y_step;          // Offset between vertically adjacent pixels
+    display_layout_t layout;
+    const pixel_t *palette;   // Palette this frame was drawn with, set on swap
+    uint32_t sequence;        // Presented frame number, set on swap
     volatile bool ready;
+    uint16_t dirty[DISPLAY_TILE_ROWS];  // Bit per tile column, set by scanout
 } framebuffer_t;
 
+// Scanout statistics (last completed frame)
+typedef struct {
+    uint32_t scanout_us;      // Wall time from window setup to last byte out
+    uint32_t core1_busy_us;   // Core 1 time spent on setup and DMA IRQs
+    uint32_t frames;          // Total frames scanned out
+    uint32_t bytes;           // SPI bytes sent, pixels plus window commands
+    uint16_t rects;           // Windows opened for dirty regions
+    uint32_t render_stall_us; // Core 0 wait for a free buffer, last frame
+    uint32_t scanout_idle_us; // Core 1 wait for a presented frame, last frame
+    uint8_t num_buffers;      // Buffers in the swap chain
+    display_color_mode_t color_mode;
+    uint32_t full_frame_bytes;    // Bytes for a full Doom frame in this format
+    uint32_t spi_bytes_per_sec;   // Raw SPI bandwidth
+} display_scanout_stats_t;
+
+// Display configuration, fixed at display_init time
+typedef struct {
+    uint8_t num_buffers;      // 2 = double buffering, 3 = triple buffering
+    frame_pace_policy_t pace_policy;  // When presented frames start scanout
+    display_layout_t layout;  // Column-major makes Doom's column draws sequential
+    display_color_mode_t color_mode;  // RGB444 cuts SPI bytes per frame by 25%
+    bool defer_panel_init;    // Reset and set up the panel on core 1 (see display_core1_loop)
+} display_config_t;
+
+/**
+ * Fill in the default display configuration (double buffering)
+ */
+void display_default_config(display_config_t *config);
+
 /**
  * Initialize the display system
  * Sets up SPI, display driver, and framebuffers
+ * config: display configuration, or NULL for defaults
+ *
+ * With defer_panel_init the panel's reset delays are left to core 1, so
+ * launch core 1 right after this and carry on booting: frames presented
+ * before the panel is up wait in the queue.
  */
-void display_init(void);
+void display_init(const display_config_t *config);
 
 /**
  * Get the current framebuffer for rendering
@@ -39,13 +108,13 @@ void display_init(void);
 framebuffer_t* display_get_framebuffer(void);
 
 /**
- * Swap framebuffers (double buffering)
- * Presents the completed frame to the display
+ * Present the completed frame
+ * Queues it for scanout on core 1 without waiting
  */
 void display_swap_buffers(void);
 
 /**
- * Wait for display to be ready for next frame
+ * Wait until a framebuffer is free for the next frame
  */
 void display_wait_vsync(void);
 
@@ -58,9 +127,29 @@ void display_wait_vsync(void);
 pixel_t display_palette_to_rgb565(const uint8_t *doom_palette, uint8_t index);
 
 /**
- * Clear the screen to a specific color
+ * Load a 256-color palette (RGB888) used to expand framebuffers at scanout
+ * Takes effect from the next presented frame
+ */
+void display_update_palette(const uint8_t *doom_palette);
+
+/**
+ * Expand a set of palettes (e.g. the PLAYPAL lump) at every gamma level
+ * palettes: num_palettes consecutive 768-byte RGB888 palettes
+ * Selects palette 0 at gamma 0. Returns true on success.
+ */
+bool display_load_palettes(const uint8_t *palettes, int num_palettes);
+
+/**
+ * Select palette and gamma level for the next presented frame
+ * Only a pointer swap: damage/pickup/radiation effects cost no render
+ * time and switch cleanly between frames.
  */
-void display_clear(pixel_t color);
+void display_set_palette(int palette, int gamma);
+
+/**
+ * Clear the screen to a palette index
+ */
+void display_clear(uint8_t color);
 
 /**
  * Update display brightness (0-255)
@@ -72,9 +161,43 @@ void display_set_brightness(uint8_t brightness);
  */
 float display_get_fps(void);
 
+/**
+ * Get the panel transport format (tells how palette entries are packed)
+ */
+display_color_mode_t display_get_color_mode(void);
+
+/**
+ * Get scanout timing for the last completed frame
+ * core1_busy_us vs scanout_us shows how much of core 1 the transfer costs
+ */
+void display_get_scanout_stats(display_scanout_stats_t *stats);
+
+/**
+ * Get frame pacing statistics for the last one-second window
+ * Either pointer may be NULL
+ */
+void display_get_pace_stats(frame_pace_stats_t *stats, frame_pace_policy_t *policy);
+
+/**
+ * Convert a line of palette indices with the scanout kernels (benchmarks)
+ * Uses the palette of the next presented frame. rgb444 packs two pixels
+ * per three bytes as the RGB444 transport does; otherwise each pixel is
+ * expanded to RGB565. count is rounded down to a multiple of 4.
+ * Returns the bytes written to dst
+ */
+uint32_t display_convert_line(void *dst, const uint8_t *src, int count, bool rgb444);
+
+/**
+ * Force the next presented frame to be sent in full
+ * Use when the panel content no longer matches the last frame (e.g. after
+ * a palette change)
+ */
+void display_invalidate(void);
+
 /**
  * Core 1 display update loop
- * Continuously pushes framebuffer to display
+ * Brings the panel up first if display_init deferred it, then starts DMA
+ * scanout of each presented framebuffer
  */
 void display_core1_loop(void);
 
@@ -8,6 +8,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "tex_columns.h"
+#include "level_loader.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,21 +44,73 @@ bool doom_init(void);
 bool doom_load_wad(const char *wad_path);
 
 /**
- * Update Doom engine with input and advance one game tick
+ * Load a level from its compact lump (wadpack --levels)
+ * map: map name, or NULL for the first map (E1M1 or MAP01)
+ * Prints load time and RAM; PICO_DOOM_LEVEL_COMPARE builds also time the
+ * classic loader on the same map.
+ * Returns true on success
+ */
+bool doom_load_level(const char *map);
+
+/**
+ * Play a demo as a timedemo
+ * Loads the demo's map, then each doom_update runs the demo's next tic
+ * instead of the input, and the statistics are printed when it ends (see
+ * g_demo.h). Callers should run one tic per frame while it plays.
+ * name: demo lump (e.g. "DEMO1"); a PWAD in the image can add others
+ * render: draw the demo's frames, or only run its tics
+ * Returns true if the demo started
+ */
+bool doom_timedemo(const char *name, bool render);
+
+/**
+ * Check whether a timedemo is playing
+ * render receives whether its frames are drawn (may be NULL)
+ */
+bool doom_timedemo_active(bool *render);
+
+/**
+ * Get the current level, or NULL if none is loaded
+ */
+const level_t* doom_get_level(void);
+
+/**
+ * Update Doom engine with input and advance one game tic (1/35 s)
+ * Called by the tic scheduler, so zero or more times per rendered frame
  */
 void doom_update(const doom_input_t *input);
 
 /**
  * Render current frame to framebuffer
- * Framebuffer should be DISPLAY_WIDTH x DISPLAY_HEIGHT pixels
+ * Framebuffer is DOOM_WIDTH x DOOM_HEIGHT 8-bit palette indices
+ */
+void doom_render(uint8_t *framebuffer);
+
+/**
+ * Decompress lumps in the background: queue the level's flats and sprites
+ * (r_prefetch_level) and advance the queue by up to max_bytes of output
+ * Called once per frame while the display scans out
+ * Returns true if work remains
  */
-void doom_render(uint16_t *framebuffer);
+bool doom_service_lumps(uint32_t max_bytes);
 
 /**
  * Get current game state info
  */
 void doom_get_state(char *buffer, int max_len);
 
+/**
+ * Get the precomposited wall texture columns (TEXCOLS lump)
+ * Returns NULL if the WAD image was packed without --texcols
+ */
+const tex_columns_t* doom_get_wall_columns(void);
+
+/**
+ * Print the lump access profile (builds with PICO_DOOM_LUMP_PROFILE)
+ * The output can be saved and passed to wadpack --profile.
+ */
+void doom_dump_lump_profile(uint32_t max_lumps);
+
 /**
  * Cleanup and shutdown
  */
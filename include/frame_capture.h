@@ -0,0 +1,72 @@
+/**
+ * Frame capture for PICO-DOOM
+ * Streams rendered frames over USB for offline comparison between builds
+ *
+ * Each captured frame is split into bands of framebuffer memory. A band is
+ * XOR-delta encoded against the previous presented frame when the host is
+ * known to hold that frame, then run-length encoded. Bands that do not fit
+ * in the USB queue are dropped and re-sent as keyframes later, so capture
+ * never blocks rendering. One band per frame is always a keyframe, in
+ * rotation, so a host that lost a band on the wire picks it up again.
+ * tools/capture_decode.py rebuilds the frames.
+ */
+
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display_adapter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Framebuffer memory is sent in bands of this many bytes
+#define FRAME_CAPTURE_BAND_SIZE 2560
+#define FRAME_CAPTURE_NUM_BANDS (DOOM_WIDTH * DOOM_HEIGHT / FRAME_CAPTURE_BAND_SIZE)
+
+// Band flags
+#define FRAME_CAPTURE_BAND_KEY  0x01    // Not a delta; decode against zeros
+
+/**
+ * Capture statistics
+ */
+typedef struct {
+    uint32_t frames;          // Frames selected for capture
+    uint32_t complete;        // Frames with every band queued
+    uint32_t bands_dropped;   // Bands that did not fit in the USB queue
+    uint32_t bytes;           // Encoded bytes queued
+    uint32_t raw_bytes;       // Framebuffer bytes those bands covered
+} frame_capture_stats_t;
+
+/**
+ * Start capturing
+ * stride: capture every Nth presented frame (1 = every frame, which is the
+ *         only setting that allows delta frames)
+ * count: number of frames to capture, 0 for no limit
+ */
+void frame_capture_start(uint32_t stride, uint32_t count);
+
+/**
+ * Stop capturing
+ */
+void frame_capture_stop(void);
+
+/**
+ * Offer a frame that has just been presented
+ * Call right after display_swap_buffers() with the buffer that was drawn.
+ * frame: presented frame number, incrementing by one per frame
+ */
+void frame_capture_submit(const framebuffer_t *fb, uint32_t frame);
+
+/**
+ * Get capture statistics
+ */
+void frame_capture_get_stats(frame_capture_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_CAPTURE_H
@@ -0,0 +1,104 @@
+/**
+ * Frame pacing for PICO-DOOM
+ * Decides when a finished frame may start scanout
+ *
+ * The pacer never reads a clock itself: every call takes "now" in
+ * microseconds, so the policy logic runs the same against time_us_64()
+ * on the device and against a simulated clock on a host.
+ */
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Presentation policies
+ */
+typedef enum {
+    FRAME_PACE_ASAP = 0,    // Present as soon as a frame is ready
+    FRAME_PACE_35HZ,        // Lock to Doom's tic rate
+    FRAME_PACE_30HZ,
+    FRAME_PACE_17_5HZ,      // Every other tic
+    FRAME_PACE_TE,          // Start scanout on the panel's tearing-effect edge
+    FRAME_PACE_COUNT
+} frame_pace_policy_t;
+
+/**
+ * Presentation statistics over the current window
+ */
+typedef struct {
+    uint32_t frames;          // Frames presented
+    uint32_t mean_us;         // Mean present-to-present interval
+    uint32_t stddev_us;       // Standard deviation of the interval (jitter)
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t missed;          // Cadence slots skipped because a frame was late
+} frame_pace_stats_t;
+
+/**
+ * Pacer state
+ */
+typedef struct {
+    frame_pace_policy_t policy;
+    uint32_t period_us;       // Cadence for fixed-rate policies
+    uint64_t next_slot;       // Next cadence slot (fixed-rate policies)
+    uint64_t last_te;         // Last tearing-effect edge, 0 if none seen
+    uint32_t te_period_us;    // Estimated panel refresh period
+    uint64_t last_present;    // Timestamp of the last presented frame
+    
+    // Interval statistics, reset by frame_pacer_reset_stats()
+    uint32_t count;
+    uint64_t sum;
+    uint64_t sum_sq;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t missed;
+} frame_pacer_t;
+
+/**
+ * Initialize a pacer with a policy
+ */
+void frame_pacer_init(frame_pacer_t *pacer, frame_pace_policy_t policy, uint64_t now);
+
+/**
+ * Record a tearing-effect edge from the panel
+ */
+void frame_pacer_on_te(frame_pacer_t *pacer, uint64_t te_time);
+
+/**
+ * Get the time at which a frame that is ready at "now" should start scanout
+ * Returns "now" (or earlier) when it may start immediately
+ */
+uint64_t frame_pacer_next_present(frame_pacer_t *pacer, uint64_t now);
+
+/**
+ * Record that a frame started scanout at "now"
+ */
+void frame_pacer_presented(frame_pacer_t *pacer, uint64_t now);
+
+/**
+ * Get statistics for the current window
+ */
+void frame_pacer_get_stats(const frame_pacer_t *pacer, frame_pace_stats_t *stats);
+
+/**
+ * Start a new statistics window
+ */
+void frame_pacer_reset_stats(frame_pacer_t *pacer);
+
+/**
+ * Get a short name for a policy
+ */
+const char* frame_pacer_policy_name(frame_pace_policy_t policy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_PACER_H
@@ -0,0 +1,92 @@
+/**
+ * Frame timing telemetry for PICO-DOOM
+ * Records how long each stage of every frame takes on both cores and
+ * streams the records over USB (usb_stream.h) for
+ * tools/telemetry_report.py, which prints per-stage histograms and
+ * percentiles.
+ *
+ * Each core appends to its own fixed-size ring, so recording never
+ * takes a lock: the recording core is the only writer of its ring's head
+ * and core 0 the only writer of the tails. A record is one stage span:
+ *
+ *   start_us u32   time_us_64() at the start of the stage (low 32 bits)
+ *   length_us u32  duration
+ *   frame u16      presented frame number (low 16 bits)
+ *   stage u8       frame_telemetry_stage_t
+ *   core u8        core that recorded it
+ *
+ * A USB_PACKET_TELEMETRY payload is the running count of records dropped
+ * because a ring was full (u32 per core), followed by whole records.
+ * Records are dropped rather than waited for, so telemetry never stalls
+ * a frame.
+ */
+
+#ifndef FRAME_TELEMETRY_H
+#define FRAME_TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FRAME_TELEMETRY_RING_SIZE   256     // Records per core (power of two)
+#define FRAME_TELEMETRY_RECORD_SIZE 12
+
+/**
+ * Frame stages
+ */
+typedef enum {
+    TELEMETRY_INPUT = 0,      // Core 0: input_update and key collection
+    TELEMETRY_UPDATE,         // Core 0: the game tics run this frame
+    TELEMETRY_RENDER,         // Core 0: doom_render, both cores' columns
+    TELEMETRY_SWAP,           // Core 0: queueing the frame for scanout
+    TELEMETRY_SERVICE,        // Core 0: capture and lump cache work
+    TELEMETRY_VSYNC,          // Core 0: waiting for a free buffer
+    TELEMETRY_PACE,           // Core 1: frame held by the pacing policy
+    TELEMETRY_SCANOUT,        // Core 1: scanout start to last byte out
+    TELEMETRY_NUM_STAGES
+} frame_telemetry_stage_t;
+
+/**
+ * One stage span, in its stream layout
+ */
+typedef struct {
+    uint32_t start_us;
+    uint32_t length_us;
+    uint16_t frame;
+    uint8_t stage;
+    uint8_t core;
+} frame_telemetry_record_t;
+
+/**
+ * Start recording (records are ignored until then)
+ * Needs usb_stream_init() to have been called.
+ */
+void frame_telemetry_start(void);
+
+/**
+ * Record a stage that ran from start_us until now, on the calling core
+ * Safe from interrupt handlers.
+ * Returns now, so the next stage can start where this one ended
+ */
+uint64_t frame_telemetry_end(frame_telemetry_stage_t stage, uint32_t frame, uint64_t start_us);
+
+/**
+ * Move recorded spans from both rings into the USB stream
+ * Call on core 0 once per frame, before usb_stream_poll(). Spans that do
+ * not fit in the stream's queue wait for the next call.
+ */
+void frame_telemetry_flush(void);
+
+/**
+ * Records dropped so far because a core's ring was full
+ */
+uint32_t frame_telemetry_dropped(uint32_t core);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_TELEMETRY_H
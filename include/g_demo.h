@@ -0,0 +1,110 @@
+/**
+ * Demo playback and timedemo for PICO-DOOM
+ * Reads Doom's LMP demo format (the DEMO1-3 lumps, or a recorded .lmp)
+ * one ticcmd per tic, and times a playback the way Doom's -timedemo does:
+ * every tic runs as soon as the last one is done, so the wall time
+ * measures the engine rather than the 35 Hz clock.
+ *
+ * Formats:
+ *   v1.4-1.9 (version 104-111)  13 byte header: version, skill, episode,
+ *                               map, deathmatch, respawn, fast,
+ *                               nomonsters, consoleplayer, playeringame[4]
+ *   v1.2 and older              7 byte header: skill, episode, map,
+ *                               playeringame[4]
+ * Then each tic has one ticcmd per player in the game, and 0x80 ends the
+ * demo. Version 111 (longtics) stores a 16-bit angleturn.
+ *
+ * The play simulation is only p_player.h (no collision, monsters or
+ * specials), so a vanilla demo drifts away from the route it was recorded
+ * on. Playback is still deterministic: the same demo and image always
+ * give the same tics and frames, which is what a benchmark needs.
+ *
+ * Nothing here touches Pico hardware, so it builds on a host too.
+ */
+
+#ifndef G_DEMO_H
+#define G_DEMO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "p_player.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define G_DEMO_MAXPLAYERS   4
+#define G_DEMO_END          0x80
+
+/**
+ * Demo being played
+ */
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+    uint32_t pos;             // Next ticcmd
+    uint8_t version;          // 0 for the old format
+    uint8_t skill;
+    uint8_t episode;
+    uint8_t map;
+    uint8_t num_players;      // Players in the game (ticcmds per tic)
+    uint8_t player;           // Which of them is played back (the console player)
+    bool longtics;            // 16-bit angleturn (version 111)
+    uint32_t tics;            // Tics read so far
+} g_demo_t;
+
+/**
+ * Timedemo statistics
+ * A tic is one game tic plus, when rendering, its frame.
+ */
+typedef struct {
+    uint64_t start_us;
+    uint64_t last_us;
+    uint32_t gametics;
+    uint32_t frames;          // Tics that were rendered
+    uint32_t min_us;          // Shortest tic
+    uint32_t max_us;          // Longest tic
+} g_timedemo_t;
+
+/**
+ * Start playing a demo from its lump data
+ * The data must stay valid while the demo plays.
+ * Returns false if the data is not a demo this code can play
+ */
+bool g_demo_open(g_demo_t *demo, const uint8_t *data, uint32_t size);
+
+/**
+ * Get the played-back player's ticcmd for the next tic
+ * Returns false at the end of the demo
+ */
+bool g_demo_read(g_demo_t *demo, ticcmd_t *cmd);
+
+/**
+ * Get the demo's map name (G_InitNew)
+ * commercial: the image is Doom II (MAPxx), otherwise ExMy
+ * name: at least 9 bytes
+ */
+void g_demo_map_name(const g_demo_t *demo, bool commercial, char *name);
+
+/**
+ * Start timing a playback
+ */
+void g_timedemo_start(g_timedemo_t *td, uint64_t now_us);
+
+/**
+ * Count a tic that finished at now_us
+ * rendered: the tic also drew a frame
+ */
+void g_timedemo_tic(g_timedemo_t *td, uint64_t now_us, bool rendered);
+
+/**
+ * Print the playback's statistics
+ * name: demo name for the report
+ */
+void g_timedemo_report(const g_timedemo_t *td, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // G_DEMO_H
@@ -0,0 +1,49 @@
+/**
+ * Rendering kernel benchmark for PICO-DOOM
+ *
+ * Runs a fixed suite of the inner loops a frame is made of, each over the
+ * same number of pixels, and prints cycles per pixel and MB/s for each
+ * over USB serial. Every build reports the same table, so builds can be
+ * compared on real hardware (layout, interpolators, clock, RGB444):
+ *
+ *   fill       solid column fill (untextured walls)
+ *   column     textured wall column (r_draw_column)
+ *   span       horizontal flat span (Doom's R_DrawSpan)
+ *   masked     sprite column with transparent texels (r_draw_masked_column)
+ *   expand     scanline palette expansion to RGB565
+ *   pack       scanline packing to RGB444
+ *
+ * Kernels draw into the framebuffer they are given, one kernel per call,
+ * so the display keeps running between them. Runs on the calling core.
+ */
+
+#ifndef KERNEL_BENCH_H
+#define KERNEL_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KERNEL_BENCH_PASSES 8     // Full-screen passes per kernel
+
+/**
+ * Run the next kernel of the suite into a framebuffer
+ * data: framebuffer, pixel (x, y) at data[x * xs + y * ys]
+ * Prints the report after the last kernel, then starts over.
+ * Returns the name of the kernel that ran, or NULL if out of memory
+ */
+const char* kernel_bench_step(uint8_t *data, int xs, int ys, int width, int height);
+
+/**
+ * Free the benchmark's buffers (the next step allocates them again)
+ */
+void kernel_bench_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_BENCH_H
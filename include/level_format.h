@@ -0,0 +1,175 @@
+/**
+ * Compact level format for PICO-DOOM
+ * Shared by the firmware and the host-side wadpack tool (tools/wadpack)
+ *
+ * wadpack --levels converts each map (THINGS ... BLOCKMAP) into one lump
+ * named LEVEL_LUMP_PREFIX + map name (e.g. "L_E1M1"). Everything the
+ * classic loader derives at P_SetupLevel time is done on the host:
+ * coordinates are 16.16 fixed point, seg angles are full binary angles,
+ * line slopes, deltas and bounding boxes are precomputed, references are
+ * indices instead of pointers, texture names are texture numbers (the
+ * TEXTURE1/TEXTURE2 order, as in TEXCOLS) and each sector's line list
+ * (P_GroupLines) is stored ready-made.
+ *
+ * The lump is never compressed and every table is 4-byte aligned, so the
+ * firmware reads it in place from flash. Only the state the game changes
+ * goes into the per-level SRAM arena (see level_loader.h).
+ *
+ * Layout (little-endian):
+ *   level_header_t
+ *   level_vertex_t vertexes[num_vertexes]
+ *   level_line_t lines[num_lines]
+ *   level_side_t sides[num_sides]
+ *   level_sector_t sectors[num_sectors]
+ *   uint16_t sector_lines[num_sector_lines]
+ *   level_seg_t segs[num_segs]
+ *   level_subsector_t subsectors[num_subsectors]
+ *   level_node_t nodes[num_nodes]
+ *   level_thing_t things[num_things]         (the THINGS lump as-is)
+ *   char flats[num_flats][8]                 (flat names used by sectors)
+ *   int16_t blockmap[]                       (the BLOCKMAP lump as-is)
+ *   uint8_t reject[]                         (the REJECT lump as-is)
+ */
+
+#ifndef LEVEL_FORMAT_H
+#define LEVEL_FORMAT_H
+
+#include <stdint.h>
+#include "m_fixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LEVEL_MAGIC         0x4C564C43u   // "CLVL"
+#define LEVEL_VERSION       1
+#define LEVEL_LUMP_PREFIX   "L_"
+
+#define LEVEL_NONE          0xFFFF        // No side, sector or dynamic slot
+#define LEVEL_SUBSECTOR     0x8000        // Node child is a subsector
+
+// Bounding box indices (m_bbox.h)
+#define LEVEL_BOXTOP        0
+#define LEVEL_BOXBOTTOM     1
+#define LEVEL_BOXLEFT       2
+#define LEVEL_BOXRIGHT      3
+
+// Line slope types (slopetype_t)
+#define LEVEL_SLOPE_HORIZONTAL  0
+#define LEVEL_SLOPE_VERTICAL    1
+#define LEVEL_SLOPE_POSITIVE    2
+#define LEVEL_SLOPE_NEGATIVE    3
+
+// Line flags used at conversion time
+#define LEVEL_ML_TWOSIDED   0x0004
+
+/**
+ * Lump header
+ */
+typedef struct {
+    uint32_t magic;               // LEVEL_MAGIC
+    uint16_t version;             // LEVEL_VERSION
+    uint16_t num_dynamic_sides;   // Sides that get arena state (lines with specials)
+    uint32_t num_vertexes;
+    uint32_t num_lines;
+    uint32_t num_sides;
+    uint32_t num_sectors;
+    uint32_t num_sector_lines;
+    uint32_t num_segs;
+    uint32_t num_subsectors;
+    uint32_t num_nodes;
+    uint32_t num_things;
+    uint32_t num_flats;
+    uint32_t vertexes_offset;
+    uint32_t lines_offset;
+    uint32_t sides_offset;
+    uint32_t sectors_offset;
+    uint32_t sector_lines_offset;
+    uint32_t segs_offset;
+    uint32_t subsectors_offset;
+    uint32_t nodes_offset;
+    uint32_t things_offset;
+    uint32_t flats_offset;
+    uint32_t blockmap_offset;
+    uint32_t blockmap_size;       // Bytes
+    uint32_t reject_offset;
+    uint32_t reject_size;         // Bytes
+} level_header_t;
+
+typedef struct {
+    fixed_t x, y;
+} level_vertex_t;
+
+typedef struct {
+    uint16_t v1, v2;
+    uint16_t side[2];             // LEVEL_NONE if absent
+    uint16_t front_sector;
+    uint16_t back_sector;         // LEVEL_NONE if one-sided
+    uint16_t flags;               // Initial value; live value in the arena
+    uint16_t special;             // Initial value; live value in the arena
+    uint16_t tag;
+    uint8_t slope;                // LEVEL_SLOPE_*
+    uint8_t reserved;
+    fixed_t dx, dy;
+    fixed_t bbox[4];              // LEVEL_BOX*
+} level_line_t;
+
+typedef struct {
+    fixed_t texture_offset;       // Initial value for dynamic sides
+    fixed_t row_offset;
+    int16_t top_texture;          // Texture numbers, 0 = none ("-")
+    int16_t bottom_texture;
+    int16_t mid_texture;
+    uint16_t sector;
+    uint16_t dynamic;             // Arena side state slot, or LEVEL_NONE
+    uint16_t reserved;
+} level_side_t;
+
+typedef struct {
+    fixed_t floor_height;         // Initial values; live ones in the arena
+    fixed_t ceiling_height;
+    fixed_t sound_x, sound_y;     // Sound origin: centre of the bounding box
+    int16_t blockbox[4];          // Blockmap cells touched, LEVEL_BOX*
+    uint16_t floor_flat;          // Index into the flat name table
+    uint16_t ceiling_flat;
+    int16_t light;
+    int16_t special;
+    uint16_t tag;
+    uint16_t line_count;
+    uint32_t first_line;          // Index into sector_lines
+} level_sector_t;
+
+typedef struct {
+    uint16_t v1, v2;
+    angle_t angle;
+    fixed_t offset;
+    uint16_t line;
+    uint16_t side;                // 0 = front of the line, 1 = back
+    uint16_t front_sector;
+    uint16_t back_sector;         // LEVEL_NONE unless the line is two-sided
+} level_seg_t;
+
+typedef struct {
+    uint16_t sector;
+    uint16_t num_segs;
+    uint32_t first_seg;
+} level_subsector_t;
+
+typedef struct {
+    fixed_t x, y, dx, dy;         // Partition line
+    fixed_t bbox[2][4];           // Child bounding boxes, LEVEL_BOX*
+    uint16_t children[2];         // LEVEL_SUBSECTOR set for subsectors
+} level_node_t;
+
+typedef struct {
+    int16_t x, y;
+    int16_t angle;
+    int16_t type;
+    int16_t options;
+} level_thing_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEVEL_FORMAT_H
@@ -0,0 +1,127 @@
+/**
+ * Level loader for PICO-DOOM
+ *
+ * level_load() maps a compact level lump (see level_format.h) in place:
+ * the geometry, BSP, blockmap and reject stay in flash and only the state
+ * the game changes is allocated, in one per-level SRAM arena:
+ *   sector heights, flats, light and special
+ *   line flags and special
+ *   texture offsets and textures of sides on special lines (switches, scrollers)
+ *   flat lump numbers for the level's flat names
+ *   blockmap object links
+ *
+ * level_load_classic() loads the same map from its raw lumps the way
+ * P_SetupLevel does, into pointer-based structs, and reports its time and
+ * RAM for comparison; the result is freed straight away.
+ */
+
+#ifndef LEVEL_LOADER_H
+#define LEVEL_LOADER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "level_format.h"
+#include "wad_set.h"
+#include "tex_columns.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Mutable sector state
+ */
+typedef struct {
+    fixed_t floor_height;
+    fixed_t ceiling_height;
+    int16_t floor_flat;           // Flat numbers (WAD_NS_FLATS index)
+    int16_t ceiling_flat;
+    int16_t light;
+    int16_t special;
+} level_sector_state_t;
+
+/**
+ * Mutable line state
+ */
+typedef struct {
+    uint16_t flags;               // ML_MAPPED etc. change during play
+    uint16_t special;             // Cleared by one-shot specials
+} level_line_state_t;
+
+/**
+ * Mutable side state (sides of lines with specials only)
+ */
+typedef struct {
+    fixed_t texture_offset;
+    int16_t top_texture;
+    int16_t bottom_texture;
+    int16_t mid_texture;
+    int16_t reserved;
+} level_side_state_t;
+
+/**
+ * Loaded level: flash tables plus the SRAM arena
+ */
+typedef struct {
+    const level_header_t *header;
+    const level_vertex_t *vertexes;
+    const level_line_t *lines;
+    const level_side_t *sides;
+    const level_sector_t *sectors;
+    const uint16_t *sector_lines;
+    const level_seg_t *segs;
+    const level_subsector_t *subsectors;
+    const level_node_t *nodes;
+    const level_thing_t *things;
+    const int16_t *blockmap;
+    const uint8_t *reject;
+    
+    // Blockmap geometry
+    fixed_t bmap_orgx, bmap_orgy;
+    int32_t bmap_width, bmap_height;
+    
+    // Arena
+    level_sector_state_t *sector_state;
+    level_line_state_t *line_state;
+    level_side_state_t *side_state;
+    void **blocklinks;            // Objects per blockmap cell
+    uint8_t *arena;
+    uint32_t arena_size;
+} level_t;
+
+/**
+ * Load report
+ */
+typedef struct {
+    uint32_t load_us;
+    uint32_t ram_bytes;           // SRAM allocated for the level
+    uint32_t flash_bytes;         // Level data read in place
+} level_load_stats_t;
+
+/**
+ * Load a map from its compact lump (wadpack --levels)
+ * clock_us: optional time source for stats (e.g. time_us_64)
+ * Returns true on success
+ */
+bool level_load(level_t *level, const wad_set_t *set, const char *map,
+                uint64_t (*clock_us)(void), level_load_stats_t *stats);
+
+/**
+ * Free a level's arena
+ */
+void level_free(level_t *level);
+
+/**
+ * Load a map from its raw lumps like the classic P_SetupLevel, report
+ * the time and RAM it took, then free it
+ * textures: texture name lookup (NULL resolves every texture to 0)
+ * Returns true on success
+ */
+bool level_load_classic(const wad_set_t *set, const tex_columns_t *textures, const char *map,
+                        uint64_t (*clock_us)(void), level_load_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEVEL_LOADER_H
@@ -0,0 +1,114 @@
+/**
+ * Decompressed lump cache for PICO-DOOM
+ * Holds compressed lumps from a packed WAD image, decompressed, in a
+ * size-bounded SRAM budget.
+ *
+ * Entries carry a purge tag, as Doom's zone tags do. Under pressure the
+ * least recently used CACHE entries go first, then PURGELEVEL ones;
+ * STATIC and LEVEL entries are never evicted (LEVEL ones are dropped by
+ * lump_cache_purge_tag() at level end). A lookup or prefetch with a less
+ * purgeable tag raises an entry's tag, never lowers it. A pointer to a
+ * purgeable entry stays valid until the next cache miss.
+ *
+ * Entries are keyed by an opaque pointer (the lump's directory entry).
+ *
+ * Decompression is resumable: lump_cache_prefetch() queues a lump and
+ * lump_cache_service() advances queued work within a byte budget, so
+ * loads can be spread over idle time instead of stalling a frame.
+ */
+
+#ifndef LUMP_CACHE_H
+#define LUMP_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Purge tags, least to most purgeable
+ */
+typedef enum {
+    LUMP_CACHE_STATIC = 0,    // Kept until freed explicitly
+    LUMP_CACHE_LEVEL,         // Kept until the level ends
+    LUMP_CACHE_PURGELEVEL,    // Evicted after every CACHE entry
+    LUMP_CACHE_CACHE,         // Evicted first, least recently used order
+    LUMP_CACHE_TAG_COUNT
+} lump_cache_tag_t;
+
+/**
+ * Cache statistics
+ */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;              // Lookups that had to decompress (or finish)
+    uint32_t evictions;
+    uint32_t failures;            // Lookups that could not fit in the budget
+    uint32_t corrupt;             // Lumps that failed to decompress
+    uint32_t used_bytes;          // Current footprint (entries + headers)
+    uint32_t budget_bytes;
+    uint32_t entries;
+    uint32_t pending;             // Prefetches not finished yet
+    uint32_t decompressed_bytes;  // Total decompressed output
+    uint32_t decompress_us;       // Total time spent decompressing
+    uint32_t max_stall_us;        // Longest synchronous decompress in a lookup
+} lump_cache_stats_t;
+
+/**
+ * Initialize the cache
+ * budget_bytes: SRAM the cache may hold
+ * clock_us: microsecond clock for the timing statistics (time_us_64 on
+ *           the device)
+ */
+void lump_cache_init(uint32_t budget_bytes, uint64_t (*clock_us)(void));
+
+/**
+ * Get a lump's decompressed data, decompressing whatever is missing
+ * key: identifies the lump
+ * src/src_size: the LZ4 block in the image
+ * size: decompressed size
+ * Returns NULL if it cannot fit in the budget
+ */
+const uint8_t* lump_cache_get(const void *key, const uint8_t *src, uint32_t src_size,
+                              uint32_t size, lump_cache_tag_t tag);
+
+/**
+ * Queue a lump for background decompression (see lump_cache_service)
+ * Returns false if it cannot fit or every decoder is busy
+ */
+bool lump_cache_prefetch(const void *key, const uint8_t *src, uint32_t src_size,
+                         uint32_t size, lump_cache_tag_t tag);
+
+/**
+ * Advance queued decompression by up to max_bytes of output
+ * Returns true if work remains
+ */
+bool lump_cache_service(uint32_t max_bytes);
+
+/**
+ * Change a cached lump's purge tag
+ */
+void lump_cache_change_tag(const void *key, lump_cache_tag_t tag);
+
+/**
+ * Drop a lump's entry whatever its tag (e.g. when its WAD goes away)
+ */
+void lump_cache_drop(const void *key);
+
+/**
+ * Drop every entry with the given tag (e.g. LUMP_CACHE_LEVEL at level end)
+ */
+void lump_cache_purge_tag(lump_cache_tag_t tag);
+
+/**
+ * Get cache statistics
+ */
+void lump_cache_get_stats(lump_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LUMP_CACHE_H
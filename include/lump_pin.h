@@ -0,0 +1,71 @@
+/**
+ * Pinned lumps for PICO-DOOM
+ * Keeps SRAM copies of the hottest lumps so the renderer's repeated reads
+ * stop going through the 16 KB XIP cache.
+ *
+ * Copies live in one block reserved at init. Lookups go through a bitmap
+ * first, so the common case (lump not pinned) costs one load and a test;
+ * pinned lumps are then found by binary search of a table sorted by key.
+ * Keys are opaque pointers (the lump's directory entry).
+ */
+
+#ifndef LUMP_PIN_H
+#define LUMP_PIN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LUMP_PIN_MAX 128    // Most lumps that can be pinned at once
+
+/**
+ * Pinning statistics
+ */
+typedef struct {
+    uint32_t pinned;          // Lumps pinned
+    uint32_t used_bytes;      // Of the reserved block
+    uint32_t budget_bytes;
+    uint32_t hits;            // Lookups served from SRAM
+} lump_pin_stats_t;
+
+/**
+ * Reserve the SRAM block for pinned copies
+ * Returns false if it cannot be allocated
+ */
+bool lump_pin_init(uint32_t budget_bytes);
+
+/**
+ * Copy a lump into the reserved block
+ * Returns false if it does not fit or is already pinned
+ */
+bool lump_pin_add(const void *key, const uint8_t *data, uint32_t size);
+
+/**
+ * Get a pinned copy, or NULL if the lump is not pinned
+ */
+const uint8_t* lump_pin_find(const void *key);
+
+/**
+ * Unpin everything (e.g. before pinning for a new level)
+ * Must also be called before the WAD the pins came from is freed.
+ */
+void lump_pin_clear(void);
+
+/**
+ * Free space left in the reserved block
+ */
+uint32_t lump_pin_space(void);
+
+/**
+ * Get pinning statistics
+ */
+void lump_pin_get_stats(lump_pin_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LUMP_PIN_H
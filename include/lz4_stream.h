@@ -0,0 +1,67 @@
+/**
+ * Resumable LZ4 block decoder for PICO-DOOM
+ * Decodes compressed lumps in slices so the work can be spread over idle
+ * time instead of stalling a frame.
+ *
+ * The input is the whole LZ4 block (it sits in flash); the output is the
+ * whole decompressed lump (matches refer back into it). Each call to
+ * lz4_stream_run() produces at most a given number of output bytes and
+ * picks up exactly where the previous call stopped.
+ */
+
+#ifndef LZ4_STREAM_H
+#define LZ4_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// LZ4 block format limits
+#define LZ4_MIN_MATCH       4
+#define LZ4_MAX_OFFSET      65535
+
+/**
+ * Decoder result
+ */
+typedef enum {
+    LZ4_STREAM_MORE = 0,      // Budget used up, call again
+    LZ4_STREAM_DONE,          // Output complete
+    LZ4_STREAM_ERROR          // Corrupt input
+} lz4_stream_result_t;
+
+/**
+ * Decoder state
+ */
+typedef struct {
+    const uint8_t *src;
+    uint32_t src_size;
+    uint32_t src_pos;
+    uint8_t *dst;
+    uint32_t dst_size;
+    uint32_t dst_pos;
+    uint32_t literal_left;    // Literal bytes still to copy
+    uint32_t match_left;      // Match bytes still to copy
+    uint32_t match_offset;
+    uint8_t token;
+    bool need_match;          // Literals of this sequence done, match next
+} lz4_stream_t;
+
+/**
+ * Start decoding src into dst (dst_size is the exact decompressed size)
+ */
+void lz4_stream_init(lz4_stream_t *stream, const uint8_t *src, uint32_t src_size,
+                     uint8_t *dst, uint32_t dst_size);
+
+/**
+ * Decode up to max_out more bytes
+ */
+lz4_stream_result_t lz4_stream_run(lz4_stream_t *stream, uint32_t max_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LZ4_STREAM_H
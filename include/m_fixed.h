@@ -0,0 +1,72 @@
+/**
+ * Fixed point types for PICO-DOOM
+ * 16.16 fixed point and 32-bit binary angles, as in Doom
+ *
+ * The Cortex-M0+ has no divide instruction, so the renderer's per-column
+ * divides go through FixedRecip(): a 256-entry reciprocal table and one
+ * Newton step, all multiplies. FixedDiv() is kept for per-seg and
+ * per-sprite setup, where a real divide is cheap enough.
+ */
+
+#ifndef M_FIXED_H
+#define M_FIXED_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FRACBITS 16
+#define FRACUNIT (1 << FRACBITS)
+
+typedef int32_t fixed_t;
+typedef uint32_t angle_t;     // Binary angle: 0x40000000 is 90 degrees
+
+// 2^62 / m for the midpoint m of each 1/256 step of [2^31, 2^32)
+extern const uint32_t fixed_recip_table[256];
+
+static inline fixed_t FixedMul(fixed_t a, fixed_t b) {
+    return (fixed_t)(((int64_t)a * b) >> FRACBITS);
+}
+
+/**
+ * a / b in 16.16, saturating like Doom's FixedDiv on overflow
+ */
+static inline fixed_t FixedDiv(fixed_t a, fixed_t b) {
+    uint32_t ua = a < 0 ? -(uint32_t)a : (uint32_t)a;
+    uint32_t ub = b < 0 ? -(uint32_t)b : (uint32_t)b;
+    if ((ua >> 14) >= ub) {
+        return (a ^ b) < 0 ? INT32_MIN : INT32_MAX;
+    }
+    return (fixed_t)(((int64_t)a << FRACBITS) / b);
+}
+
+/**
+ * 2^32 / x, i.e. FixedDiv(FRACUNIT, x) for a positive 16.16 x
+ * Relative error below 2^-18; saturates at 0xFFFFFFFF for x <= 1.
+ */
+static inline uint32_t FixedRecip(uint32_t x) {
+    if (x <= 1) {
+        return 0xFFFFFFFFu;
+    }
+    int n = __builtin_clz(x);
+    uint32_t m = x << n;                                  // [2^31, 2^32)
+    uint32_t y = fixed_recip_table[(m >> 23) & 0xFF];     // ~2^62 / m
+    
+    // Newton step: y = y * (2 - m * y / 2^62)
+    uint64_t e = (1ull << 63) - (uint64_t)m * y;
+    y = (uint32_t)(((uint64_t)y * (uint32_t)(e >> 31)) >> 31);
+    
+    // 2^32 / x = y * 2^(n - 30)
+    if (n >= 31) {
+        return 0xFFFFFFFFu;
+    }
+    return n == 30 ? y : y >> (30 - n);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // M_FIXED_H
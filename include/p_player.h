@@ -0,0 +1,76 @@
+/**
+ * Player movement for PICO-DOOM
+ * Doom's per-tic command (ticcmd_t) and the part of the play simulation
+ * that moves the player from it: turning, thrust, momentum and friction
+ * (P_MovePlayer, P_XYMovement), with the view at eye height above the
+ * floor underfoot. There is no collision yet, so the player passes
+ * through walls and things, and no view bob.
+ *
+ * Live input and demo playback (g_demo.h) both produce ticcmds, so a
+ * demo moves the player exactly as the same key presses would.
+ */
+
+#ifndef P_PLAYER_H
+#define P_PLAYER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "m_fixed.h"
+#include "level_loader.h"
+#include "r_render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Walking speeds and turn rate of G_BuildTiccmd (forwardmove[0],
+// sidemove[0], angleturn[1])
+#define P_FORWARDMOVE       0x19
+#define P_SIDEMOVE          0x18
+#define P_ANGLETURN         1280
+
+// ticcmd buttons
+#define P_BT_ATTACK         1
+#define P_BT_USE            2
+
+/**
+ * One tic of player input (Doom's ticcmd_t)
+ */
+typedef struct {
+    int8_t forwardmove;       // *2048 for thrust
+    int8_t sidemove;          // Positive is right
+    int16_t angleturn;        // <<16 for angle turn, positive is left
+    uint8_t buttons;
+} ticcmd_t;
+
+/**
+ * Player state
+ */
+typedef struct {
+    fixed_t x, y, z;          // z is the eye
+    angle_t angle;
+    fixed_t momx, momy;
+    int sector;
+} p_player_t;
+
+/**
+ * Put the player on player 1's start (thing type 1)
+ * Returns false if the level has none (the player is put at the origin)
+ */
+bool p_spawn_player(const level_t *level, p_player_t *player);
+
+/**
+ * Run one tic of player movement
+ */
+void p_player_tic(const level_t *level, p_player_t *player, const ticcmd_t *cmd);
+
+/**
+ * Get the player's view for the renderer
+ */
+void p_player_view(const p_player_t *player, r_view_t *view);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // P_PLAYER_H
@@ -0,0 +1,230 @@
+/**
+ * Renderer internals shared by src/doom/r_*.c
+ * Doom's r_local.h on the compact level format. Everything a frame needs
+ * lives in one zone block (r_state_t) so the renderer's RAM shows up as
+ * a single allocation; the level-sized tables are PU_LEVEL.
+ */
+
+#ifndef R_LOCAL_H
+#define R_LOCAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "r_render.h"
+#include "r_tables.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CENTERX             (R_WIDTH / 2)
+#define CENTERY             (R_HEIGHT / 2)
+
+// Wall heights are kept in 20.12 so a whole column fits the step math
+#define HEIGHTBITS          12
+#define HEIGHTUNIT          (1 << HEIGHTBITS)
+
+// Lighting (r_main.h)
+#define LIGHTLEVELS         16
+#define LIGHTSEGSHIFT       4
+#define MAXLIGHTSCALE       48
+#define LIGHTSCALESHIFT     12
+#define MAXLIGHTZ           128
+#define LIGHTZSHIFT         20
+#define NUMCOLORMAPS        32
+#define DISTMAP             2
+
+// Frame list sizes (Doom: 256 drawsegs, 128 vissprites)
+#define MAXDRAWSEGS         128
+#define MAXVISSPRITES       64
+#define MAXSOLIDSEGS        32
+#define MAXFRAMELUMPS       128     // Compressed flats and patches held per frame
+
+#define MINZ                (4 * FRACUNIT)      // Nearest sprite drawn
+
+// Line flags (doomdata.h)
+#define ML_DONTPEGTOP       0x0008
+#define ML_DONTPEGBOTTOM    0x0010
+#define ML_MAPPED           0x0100
+
+// Drawseg flags
+#define DS_SOLID            0x01    // One-sided: hides everything behind it
+#define DS_MARKFLOOR        0x02    // Draws the front sector's floor below it
+#define DS_MARKCEILING      0x04    // Draws the front sector's ceiling above it
+#define DS_TEXTURED         0x08    // Has a wall texture to draw
+#define DS_MASKED           0x10    // Two-sided with a masked mid texture
+#define DS_SKY              0x20    // Front ceiling is the sky
+
+/**
+ * A visible range of one seg (Doom's drawseg_t plus the R_StoreWallRange
+ * state its column loop needs)
+ * Heights are relative to the view, in 20.12 (>> 4).
+ */
+typedef struct {
+    int16_t x1, x2;               // Screen columns, inclusive
+    uint16_t seg;
+    uint8_t flags;                // DS_*
+    uint8_t light;                // Wall light level, 0..LIGHTLEVELS-1
+    fixed_t scale1;               // Scale at x1
+    fixed_t scalestep;            // Per column
+    fixed_t offset;               // rw_offset
+    fixed_t distance;             // rw_distance
+    angle_t centerangle;          // rw_centerangle
+    fixed_t worldtop, worldbottom;
+    fixed_t worldhigh, worldlow;  // Back sector (two-sided)
+    fixed_t toptexturemid;
+    fixed_t bottomtexturemid;
+    fixed_t midtexturemid;        // Solid or masked mid texture
+    int16_t toptexture;           // Texture numbers, 0 = none
+    int16_t bottomtexture;
+    int16_t midtexture;
+    int16_t reserved;
+} r_drawseg_t;
+
+/**
+ * A visible thing (Doom's vissprite_t)
+ */
+typedef struct {
+    int16_t x1, x2;
+    fixed_t gx, gy;               // Map position, for the in-front test
+    fixed_t scale;
+    fixed_t xiscale;              // Patch column step, negative if flipped
+    fixed_t startfrac;            // Patch column at x1
+    fixed_t texturemid;
+    const uint8_t *patch;
+    uint8_t colormap;             // COLORMAP index
+    uint8_t reserved[3];
+} r_vissprite_t;
+
+/**
+ * Solid (fully drawn) column ranges during the BSP walk
+ */
+typedef struct {
+    int16_t first, last;
+} r_cliprange_t;
+
+/**
+ * Renderer state
+ */
+typedef struct {
+    // Level (r_set_level)
+    const level_t *level;
+    const wad_set_t *set;
+    const tex_columns_t *textures;
+    const uint8_t *colormaps;     // NUMCOLORMAPS light levels of 256 bytes
+    int sky_texture;              // -1 if missing
+    int sky_flat;                 // Flat number of F_SKY1, -1 if missing
+    const uint8_t **flat_data;    // Per flat number, resolved on first use this frame (PU_LEVEL)
+    uint32_t num_flats;
+    uint16_t (*sprite_lumps)[8];  // Per sprite type and rotation, resolved on first use (PU_LEVEL)
+    uint8_t *thing_sprite;        // Sprite type of each thing, R_NOSPRITE if none (PU_LEVEL)
+    uint16_t *sector_things;      // First thing in each sector (PU_LEVEL)
+    uint16_t *thing_next;         // Next thing in the same sector (PU_LEVEL)
+    uint8_t *sector_seen;         // Sectors whose things were added this frame (PU_LEVEL)
+    uint32_t prefetch_next;       // Next flat or sprite r_prefetch_level() queues
+    
+    // View (r_setup_frame)
+    fixed_t viewx, viewy, viewz;
+    angle_t viewangle;
+    fixed_t viewsin, viewcos;
+    angle_t clipangle;
+    
+    // Compressed lumps held in the lump cache until r_finish_frame()
+    uint16_t frame_lumps[MAXFRAMELUMPS];
+    int num_frame_lumps;
+    
+    // Frame lists, read by both cores while drawing
+    r_drawseg_t drawsegs[MAXDRAWSEGS];
+    r_vissprite_t vissprites[MAXVISSPRITES];
+    uint8_t sprite_order[MAXVISSPRITES];  // Far to near
+    uint8_t masked[MAXDRAWSEGS];  // Drawsegs with masked mid textures, near to far
+    int num_drawsegs;
+    int num_vissprites;
+    int num_masked;
+    r_stats_t stats;
+    
+    // BSP walk (core 0)
+    r_cliprange_t solidsegs[MAXSOLIDSEGS];
+    int num_solidsegs;
+    
+    // Per-column clipping while drawing; each core owns its columns
+    int16_t ceilingclip[R_WIDTH];
+    int16_t floorclip[R_WIDTH];
+    
+    // View tables (r_init)
+    angle_t xtoviewangle[R_WIDTH + 1];
+    fixed_t distscale[R_WIDTH];
+    fixed_t yslope[R_HEIGHT];
+    uint8_t zlight[LIGHTLEVELS][MAXLIGHTZ];   // COLORMAP index by distance
+} r_state_t;
+
+extern r_state_t *r;
+
+// r_main.c
+angle_t r_point_to_angle(fixed_t x, fixed_t y);
+fixed_t r_point_to_dist(fixed_t x, fixed_t y);
+int r_point_on_side(fixed_t x, fixed_t y, const level_node_t *node);
+int r_point_on_seg_side(fixed_t x, fixed_t y, const level_seg_t *seg);
+int r_view_angle_to_x(unsigned fine);
+const uint8_t* r_frame_lump(int lump);
+const uint8_t* r_flat_data(int flat);
+
+/**
+ * Flat data already resolved by core 0 this frame (safe on either core)
+ */
+static inline const uint8_t* r_flat_cached(int flat) {
+    return (flat >= 0 && (uint32_t)flat < r->num_flats) ? r->flat_data[flat] : NULL;
+}
+
+/**
+ * COLORMAP index for a wall or sprite at a given scale (Doom's scalelight)
+ */
+static inline int r_scale_light(int light, fixed_t scale) {
+    int index = scale >> LIGHTSCALESHIFT;
+    if (index >= MAXLIGHTSCALE) {
+        index = MAXLIGHTSCALE - 1;
+    }
+    int level = ((LIGHTLEVELS - 1 - light) * 2) * NUMCOLORMAPS / LIGHTLEVELS - index / DISTMAP;
+    if (level < 0) {
+        return 0;
+    }
+    return level >= NUMCOLORMAPS ? NUMCOLORMAPS - 1 : level;
+}
+
+/**
+ * Light level of a sector (0..LIGHTLEVELS-1)
+ */
+static inline int r_sector_light(int light) {
+    int level = light >> LIGHTSEGSHIFT;
+    if (level < 0) {
+        return 0;
+    }
+    return level >= LIGHTLEVELS ? LIGHTLEVELS - 1 : level;
+}
+
+// r_bsp.c
+void r_render_bsp(void);
+
+// r_things.c
+#define R_NOSPRITE          0xFF
+
+int r_sprite_type(int doomednum);
+int r_num_sprite_types(void);
+void r_add_sprites(int sector);
+bool r_prefetch_sprite(int type, int rotation);
+void r_sort_sprites(void);
+void r_draw_masked(uint8_t *data, int xs, int ys, int x0, int x1);
+
+// r_draw.c
+void r_draw_column(uint8_t *dest, int ys, int count, const uint8_t *source, int height,
+                   fixed_t frac, fixed_t fracstep, const uint8_t *colormap);
+void r_draw_masked_column(uint8_t *dest, int ys, int count, const uint8_t *source, int height,
+                          fixed_t frac, fixed_t fracstep, const uint8_t *colormap, bool holes);
+void r_draw_plane_column(uint8_t *dest, int ys, int y1, int y2, const uint8_t *flat,
+                         fixed_t planeheight, int light, int x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // R_LOCAL_H
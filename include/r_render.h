@@ -0,0 +1,135 @@
+/**
+ * Software renderer for PICO-DOOM
+ * Doom's view path on the compact level format: BSP traversal, wall
+ * columns, floors and ceilings, sky and masked sprites, drawn as 8-bit
+ * palette indices through COLORMAP lighting.
+ *
+ * A frame runs in two steps:
+ *   r_setup_frame()   core 0 walks the BSP front to back and builds the
+ *                     frame's draw lists (visible wall ranges and sprites),
+ *                     resolving every lump the frame needs
+ *   r_draw_columns()  draws a range of screen columns from those lists;
+ *                     ranges are independent, so core 0 and core 1 each
+ *                     draw a share (see render_split.h)
+ * Floors and ceilings are cast per column instead of being collected
+ * into visplanes, which keeps the working set to a few KB and lets each
+ * column be finished by one core.
+ *
+ * Nothing here touches Pico hardware except the interpolator path in
+ * r_draw.c, so the same sources build on a host (tools/render_host).
+ */
+
+#ifndef R_RENDER_H
+#define R_RENDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "m_fixed.h"
+#include "level_loader.h"
+#include "wad_set.h"
+#include "tex_columns.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// View window: the full 320x200 Doom screen (no status bar)
+#define R_WIDTH             320
+#define R_HEIGHT            200
+
+#define R_VIEWHEIGHT        (41 * FRACUNIT)     // Eye height above the floor
+
+/**
+ * Viewpoint
+ */
+typedef struct {
+    fixed_t x, y, z;
+    angle_t angle;
+} r_view_t;
+
+/**
+ * Per-frame counters from the last r_setup_frame()
+ */
+typedef struct {
+    uint16_t nodes;           // BSP nodes visited
+    uint16_t subsectors;      // Subsectors drawn
+    uint16_t drawsegs;        // Visible wall ranges
+    uint16_t sprites;         // Visible sprites
+    uint16_t overflows;       // Wall ranges or sprites dropped for lack of room
+    uint16_t missing;         // Flats and sprite patches the lump cache could not hold
+} r_stats_t;
+
+/**
+ * Allocate the renderer's working memory (zone, PU_STATIC) and build the
+ * view tables
+ * Returns true on success
+ */
+bool r_init(void);
+
+/**
+ * Attach a loaded level
+ * Resolves the colormaps, sky texture and sky flat, and links things to
+ * their sectors (PU_LEVEL, freed with the level).
+ * textures: TEXCOLS store, or NULL to draw walls untextured
+ * sky: sky texture name (e.g. "SKY1")
+ * Returns true on success
+ */
+bool r_set_level(const level_t *level, const wad_set_t *set,
+                 const tex_columns_t *textures, const char *sky);
+
+/**
+ * Queue the level's flats and sprite patches for background decompression
+ * (lump_cache_prefetch, tagged PURGELEVEL), so the first frames that need them
+ * find them cached. Queues what the cache's decoders take and resumes on
+ * the next call: call once per frame until it returns false.
+ */
+bool r_prefetch_level(void);
+
+/**
+ * Get a map's sky texture name (G_InitNew): by episode for ExMy maps, by
+ * map number for MAPxx
+ */
+const char* r_sky_name(const char *map);
+
+/**
+ * Detach the level (before it is freed)
+ */
+void r_clear_level(void);
+
+/**
+ * Get the sector containing a point (Doom's R_PointInSubsector)
+ */
+int r_point_sector(const level_t *level, fixed_t x, fixed_t y);
+
+/**
+ * Walk the BSP from a viewpoint and build the frame's draw lists (core 0)
+ */
+void r_setup_frame(const r_view_t *view);
+
+/**
+ * Draw screen columns [x0, x1) of the frame built by r_setup_frame()
+ * Safe to run on both cores at once for disjoint ranges.
+ * data: framebuffer, pixel (x, y) at data[x * xs + y * ys]
+ */
+void r_draw_columns(uint8_t *data, int xs, int ys, int x0, int x1);
+
+/**
+ * Hand the frame's compressed flats and sprite patches back to the lump
+ * cache once every r_draw_columns() call is done with them
+ * They were held at LEVEL so later misses in the frame could not evict
+ * them; released they are PURGELEVEL, kept over CACHE entries but
+ * evictable, so a level's flats and sprites need not fit the cache at
+ * once, only one frame's. r_setup_frame() releases anything still held.
+ */
+void r_finish_frame(void);
+
+/**
+ * Get the counters of the last frame
+ */
+void r_get_stats(r_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // R_RENDER_H
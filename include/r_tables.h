@@ -0,0 +1,76 @@
+/**
+ * Trigonometry tables for the renderer (Doom's tables.h)
+ * Only the first quadrant of the sine and the positive half of the
+ * tangent are stored (16 KB of flash instead of 56 KB); the accessors
+ * below rebuild finesine/finecosine/finetangent by symmetry.
+ */
+
+#ifndef R_TABLES_H
+#define R_TABLES_H
+
+#include <stdint.h>
+#include "m_fixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FINEANGLES          8192
+#define FINEMASK            (FINEANGLES - 1)
+#define ANGLETOFINESHIFT    19          // Binary angle to fine angle index
+
+#define ANG45               0x20000000u
+#define ANG90               0x40000000u
+#define ANG180              0x80000000u
+#define ANG270              0xC0000000u
+
+#define SLOPERANGE          2048
+#define SLOPEBITS           11
+#define DBITS               (FRACBITS - SLOPEBITS)
+
+extern const fixed_t r_sine_quarter[FINEANGLES / 4];
+extern const fixed_t r_tangent_half[FINEANGLES / 4];
+extern const angle_t tantoangle[SLOPERANGE + 1];
+
+/**
+ * finesine[i] for any fine angle index
+ */
+static inline fixed_t finesine(unsigned i) {
+    unsigned j = i & (FINEANGLES / 2 - 1);
+    if (j >= FINEANGLES / 4) {
+        j = FINEANGLES / 2 - 1 - j;
+    }
+    return (i & (FINEANGLES / 2)) ? -r_sine_quarter[j] : r_sine_quarter[j];
+}
+
+static inline fixed_t finecosine(unsigned i) {
+    return finesine(i + FINEANGLES / 4);
+}
+
+/**
+ * finetangent[i] for i in [0, FINEANGLES / 2): -90 to +90 degrees
+ */
+static inline fixed_t finetangent(unsigned i) {
+    i &= FINEANGLES / 2 - 1;
+    if (i >= FINEANGLES / 4) {
+        return r_tangent_half[i - FINEANGLES / 4];
+    }
+    return -r_tangent_half[FINEANGLES / 4 - 1 - i];
+}
+
+/**
+ * Tangent to angle lookup index (Doom's SlopeDiv)
+ */
+static inline unsigned slope_div(uint32_t num, uint32_t den) {
+    if (den < 512) {
+        return SLOPERANGE;
+    }
+    uint32_t ans = (num << 3) / (den >> 8);
+    return ans <= SLOPERANGE ? ans : SLOPERANGE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // R_TABLES_H
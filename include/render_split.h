@@ -0,0 +1,83 @@
+/**
+ * Dual-core split rendering for PICO-DOOM
+ *
+ * Core 0 divides each frame's columns in two: it draws [0, split) itself
+ * and hands [split, width) to core 1, which runs it from the idle gaps of
+ * its display loop (waiting for a frame, for DMA scanout, or for the
+ * pacer). The handoff is a single-slot mailbox guarded by sequence
+ * numbers, so neither core takes a lock.
+ *
+ * The split moves every frame toward equal finish times: each core's cost
+ * per column from the previous frame predicts the next one, which also
+ * absorbs the scanout interrupts core 1 services while it draws.
+ */
+
+#ifndef RENDER_SPLIT_H
+#define RENDER_SPLIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Split rendering by default; the mode can also change at run time
+#ifndef PICO_DOOM_DUAL_CORE_RENDER
+#define PICO_DOOM_DUAL_CORE_RENDER 1
+#endif
+
+/**
+ * Draw columns [x0, x1) of the current frame
+ * ctx: per-frame state shared by both cores (read-only while drawing)
+ */
+typedef void (*render_columns_fn)(void *ctx, int x0, int x1);
+
+/**
+ * Render statistics since the last reset, per mode
+ */
+typedef struct {
+    bool dual;                // Current mode
+    uint32_t single_frames;
+    uint32_t single_us;       // Mean frame render time on core 0 alone
+    uint32_t dual_frames;
+    uint32_t dual_us;         // Mean frame render time split across cores
+    uint32_t core0_us;        // Mean time of each core's share (dual mode)
+    uint32_t core1_us;
+    uint32_t wait_us;         // Mean time core 0 waited for core 1
+    uint16_t split;           // Current first column of core 1's share
+    uint16_t width;
+} render_split_stats_t;
+
+/**
+ * Choose single- or dual-core rendering (core 0 only)
+ */
+void render_split_set_dual(bool dual);
+
+/**
+ * Render a frame of "width" columns (core 0)
+ * Falls back to core 0 alone until core 1 has entered its display loop.
+ */
+void render_split_run(render_columns_fn fn, void *ctx, int width);
+
+/**
+ * Run core 1's share of a posted frame, if any (core 1)
+ * Returns true if it drew something. Cheap enough for any wait loop.
+ */
+bool render_split_service(void);
+
+/**
+ * Get statistics since the last reset
+ */
+void render_split_get_stats(render_split_stats_t *stats);
+
+/**
+ * Start a new statistics window
+ */
+void render_split_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RENDER_SPLIT_H
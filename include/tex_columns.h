@@ -0,0 +1,94 @@
+/**
+ * Precomposited wall texture columns for PICO-DOOM
+ *
+ * wadpack --texcols composites every TEXTURE1/TEXTURE2 texture from its
+ * PNAMES patches at pack time and stores the result as the TEXCOLS lump.
+ * The lump stays uncompressed in flash, so the column renderer reads any
+ * texture column straight from XIP with one table load. Nothing is
+ * composited or allocated on the device.
+ *
+ * TEXCOLS layout (little-endian):
+ *   texcols_header_t
+ *   texcols_texture_t textures[num_textures]   (Doom texture number order)
+ *   uint32_t column_offsets[num_columns]       (from the start of the lump)
+ *   column data: height bytes per column, identical columns stored once
+ */
+
+#ifndef TEX_COLUMNS_H
+#define TEX_COLUMNS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TEXCOLS_MAGIC    0x4C435854u    // "TXCL"
+#define TEXCOLS_VERSION  1
+
+// Texture flags
+#define TEXCOLS_HOLES    0x0001          // Some pixels are not covered by any patch (stored as 0)
+
+/**
+ * Lump header
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t num_textures;
+    uint32_t num_columns;       // Entries in column_offsets
+    uint32_t textures_offset;
+    uint32_t columns_offset;    // column_offsets[]
+} texcols_header_t;
+
+/**
+ * Texture entry
+ */
+typedef struct {
+    char name[8];               // Upper case, zero padded
+    uint16_t width;
+    uint16_t height;
+    uint16_t width_mask;        // width - 1 if width is a power of two, else 0
+    uint16_t flags;             // TEXCOLS_*
+    uint32_t first_column;      // Index of column 0 in column_offsets
+} texcols_texture_t;
+
+/**
+ * Mapped store
+ */
+typedef struct {
+    const uint8_t *base;
+    const texcols_texture_t *textures;
+    const uint32_t *column_offsets;
+    uint32_t num_textures;
+} tex_columns_t;
+
+/**
+ * Map a TEXCOLS lump (in place, nothing is copied)
+ * Returns true if the lump is valid
+ */
+bool tex_columns_init(tex_columns_t *store, const uint8_t *lump, uint32_t size);
+
+/**
+ * Find a texture by name (case-insensitive)
+ * Returns the texture number, or -1 if not found
+ */
+int tex_columns_find(const tex_columns_t *store, const char *name);
+
+/**
+ * Get one column of a texture: height bytes of palette indices
+ * col wraps like R_GetColumn (mask for power-of-two widths, else modulo)
+ */
+static inline const uint8_t *tex_columns_get(const tex_columns_t *store, int texture, int col) {
+    const texcols_texture_t *tex = &store->textures[texture];
+    col = tex->width_mask ? (col & tex->width_mask) : (int)((unsigned)col % tex->width);
+    return store->base + store->column_offsets[tex->first_column + col];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEX_COLUMNS_H
@@ -0,0 +1,82 @@
+/**
+ * Game tic scheduler for PICO-DOOM
+ * Runs the simulation at Doom's fixed 35 Hz, independent of frame rate
+ *
+ * Each rendered frame asks how many tics are due since the last one: none
+ * when rendering is faster than 35 Hz, several after a slow frame. A cap
+ * bounds the catch-up so one long stall (a level load, a flash erase)
+ * cannot snowball into a burst of tics; the surplus is dropped and game
+ * time slips instead. Like the frame pacer it never reads a clock
+ * itself, so the same logic runs against a simulated clock on a host.
+ */
+
+#ifndef TIC_SCHEDULER_H
+#define TIC_SCHEDULER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TICRATE 35
+
+/**
+ * Scheduler statistics over the current window
+ */
+typedef struct {
+    uint32_t tics;            // Tics run
+    uint32_t frames;          // Frames rendered
+    float tics_per_sec;
+    float frames_per_sec;
+    uint32_t catchup_frames;  // Frames that ran more than one tic
+    uint32_t idle_frames;     // Frames that ran no tic (rendering ahead of 35 Hz)
+    uint32_t dropped_tics;    // Tics skipped by the catch-up cap
+    uint32_t max_tics;        // Most tics run before a single frame
+} tic_stats_t;
+
+/**
+ * Scheduler state
+ */
+typedef struct {
+    uint64_t start;           // Time of tic 0
+    uint64_t gametic;         // Tics run or dropped so far
+    uint32_t max_catchup;     // Most tics run per frame
+    
+    // Window statistics, reset by tic_scheduler_reset_stats()
+    uint64_t window_start;
+    uint32_t tics;
+    uint32_t frames;
+    uint32_t catchup_frames;
+    uint32_t idle_frames;
+    uint32_t dropped_tics;
+    uint32_t max_tics;
+} tic_scheduler_t;
+
+/**
+ * Initialize a scheduler; the first tic is due at "now"
+ * max_catchup: most tics run per frame (at least 1)
+ */
+void tic_scheduler_init(tic_scheduler_t *sched, uint32_t max_catchup, uint64_t now);
+
+/**
+ * Get the number of tics to run before rendering the frame at "now"
+ * The caller runs exactly that many; they count as run.
+ */
+uint32_t tic_scheduler_due(tic_scheduler_t *sched, uint64_t now);
+
+/**
+ * Get statistics for the window ending at "now"
+ */
+void tic_scheduler_get_stats(const tic_scheduler_t *sched, uint64_t now, tic_stats_t *stats);
+
+/**
+ * Start a new statistics window at "now"
+ */
+void tic_scheduler_reset_stats(tic_scheduler_t *sched, uint64_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIC_SCHEDULER_H
@@ -0,0 +1,94 @@
+/**
+ * Binary packet stream over USB stdio for PICO-DOOM
+ * Debug data (frame captures, telemetry) shares the CDC link with printf.
+ * Packets are framed so a host tool can pick them out of the text:
+ *
+ *   0xA5 0x5A type len_lo len_hi payload[len] sum_lo sum_hi
+ *
+ * sum is the 16-bit sum of type, length and payload bytes.
+ */
+
+#ifndef USB_STREAM_H
+#define USB_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Packet framing
+#define USB_STREAM_SYNC0        0xA5
+#define USB_STREAM_SYNC1        0x5A
+#define USB_STREAM_HEADER_SIZE  5
+#define USB_STREAM_TRAILER_SIZE 2
+#define USB_STREAM_MAX_PAYLOAD  4096
+
+// Transmit ring (power of two), taken from the zone's SRAM (ZONE_DEBUG_KB).
+// A captured frame reaches the host whole only if its bands fit at once;
+// telemetry alone needs a couple of polls' worth.
+#if PICO_DOOM_CAPTURE
+#define USB_STREAM_RING_SIZE    (16 * 1024)
+#else
+#define USB_STREAM_RING_SIZE    (8 * 1024)
+#endif
+
+// Packet types
+typedef enum {
+    USB_PACKET_FRAME_BEGIN = 1,     // Frame capture: frame header
+    USB_PACKET_FRAME_BAND  = 2,     // Frame capture: one encoded band
+    USB_PACKET_PALETTE     = 3,     // Frame capture: RGB888 palette
+    USB_PACKET_FRAME_END   = 4,     // Frame capture: frame trailer
+    USB_PACKET_TELEMETRY   = 5,     // Frame telemetry: stage spans (frame_telemetry.h)
+} usb_packet_type_t;
+
+/**
+ * Initialize the stream (switches USB stdio to raw, untranslated output)
+ */
+void usb_stream_init(void);
+
+/**
+ * Free space in the transmit queue, in payload bytes for one packet
+ */
+uint32_t usb_stream_space(void);
+
+/**
+ * Begin a packet of a known payload size
+ * Returns false (and queues nothing) if it does not fit
+ */
+bool usb_stream_begin(uint8_t type, uint16_t len);
+
+/**
+ * Append payload bytes to the packet being built
+ */
+void usb_stream_write(const void *data, uint16_t len);
+
+/**
+ * Finish the packet being built
+ */
+void usb_stream_end(void);
+
+/**
+ * Queue a whole packet
+ * Returns false if it does not fit
+ */
+bool usb_stream_send(uint8_t type, const void *payload, uint16_t len);
+
+/**
+ * Push queued packets to USB, whole packets of at most max_bytes in total
+ * per call (a single larger packet is sent on its own)
+ * Call once per main loop iteration; never waits for a disconnected host.
+ */
+void usb_stream_poll(uint32_t max_bytes);
+
+/**
+ * Number of packets dropped because the queue was full
+ */
+uint32_t usb_stream_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // USB_STREAM_H
@@ -0,0 +1,150 @@
+/**
+ * Packed WAD flash image format for PICO-DOOM
+ * Shared by the firmware and the host-side wadpack tool (tools/wadpack)
+ *
+ * An image is one or more WADs merged and laid out for the XIP window so
+ * the firmware can use it in place:
+ *
+ *   wad_image_header_t
+ *   wad_image_lump_t directory[num_lumps]    (same layout as wad_lump_t)
+ *   uint16_t hash[hash_slots]                (lump number + 1, 0 = empty)
+ *   wad_image_pack_t pack[num_lumps]         (only if any lump is compressed)
+ *   hot lump data                            (lumps touched at startup)
+ *   remaining lump data
+ *
+ * Names are upper case and zero padded. Lump data is aligned to the
+ * image's lump alignment and offsets are from the start of the image.
+ * A directory entry's size is always the decompressed size; the pack
+ * table says how each lump is stored.
+ * Everything is little-endian, like the RP2040.
+ */
+
+#ifndef WAD_IMAGE_H
+#define WAD_IMAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WAD_IMAGE_MAGIC     0x4B504457u   // "WDPK"
+#define WAD_IMAGE_VERSION   2
+
+// Header flags
+#define WAD_IMAGE_IWAD      0x0001        // First input was an IWAD
+
+// Largest directory and index an image may have
+#define WAD_IMAGE_MAX_LUMPS      0xFFFF    // Index slots hold lump number + 1
+#define WAD_IMAGE_MAX_HASH_SLOTS 0x20000   // wad_hash_slots(WAD_IMAGE_MAX_LUMPS)
+
+// Lump storage methods
+#define WAD_LUMP_RAW        0             // Stored as-is, usable in place
+#define WAD_LUMP_LZ4        1             // LZ4 block (see lz4_stream.h)
+
+// Default lump data alignment: one RP2040 XIP cache line
+#define WAD_IMAGE_DEFAULT_ALIGN 8
+
+// Default flash offset of the image (firmware gets the first 512 KB)
+#define WAD_IMAGE_DEFAULT_FLASH_OFFSET 0x80000
+
+/**
+ * Image header (at offset 0, 4-byte aligned)
+ */
+typedef struct {
+    uint32_t magic;           // WAD_IMAGE_MAGIC
+    uint16_t version;         // WAD_IMAGE_VERSION
+    uint16_t flags;           // WAD_IMAGE_*
+    uint32_t image_size;      // Total bytes, header included
+    uint32_t num_lumps;
+    uint32_t dir_offset;      // wad_image_lump_t[num_lumps]
+    uint32_t hash_offset;     // uint16_t[hash_slots]
+    uint32_t hash_slots;      // Power of two, at most 3/4 full
+    uint32_t hot_offset;      // Hot lump group
+    uint32_t hot_size;
+    uint32_t lump_align;      // Alignment of every lump's data
+    uint32_t pack_offset;     // wad_image_pack_t[num_lumps], 0 if all raw
+    uint32_t dir_checksum;    // wad_image_checksum() of directory, hash and pack table
+} wad_image_header_t;
+
+/**
+ * Directory entry (layout matches wad_lump_t, so the firmware uses the
+ * directory in flash as-is)
+ */
+typedef struct {
+    uint32_t offset;          // From the start of the image
+    uint32_t size;
+    char name[8];             // Upper case, zero padded
+} wad_image_lump_t;
+
+/**
+ * How a lump is stored
+ */
+typedef struct {
+    uint32_t stored_size;     // Bytes at the directory offset
+    uint8_t method;           // WAD_LUMP_*
+    uint8_t reserved[3];
+} wad_image_pack_t;
+
+/**
+ * Load 4 bytes of a lump name as one word
+ */
+static inline uint32_t wad_name_word(const char *p) {
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+/**
+ * Normalize a lump name: upper case, zero-filled after the terminator
+ * Reads at most 8 characters, so both C strings and directory names work.
+ */
+static inline void wad_normalize_name(char *dst, const char *src) {
+    int i = 0;
+    for (; i < 8 && src[i]; i++) {
+        dst[i] = toupper((unsigned char)src[i]);
+    }
+    for (; i < 8; i++) {
+        dst[i] = 0;
+    }
+}
+
+/**
+ * Hash a normalized name given as two words
+ * The packer and the loader must agree on this.
+ */
+static inline uint32_t wad_hash_name(uint32_t w0, uint32_t w1) {
+    uint32_t h = (w0 * 0x9E3779B1u) ^ ((w1 + 0x7F4A7C15u) * 0x85EBCA77u);
+    return h ^ (h >> 16);
+}
+
+/**
+ * Number of index slots for a directory: power of two, at most 3/4 full
+ */
+static inline uint32_t wad_hash_slots(uint32_t num_lumps) {
+    uint32_t slots = 16;
+    while (slots * 3 < num_lumps * 4) {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+/**
+ * FNV-1a over a byte range
+ */
+static inline uint32_t wad_image_checksum(const uint8_t *data, uint32_t len) {
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < len; i++) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    return h;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAD_IMAGE_H
@@ -8,6 +8,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "wad_image.h"
+#include "lump_cache.h"
+#include "lump_pin.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,16 +34,29 @@ typedef struct {
     char name[8];            // Lump name
 } wad_lump_t;
 
+/**
+ * Per-lump access counters (profiling)
+ */
+typedef struct {
+    uint32_t accesses;       // Data lookups
+    uint32_t bytes;          // Lump bytes handed out (size per lookup)
+} wad_lump_access_t;
+
 /**
  * WAD file structure
  */
 typedef struct {
     wad_header_t header;
-    wad_lump_t *lumps;       // Directory of lumps
+    const wad_lump_t *lumps; // Directory of lumps
     bool is_iwad;            // true for IWAD, false for PWAD
     uint32_t num_lumps;      // Cached lump count
     const uint8_t *data;     // Pointer to WAD data in memory
     uint32_t data_size;      // Size of loaded data
+    const uint16_t *hash;    // Name index: lump number + 1 per slot, 0 = empty
+    uint32_t hash_mask;      // Index slots - 1 (power of two)
+    bool mapped;             // Directory and index live in a packed image
+    const wad_image_pack_t *pack;  // Per-lump storage, NULL if all raw
+    wad_lump_access_t *access;     // Access profile, NULL unless enabled
 } wad_file_t;
 
 /**
@@ -50,16 +66,68 @@ typedef struct {
 wad_file_t* wad_load_from_memory(const uint8_t *data, uint32_t size);
 
 /**
- * Find a lump by name
+ * Map a packed image built by tools/wadpack
+ * The directory and name index are used in place; nothing is parsed or
+ * copied, and lump data pointers point into the image.
+ * Returns pointer to WAD structure on success, NULL on failure
+ */
+wad_file_t* wad_map_image(const uint8_t *image, uint32_t size);
+
+/**
+ * Find a lump by name (case-insensitive)
+ * When a name appears more than once the last lump wins, as with PWADs.
  * Returns lump entry if found, NULL otherwise
  */
-wad_lump_t* wad_find_lump(wad_file_t *wad, const char *name);
+const wad_lump_t* wad_find_lump(wad_file_t *wad, const char *name);
+
+/**
+ * Find a lump by scanning the whole directory
+ * Same result as wad_find_lump(); kept for comparison and as the fallback
+ * when the index could not be built.
+ */
+const wad_lump_t* wad_find_lump_linear(wad_file_t *wad, const char *name);
+
+/**
+ * Time every directory name through both lookups and print the result
+ * clock_us: microsecond clock (time_us_64 on the device)
+ */
+void wad_benchmark_lookups(wad_file_t *wad, uint64_t (*clock_us)(void));
 
 /**
  * Get lump data pointer
- * Returns pointer to lump data in the WAD
+ * Raw lumps point into the WAD; compressed lumps come from the lump cache
+ * with the CACHE tag (valid until the next cache miss).
+ * Returns pointer to lump data, NULL on failure
+ */
+const uint8_t* wad_get_lump_data(wad_file_t *wad, const wad_lump_t *lump);
+
+/**
+ * Get lump data, keeping a compressed lump cached under the given tag
+ */
+const uint8_t* wad_cache_lump(wad_file_t *wad, const wad_lump_t *lump, lump_cache_tag_t tag);
+
+/**
+ * Start decompressing a lump in the background (no-op for raw and pinned
+ * lumps)
+ * Returns false if the lump cache could not take it now
+ */
+bool wad_prefetch_lump(wad_file_t *wad, const wad_lump_t *lump, lump_cache_tag_t tag);
+
+/**
+ * Start counting lump data lookups (see wad_set_dump_profile)
+ * Returns false if the counters cannot be allocated
+ */
+bool wad_profile_enable(wad_file_t *wad);
+
+/**
+ * Zero the access counters
+ */
+void wad_profile_reset(wad_file_t *wad);
+
+/**
+ * Whether a lump is stored compressed
  */
-const uint8_t* wad_get_lump_data(wad_file_t *wad, wad_lump_t *lump);
+bool wad_lump_is_compressed(const wad_file_t *wad, const wad_lump_t *lump);
 
 /**
  * Free WAD structure
@@ -0,0 +1,140 @@
+/**
+ * WAD set for PICO-DOOM
+ * Stacks an IWAD with PWADs. Lumps are numbered across the whole set in
+ * load order, and a name resolves to its last occurrence, so a PWAD
+ * overrides anything loaded before it.
+ *
+ * The set keeps one merged name index (a lookup is one hash probe however
+ * many WADs are loaded) and, for each marker namespace, the list of lumps
+ * between its START/END markers with overrides already applied. Sprite,
+ * flat and patch enumeration walks that list instead of the directory.
+ */
+
+#ifndef WAD_SET_H
+#define WAD_SET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "wad_loader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WAD_SET_MAX_WADS 8
+
+/**
+ * Marker namespaces
+ */
+typedef enum {
+    WAD_NS_SPRITES = 0,       // S_START/S_END (or SS_)
+    WAD_NS_FLATS,             // F_START/F_END (or FF_)
+    WAD_NS_PATCHES,           // P_START/P_END (or PP_)
+    WAD_NS_COUNT
+} wad_namespace_t;
+
+/**
+ * WAD set
+ */
+typedef struct {
+    wad_file_t *wads[WAD_SET_MAX_WADS];
+    uint32_t base[WAD_SET_MAX_WADS];    // Set lump number of each WAD's first lump
+    uint32_t num_wads;
+    uint32_t num_lumps;
+    
+    uint16_t *hash;                     // Set lump number + 1, 0 = empty
+    uint32_t hash_mask;
+    
+    uint16_t *ns_lumps[WAD_NS_COUNT];   // Set lump numbers, in namespace order
+    uint32_t ns_count[WAD_NS_COUNT];
+} wad_set_t;
+
+/**
+ * Initialize an empty set
+ */
+void wad_set_init(wad_set_t *set);
+
+/**
+ * Add a WAD on top of the set (the set does not take ownership)
+ * Rebuilds the merged index and namespace lists.
+ * Returns true on success
+ */
+bool wad_set_add(wad_set_t *set, wad_file_t *wad);
+
+/**
+ * Find a lump by name; the last WAD to define it wins
+ * Returns the set lump number, or -1 if not found
+ */
+int wad_set_find(const wad_set_t *set, const char *name);
+
+/**
+ * Find a lump by name within a namespace
+ * Returns its index in the namespace list (e.g. the flat number), or -1
+ */
+int wad_set_find_in(const wad_set_t *set, wad_namespace_t ns, const char *name);
+
+/**
+ * Get a namespace's lumps as set lump numbers
+ * count receives the number of entries
+ */
+const uint16_t* wad_set_namespace(const wad_set_t *set, wad_namespace_t ns, uint32_t *count);
+
+/**
+ * Get a lump's directory entry by set lump number
+ */
+const wad_lump_t* wad_set_lump(const wad_set_t *set, int lump);
+
+/**
+ * Get a lump's data by set lump number
+ */
+const uint8_t* wad_set_lump_data(const wad_set_t *set, int lump);
+
+/**
+ * Get a lump's data by set lump number, cached with a purge tag
+ * (see wad_cache_lump)
+ */
+const uint8_t* wad_set_cache_lump(const wad_set_t *set, int lump, lump_cache_tag_t tag);
+
+/**
+ * Change a cached lump's purge tag by set lump number
+ * (see lump_cache_change_tag; no-op for lumps not in the cache)
+ */
+void wad_set_change_tag(const wad_set_t *set, int lump, lump_cache_tag_t tag);
+
+/**
+ * Start decompressing a lump by set lump number in the background
+ * (see wad_prefetch_lump)
+ */
+bool wad_set_prefetch_lump(const wad_set_t *set, int lump, lump_cache_tag_t tag);
+
+/**
+ * Check whether a lump is stored compressed (not usable in place)
+ */
+bool wad_set_lump_is_compressed(const wad_set_t *set, int lump);
+
+/**
+ * Print the access profile of every WAD with profiling enabled
+ * Lumps are listed hottest first (most lookups per KB), one per line as
+ * "NAME  # lookups bytes", which wadpack --hot/--profile reads back.
+ * max_lumps: longest list to print
+ */
+void wad_set_dump_profile(const wad_set_t *set, uint32_t max_lumps);
+
+/**
+ * Pin the hottest lumps into the lump_pin SRAM block
+ * list/len: a stored profile in the dump format (e.g. the LUMPPROF lump),
+ *           pinned in list order; NULL uses the live access profile
+ * Clears existing pins first. Returns the number of lumps pinned.
+ */
+uint32_t wad_set_pin_hot(wad_set_t *set, const char *list, uint32_t len);
+
+/**
+ * Free the set's index (the WADs themselves are not freed)
+ */
+void wad_set_free(wad_set_t *set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAD_SET_H
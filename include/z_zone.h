@@ -0,0 +1,127 @@
+/**
+ * Zone memory for PICO-DOOM
+ *
+ * All firmware allocations come from one statically reserved SRAM region
+ * (PICO_DOOM_ZONE_KB) instead of the newlib heap, so fragmentation and
+ * the high-water mark are visible and Doom's purge tags work:
+ *
+ *   PU_STATIC, PU_SOUND, PU_MUSIC   kept until freed
+ *   PU_LEVEL                        freed with the level
+ *   PU_LEVSPEC                      level specials (thinkers), freed with the level
+ *   PU_PURGELEVEL, PU_CACHE         purged by Z_Malloc when it needs room
+ *
+ * General blocks live in Doom's address-ordered block list with a rover.
+ * PU_LEVEL blocks come from a level arena that grows down from the top of
+ * the region: allocation is a bump (or reuse of a freed block of the same
+ * size), and Z_FreeTags over PU_LEVEL drops the whole arena at once.
+ *
+ * Core 0 only; not safe to call from both cores.
+ */
+
+#ifndef Z_ZONE_H
+#define Z_ZONE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SRAM the zone shares with the capture and telemetry buffers (USB
+// stream ring, band encoder); the rest holds .data/.bss and newlib's heap
+#define ZONE_SRAM_KB 216
+
+// SRAM those buffers take outside the zone in this build
+#if PICO_DOOM_CAPTURE
+#define ZONE_DEBUG_KB 19    // USB stream ring and band encoder
+#elif PICO_DOOM_TELEMETRY
+#define ZONE_DEBUG_KB 8     // USB stream ring (the stage rings are always in)
+#else
+#define ZONE_DEBUG_KB 0
+#endif
+
+// Zone size
+#ifndef PICO_DOOM_ZONE_KB
+#define PICO_DOOM_ZONE_KB (ZONE_SRAM_KB - ZONE_DEBUG_KB)
+#endif
+
+/**
+ * Purge tags (Chocolate Doom numbering)
+ * Tags from PU_PURGELEVEL up may be purged and need a user pointer.
+ */
+enum {
+    PU_STATIC = 1,
+    PU_SOUND,
+    PU_MUSIC,
+    PU_FREE,
+    PU_LEVEL,
+    PU_LEVSPEC,
+    PU_PURGELEVEL,
+    PU_CACHE,
+    PU_NUM_TAGS
+};
+
+/**
+ * Zone statistics
+ */
+typedef struct {
+    uint32_t total_bytes;
+    uint32_t used_bytes;              // Block headers included
+    uint32_t free_bytes;
+    uint32_t largest_free;            // Biggest single allocation that fits without purging
+    uint32_t peak_used;               // High-water mark
+    uint32_t free_blocks;             // Fragments in the block list
+    uint32_t level_bytes;             // Level arena size (freed blocks awaiting reuse included)
+    uint32_t purged_blocks;           // PU_PURGELEVEL/PU_CACHE blocks purged to make room
+    uint32_t failed_allocs;
+    uint32_t tag_bytes[PU_NUM_TAGS];  // Bytes allocated per tag
+    uint32_t tag_blocks[PU_NUM_TAGS];
+} zone_stats_t;
+
+/**
+ * Initialize the zone over its static region
+ * Call once, before anything allocates.
+ */
+void Z_Init(void);
+
+/**
+ * Allocate a block
+ * user: pointer to the caller's reference, cleared if the block is purged
+ *       (required for PU_PURGELEVEL and PU_CACHE)
+ * Returns NULL if there is no room even after purging
+ */
+void* Z_Malloc(uint32_t size, int tag, void **user);
+
+/**
+ * Free a block (clears its user pointer)
+ */
+void Z_Free(void *ptr);
+
+/**
+ * Free every block with a tag in [low_tag, high_tag]
+ * A range covering PU_LEVEL drops the whole level arena in O(1).
+ */
+void Z_FreeTags(int low_tag, int high_tag);
+
+/**
+ * Change a block's tag (e.g. make a cached lump purgable)
+ * Level arena blocks stay PU_LEVEL.
+ */
+void Z_ChangeTag(void *ptr, int tag);
+
+/**
+ * Get zone statistics (walks the block list)
+ */
+void zone_get_stats(zone_stats_t *stats);
+
+/**
+ * Short name of a tag, for stats output
+ */
+const char* zone_tag_name(int tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // Z_ZONE_H
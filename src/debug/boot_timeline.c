@@ -0,0 +1,80 @@
+/**
+ * Boot timeline recorder implementation
+ */
+
+#include "boot_timeline.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+
+typedef struct {
+    const char *name;
+    uint64_t start_us;
+    uint64_t end_us;          // 0 while the phase is running
+} boot_phase_t;
+
+static boot_phase_t phases[2][BOOT_TIMELINE_MAX_PHASES];
+static volatile uint32_t num_phases[2];
+
+int boot_phase_begin(const char *name) {
+    uint32_t core = get_core_num();
+    uint32_t n = num_phases[core];
+    if (n == BOOT_TIMELINE_MAX_PHASES) {
+        return -1;
+    }
+    phases[core][n].name = name;
+    phases[core][n].start_us = time_us_64();
+    phases[core][n].end_us = 0;
+    __dmb();  // Entry must be complete before the count covers it
+    num_phases[core] = n + 1;
+    return (int)(core * BOOT_TIMELINE_MAX_PHASES + n);
+}
+
+void boot_phase_end(int phase) {
+    if (phase < 0 || phase >= 2 * BOOT_TIMELINE_MAX_PHASES) {
+        return;
+    }
+    phases[phase / BOOT_TIMELINE_MAX_PHASES][phase % BOOT_TIMELINE_MAX_PHASES].end_us = time_us_64();
+}
+
+void boot_mark(const char *name) {
+    int phase = boot_phase_begin(name);
+    if (phase >= 0) {
+        boot_phase_t *p = &phases[phase / BOOT_TIMELINE_MAX_PHASES][phase % BOOT_TIMELINE_MAX_PHASES];
+        p->end_us = p->start_us;
+    }
+}
+
+void boot_timeline_dump(void) {
+    uint32_t count[2] = {num_phases[0], num_phases[1]};
+    uint32_t next[2] = {0, 0};
+    uint64_t last = 0;
+    
+    printf("--- boot timeline (ms since reset) ---\n");
+    printf("core   start     end   length  phase\n");
+    
+    // Merge the two per-core tables, which are each in start order
+    while (next[0] < count[0] || next[1] < count[1]) {
+        uint32_t core;
+        if (next[0] == count[0]) {
+            core = 1;
+        } else if (next[1] == count[1]) {
+            core = 0;
+        } else {
+            core = phases[1][next[1]].start_us < phases[0][next[0]].start_us ? 1 : 0;
+        }
+        const boot_phase_t *p = &phases[core][next[core]++];
+        
+        if (p->end_us == 0) {
+            printf("%4lu %7.1f   (running)        %s\n", core, p->start_us / 1000.0f, p->name);
+            continue;
+        }
+        printf("%4lu %7.1f %7.1f %8.1f  %s\n", core, p->start_us / 1000.0f, p->end_us / 1000.0f,
+               (p->end_us - p->start_us) / 1000.0f, p->name);
+        if (p->end_us > last) {
+            last = p->end_us;
+        }
+    }
+    printf("Boot: %.1f ms from reset to the last event\n", last / 1000.0f);
+    printf("--- end boot timeline ---\n");
+}
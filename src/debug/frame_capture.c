@@ -0,0 +1,255 @@
+/**
+ * Frame capture implementation
+ *
+ * Band encoding (XOR delta against the reference, or against zeros for a
+ * keyframe band), one token per run:
+ *   0x00-0x7F  literal: (t + 1) bytes follow
+ *   0x80-0xBF  repeat: next byte, (t & 0x3F) + 3 times
+ *   0xC0-0xFF  zero run: ((t & 0x3F) << 8 | next byte) + 1 zeros
+ */
+
+#include "frame_capture.h"
+#include "usb_stream.h"
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "z_zone.h"
+
+#define MAX_LITERAL    128
+#define MIN_REPEAT     3
+#define MAX_REPEAT     66
+#define MAX_ZERO_RUN   16384
+
+// Band payload header: frame (4), band (1), flags (1)
+#define BAND_HEADER_SIZE 6
+
+// Worst case: all literals
+#define BAND_MAX_ENCODED (FRAME_CAPTURE_BAND_SIZE + FRAME_CAPTURE_BAND_SIZE / MAX_LITERAL + 1)
+
+static bool capturing = false;
+static uint32_t capture_stride = 1;
+static uint32_t capture_remaining = 0;     // 0 = no limit
+static bool capture_limited = false;
+
+// Reference for delta bands: the last captured frame, still intact in its
+// framebuffer because core 0 cannot draw into it before the next present
+static const uint8_t *ref_data = NULL;
+static uint32_t ref_frame = 0;
+static uint32_t ref_synced = 0;            // Bands the host holds for ref_frame
+static uint8_t band_start = 0;             // Rotates so no band starves
+
+// A band queued here can still be lost or corrupted on its way to the
+// host, which then drops every later delta of that band. One band per
+// frame is sent as a keyframe regardless, in rotation, so the host gets
+// every band back within FRAME_CAPTURE_NUM_BANDS frames.
+static uint8_t key_band = 0;
+
+// Palette the host holds
+static const pixel_t *sent_palette = NULL;
+static uint16_t palette_id = 0;
+
+static uint8_t encode_buffer[BAND_HEADER_SIZE + BAND_MAX_ENCODED];
+static frame_capture_stats_t stats;
+
+#if PICO_DOOM_CAPTURE
+_Static_assert(USB_STREAM_RING_SIZE + sizeof(encode_buffer) <= ZONE_DEBUG_KB * 1024,
+               "ZONE_DEBUG_KB does not cover the USB stream ring and band encoder");
+#endif
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v) {
+    put_u16(p, v & 0xFFFF);
+    put_u16(p + 2, v >> 16);
+}
+
+/**
+ * Run-length encode cur ^ ref (ref may be NULL)
+ * Returns the encoded size
+ */
+static uint32_t encode_band(uint8_t *out, const uint8_t *cur, const uint8_t *ref, uint32_t len) {
+    uint8_t *start = out;
+    uint8_t *literal = NULL;   // Token of the open literal run
+    uint32_t i = 0;
+    
+    #define DELTA(k) (uint8_t)(cur[k] ^ (ref ? ref[k] : 0))
+    
+    while (i < len) {
+        uint8_t d = DELTA(i);
+        uint32_t run = 1;
+        while (i + run < len && DELTA(i + run) == d &&
+               run < (d == 0 ? MAX_ZERO_RUN : MAX_REPEAT)) {
+            run++;
+        }
+        
+        if (d == 0 && run >= MIN_REPEAT) {
+            *out++ = 0xC0 | ((run - 1) >> 8);
+            *out++ = (run - 1) & 0xFF;
+            literal = NULL;
+            i += run;
+        } else if (run >= MIN_REPEAT) {
+            *out++ = 0x80 | (run - MIN_REPEAT);
+            *out++ = d;
+            literal = NULL;
+            i += run;
+        } else {
+            if (!literal || *literal == MAX_LITERAL - 1) {
+                literal = out++;
+                *literal = 0xFF;  // Becomes 0 on the increment below
+            }
+            (*literal)++;
+            *out++ = d;
+            i++;
+        }
+    }
+    
+    #undef DELTA
+    return out - start;
+}
+
+/**
+ * Convert a transport-format palette entry back to RGB888
+ */
+static void palette_entry_rgb(pixel_t entry, uint8_t *rgb) {
+    if (display_get_color_mode() == DISPLAY_COLOR_RGB444) {
+        rgb[0] = ((entry >> 8) & 0x0F) * 17;
+        rgb[1] = ((entry >> 4) & 0x0F) * 17;
+        rgb[2] = (entry & 0x0F) * 17;
+    } else {
+        uint16_t v = __builtin_bswap16(entry);
+        rgb[0] = ((v >> 11) & 0x1F) << 3;
+        rgb[1] = ((v >> 5) & 0x3F) << 2;
+        rgb[2] = (v & 0x1F) << 3;
+    }
+}
+
+/**
+ * Send the frame's palette if the host does not have it yet
+ */
+static bool send_palette(const pixel_t *palette) {
+    if (palette == sent_palette) {
+        return true;
+    }
+    if (!usb_stream_begin(USB_PACKET_PALETTE, 2 + 768)) {
+        return false;
+    }
+    
+    uint8_t id[2];
+    put_u16(id, palette_id + 1);
+    usb_stream_write(id, 2);
+    for (int i = 0; i < 256; i++) {
+        uint8_t rgb[3];
+        palette_entry_rgb(palette[i], rgb);
+        usb_stream_write(rgb, 3);
+    }
+    usb_stream_end();
+    
+    palette_id++;
+    sent_palette = palette;
+    return true;
+}
+
+void frame_capture_start(uint32_t stride, uint32_t count) {
+    capturing = true;
+    capture_stride = stride ? stride : 1;
+    capture_remaining = count;
+    capture_limited = (count != 0);
+    ref_data = NULL;
+    ref_synced = 0;
+    sent_palette = NULL;
+    memset(&stats, 0, sizeof(stats));
+    printf("Frame capture started (every %lu frame(s))\n", capture_stride);
+}
+
+void frame_capture_stop(void) {
+    capturing = false;
+    ref_data = NULL;
+}
+
+void frame_capture_submit(const framebuffer_t *fb, uint32_t frame) {
+    if (!capturing || !fb || (frame % capture_stride) != 0) {
+        return;
+    }
+    
+    // The palette and frame header must both make it, or skip the frame
+    if (!send_palette(fb->palette)) {
+        return;
+    }
+    
+    uint8_t begin[22];
+    put_u32(&begin[0], frame);
+    put_u32(&begin[4], (uint32_t)time_us_64());
+    put_u32(&begin[8], (uint32_t)(time_us_64() >> 32));
+    put_u16(&begin[12], fb->width);
+    put_u16(&begin[14], fb->height);
+    begin[16] = fb->layout;
+    begin[17] = FRAME_CAPTURE_NUM_BANDS;
+    put_u16(&begin[18], FRAME_CAPTURE_BAND_SIZE);
+    put_u16(&begin[20], palette_id);
+    if (!usb_stream_send(USB_PACKET_FRAME_BEGIN, begin, sizeof(begin))) {
+        return;
+    }
+    
+    stats.frames++;
+    
+    // Delta only against the immediately preceding frame
+    bool have_ref = (ref_data != NULL && ref_frame + 1 == frame);
+    uint32_t synced = 0;
+    uint8_t sent = 0;
+    
+    for (int n = 0; n < FRAME_CAPTURE_NUM_BANDS; n++) {
+        int band = (band_start + n) % FRAME_CAPTURE_NUM_BANDS;
+        uint32_t offset = band * FRAME_CAPTURE_BAND_SIZE;
+        bool delta = have_ref && (ref_synced & (1u << band)) && band != key_band;
+        
+        // Not even an all-zero delta would fit
+        if (usb_stream_space() < BAND_HEADER_SIZE + 2) {
+            stats.bands_dropped++;
+            continue;
+        }
+        
+        put_u32(&encode_buffer[0], frame);
+        encode_buffer[4] = band;
+        encode_buffer[5] = delta ? 0 : FRAME_CAPTURE_BAND_KEY;
+        uint32_t len = encode_band(&encode_buffer[BAND_HEADER_SIZE], &fb->data[offset],
+                                   delta ? &ref_data[offset] : NULL, FRAME_CAPTURE_BAND_SIZE);
+        
+        if (!usb_stream_send(USB_PACKET_FRAME_BAND, encode_buffer, BAND_HEADER_SIZE + len)) {
+            stats.bands_dropped++;
+            continue;
+        }
+        synced |= 1u << band;
+        sent++;
+        stats.bytes += BAND_HEADER_SIZE + len;
+        stats.raw_bytes += FRAME_CAPTURE_BAND_SIZE;
+    }
+    
+    uint8_t end[5];
+    put_u32(&end[0], frame);
+    end[4] = sent;
+    usb_stream_send(USB_PACKET_FRAME_END, end, sizeof(end));
+    
+    if (sent == FRAME_CAPTURE_NUM_BANDS) {
+        stats.complete++;
+    }
+    band_start = (band_start + sent) % FRAME_CAPTURE_NUM_BANDS;
+    key_band = (key_band + 1) % FRAME_CAPTURE_NUM_BANDS;
+    
+    ref_data = fb->data;
+    ref_frame = frame;
+    ref_synced = synced;
+    
+    if (capture_limited && --capture_remaining == 0) {
+        frame_capture_stop();
+        printf("Frame capture finished\n");
+    }
+}
+
+void frame_capture_get_stats(frame_capture_stats_t *out) {
+    if (out) {
+        *out = stats;
+    }
+}
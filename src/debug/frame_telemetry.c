@@ -0,0 +1,111 @@
+/**
+ * Frame timing telemetry implementation
+ */
+
+#include "frame_telemetry.h"
+#include "usb_stream.h"
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+#include "hardware/sync.h"
+
+#define TELEMETRY_HEADER_SIZE   8       // Dropped count per core
+
+// Records go into the stream as they are laid out in the ring
+_Static_assert(sizeof(frame_telemetry_record_t) == FRAME_TELEMETRY_RECORD_SIZE,
+               "telemetry record must match its stream layout");
+
+/**
+ * Single-producer ring: the owning core writes head, core 0 writes tail
+ */
+typedef struct {
+    frame_telemetry_record_t records[FRAME_TELEMETRY_RING_SIZE];
+    volatile uint32_t head;   // Next record to write
+    volatile uint32_t tail;   // Next record to send
+    volatile uint32_t dropped;
+} telemetry_ring_t;
+
+static telemetry_ring_t rings[2];
+static volatile bool active = false;
+
+void frame_telemetry_start(void) {
+    active = true;
+}
+
+uint64_t __not_in_flash_func(frame_telemetry_end)(frame_telemetry_stage_t stage, uint32_t frame, uint64_t start_us) {
+    uint64_t now = time_us_64();
+    if (!active) {
+        return now;
+    }
+    
+    // Core 1 records from its scanout IRQ as well as its loop, so a record
+    // must not be interrupted halfway
+    uint32_t core = get_core_num();
+    telemetry_ring_t *ring = &rings[core];
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t head = ring->head;
+    if (head - ring->tail == FRAME_TELEMETRY_RING_SIZE) {
+        ring->dropped++;
+    } else {
+        frame_telemetry_record_t *rec = &ring->records[head & (FRAME_TELEMETRY_RING_SIZE - 1)];
+        rec->start_us = (uint32_t)start_us;
+        rec->length_us = (uint32_t)(now - start_us);
+        rec->frame = (uint16_t)frame;
+        rec->stage = (uint8_t)stage;
+        rec->core = (uint8_t)core;
+        __dmb();  // Record must be complete before the head covers it
+        ring->head = head + 1;
+    }
+    restore_interrupts(irq);
+    return now;
+}
+
+void frame_telemetry_flush(void) {
+    if (!active) {
+        return;
+    }
+    
+    uint32_t pending[2];
+    uint32_t total = 0;
+    for (int core = 0; core < 2; core++) {
+        pending[core] = rings[core].head - rings[core].tail;
+        total += pending[core];
+    }
+    if (total == 0) {
+        return;
+    }
+    
+    // As many whole records as one packet and the queue can take
+    uint32_t space = usb_stream_space();
+    if (space > USB_STREAM_MAX_PAYLOAD) {
+        space = USB_STREAM_MAX_PAYLOAD;
+    }
+    if (space < TELEMETRY_HEADER_SIZE + FRAME_TELEMETRY_RECORD_SIZE) {
+        return;
+    }
+    uint32_t max_records = (space - TELEMETRY_HEADER_SIZE) / FRAME_TELEMETRY_RECORD_SIZE;
+    if (total > max_records) {
+        total = max_records;
+    }
+    
+    __dmb();  // Records up to the heads read above are complete
+    usb_stream_begin(USB_PACKET_TELEMETRY, TELEMETRY_HEADER_SIZE + total * FRAME_TELEMETRY_RECORD_SIZE);
+    uint32_t dropped[2] = {rings[0].dropped, rings[1].dropped};
+    usb_stream_write(dropped, sizeof(dropped));
+    for (int core = 0; core < 2 && total > 0; core++) {
+        telemetry_ring_t *ring = &rings[core];
+        uint32_t count = pending[core] < total ? pending[core] : total;
+        uint32_t tail = ring->tail;
+        for (uint32_t i = 0; i < count; i++) {
+            usb_stream_write(&ring->records[(tail + i) & (FRAME_TELEMETRY_RING_SIZE - 1)],
+                             FRAME_TELEMETRY_RECORD_SIZE);
+        }
+        __dmb();  // Done reading before the slots are handed back
+        ring->tail = tail + count;
+        total -= count;
+    }
+    usb_stream_end();
+}
+
+uint32_t frame_telemetry_dropped(uint32_t core) {
+    return core < 2 ? rings[core].dropped : 0;
+}
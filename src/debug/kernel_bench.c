@@ -0,0 +1,214 @@
+/**
+ * Rendering kernel benchmark implementation
+ */
+
+#include "kernel_bench.h"
+#include "display_adapter.h"
+#include "r_local.h"
+#include "z_zone.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+#ifndef PICO_DOOM_INTERP
+#define PICO_DOOM_INTERP 0
+#endif
+
+#define BENCH_TEX_COLUMNS   16
+#define BENCH_TEX_HEIGHT    128     // Power of two, like most wall textures
+#define BENCH_FLAT_SIZE     (64 * 64)
+
+/**
+ * Framebuffer a kernel draws into
+ */
+typedef struct {
+    uint8_t *data;
+    int xs, ys;
+    int width, height;
+} bench_target_t;
+
+typedef struct {
+    const char *name;
+    uint32_t (*run)(const bench_target_t *t);   // One pass; returns bytes written
+} bench_kernel_t;
+
+typedef struct {
+    uint32_t us;
+    uint64_t pixels;
+    uint64_t bytes;
+} bench_result_t;
+
+// Synthetic source data in SRAM, one zone block
+typedef struct {
+    uint8_t texture[BENCH_TEX_COLUMNS][BENCH_TEX_HEIGHT];
+    uint8_t flat[BENCH_FLAT_SIZE];
+    uint8_t colormap[256];
+    uint8_t line[DISPLAY_WIDTH * 2];   // Scanline output, sized for the longer side
+} bench_data_t;
+
+static bench_data_t *bench = NULL;
+
+static uint32_t kernel_fill(const bench_target_t *t) {
+    for (int x = 0; x < t->width; x++) {
+        uint8_t *dest = &t->data[x * t->xs];
+        uint8_t color = (uint8_t)x;
+        for (int y = 0; y < t->height; y++) {
+            *dest = color;
+            dest += t->ys;
+        }
+    }
+    return t->width * t->height;
+}
+
+static uint32_t kernel_column(const bench_target_t *t) {
+    // Texel steps between 0.5 and 1.5 per pixel, as walls at varying range
+    for (int x = 0; x < t->width; x++) {
+        fixed_t step = FRACUNIT / 2 + (x & 63) * (FRACUNIT / 64);
+        r_draw_column(&t->data[x * t->xs], t->ys, t->height, bench->texture[x % BENCH_TEX_COLUMNS],
+                      BENCH_TEX_HEIGHT, x << 12, step, bench->colormap);
+    }
+    return t->width * t->height;
+}
+
+static uint32_t kernel_span(const bench_target_t *t) {
+    // Doom's R_DrawSpan inner loop along each row
+    const uint8_t *flat = bench->flat;
+    const uint8_t *colormap = bench->colormap;
+    for (int y = 0; y < t->height; y++) {
+        uint8_t *dest = &t->data[y * t->ys];
+        fixed_t xfrac = y << 14;
+        fixed_t yfrac = y << 16;
+        fixed_t xstep = FRACUNIT / 2 + (y & 31) * (FRACUNIT / 32);
+        fixed_t ystep = (y & 15) * (FRACUNIT / 64);
+        for (int x = 0; x < t->width; x++) {
+            int spot = ((yfrac >> (FRACBITS - 6)) & (63 * 64)) + ((xfrac >> FRACBITS) & 63);
+            *dest = colormap[flat[spot]];
+            dest += t->xs;
+            xfrac += xstep;
+            yfrac += ystep;
+        }
+    }
+    return t->width * t->height;
+}
+
+static uint32_t kernel_masked(const bench_target_t *t) {
+    // The whole texture over the column; a quarter of its texels are
+    // holes, so three quarters of the pixels are written
+    fixed_t step = (BENCH_TEX_HEIGHT << FRACBITS) / t->height;
+    for (int x = 0; x < t->width; x++) {
+        r_draw_masked_column(&t->data[x * t->xs], t->ys, t->height, bench->texture[x % BENCH_TEX_COLUMNS],
+                             BENCH_TEX_HEIGHT, 0, step, bench->colormap, true);
+    }
+    return t->width * t->height / 4 * 3;
+}
+
+/**
+ * Convert every scanline as scanout does: rows, or columns when the
+ * framebuffer is column-major (the contiguous direction either way)
+ */
+static uint32_t convert_lines(const bench_target_t *t, bool rgb444) {
+    bool rows = t->xs == 1;
+    int length = rows ? t->width : t->height;
+    int lines = rows ? t->height : t->width;
+    int stride = rows ? t->ys : t->xs;
+    uint32_t bytes = 0;
+    for (int i = 0; i < lines; i++) {
+        bytes += display_convert_line(bench->line, &t->data[i * stride], length, rgb444);
+    }
+    return bytes;
+}
+
+static uint32_t kernel_expand(const bench_target_t *t) {
+    return convert_lines(t, false);
+}
+
+static uint32_t kernel_pack(const bench_target_t *t) {
+    return convert_lines(t, true);
+}
+
+static const bench_kernel_t kernels[] = {
+    {"fill", kernel_fill},
+    {"column", kernel_column},
+    {"span", kernel_span},
+    {"masked", kernel_masked},
+    {"expand", kernel_expand},
+    {"pack", kernel_pack},
+};
+
+#define NUM_KERNELS ((int)(sizeof(kernels) / sizeof(kernels[0])))
+
+static bench_result_t results[NUM_KERNELS];
+static int next_kernel = 0;
+
+/**
+ * Build the synthetic texture, flat and colormap
+ */
+static bool bench_alloc(void) {
+    bench = (bench_data_t *)Z_Malloc(sizeof(bench_data_t), PU_STATIC, NULL);
+    if (!bench) {
+        printf("Error: Out of memory for the kernel benchmark (%u bytes)\n", (unsigned)sizeof(bench_data_t));
+        return false;
+    }
+    for (int x = 0; x < BENCH_TEX_COLUMNS; x++) {
+        for (int y = 0; y < BENCH_TEX_HEIGHT; y++) {
+            // Every fourth run of 8 texels is transparent for the masked kernel
+            bench->texture[x][y] = ((y >> 3) & 3) == 3 ? 0 : (uint8_t)(x * 16 + y + 1);
+        }
+    }
+    for (int i = 0; i < BENCH_FLAT_SIZE; i++) {
+        bench->flat[i] = (uint8_t)((i >> 6) ^ i);
+    }
+    for (int i = 0; i < 256; i++) {
+        bench->colormap[i] = (uint8_t)i;
+    }
+    return true;
+}
+
+static void print_report(const bench_target_t *t) {
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+    printf("--- kernel benchmark: %lu MHz, %dx%d %s, interp %s, %d passes ---\n",
+           mhz, t->width, t->height, t->xs == 1 ? "row-major" : "column-major",
+           PICO_DOOM_INTERP ? "on" : "off", KERNEL_BENCH_PASSES);
+    printf("kernel      pixels       us   cyc/px    MB/s\n");
+    for (int i = 0; i < NUM_KERNELS; i++) {
+        const bench_result_t *res = &results[i];
+        float cycles = (float)res->us * mhz / (float)res->pixels;
+        float mbps = res->us ? (float)res->bytes / res->us : 0.0f;
+        printf("%-8s %9llu %8lu %8.2f %7.1f\n", kernels[i].name, res->pixels, res->us, cycles, mbps);
+    }
+}
+
+const char* kernel_bench_step(uint8_t *data, int xs, int ys, int width, int height) {
+    if (!bench && !bench_alloc()) {
+        return NULL;
+    }
+    if (width * 2 > (int)sizeof(bench->line) || height * 2 > (int)sizeof(bench->line)) {
+        return NULL;
+    }
+    
+    bench_target_t target = {data, xs, ys, width, height};
+    const bench_kernel_t *kernel = &kernels[next_kernel];
+    bench_result_t *res = &results[next_kernel];
+    
+    res->bytes = 0;
+    uint64_t start = time_us_64();
+    for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+        res->bytes += kernel->run(&target);
+    }
+    res->us = (uint32_t)(time_us_64() - start);
+    res->pixels = (uint64_t)width * height * KERNEL_BENCH_PASSES;
+    
+    if (++next_kernel == NUM_KERNELS) {
+        print_report(&target);
+        next_kernel = 0;
+    }
+    return kernel->name;
+}
+
+void kernel_bench_stop(void) {
+    if (bench) {
+        Z_Free(bench);
+        bench = NULL;
+    }
+    next_kernel = 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * Binary packet stream implementation
+ * Packets are queued in a RAM ring and trickled out a few KB per main loop
+ * iteration, so a slow or absent host never stalls the game loop. Only
+ * whole packets are written, so printf output between polls always lands
+ * between packets, never inside one.
+ */
+
+#include "usb_stream.h"
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "z_zone.h"
+
+#if PICO_DOOM_CAPTURE || PICO_DOOM_TELEMETRY
+_Static_assert(USB_STREAM_RING_SIZE <= ZONE_DEBUG_KB * 1024,
+               "ZONE_DEBUG_KB does not cover the USB stream ring");
+#endif
+
+static uint8_t ring[USB_STREAM_RING_SIZE];
+static uint32_t ring_head = 0;      // Next byte to write
+static uint32_t ring_tail = 0;      // Next byte to send, always a packet start
+static uint32_t ring_done = 0;      // End of the last finished packet
+static uint32_t packet_sum = 0;     // Checksum of the packet being built
+static uint32_t dropped = 0;
+
+/**
+ * Append raw bytes to the ring (space already checked)
+ */
+static void ring_put(const uint8_t *data, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        ring[(ring_head + i) & (USB_STREAM_RING_SIZE - 1)] = data[i];
+    }
+    ring_head += len;
+}
+
+/**
+ * Size of the queued packet starting at pos, framing included
+ */
+static uint32_t ring_packet_size(uint32_t pos) {
+    uint32_t len = ring[(pos + 3) & (USB_STREAM_RING_SIZE - 1)] |
+                   (ring[(pos + 4) & (USB_STREAM_RING_SIZE - 1)] << 8);
+    return USB_STREAM_HEADER_SIZE + len + USB_STREAM_TRAILER_SIZE;
+}
+
+void usb_stream_init(void) {
+    ring_head = 0;
+    ring_tail = 0;
+    ring_done = 0;
+    dropped = 0;
+    
+    // Binary payloads must not have CR inserted before every 0x0A
+    stdio_set_translate_crlf(&stdio_usb, false);
+}
+
+uint32_t usb_stream_space(void) {
+    uint32_t used = ring_head - ring_tail;
+    uint32_t overhead = USB_STREAM_HEADER_SIZE + USB_STREAM_TRAILER_SIZE;
+    uint32_t free_bytes = USB_STREAM_RING_SIZE - used;
+    return free_bytes > overhead ? free_bytes - overhead : 0;
+}
+
+bool usb_stream_begin(uint8_t type, uint16_t len) {
+    if (len > USB_STREAM_MAX_PAYLOAD || len > usb_stream_space()) {
+        dropped++;
+        return false;
+    }
+    
+    uint8_t header[USB_STREAM_HEADER_SIZE] = {
+        USB_STREAM_SYNC0, USB_STREAM_SYNC1, type, len & 0xFF, len >> 8
+    };
+    ring_put(header, sizeof(header));
+    packet_sum = type + (len & 0xFF) + (len >> 8);
+    return true;
+}
+
+void usb_stream_write(const void *data, uint16_t len) {
+    const uint8_t *bytes = (const uint8_t*)data;
+    for (uint16_t i = 0; i < len; i++) {
+        packet_sum += bytes[i];
+    }
+    ring_put(bytes, len);
+}
+
+void usb_stream_end(void) {
+    uint8_t trailer[USB_STREAM_TRAILER_SIZE] = {packet_sum & 0xFF, (packet_sum >> 8) & 0xFF};
+    ring_put(trailer, sizeof(trailer));
+    ring_done = ring_head;
+}
+
+bool usb_stream_send(uint8_t type, const void *payload, uint16_t len) {
+    if (!usb_stream_begin(type, len)) {
+        return false;
+    }
+    usb_stream_write(payload, len);
+    usb_stream_end();
+    return true;
+}
+
+void usb_stream_poll(uint32_t max_bytes) {
+    if (!stdio_usb_connected()) {
+        // Nobody listening: discard rather than block
+        ring_tail = ring_done;
+        return;
+    }
+    
+    // Whole finished packets up to max_bytes; always at least one, so a
+    // packet larger than max_bytes still goes out
+    uint32_t pending = 0;
+    while (ring_tail + pending != ring_done) {
+        uint32_t size = ring_packet_size(ring_tail + pending);
+        if (pending > 0 && pending + size > max_bytes) {
+            break;
+        }
+        pending += size;
+    }
+    if (pending == 0) {
+        return;
+    }
+    
+    // At most two contiguous pieces (ring wrap)
+    while (pending > 0) {
+        uint32_t offset = ring_tail & (USB_STREAM_RING_SIZE - 1);
+        uint32_t chunk = USB_STREAM_RING_SIZE - offset;
+        if (chunk > pending) {
+            chunk = pending;
+        }
+        fwrite(&ring[offset], 1, chunk, stdout);
+        ring_tail += chunk;
+        pending -= chunk;
+    }
+    fflush(stdout);
+}
+
+uint32_t usb_stream_dropped(void) {
+    return dropped;
+}
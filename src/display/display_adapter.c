@@ -4,6 +4,11 @@
  */
 
 #include "display_adapter.h"
+#include "frame_pacer.h"
+#include "z_zone.h"
+#include "boot_timeline.h"
+#include "render_split.h"
+#include "frame_telemetry.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -13,6 +18,7 @@
 #include "hardware/spi.h"
 #include "hardware/gpio.h"
 #include "hardware/dma.h"
+#include "hardware/irq.h"
 
 // ST7789 Display pins (Pimoroni Pico Display 2.0)
 #define LCD_SPI       spi0
@@ -22,6 +28,7 @@
 #define LCD_CS        17
 #define LCD_RESET     21
 #define LCD_BL        20
+#define LCD_TE        -1  // Tearing-effect output; not wired on Pico Display 2.0
 
 // ST7789 Commands
 #define ST7789_SWRESET   0x01
@@ -33,23 +40,123 @@
 #define ST7789_CASET     0x2A
 #define ST7789_RASET     0x2B
 #define ST7789_RAMWR     0x2C
+#define ST7789_TEON      0x35
 #define ST7789_MADCTL    0x36
 #define ST7789_COLMOD    0x3A
 
-// Double buffering
-static framebuffer_t framebuffers[2];
-static volatile int current_fb = 0;
-static volatile int display_fb = 1;
-static mutex_t fb_mutex;
-static semaphore_t frame_ready;
+// MADCTL bits
+#define MADCTL_MV        0x20  // Row/column exchange
+
+// Frame handoff between the cores
+// Two single-producer/single-consumer rings of buffer indices: core 0
+// pushes finished frames onto present_queue, core 1 (from the scanout
+// IRQ) hands scanned-out buffers back on free_queue. Neither side ever
+// blocks the other; waiting is a __wfe() until the peer's __sev().
+#define FRAME_QUEUE_SIZE 4  // Power of two, > DISPLAY_MAX_BUFFERS
+
+typedef struct {
+    volatile uint8_t slots[FRAME_QUEUE_SIZE];
+    volatile uint32_t head;   // Written by the producer only
+    volatile uint32_t tail;   // Written by the consumer only
+} frame_queue_t;
+
+static framebuffer_t framebuffers[DISPLAY_MAX_BUFFERS];
+static int num_framebuffers = 2;
+static int render_fb = -1;            // Buffer core 0 draws into, -1 if none
+static uint32_t presented_frames = 0; // Frames queued for scanout (core 0)
+static frame_queue_t present_queue;   // Core 0 -> core 1
+static frame_queue_t free_queue;      // Core 1 -> core 0
+
+// Stall accounting (time each side spent waiting for the other)
+static uint32_t render_stall_us = 0;            // Core 0, last frame
+static volatile uint32_t scanout_idle_us = 0;   // Core 1, before last frame
+
+// Framebuffer memory layout; column-major also rotates the panel's
+// address order (MADCTL MV) so it takes the buffer as-is
+static display_layout_t fb_layout = DISPLAY_LAYOUT_ROW_MAJOR;
+
+// Frame pacing (pacer state is only touched by the core 1 loop)
+static frame_pacer_t pacer;
+static frame_pace_policy_t pace_policy = FRAME_PACE_ASAP;
+static volatile uint64_t te_last_edge = 0;
+static volatile uint32_t te_edge_count = 0;
+static frame_pace_stats_t pace_stats_snapshot;  // Published once a second
 
 // FPS tracking
 static volatile uint32_t frame_count = 0;
 static volatile uint64_t last_fps_time = 0;
 static volatile float current_fps = 0.0f;
 
-// Doom palette cache (RGB565 converted)
-static pixel_t palette_cache[256];
+// Palettes in transport format, used to expand scanlines:
+// byte-swapped RGB565, or right-aligned 12-bit RGB444.
+// Every frame carries a pointer to the 256-entry palette it was drawn
+// with, so a palette switch is a pointer swap on a frame boundary and
+// never changes colors halfway down the panel.
+// display_update_palette() writes a fresh slot once the current one has
+// been latched by a swap. Frames in flight reference at most
+// DISPLAY_MAX_BUFFERS distinct slots, so one more keeps them all intact.
+static pixel_t palette_custom[DISPLAY_MAX_BUFFERS + 1][256];
+static int palette_custom_slot = 0;
+static bool palette_custom_latched = false;     // Current slot is on a frame
+static pixel_t *palette_table = NULL;           // [gamma][palette][256]
+static int palette_table_count = 0;             // Palettes per gamma level
+static const pixel_t *pending_palette = NULL;   // Core 0: next frame's palette
+static const pixel_t *panel_palette = NULL;     // Core 1: palette on the panel
+
+// Transport color format on the SPI bus
+static display_color_mode_t color_mode = DISPLAY_COLOR_RGB565;
+static bool panel_deferred = false;             // Core 1 runs panel_start()
+
+// DMA scanout
+// Two data channels are chained to each other and paced by the SPI TX DREQ.
+// While one channel streams a chunk, the completion IRQ of the other reloads
+// it with the next chunk, so the SPI FIFO never runs dry and core 1 only
+// touches the transfer at chunk boundaries.
+#define SCANOUT_DMA_IRQ  DMA_IRQ_0
+
+// Bytes of CASET/RASET/RAMWR traffic per window
+#define WINDOW_CMD_BYTES 11
+
+// Screen-space rectangle (inclusive, Doom frame coordinates)
+typedef struct {
+    uint16_t x0, y0, x1, y1;
+} scanout_rect_t;
+
+static int scanout_dma_chan[2];
+static volatile bool scanout_active = false;
+static framebuffer_t *scanout_fb = NULL;
+static scanout_rect_t scanout_rects[DISPLAY_TILE_ROWS > DISPLAY_TILE_COLS ?
+                                    DISPLAY_TILE_ROWS : DISPLAY_TILE_COLS];
+static int scanout_num_rects = 0;
+static int scanout_rect = 0;           // Rectangle being sent
+static int scanout_num_chunks = 0;     // Chunks in the current rectangle
+static int scanout_next_chunk = 0;     // Next chunk to load into a channel
+static int scanout_chunks_done = 0;    // Chunks fully transferred
+static int scanout_irq_slot = 0;       // Slot expected to complete next
+
+// Ping-pong RGB565 line buffers; each DMA slot streams from its own line
+// while the IRQ expands the next scanline into the other
+static pixel_t scanout_line[2][DOOM_WIDTH > DOOM_HEIGHT ? DOOM_WIDTH : DOOM_HEIGHT]
+    __attribute__((aligned(4)));
+
+// What the panel currently shows, as one hash per tile
+static uint32_t panel_tile_hash[DISPLAY_TILE_ROWS][DISPLAY_TILE_COLS];
+static volatile bool panel_valid = false;
+
+// A changed tile whose hash collides with the old one would stay stale, so
+// one tile row per frame is sent regardless, in rotation: any such tile is
+// repaired within DISPLAY_TILE_ROWS frames, at the cost of one row each
+static int panel_refresh_row = 0;
+
+// Scanout timing (for measuring how much of core 1 the transfer costs)
+static uint64_t scanout_start_time = 0;
+static uint32_t scanout_busy_accum = 0;
+static volatile uint32_t scanout_last_us = 0;
+static volatile uint32_t scanout_last_busy_us = 0;
+static volatile uint32_t scanout_frames = 0;
+static uint32_t scanout_bytes_accum = 0;
+static volatile uint32_t scanout_last_bytes = 0;
+static volatile uint16_t scanout_last_rects = 0;
 
 /**
  * Write command to ST7789
@@ -80,8 +187,16 @@ static inline void lcd_write_byte(uint8_t data) {
 
 /**
  * Set drawing window on display
+ * Coordinates are screen x/y; in column-major mode MADCTL MV is set, so the
+ * column address (fast axis) runs down the screen and the two ranges swap.
  */
 static void lcd_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    if (fb_layout == DISPLAY_LAYOUT_COLUMN_MAJOR) {
+        uint16_t t;
+        t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+    }
+    
     lcd_write_cmd(ST7789_CASET);
     uint8_t caset[] = {x0 >> 8, x0 & 0xFF, x1 >> 8, x1 & 0xFF};
     lcd_write_data(caset, 4);
@@ -93,11 +208,41 @@ static void lcd_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
     lcd_write_cmd(ST7789_RAMWR);
 }
 
+/**
+ * Bytes on the wire for a run of pixels in the current transport format
+ */
+static inline uint32_t transport_bytes(uint32_t pixels) {
+    return (color_mode == DISPLAY_COLOR_RGB444) ? pixels * 3 / 2 : pixels * 2;
+}
+
+/**
+ * Clear a panel rectangle to black (blocking)
+ */
+static void lcd_clear_rect(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    static const uint8_t zeros[64] = {0};
+    
+    lcd_set_window(x0, y0, x1, y1);
+    gpio_put(LCD_CS, 0);
+    gpio_put(LCD_DC, 1);
+    
+    // Black is all-zero bytes in both transport formats
+    uint32_t remaining = transport_bytes((uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1));
+    while (remaining > 0) {
+        uint32_t n = remaining < sizeof(zeros) ? remaining : sizeof(zeros);
+        spi_write_blocking(LCD_SPI, zeros, n);
+        remaining -= n;
+    }
+    
+    gpio_put(LCD_CS, 1);
+}
+
 /**
  * Initialize ST7789 display
  */
 static void lcd_init(void) {
-    // Hardware reset
+    // Hardware reset. It leaves the panel in the same state as SWRESET,
+    // so no software reset (and its 150 ms wait) follows; SLPOUT may be
+    // sent 120 ms after the reset is released.
     gpio_put(LCD_RESET, 1);
     sleep_ms(5);
     gpio_put(LCD_RESET, 0);
@@ -105,25 +250,29 @@ static void lcd_init(void) {
     gpio_put(LCD_RESET, 1);
     sleep_ms(150);
     
-    // Software reset
-    lcd_write_cmd(ST7789_SWRESET);
-    sleep_ms(150);
-    
     // Exit sleep mode
     lcd_write_cmd(ST7789_SLPOUT);
     sleep_ms(10);
     
-    // Set color mode to 16-bit (RGB565)
+    // Set color mode: 16-bit RGB565, or 12-bit RGB444 (2 pixels in 3 bytes)
     lcd_write_cmd(ST7789_COLMOD);
-    lcd_write_byte(0x55);  // 16-bit color
+    lcd_write_byte(color_mode == DISPLAY_COLOR_RGB444 ? 0x53 : 0x55);
     
     // Memory access control (screen orientation)
+    // Column-major flips only MV: MX/MY stay put, so the origin is still
+    // top-left and pixels fill top to bottom, then left to right
     lcd_write_cmd(ST7789_MADCTL);
-    lcd_write_byte(0x00);  // Normal orientation
+    lcd_write_byte(fb_layout == DISPLAY_LAYOUT_COLUMN_MAJOR ? MADCTL_MV : 0x00);
     
     // Inversion on (looks better)
     lcd_write_cmd(ST7789_INVON);
     
+    // Tearing-effect output, V-blank only
+    if (LCD_TE >= 0) {
+        lcd_write_cmd(ST7789_TEON);
+        lcd_write_byte(0x00);
+    }
+    
     // Normal display mode
     lcd_write_cmd(ST7789_NORON);
     sleep_ms(10);
@@ -135,12 +284,90 @@ static void lcd_init(void) {
     printf("ST7789 display initialized\n");
 }
 
+/**
+ * Push a buffer index onto a frame queue
+ * Returns false if the queue is full
+ */
+static inline bool frame_queue_push(frame_queue_t *q, uint8_t index) {
+    uint32_t head = q->head;
+    if (head - q->tail == FRAME_QUEUE_SIZE) {
+        return false;
+    }
+    q->slots[head & (FRAME_QUEUE_SIZE - 1)] = index;
+    __dmb();  // Slot must be visible before the new head
+    q->head = head + 1;
+    __sev();  // Wake the consumer if it is in __wfe()
+    return true;
+}
+
+/**
+ * Pop a buffer index from a frame queue
+ * Returns false if the queue is empty
+ */
+static inline bool frame_queue_pop(frame_queue_t *q, uint8_t *index) {
+    uint32_t tail = q->tail;
+    if (q->head == tail) {
+        return false;
+    }
+    __dmb();  // Read the slot only after seeing the head
+    *index = q->slots[tail & (FRAME_QUEUE_SIZE - 1)];
+    __dmb();
+    q->tail = tail + 1;
+    return true;
+}
+
+/**
+ * Get default display configuration
+ */
+void display_default_config(display_config_t *config) {
+    config->num_buffers = 2;
+    config->pace_policy = FRAME_PACE_ASAP;
+    config->layout = DISPLAY_LAYOUT_ROW_MAJOR;
+    config->color_mode = DISPLAY_COLOR_RGB565;
+    config->defer_panel_init = false;
+}
+
+/**
+ * Reset and set up the panel, then clear the letterbox bars
+ */
+static void panel_start(void) {
+    int phase = boot_phase_begin("panel init");
+    lcd_init();
+    
+    // Letterbox bars never change; clear them once and only send the
+    // Doom area from now on
+    uint16_t y_offset = (DISPLAY_HEIGHT - DOOM_HEIGHT) / 2;
+    if (y_offset > 0) {
+        lcd_clear_rect(0, 0, DISPLAY_WIDTH - 1, y_offset - 1);
+        lcd_clear_rect(0, y_offset + DOOM_HEIGHT, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    }
+    display_invalidate();
+    boot_phase_end(phase);
+}
+
 /**
  * Initialize display system
  */
-void display_init(void) {
+void display_init(const display_config_t *config) {
     printf("Initializing display adapter...\n");
     
+    display_config_t defaults;
+    if (!config) {
+        display_default_config(&defaults);
+        config = &defaults;
+    }
+    num_framebuffers = config->num_buffers;
+    if (num_framebuffers < 2 || num_framebuffers > DISPLAY_MAX_BUFFERS) {
+        num_framebuffers = 2;
+    }
+    fb_layout = config->layout;
+    color_mode = config->color_mode;
+    pace_policy = config->pace_policy;
+    if (pace_policy == FRAME_PACE_TE && LCD_TE < 0) {
+        printf("WARNING: Panel has no TE line, pacing falls back to ASAP\n");
+        pace_policy = FRAME_PACE_ASAP;
+    }
+    
     // Initialize SPI
     spi_init(LCD_SPI, 62500000);  // 62.5 MHz (fast!)
     gpio_set_function(LCD_SPI_SCK, GPIO_FUNC_SPI);
@@ -161,11 +388,19 @@ void display_init(void) {
     gpio_put(LCD_BL, 1);  // Backlight on
     
     // Initialize framebuffers
-    for (int i = 0; i < 2; i++) {
+    for (int i = 0; i < num_framebuffers; i++) {
         framebuffers[i].width = DISPLAY_WIDTH;
         framebuffers[i].height = DOOM_HEIGHT;
-        framebuffers[i].data = (pixel_t*)malloc(DISPLAY_WIDTH * DOOM_HEIGHT * sizeof(pixel_t));
+        framebuffers[i].data = (uint8_t*)Z_Malloc(DISPLAY_WIDTH * DOOM_HEIGHT, PU_STATIC, NULL);
         framebuffers[i].ready = false;
+        framebuffers[i].layout = fb_layout;
+        if (fb_layout == DISPLAY_LAYOUT_COLUMN_MAJOR) {
+            framebuffers[i].x_step = DOOM_HEIGHT;
+            framebuffers[i].y_step = 1;
+        } else {
+            framebuffers[i].x_step = 1;
+            framebuffers[i].y_step = DISPLAY_WIDTH;
+        }
         
         if (!framebuffers[i].data) {
             printf("ERROR: Failed to allocate framebuffer %d\n", i);
@@ -173,53 +408,91 @@ void display_init(void) {
         }
         
         // Clear to black
-        memset(framebuffers[i].data, 0, DISPLAY_WIDTH * DOOM_HEIGHT * sizeof(pixel_t));
+        memset(framebuffers[i].data, 0, DISPLAY_WIDTH * DOOM_HEIGHT);
     }
     
-    // Initialize synchronization primitives
-    mutex_init(&fb_mutex);
-    sem_init(&frame_ready, 0, 1);
+    // Claim the scanout DMA channels (IRQ is routed from core 1)
+    for (int i = 0; i < 2; i++) {
+        scanout_dma_chan[i] = dma_claim_unused_channel(true);
+        dma_channel_set_irq0_enabled(scanout_dma_chan[i], true);
+    }
     
-    // Initialize LCD
-    lcd_init();
+    // Until a palette is loaded everything expands to black
+    pending_palette = palette_custom[0];
+    
+    // Core 0 starts out drawing into buffer 0; the rest are free
+    memset(&present_queue, 0, sizeof(present_queue));
+    presented_frames = 0;
+    memset(&free_queue, 0, sizeof(free_queue));
+    render_fb = 0;
+    for (int i = 1; i < num_framebuffers; i++) {
+        frame_queue_push(&free_queue, i);
+    }
+    
+    // Initialize LCD, unless core 1 will
+    panel_deferred = config->defer_panel_init;
+    if (!panel_deferred) {
+        panel_start();
+    }
+    
+    printf("Display adapter initialized: %d x %dx%d 8-bit framebuffers (%d KB)\n",
+           num_framebuffers, DISPLAY_WIDTH, DOOM_HEIGHT,
+           num_framebuffers * DISPLAY_WIDTH * DOOM_HEIGHT / 1024);
+}
+
+/**
+ * Wait for a free buffer to draw into
+ */
+static void acquire_render_buffer(void) {
+    uint8_t index;
+    uint64_t t0 = time_us_64();
     
-    printf("Display adapter initialized: %dx%d framebuffers\n", DISPLAY_WIDTH, DOOM_HEIGHT);
+    while (!frame_queue_pop(&free_queue, &index)) {
+        __wfe();
+    }
+    
+    render_stall_us = (uint32_t)(time_us_64() - t0);
+    render_fb = index;
 }
 
 /**
  * Get current drawing framebuffer
  */
 framebuffer_t* display_get_framebuffer(void) {
-    return &framebuffers[current_fb];
+    if (render_fb < 0) {
+        acquire_render_buffer();
+    }
+    return &framebuffers[render_fb];
 }
 
 /**
  * Swap framebuffers
+ * Queues the finished frame for core 1 and returns without waiting.
  */
 void display_swap_buffers(void) {
-    mutex_enter_blocking(&fb_mutex);
-    
-    // Swap buffers
-    int temp = current_fb;
-    current_fb = display_fb;
-    display_fb = temp;
-    
-    // Mark as ready for display
-    framebuffers[display_fb].ready = true;
-    
-    mutex_exit(&fb_mutex);
+    if (render_fb < 0) {
+        return;
+    }
     
-    // Signal frame ready
-    sem_release(&frame_ready);
+    framebuffers[render_fb].palette = pending_palette;
+    if (pending_palette == palette_custom[palette_custom_slot]) {
+        palette_custom_latched = true;
+    }
+    framebuffers[render_fb].sequence = presented_frames++;
+    framebuffers[render_fb].ready = true;
+    frame_queue_push(&present_queue, render_fb);
+    render_fb = -1;
 }
 
 /**
  * Wait for vsync
+ * Blocks until a buffer is free to draw the next frame into. With double
+ * buffering that is the end of the previous scanout; with triple buffering
+ * core 0 only stalls when it is two frames ahead of the panel.
  */
 void display_wait_vsync(void) {
-    // Wait for previous frame to be displayed
-    while (framebuffers[current_fb].ready) {
-        tight_loop_contents();
+    if (render_fb < 0) {
+        acquire_render_buffer();
     }
 }
 
@@ -238,23 +511,194 @@ pixel_t display_palette_to_rgb565(const uint8_t *doom_palette, uint8_t index) {
     return __builtin_bswap16(color565);
 }
 
+/**
+ * Convert Doom palette to 12-bit RGB444 (right-aligned, 0x0RGB)
+ */
+static uint16_t palette_to_rgb444(const uint8_t *doom_palette, uint8_t index) {
+    const uint8_t *rgb = &doom_palette[index * 3];
+    return ((rgb[0] & 0xF0) << 4) | (rgb[1] & 0xF0) | (rgb[2] >> 4);
+}
+
+/**
+ * Convert one palette into transport format
+ * gamma: 256-entry ramp applied to each channel, or NULL
+ */
+static void convert_palette(pixel_t *dst, const uint8_t *doom_palette, const uint8_t *gamma) {
+    uint8_t rgb[3];
+    
+    for (int i = 0; i < 256; i++) {
+        for (int c = 0; c < 3; c++) {
+            uint8_t v = doom_palette[i * 3 + c];
+            rgb[c] = gamma ? gamma[v] : v;
+        }
+        dst[i] = (color_mode == DISPLAY_COLOR_RGB444) ?
+            palette_to_rgb444(rgb, 0) :
+            display_palette_to_rgb565(rgb, 0);
+    }
+}
+
 /**
  * Update palette cache
+ * Takes effect from the next presented frame. A frame still queued for
+ * scanout keeps its colors: its slot is never rewritten while in flight.
  */
 void display_update_palette(const uint8_t *doom_palette) {
-    for (int i = 0; i < 256; i++) {
-        palette_cache[i] = display_palette_to_rgb565(doom_palette, i);
+    if (palette_custom_latched) {
+        palette_custom_slot = (palette_custom_slot + 1) % (DISPLAY_MAX_BUFFERS + 1);
+        palette_custom_latched = false;
+    }
+    convert_palette(palette_custom[palette_custom_slot], doom_palette, NULL);
+    pending_palette = palette_custom[palette_custom_slot];
+}
+
+/**
+ * Gamma ramps, one per usegamma level, generated as
+ * min(255, round(255 * ((i + 1) / 255) ^ (1 - level / 8)))
+ * This approximates the ramps of Doom's gammatable (v_video.c) but is not
+ * a copy of it: level 0 is almost linear, each step up brightens the darks.
+ */
+static const uint8_t gamma_table[DISPLAY_NUM_GAMMA][256] = {
+    {
+          1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,  16,
+         17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,
+         33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
+         49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,
+         65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  80,
+         81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,  94,  95,  96,
+         97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112,
+        113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128,
+        129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144,
+        145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160,
+        161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176,
+        177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192,
+        193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208,
+        209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224,
+        225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240,
+        241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255, 255
+    },
+    {
+          2,   4,   5,   7,   8,  10,  11,  12,  14,  15,  16,  18,  19,  20,  21,  23,
+         24,  25,  26,  27,  29,  30,  31,  32,  33,  35,  36,  37,  38,  39,  40,  41,
+         43,  44,  45,  46,  47,  48,  49,  50,  52,  53,  54,  55,  56,  57,  58,  59,
+         60,  61,  62,  63,  64,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,
+         77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,
+         93,  94,  96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 105, 106, 107, 108,
+        109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124,
+        125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140,
+        140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155,
+        156, 157, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170,
+        171, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 183, 184,
+        185, 186, 187, 188, 189, 190, 191, 192, 193, 193, 194, 195, 196, 197, 198, 199,
+        200, 201, 202, 203, 203, 204, 205, 206, 207, 208, 209, 210, 211, 212, 212, 213,
+        214, 215, 216, 217, 218, 219, 220, 221, 221, 222, 223, 224, 225, 226, 227, 228,
+        229, 229, 230, 231, 232, 233, 234, 235, 236, 237, 237, 238, 239, 240, 241, 242,
+        243, 244, 244, 245, 246, 247, 248, 249, 250, 251, 251, 252, 253, 254, 255, 255
+    },
+    {
+          4,   7,   9,  11,  13,  15,  17,  19,  21,  22,  24,  26,  27,  29,  30,  32,
+         33,  35,  36,  38,  39,  41,  42,  43,  45,  46,  47,  49,  50,  51,  52,  54,
+         55,  56,  58,  59,  60,  61,  62,  64,  65,  66,  67,  68,  69,  71,  72,  73,
+         74,  75,  76,  77,  78,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,
+         91,  93,  94,  95,  96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107,
+        108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123,
+        124, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138,
+        138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 148, 149, 150, 151, 152,
+        153, 154, 155, 156, 157, 157, 158, 159, 160, 161, 162, 163, 164, 164, 165, 166,
+        167, 168, 169, 170, 170, 171, 172, 173, 174, 175, 176, 176, 177, 178, 179, 180,
+        181, 181, 182, 183, 184, 185, 186, 186, 187, 188, 189, 190, 191, 191, 192, 193,
+        194, 195, 196, 196, 197, 198, 199, 200, 200, 201, 202, 203, 204, 205, 205, 206,
+        207, 208, 209, 209, 210, 211, 212, 213, 213, 214, 215, 216, 216, 217, 218, 219,
+        220, 220, 221, 222, 223, 224, 224, 225, 226, 227, 227, 228, 229, 230, 231, 231,
+        232, 233, 234, 234, 235, 236, 237, 238, 238, 239, 240, 241, 241, 242, 243, 244,
+        244, 245, 246, 247, 247, 248, 249, 250, 250, 251, 252, 253, 253, 254, 255, 255
+    },
+    {
+          8,  12,  16,  19,  22,  24,  27,  29,  32,  34,  36,  38,  40,  42,  43,  45,
+         47,  49,  50,  52,  54,  55,  57,  58,  60,  61,  63,  64,  66,  67,  68,  70,
+         71,  72,  74,  75,  76,  78,  79,  80,  81,  83,  84,  85,  86,  87,  89,  90,
+         91,  92,  93,  94,  96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107,
+        109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124,
+        125, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 138,
+        139, 140, 141, 142, 143, 144, 145, 146, 146, 147, 148, 149, 150, 151, 152, 152,
+        153, 154, 155, 156, 157, 158, 158, 159, 160, 161, 162, 162, 163, 164, 165, 166,
+        167, 167, 168, 169, 170, 171, 171, 172, 173, 174, 175, 175, 176, 177, 178, 178,
+        179, 180, 181, 181, 182, 183, 184, 185, 185, 186, 187, 188, 188, 189, 190, 191,
+        191, 192, 193, 194, 194, 195, 196, 196, 197, 198, 199, 199, 200, 201, 202, 202,
+        203, 204, 204, 205, 206, 207, 207, 208, 209, 209, 210, 211, 211, 212, 213, 214,
+        214, 215, 216, 216, 217, 218, 218, 219, 220, 220, 221, 222, 222, 223, 224, 225,
+        225, 226, 227, 227, 228, 229, 229, 230, 231, 231, 232, 233, 233, 234, 235, 235,
+        236, 236, 237, 238, 238, 239, 240, 240, 241, 242, 242, 243, 244, 244, 245, 246,
+        246, 247, 247, 248, 249, 249, 250, 251, 251, 252, 252, 253, 254, 254, 255, 255
+    },
+    {
+         16,  23,  28,  32,  36,  39,  42,  45,  48,  50,  53,  55,  58,  60,  62,  64,
+         66,  68,  70,  71,  73,  75,  77,  78,  80,  81,  83,  84,  86,  87,  89,  90,
+         92,  93,  94,  96,  97,  98, 100, 101, 102, 103, 105, 106, 107, 108, 109, 111,
+        112, 113, 114, 115, 116, 117, 118, 119, 121, 122, 123, 124, 125, 126, 127, 128,
+        129, 130, 131, 132, 133, 134, 135, 135, 136, 137, 138, 139, 140, 141, 142, 143,
+        144, 145, 145, 146, 147, 148, 149, 150, 151, 151, 152, 153, 154, 155, 156, 156,
+        157, 158, 159, 160, 160, 161, 162, 163, 164, 164, 165, 166, 167, 167, 168, 169,
+        170, 170, 171, 172, 173, 173, 174, 175, 176, 176, 177, 178, 179, 179, 180, 181,
+        181, 182, 183, 183, 184, 185, 186, 186, 187, 188, 188, 189, 190, 190, 191, 192,
+        192, 193, 194, 194, 195, 196, 196, 197, 198, 198, 199, 199, 200, 201, 201, 202,
+        203, 203, 204, 204, 205, 206, 206, 207, 208, 208, 209, 209, 210, 211, 211, 212,
+        212, 213, 214, 214, 215, 215, 216, 217, 217, 218, 218, 219, 220, 220, 221, 221,
+        222, 222, 223, 224, 224, 225, 225, 226, 226, 227, 228, 228, 229, 229, 230, 230,
+        231, 231, 232, 233, 233, 234, 234, 235, 235, 236, 236, 237, 237, 238, 238, 239,
+        240, 240, 241, 241, 242, 242, 243, 243, 244, 244, 245, 245, 246, 246, 247, 247,
+        248, 248, 249, 249, 250, 250, 251, 251, 252, 252, 253, 253, 254, 254, 255, 255
+    },
+};
+
+/**
+ * Expand a set of palettes (e.g. PLAYPAL) at every gamma level
+ */
+bool display_load_palettes(const uint8_t *palettes, int num_palettes) {
+    if (!palettes || num_palettes <= 0 || num_palettes > DISPLAY_NUM_PALETTES) {
+        return false;
+    }
+    
+    if (!palette_table) {
+        palette_table = (pixel_t*)Z_Malloc(DISPLAY_NUM_GAMMA * DISPLAY_NUM_PALETTES * 256 * sizeof(pixel_t), PU_STATIC, NULL);
+        if (!palette_table) {
+            printf("ERROR: Failed to allocate palette table\n");
+            return false;
+        }
+    }
+    
+    for (int g = 0; g < DISPLAY_NUM_GAMMA; g++) {
+        for (int p = 0; p < num_palettes; p++) {
+            convert_palette(&palette_table[(g * DISPLAY_NUM_PALETTES + p) * 256],
+                            &palettes[p * 768], gamma_table[g]);
+        }
+    }
+    
+    palette_table_count = num_palettes;
+    display_set_palette(0, 0);
+    
+    printf("Palettes expanded: %d x %d gamma levels (%d bytes)\n",
+           num_palettes, DISPLAY_NUM_GAMMA,
+           DISPLAY_NUM_GAMMA * DISPLAY_NUM_PALETTES * 256 * (int)sizeof(pixel_t));
+    return true;
+}
+
+/**
+ * Select palette and gamma for the next presented frame
+ */
+void display_set_palette(int palette, int gamma) {
+    if (!palette_table || palette < 0 || palette >= palette_table_count ||
+        gamma < 0 || gamma >= DISPLAY_NUM_GAMMA) {
+        return;
     }
+    pending_palette = &palette_table[(gamma * DISPLAY_NUM_PALETTES + palette) * 256];
 }
 
 /**
  * Clear screen
  */
-void display_clear(pixel_t color) {
+void display_clear(uint8_t color) {
     framebuffer_t *fb = display_get_framebuffer();
-    for (int i = 0; i < fb->width * fb->height; i++) {
-        fb->data[i] = color;
-    }
+    memset(fb->data, color, fb->width * fb->height);
 }
 
 /**
@@ -273,66 +717,467 @@ float display_get_fps(void) {
 }
 
 /**
- * Core 1 display loop - continuously updates display
+ * Get the panel transport format
  */
-void display_core1_loop(void) {
-    printf("Core 1: Display update loop started\n");
+display_color_mode_t display_get_color_mode(void) {
+    return color_mode;
+}
+
+/**
+ * Hash one tile of a framebuffer
+ */
+static uint32_t tile_hash(const framebuffer_t *fb, int tx, int ty) {
+    uint32_t h = 2166136261u;
     
-    uint64_t last_time = time_us_64();
-    uint32_t local_frame_count = 0;
+    if (fb->layout == DISPLAY_LAYOUT_COLUMN_MAJOR) {
+        for (int x = tx * DISPLAY_TILE_W; x < (tx + 1) * DISPLAY_TILE_W; x++) {
+            const uint32_t *p = (const uint32_t*)&fb->data[x * fb->x_step + ty * DISPLAY_TILE_H];
+            for (int i = 0; i < DISPLAY_TILE_H / 4; i++) {
+                h = (h ^ p[i]) * 16777619u;
+            }
+        }
+    } else {
+        for (int y = ty * DISPLAY_TILE_H; y < (ty + 1) * DISPLAY_TILE_H; y++) {
+            const uint32_t *p = (const uint32_t*)&fb->data[y * fb->y_step + tx * DISPLAY_TILE_W];
+            for (int i = 0; i < DISPLAY_TILE_W / 4; i++) {
+                h = (h ^ p[i]) * 16777619u;
+            }
+        }
+    }
+    return h;
+}
+
+/**
+ * Work out which tiles differ from what the panel shows
+ * Hashing only reads the new frame, so core 0 is free to keep drawing
+ * into the previously presented buffer while this runs.
+ */
+static void scanout_update_dirty(framebuffer_t *fb) {
+    bool full = !panel_valid;
+    int refresh_row = panel_refresh_row;
+    panel_refresh_row = (refresh_row + 1) % DISPLAY_TILE_ROWS;
     
-    while (true) {
-        // Wait for frame to be ready
-        sem_acquire_blocking(&frame_ready);
+    for (int ty = 0; ty < DISPLAY_TILE_ROWS; ty++) {
+        bool force = full || ty == refresh_row;
+        uint16_t mask = 0;
+        for (int tx = 0; tx < DISPLAY_TILE_COLS; tx++) {
+            uint32_t h = tile_hash(fb, tx, ty);
+            if (force || h != panel_tile_hash[ty][tx]) {
+                panel_tile_hash[ty][tx] = h;
+                mask |= 1u << tx;
+            }
+        }
+        fb->dirty[ty] = mask;
+    }
+    
+    panel_valid = true;
+}
+
+/**
+ * Turn the dirty tile mask into window rectangles (column-major)
+ * Same as the row-major case with the axes swapped, so each scanline the
+ * DMA sends is a long contiguous column rather than a short row slice.
+ */
+static void scanout_build_column_rects(const framebuffer_t *fb) {
+    scanout_num_rects = 0;
+    
+    for (int tx = 0; tx < DISPLAY_TILE_COLS; tx++) {
+        uint32_t mask = 0;
+        for (int ty = 0; ty < DISPLAY_TILE_ROWS; ty++) {
+            if (fb->dirty[ty] & (1u << tx)) {
+                mask |= 1u << ty;
+            }
+        }
+        if (!mask) {
+            continue;
+        }
         
-        mutex_enter_blocking(&fb_mutex);
+        uint16_t y0 = __builtin_ctz(mask) * DISPLAY_TILE_H;
+        uint16_t y1 = (32 - __builtin_clz(mask)) * DISPLAY_TILE_H - 1;
+        uint16_t x0 = tx * DISPLAY_TILE_W;
+        uint16_t x1 = x0 + DISPLAY_TILE_W - 1;
         
-        if (framebuffers[display_fb].ready) {
-            framebuffer_t *fb = &framebuffers[display_fb];
-            
-            // Set display window (Doom is 320x200, center on 320x240 display)
-            uint16_t y_offset = (DISPLAY_HEIGHT - DOOM_HEIGHT) / 2;
-            
-            // Clear top border (black bars for letterboxing)
-            if (y_offset > 0) {
-                lcd_set_window(0, 0, DISPLAY_WIDTH - 1, y_offset - 1);
-                pixel_t black = 0;
-                for (int i = 0; i < DISPLAY_WIDTH * y_offset; i++) {
-                    lcd_write_data((uint8_t*)&black, 2);
-                }
+        scanout_rect_t *prev = scanout_num_rects ? &scanout_rects[scanout_num_rects - 1] : NULL;
+        if (prev && prev->y0 == y0 && prev->y1 == y1 && prev->x1 + 1 == x0) {
+            prev->x1 = x1;
+        } else {
+            scanout_rects[scanout_num_rects++] = (scanout_rect_t){x0, y0, x1, y1};
+        }
+    }
+}
+
+/**
+ * Turn the dirty tile mask into window rectangles
+ * Each tile row becomes one span; equal spans on adjacent rows are merged.
+ */
+static void scanout_build_rects(const framebuffer_t *fb) {
+    if (fb->layout == DISPLAY_LAYOUT_COLUMN_MAJOR) {
+        scanout_build_column_rects(fb);
+        return;
+    }
+    
+    scanout_num_rects = 0;
+    
+    for (int ty = 0; ty < DISPLAY_TILE_ROWS; ty++) {
+        uint32_t mask = fb->dirty[ty];
+        if (!mask) {
+            continue;
+        }
+        
+        uint16_t x0 = __builtin_ctz(mask) * DISPLAY_TILE_W;
+        uint16_t x1 = (32 - __builtin_clz(mask)) * DISPLAY_TILE_W - 1;
+        uint16_t y0 = ty * DISPLAY_TILE_H;
+        uint16_t y1 = y0 + DISPLAY_TILE_H - 1;
+        
+        scanout_rect_t *prev = scanout_num_rects ? &scanout_rects[scanout_num_rects - 1] : NULL;
+        if (prev && prev->x0 == x0 && prev->x1 == x1 && prev->y1 + 1 == y0) {
+            prev->y1 = y1;
+        } else {
+            scanout_rects[scanout_num_rects++] = (scanout_rect_t){x0, y0, x1, y1};
+        }
+    }
+}
+
+/**
+ * Expand a run of palette indices into RGB565
+ */
+static void __not_in_flash_func(expand_line)(pixel_t *dst, const uint8_t *src, int count, const pixel_t *pal) {
+    // Unrolled by four; dirty spans are always a multiple of the tile size
+    for (int i = 0; i < count; i += 4) {
+        dst[i + 0] = pal[src[i + 0]];
+        dst[i + 1] = pal[src[i + 1]];
+        dst[i + 2] = pal[src[i + 2]];
+        dst[i + 3] = pal[src[i + 3]];
+    }
+}
+
+/**
+ * Pack a run of palette indices into RGB444, two pixels per three bytes
+ * count is even (dirty spans are a multiple of the tile size)
+ */
+static void __not_in_flash_func(pack_line_444)(uint8_t *dst, const uint8_t *src, int count, const pixel_t *pal) {
+    for (int i = 0; i < count; i += 2) {
+        uint32_t pair = ((uint32_t)pal[src[i]] << 12) | pal[src[i + 1]];
+        dst[0] = pair >> 16;
+        dst[1] = pair >> 8;
+        dst[2] = pair;
+        dst += 3;
+    }
+}
+
+uint32_t display_convert_line(void *dst, const uint8_t *src, int count, bool rgb444) {
+    const pixel_t *pal = pending_palette ? pending_palette : palette_custom[palette_custom_slot];
+    count &= ~3;
+    if (rgb444) {
+        pack_line_444((uint8_t*)dst, src, count, pal);
+        return count * 3 / 2;
+    }
+    expand_line((pixel_t*)dst, src, count, pal);
+    return count * 2;
+}
+
+/**
+ * Load the next scanline of the current rectangle into a DMA slot
+ * A scanline is a row slice, or a column slice in column-major mode; either
+ * way it is contiguous in the framebuffer. It is expanded into the slot's
+ * line buffer first. The last line chains to itself, which ends the chain.
+ */
+static void __not_in_flash_func(scanout_load_chunk)(int slot, bool trigger) {
+    const scanout_rect_t *r = &scanout_rects[scanout_rect];
+    const framebuffer_t *fb = scanout_fb;
+    int chan = scanout_dma_chan[slot];
+    bool last = (scanout_next_chunk == scanout_num_chunks - 1);
+    const uint8_t *src;
+    uint32_t w;
+    
+    if (fb->layout == DISPLAY_LAYOUT_COLUMN_MAJOR) {
+        w = r->y1 - r->y0 + 1;
+        src = &fb->data[(r->x0 + scanout_next_chunk) * fb->x_step + r->y0];
+    } else {
+        w = r->x1 - r->x0 + 1;
+        src = &fb->data[(r->y0 + scanout_next_chunk) * fb->y_step + r->x0];
+    }
+    if (color_mode == DISPLAY_COLOR_RGB444) {
+        pack_line_444((uint8_t*)scanout_line[slot], src, w, panel_palette);
+    } else {
+        expand_line(scanout_line[slot], src, w, panel_palette);
+    }
+    
+    dma_channel_config c = dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, spi_get_dreq(LCD_SPI, true));
+    channel_config_set_chain_to(&c, last ? chan : scanout_dma_chan[slot ^ 1]);
+    dma_channel_configure(chan, &c, &spi_get_hw(LCD_SPI)->dr, scanout_line[slot],
+                          transport_bytes(w), trigger);
+    
+    scanout_next_chunk++;
+    scanout_bytes_accum += transport_bytes(w);
+}
+
+/**
+ * Open the window for the current rectangle and start its DMA chain
+ */
+static void __not_in_flash_func(scanout_begin_rect)(void) {
+    const scanout_rect_t *r = &scanout_rects[scanout_rect];
+    uint16_t y_offset = (DISPLAY_HEIGHT - DOOM_HEIGHT) / 2;
+    
+    lcd_set_window(r->x0, r->y0 + y_offset, r->x1, r->y1 + y_offset);
+    gpio_put(LCD_CS, 0);
+    gpio_put(LCD_DC, 1);
+    scanout_bytes_accum += WINDOW_CMD_BYTES;
+    
+    if (scanout_fb->layout == DISPLAY_LAYOUT_COLUMN_MAJOR) {
+        scanout_num_chunks = r->x1 - r->x0 + 1;
+    } else {
+        scanout_num_chunks = r->y1 - r->y0 + 1;
+    }
+    scanout_next_chunk = 0;
+    scanout_chunks_done = 0;
+    scanout_irq_slot = 0;
+    
+    // Prime both channels, then kick off the first one
+    scanout_load_chunk(0, false);
+    if (scanout_num_chunks > 1) {
+        scanout_load_chunk(1, false);
+    }
+    dma_channel_start(scanout_dma_chan[0]);
+}
+
+/**
+ * Finish a scanout once the last rectangle has left the DMA
+ */
+static void __not_in_flash_func(scanout_finish)(void) {
+    uint64_t now = time_us_64();
+    scanout_last_us = (uint32_t)(now - scanout_start_time);
+    scanout_last_busy_us = scanout_busy_accum;
+    scanout_last_bytes = scanout_bytes_accum;
+    scanout_last_rects = scanout_num_rects;
+    scanout_frames++;
+    frame_telemetry_end(TELEMETRY_SCANOUT, scanout_fb->sequence, scanout_start_time);
+    
+    scanout_fb->ready = false;
+    frame_queue_push(&free_queue, (uint8_t)(scanout_fb - framebuffers));
+    scanout_fb = NULL;
+    scanout_active = false;
+    
+    // Wake core 1 if it is waiting for the scanout to end
+    __sev();
+}
+
+/**
+ * DMA completion IRQ (runs on core 1)
+ */
+static void __isr __not_in_flash_func(scanout_dma_irq_handler)(void) {
+    uint64_t t0 = time_us_64();
+    
+    // Service channels in completion order so chunks stay in sequence
+    while (scanout_active && dma_channel_get_irq0_status(scanout_dma_chan[scanout_irq_slot])) {
+        int slot = scanout_irq_slot;
+        dma_channel_acknowledge_irq0(scanout_dma_chan[slot]);
+        scanout_irq_slot ^= 1;
+        scanout_chunks_done++;
+        
+        if (scanout_next_chunk < scanout_num_chunks) {
+            // Re-arm this channel; the other one triggers it through the chain
+            scanout_load_chunk(slot, false);
+        } else if (scanout_chunks_done == scanout_num_chunks) {
+            // DMA completion only means the FIFO has the data; let it drain
+            while (spi_is_busy(LCD_SPI)) {
+                tight_loop_contents();
             }
-            
-            // Draw Doom frame
-            lcd_set_window(0, y_offset, DISPLAY_WIDTH - 1, y_offset + DOOM_HEIGHT - 1);
-            
-            // Write framebuffer to display
-            gpio_put(LCD_CS, 0);
-            gpio_put(LCD_DC, 1);
-            spi_write_blocking(LCD_SPI, (uint8_t*)fb->data, 
-                             DISPLAY_WIDTH * DOOM_HEIGHT * sizeof(pixel_t));
             gpio_put(LCD_CS, 1);
             
-            // Clear bottom border
-            if (y_offset > 0) {
-                lcd_set_window(0, y_offset + DOOM_HEIGHT, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
-                pixel_t black = 0;
-                for (int i = 0; i < DISPLAY_WIDTH * y_offset; i++) {
-                    lcd_write_data((uint8_t*)&black, 2);
-                }
+            if (++scanout_rect < scanout_num_rects) {
+                scanout_begin_rect();
+            } else {
+                scanout_busy_accum += (uint32_t)(time_us_64() - t0);
+                scanout_finish();
+                return;
             }
-            
-            fb->ready = false;
-            local_frame_count++;
-            
-            // Calculate FPS every second
-            uint64_t current_time = time_us_64();
-            if (current_time - last_time >= 1000000) {
-                current_fps = (float)local_frame_count * 1000000.0f / (float)(current_time - last_time);
-                local_frame_count = 0;
-                last_time = current_time;
+        }
+    }
+    
+    scanout_busy_accum += (uint32_t)(time_us_64() - t0);
+}
+
+/**
+ * Start pushing the dirty parts of a framebuffer to the panel
+ * Returns immediately; the DMA IRQ completes the frame.
+ */
+static void scanout_start(framebuffer_t *fb) {
+    uint64_t t0 = time_us_64();
+    
+    scanout_fb = fb;
+    scanout_active = true;
+    scanout_start_time = t0;
+    scanout_busy_accum = 0;
+    scanout_bytes_accum = 0;
+    
+    // Same indices, different colors: every tile has to go out again
+    if (fb->palette != panel_palette) {
+        panel_palette = fb->palette;
+        panel_valid = false;
+    }
+    
+    scanout_update_dirty(fb);
+    scanout_build_rects(fb);
+    scanout_rect = 0;
+    
+    if (scanout_num_rects == 0) {
+        // Nothing changed since the last frame
+        scanout_busy_accum += (uint32_t)(time_us_64() - t0);
+        scanout_finish();
+        return;
+    }
+    
+    scanout_begin_rect();
+    scanout_busy_accum += (uint32_t)(time_us_64() - t0);
+}
+
+/**
+ * Get scanout statistics for the last completed frame
+ */
+void display_get_scanout_stats(display_scanout_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    stats->scanout_us = scanout_last_us;
+    stats->core1_busy_us = scanout_last_busy_us;
+    stats->frames = scanout_frames;
+    stats->bytes = scanout_last_bytes;
+    stats->rects = scanout_last_rects;
+    stats->render_stall_us = render_stall_us;
+    stats->scanout_idle_us = scanout_idle_us;
+    stats->num_buffers = num_framebuffers;
+    stats->color_mode = color_mode;
+    stats->full_frame_bytes = transport_bytes(DOOM_WIDTH * DOOM_HEIGHT);
+    stats->spi_bytes_per_sec = spi_get_baudrate(LCD_SPI) / 8;
+}
+
+/**
+ * Force the next frame to be sent in full
+ */
+void display_invalidate(void) {
+    panel_valid = false;
+}
+
+/**
+ * Get frame pacing statistics for the last one-second window
+ */
+void display_get_pace_stats(frame_pace_stats_t *stats, frame_pace_policy_t *policy) {
+    if (stats) {
+        *stats = pace_stats_snapshot;
+    }
+    if (policy) {
+        *policy = pace_policy;
+    }
+}
+
+/**
+ * Tearing-effect edge IRQ (runs on core 1)
+ */
+static void te_irq_callback(uint gpio, uint32_t events) {
+    (void)gpio;
+    (void)events;
+    te_last_edge = time_us_64();
+    te_edge_count++;
+    __sev();
+}
+
+/**
+ * Hold a frame until the pacing policy lets it start scanout
+ */
+static void pace_frame(void) {
+    if (pace_policy == FRAME_PACE_TE) {
+        frame_pacer_on_te(&pacer, te_last_edge);
+    }
+    
+    uint64_t target = frame_pacer_next_present(&pacer, time_us_64());
+    if (pace_policy == FRAME_PACE_TE) {
+        // Wait for the real edge; the prediction only bounds the wait
+        uint32_t edges = te_edge_count;
+        while (te_edge_count == edges && time_us_64() < target + 2000) {
+            if (!render_split_service()) {
+                __wfe();
             }
         }
+    } else {
+        while (time_us_64() < target) {
+            render_split_service();
+        }
+    }
+    
+    frame_pacer_presented(&pacer, time_us_64());
+}
+
+/**
+ * Core 1 display loop - continuously updates display
+ */
+void display_core1_loop(void) {
+    printf("Core 1: Display update loop started\n");
+    
+    // The panel's reset delays overlap core 0's boot
+    if (panel_deferred) {
+        panel_start();
+    }
+    
+    // Route the DMA completion IRQ to this core
+    irq_set_exclusive_handler(SCANOUT_DMA_IRQ, scanout_dma_irq_handler);
+    irq_set_enabled(SCANOUT_DMA_IRQ, true);
+    
+    // Route the tearing-effect edge to this core as well
+    if (LCD_TE >= 0 && pace_policy == FRAME_PACE_TE) {
+        gpio_init(LCD_TE);
+        gpio_set_dir(LCD_TE, GPIO_IN);
+        gpio_set_irq_enabled_with_callback(LCD_TE, GPIO_IRQ_EDGE_RISE, true, te_irq_callback);
+    }
+    
+    frame_pacer_init(&pacer, pace_policy, time_us_64());
+    
+    uint64_t last_time = time_us_64();
+    uint32_t last_frames = scanout_frames;
+    bool first_frame = true;
+    
+    while (true) {
+        // Only one scanout can own the SPI bus at a time; draw core 0's
+        // posted columns while the DMA runs
+        while (scanout_active) {
+            if (!render_split_service()) {
+                __wfe();
+            }
+        }
+        
+        // Wait for core 0 to present a frame
+        uint8_t index;
+        uint64_t idle_start = time_us_64();
+        while (!frame_queue_pop(&present_queue, &index)) {
+            if (!render_split_service()) {
+                __wfe();
+            }
+        }
+        scanout_idle_us = (uint32_t)(time_us_64() - idle_start);
         
-        mutex_exit(&fb_mutex);
+        uint64_t pace_start = time_us_64();
+        pace_frame();
+        frame_telemetry_end(TELEMETRY_PACE, framebuffers[index].sequence, pace_start);
+        if (first_frame) {
+            boot_mark("first scanout");
+            first_frame = false;
+        }
+        scanout_start(&framebuffers[index]);
+        
+        // Calculate FPS every second
+        uint64_t current_time = time_us_64();
+        if (current_time - last_time >= 1000000) {
+            uint32_t frames = scanout_frames;
+            current_fps = (float)(frames - last_frames) * 1000000.0f / (float)(current_time - last_time);
+            last_frames = frames;
+            last_time = current_time;
+            
+            frame_pacer_get_stats(&pacer, &pace_stats_snapshot);
+            frame_pacer_reset_stats(&pacer);
+        }
     }
 }
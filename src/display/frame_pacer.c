@@ -0,0 +1,166 @@
+/**
+ * Frame pacing implementation
+ * Pure policy logic; the caller supplies all timestamps
+ */
+
+#include "frame_pacer.h"
+#include <string.h>
+
+// Nominal ST7789 refresh until tearing-effect edges have been measured
+#define DEFAULT_TE_PERIOD_US 16667
+
+// A frame this close to a missed slot still counts as on time
+#define SLOT_TOLERANCE_US    1000
+
+static const uint32_t policy_period_us[FRAME_PACE_COUNT] = {
+    0,          // ASAP
+    28571,      // 35 Hz
+    33333,      // 30 Hz
+    57143,      // 17.5 Hz
+    0,          // TE
+};
+
+static const char *policy_names[FRAME_PACE_COUNT] = {
+    "ASAP", "35Hz", "30Hz", "17.5Hz", "TE",
+};
+
+/**
+ * Integer square root (for the jitter metric, no FPU)
+ */
+static uint32_t isqrt64(uint64_t v) {
+    uint64_t root = 0;
+    uint64_t bit = 1ull << 62;
+    
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+void frame_pacer_init(frame_pacer_t *pacer, frame_pace_policy_t policy, uint64_t now) {
+    memset(pacer, 0, sizeof(*pacer));
+    
+    if (policy >= FRAME_PACE_COUNT) {
+        policy = FRAME_PACE_ASAP;
+    }
+    pacer->policy = policy;
+    pacer->period_us = policy_period_us[policy];
+    pacer->next_slot = now;
+    pacer->te_period_us = DEFAULT_TE_PERIOD_US;
+    frame_pacer_reset_stats(pacer);
+}
+
+void frame_pacer_on_te(frame_pacer_t *pacer, uint64_t te_time) {
+    if (te_time <= pacer->last_te) {
+        return;
+    }
+    
+    if (pacer->last_te != 0) {
+        // Smooth the refresh period estimate; ignore edges we slept through
+        uint64_t interval = te_time - pacer->last_te;
+        if (interval < 2 * (uint64_t)pacer->te_period_us) {
+            pacer->te_period_us = (pacer->te_period_us * 7 + (uint32_t)interval) / 8;
+        }
+    }
+    pacer->last_te = te_time;
+}
+
+uint64_t frame_pacer_next_present(frame_pacer_t *pacer, uint64_t now) {
+    switch (pacer->policy) {
+        case FRAME_PACE_35HZ:
+        case FRAME_PACE_30HZ:
+        case FRAME_PACE_17_5HZ: {
+            if (now <= pacer->next_slot + SLOT_TOLERANCE_US) {
+                return pacer->next_slot;
+            }
+            
+            // Late: drop the slots we missed and realign to the cadence
+            uint64_t late = now - pacer->next_slot;
+            uint32_t skipped = (uint32_t)((late + pacer->period_us - 1) / pacer->period_us);
+            pacer->next_slot += (uint64_t)skipped * pacer->period_us;
+            if (pacer->last_present != 0) {
+                pacer->missed += skipped;
+            }
+            return pacer->next_slot;
+        }
+        
+        case FRAME_PACE_TE: {
+            if (pacer->last_te == 0) {
+                return now;
+            }
+            
+            // Next predicted edge at or after now
+            uint64_t since = now - pacer->last_te;
+            uint64_t edges = (since + pacer->te_period_us - 1) / pacer->te_period_us;
+            return pacer->last_te + edges * pacer->te_period_us;
+        }
+        
+        case FRAME_PACE_ASAP:
+        default:
+            return now;
+    }
+}
+
+void frame_pacer_presented(frame_pacer_t *pacer, uint64_t now) {
+    if (pacer->period_us) {
+        pacer->next_slot += pacer->period_us;
+        if (pacer->next_slot + pacer->period_us < now) {
+            // Presented well after the slot (first frame or long stall)
+            pacer->next_slot = now + pacer->period_us;
+        }
+    }
+    
+    if (pacer->last_present != 0) {
+        uint32_t interval = (uint32_t)(now - pacer->last_present);
+        pacer->count++;
+        pacer->sum += interval;
+        pacer->sum_sq += (uint64_t)interval * interval;
+        if (interval < pacer->min_us) {
+            pacer->min_us = interval;
+        }
+        if (interval > pacer->max_us) {
+            pacer->max_us = interval;
+        }
+    }
+    pacer->last_present = now;
+}
+
+void frame_pacer_get_stats(const frame_pacer_t *pacer, frame_pace_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->missed = pacer->missed;
+    
+    if (pacer->count == 0) {
+        return;
+    }
+    
+    uint64_t mean = pacer->sum / pacer->count;
+    uint64_t mean_sq = pacer->sum_sq / pacer->count;
+    
+    stats->frames = pacer->count;
+    stats->mean_us = (uint32_t)mean;
+    stats->stddev_us = (mean_sq > mean * mean) ? isqrt64(mean_sq - mean * mean) : 0;
+    stats->min_us = pacer->min_us;
+    stats->max_us = pacer->max_us;
+}
+
+void frame_pacer_reset_stats(frame_pacer_t *pacer) {
+    pacer->count = 0;
+    pacer->sum = 0;
+    pacer->sum_sq = 0;
+    pacer->min_us = UINT32_MAX;
+    pacer->max_us = 0;
+    pacer->missed = 0;
+}
+
+const char* frame_pacer_policy_name(frame_pace_policy_t policy) {
+    return (policy < FRAME_PACE_COUNT) ? policy_names[policy] : "Unknown";
+}
@@ -0,0 +1,142 @@
+/**
+ * Demo playback and timedemo (Doom's G_DoPlayDemo, G_ReadDemoTiccmd and
+ * G_CheckDemoStatus)
+ */
+
+#include "g_demo.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DEMO_OLD_MAX_SKILL  4       // First byte 0-4 is the old format's skill
+#define DEMO_VERSION_MIN    104
+#define DEMO_VERSION_MAX    111
+#define DEMO_LONGTICS       111
+#define TICRATE             35
+
+bool g_demo_open(g_demo_t *demo, const uint8_t *data, uint32_t size) {
+    memset(demo, 0, sizeof(*demo));
+    if (!data || size < 7) {
+        printf("Error: Demo too short (%lu bytes)\n", size);
+        return false;
+    }
+    
+    uint32_t pos = 0;
+    uint8_t console = 0;
+    if (data[0] <= DEMO_OLD_MAX_SKILL) {
+        demo->skill = data[pos++];
+        demo->episode = data[pos++];
+        demo->map = data[pos++];
+    } else {
+        demo->version = data[pos++];
+        if (demo->version < DEMO_VERSION_MIN || demo->version > DEMO_VERSION_MAX || size < 13) {
+            printf("Error: Unsupported demo version %u\n", demo->version);
+            return false;
+        }
+        demo->skill = data[pos++];
+        demo->episode = data[pos++];
+        demo->map = data[pos++];
+        pos += 4;   // deathmatch, respawn, fast, nomonsters
+        console = data[pos++];
+        demo->longtics = demo->version == DEMO_LONGTICS;
+    }
+    
+    // Ticcmds are stored in player order; play back the console player,
+    // or the first player in the game if it is not
+    bool console_found = false;
+    for (int i = 0; i < G_DEMO_MAXPLAYERS; i++) {
+        if (!data[pos + i]) {
+            continue;
+        }
+        if (i == console) {
+            demo->player = demo->num_players;
+            console_found = true;
+        }
+        demo->num_players++;
+    }
+    pos += G_DEMO_MAXPLAYERS;
+    if (!demo->num_players) {
+        printf("Error: Demo has no players\n");
+        return false;
+    }
+    if (!console_found) {
+        demo->player = 0;
+    }
+    
+    demo->data = data;
+    demo->size = size;
+    demo->pos = pos;
+    return true;
+}
+
+bool g_demo_read(g_demo_t *demo, ticcmd_t *cmd) {
+    uint32_t cmd_size = demo->longtics ? 5 : 4;
+    uint32_t tic_size = cmd_size * demo->num_players;
+    
+    // A demo cut short without its end marker ends at the last whole tic
+    if (demo->pos >= demo->size || demo->data[demo->pos] == G_DEMO_END ||
+        demo->size - demo->pos < tic_size) {
+        return false;
+    }
+    
+    const uint8_t *p = &demo->data[demo->pos + demo->player * cmd_size];
+    cmd->forwardmove = (int8_t)p[0];
+    cmd->sidemove = (int8_t)p[1];
+    if (demo->longtics) {
+        cmd->angleturn = (int16_t)(p[2] | (p[3] << 8));
+        cmd->buttons = p[4];
+    } else {
+        cmd->angleturn = (int16_t)(p[2] << 8);
+        cmd->buttons = p[3];
+    }
+    
+    demo->pos += tic_size;
+    demo->tics++;
+    return true;
+}
+
+void g_demo_map_name(const g_demo_t *demo, bool commercial, char *name) {
+    if (commercial) {
+        snprintf(name, 9, "MAP%02u", demo->map);
+    } else {
+        snprintf(name, 9, "E%uM%u", demo->episode, demo->map);
+    }
+}
+
+void g_timedemo_start(g_timedemo_t *td, uint64_t now_us) {
+    memset(td, 0, sizeof(*td));
+    td->start_us = now_us;
+    td->last_us = now_us;
+    td->min_us = UINT32_MAX;
+}
+
+void g_timedemo_tic(g_timedemo_t *td, uint64_t now_us, bool rendered) {
+    uint32_t us = (uint32_t)(now_us - td->last_us);
+    td->last_us = now_us;
+    td->gametics++;
+    if (rendered) {
+        td->frames++;
+    }
+    if (us < td->min_us) {
+        td->min_us = us;
+    }
+    if (us > td->max_us) {
+        td->max_us = us;
+    }
+}
+
+void g_timedemo_report(const g_timedemo_t *td, const char *name) {
+    uint64_t wall_us = td->last_us - td->start_us;
+    if (!td->gametics || !wall_us) {
+        printf("Timedemo %s: no tics played\n", name);
+        return;
+    }
+    
+    // Doom prints fps as gametics * 35 / realtics; this is the same
+    // figure at microsecond resolution
+    float seconds = (float)wall_us / 1000000.0f;
+    printf("Timedemo %s: %lu gametics, %lu frames in %lu ms (%.1f tics/s, %.1f fps, %.2fx realtime)\n",
+           name, td->gametics, td->frames, (uint32_t)(wall_us / 1000),
+           td->gametics / seconds, td->frames / seconds, td->gametics / (seconds * TICRATE));
+    printf("Timedemo %s: %s time min %lu us | avg %lu us | max %lu us\n", name,
+           td->frames ? "frame" : "tic", td->min_us, (uint32_t)(wall_us / td->gametics), td->max_us);
+}
@@ -0,0 +1,52 @@
+/**
+ * Fixed point reciprocal table
+ * fixed_recip_table[i] = 2^62 / (2^31 + i * 2^23 + 2^22), generated once
+ */
+
+#include "m_fixed.h"
+
+const uint32_t fixed_recip_table[256] = {
+    0x7FC01FF0, 0x7F411E52, 0x7EC31843, 0x7E460ADA, 0x7DC9F339, 0x7D4ECE8F,
+    0x7CD49A16, 0x7C5B5311, 0x7BE2F6CE, 0x7B6B82A6, 0x7AF4F3FE, 0x7A7F4841,
+    0x7A0A7CE6, 0x79968F6F, 0x79237D65, 0x78B1445C, 0x783FE1F0, 0x77CF53C5,
+    0x775F978C, 0x76F0AAF9, 0x76828BCE, 0x761537D0, 0x75A8ACCF, 0x753CE8A4,
+    0x74D1E92F, 0x7467AC55, 0x73FE3007, 0x7395723A, 0x732D70ED, 0x72C62A24,
+    0x725F9BEC, 0x71F9C457, 0x7194A17F, 0x71303185, 0x70CC728F, 0x706962CC,
+    0x70070070, 0x6FA549B4, 0x6F443CD9, 0x6EE3D826, 0x6E8419E6, 0x6E25006E,
+    0x6DC68A13, 0x6D68B535, 0x6D0B8036, 0x6CAEE97F, 0x6C52EF7F, 0x6BF790A8,
+    0x6B9CCB74, 0x6B429E60, 0x6AE907EF, 0x6A9006A9, 0x6A37991A, 0x69DFBDD4,
+    0x6988736D, 0x6931B880, 0x68DB8BAC, 0x6885EB95, 0x6830D6E4, 0x67DC4C45,
+    0x67884A69, 0x6734D006, 0x66E1DBD4, 0x668F6C91, 0x663D80FF, 0x65EC17E3,
+    0x659B3006, 0x654AC835, 0x64FADF42, 0x64AB7401, 0x645C854A, 0x640E11FA,
+    0x63C018F0, 0x6372990E, 0x6325913C, 0x62D90062, 0x628CE570, 0x62413F54,
+    0x61F60D02, 0x61AB4D72, 0x6160FF9E, 0x61172283, 0x60CDB520, 0x6084B67A,
+    0x603C2597, 0x5FF4017F, 0x5FAC493F, 0x5F64FBE6, 0x5F1E1885, 0x5ED79E31,
+    0x5E918C01, 0x5E4BE10F, 0x5E069C77, 0x5DC1BD58, 0x5D7D42D4, 0x5D392C10,
+    0x5CF57831, 0x5CB22661, 0x5C6F35CC, 0x5C2CA5A0, 0x5BEA750C, 0x5BA8A344,
+    0x5B672F7C, 0x5B2618EC, 0x5AE55ECD, 0x5AA5005A, 0x5A64FCD2, 0x5A255374,
+    0x59E60382, 0x59A70C41, 0x59686CF7, 0x592A24EB, 0x58EC3368, 0x58AE97BA,
+    0x58715130, 0x58345F18, 0x57F7C0C5, 0x57BB758C, 0x577F7CC0, 0x5743D5BB,
+    0x57087FD4, 0x56CD7A67, 0x5692C4D1, 0x56585E70, 0x561E46A4, 0x55E47CD0,
+    0x55AB0055, 0x5571D09A, 0x5538ED06, 0x55005500, 0x54C807F2, 0x54900549,
+    0x54584C70, 0x5420DCD6, 0x53E9B5EB, 0x53B2D721, 0x537C3FEB, 0x5345EFBC,
+    0x530FE60B, 0x52DA224E, 0x52A4A3FE, 0x526F6A96, 0x523A758F, 0x5205C467,
+    0x51D1569C, 0x519D2BAD, 0x51694319, 0x51359C64, 0x5102370F, 0x50CF129F,
+    0x509C2E9A, 0x50698A85, 0x503725EA, 0x50050050, 0x4FD31941, 0x4FA1704A,
+    0x4F7004F7, 0x4F3ED6D4, 0x4F0DE571, 0x4EDD305D, 0x4EACB72A, 0x4E7C7968,
+    0x4E4C76AB, 0x4E1CAE88, 0x4DED2092, 0x4DBDCC5F, 0x4D8EB188, 0x4D5FCFA4,
+    0x4D31264B, 0x4D02B518, 0x4CD47BA5, 0x4CA67990, 0x4C78AE73, 0x4C4B19ED,
+    0x4C1DBB9D, 0x4BF09322, 0x4BC3A01C, 0x4B96E22D, 0x4B6A58F7, 0x4B3E041D,
+    0x4B11E343, 0x4AE5F60D, 0x4ABA3C21, 0x4A8EB526, 0x4A6360C3, 0x4A383E9F,
+    0x4A0D4E64, 0x49E28FBA, 0x49B8024D, 0x498DA5C8, 0x496379D6, 0x49397E24,
+    0x490FB25F, 0x48E61636, 0x48BCA957, 0x48936B72, 0x486A5C37, 0x48417B57,
+    0x4818C884, 0x47F04371, 0x47C7EBCF, 0x479FC154, 0x4777C3B2, 0x474FF2A1,
+    0x47284DD4, 0x4700D502, 0x46D987E3, 0x46B2662D, 0x468B6F9A, 0x4664A3E2,
+    0x463E02BE, 0x46178BE9, 0x45F13F1C, 0x45CB1C14, 0x45A5228C, 0x457F5241,
+    0x4559AAF0, 0x45342C55, 0x450ED630, 0x44E9A83E, 0x44C4A23F, 0x449FC3F4,
+    0x447B0D1B, 0x44567D76, 0x443214C7, 0x440DD2CE, 0x43E9B74F, 0x43C5C20D,
+    0x43A1F2CA, 0x437E494B, 0x435AC553, 0x433766A9, 0x43142D11, 0x42F11851,
+    0x42CE2830, 0x42AB5C73, 0x4288B4E3, 0x42663147, 0x4243D168, 0x4221950D,
+    0x41FF7C01, 0x41DD860B, 0x41BBB2F8, 0x419A0290, 0x4178749E, 0x415708EE,
+    0x4135BF4C, 0x41149783, 0x40F39161, 0x40D2ACB1, 0x40B1E941, 0x409146DF,
+    0x4070C559, 0x4050647D, 0x4030241B, 0x40100401,
+};
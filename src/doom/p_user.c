@@ -0,0 +1,89 @@
+/**
+ * Player movement (Doom's p_user.c and the player case of p_mobj.c)
+ */
+
+#include "p_player.h"
+#include "r_tables.h"
+#include <string.h>
+
+#define MAXMOVE             (30 * FRACUNIT)
+#define STOPSPEED           0x1000
+#define FRICTION            0xe800
+
+/**
+ * Add momentum in a direction (P_Thrust)
+ */
+static void thrust(p_player_t *player, angle_t angle, fixed_t move) {
+    angle >>= ANGLETOFINESHIFT;
+    player->momx += FixedMul(move, finecosine(angle));
+    player->momy += FixedMul(move, finesine(angle));
+}
+
+/**
+ * Follow the floor underfoot (P_CalcHeight without the bob)
+ */
+static void update_height(const level_t *level, p_player_t *player) {
+    player->sector = r_point_sector(level, player->x, player->y);
+    player->z = level->sector_state[player->sector].floor_height + R_VIEWHEIGHT;
+}
+
+bool p_spawn_player(const level_t *level, p_player_t *player) {
+    memset(player, 0, sizeof(*player));
+    bool found = false;
+    for (uint32_t i = 0; i < level->header->num_things; i++) {
+        const level_thing_t *thing = &level->things[i];
+        if (thing->type == 1) {
+            player->x = thing->x << FRACBITS;
+            player->y = thing->y << FRACBITS;
+            player->angle = ANG45 * (thing->angle / 45);
+            found = true;
+            break;
+        }
+    }
+    update_height(level, player);
+    return found;
+}
+
+void p_player_tic(const level_t *level, p_player_t *player, const ticcmd_t *cmd) {
+    // P_MovePlayer: the player is always on the ground
+    player->angle += (angle_t)cmd->angleturn << 16;
+    if (cmd->forwardmove) {
+        thrust(player, player->angle, cmd->forwardmove * 2048);
+    }
+    if (cmd->sidemove) {
+        thrust(player, player->angle - ANG90, cmd->sidemove * 2048);
+    }
+    
+    // P_XYMovement, without the collision checks
+    if (player->momx > MAXMOVE) {
+        player->momx = MAXMOVE;
+    } else if (player->momx < -MAXMOVE) {
+        player->momx = -MAXMOVE;
+    }
+    if (player->momy > MAXMOVE) {
+        player->momy = MAXMOVE;
+    } else if (player->momy < -MAXMOVE) {
+        player->momy = -MAXMOVE;
+    }
+    player->x += player->momx;
+    player->y += player->momy;
+    
+    if (player->momx > -STOPSPEED && player->momx < STOPSPEED &&
+        player->momy > -STOPSPEED && player->momy < STOPSPEED &&
+        !cmd->forwardmove && !cmd->sidemove) {
+        player->momx = 0;
+        player->momy = 0;
+    } else {
+        player->momx = FixedMul(player->momx, FRICTION);
+        player->momy = FixedMul(player->momy, FRICTION);
+    }
+    
+    update_height(level, player);
+}
+
+void p_player_view(const p_player_t *player, r_view_t *view) {
+    view->x = player->x;
+    view->y = player->y;
+    view->z = player->z;
+    view->angle = player->angle;
+}
@@ -0,0 +1,528 @@
+/**
+ * BSP traversal and wall range setup (Doom's r_bsp.c and R_StoreWallRange)
+ * Runs on core 0 only. Walks the BSP front to back, clips each seg
+ * against the columns already hidden by solid walls and stores what is
+ * left as drawsegs; r_draw_columns() turns those into pixels.
+ */
+
+#include "r_local.h"
+#include <string.h>
+
+static const level_seg_t *curline;
+static angle_t rw_angle1;           // Angle from the view to the seg's first vertex
+
+/**
+ * Texture height in 16.16 (for pegging)
+ */
+static fixed_t texture_height(int texture) {
+    if (!r->textures || texture <= 0 || (uint32_t)texture >= r->textures->num_textures) {
+        return 128 * FRACUNIT;
+    }
+    return r->textures->textures[texture].height << FRACBITS;
+}
+
+/**
+ * A side's live textures and offset (dynamic sides keep them in the arena)
+ */
+static void side_textures(const level_side_t *side, fixed_t *offset, int *top, int *bottom, int *mid) {
+    if (side->dynamic != LEVEL_NONE) {
+        const level_side_state_t *state = &r->level->side_state[side->dynamic];
+        *offset = state->texture_offset;
+        *top = state->top_texture;
+        *bottom = state->bottom_texture;
+        *mid = state->mid_texture;
+    } else {
+        *offset = side->texture_offset;
+        *top = side->top_texture;
+        *bottom = side->bottom_texture;
+        *mid = side->mid_texture;
+    }
+}
+
+/**
+ * Scale of the current seg at a view angle (R_ScaleFromGlobalAngle)
+ */
+static fixed_t scale_from_global_angle(angle_t visangle, angle_t normalangle, fixed_t distance) {
+    angle_t anglea = ANG90 + (visangle - r->viewangle);
+    angle_t angleb = ANG90 + (visangle - normalangle);
+    fixed_t sinea = finesine(anglea >> ANGLETOFINESHIFT);
+    fixed_t sineb = finesine(angleb >> ANGLETOFINESHIFT);
+    fixed_t num = FixedMul(CENTERX * FRACUNIT, sineb);
+    fixed_t den = FixedMul(distance, sinea);
+    
+    if (den > num >> FRACBITS) {
+        fixed_t scale = FixedDiv(num, den);
+        if (scale > 64 * FRACUNIT) {
+            return 64 * FRACUNIT;
+        }
+        return scale < 256 ? 256 : scale;
+    }
+    return 64 * FRACUNIT;
+}
+
+/**
+ * Store columns [start, stop] of curline as a drawseg (R_StoreWallRange)
+ */
+static void store_wall_range(int start, int stop) {
+    if (start > stop || start >= R_WIDTH) {
+        return;
+    }
+    if (r->num_drawsegs == MAXDRAWSEGS) {
+        r->stats.overflows++;
+        return;
+    }
+    
+    const level_t *level = r->level;
+    const level_line_t *line = &level->lines[curline->line];
+    const level_side_t *side = &level->sides[line->side[curline->side]];
+    const level_sector_state_t *front = &level->sector_state[curline->front_sector];
+    const level_sector_state_t *back = curline->back_sector != LEVEL_NONE ?
+                                       &level->sector_state[curline->back_sector] : NULL;
+    uint16_t line_flags = level->line_state[curline->line].flags;
+    level->line_state[curline->line].flags = line_flags | ML_MAPPED;
+    
+    r_drawseg_t *ds = &r->drawsegs[r->num_drawsegs];
+    memset(ds, 0, sizeof(*ds));
+    ds->x1 = (int16_t)start;
+    ds->x2 = (int16_t)stop;
+    ds->seg = (uint16_t)(curline - level->segs);
+    
+    // Perpendicular distance to the seg's line
+    angle_t normalangle = curline->angle + ANG90;
+    angle_t offsetangle = normalangle - rw_angle1;
+    if ((int32_t)offsetangle < 0) {
+        offsetangle = -offsetangle;
+    }
+    if (offsetangle > ANG90) {
+        offsetangle = ANG90;
+    }
+    const level_vertex_t *v1 = &level->vertexes[curline->v1];
+    const level_vertex_t *v2 = &level->vertexes[curline->v2];
+    fixed_t hyp = r_point_to_dist(v1->x, v1->y);
+    ds->distance = FixedMul(hyp, finesine((ANG90 - offsetangle) >> ANGLETOFINESHIFT));
+    
+    // Scale at both ends; columns in between are interpolated
+    ds->scale1 = scale_from_global_angle(r->viewangle + r->xtoviewangle[start], normalangle, ds->distance);
+    if (stop > start) {
+        fixed_t scale2 = scale_from_global_angle(r->viewangle + r->xtoviewangle[stop], normalangle, ds->distance);
+        ds->scalestep = (scale2 - ds->scale1) / (stop - start);
+    }
+    
+    fixed_t texture_offset;
+    int top, bottom, mid;
+    side_textures(side, &texture_offset, &top, &bottom, &mid);
+    
+    bool sky = r->sky_flat >= 0 && front->ceiling_flat == r->sky_flat;
+    bool markfloor, markceiling;
+    fixed_t worldtop = front->ceiling_height - r->viewz;
+    fixed_t worldbottom = front->floor_height - r->viewz;
+    fixed_t worldhigh = 0;
+    fixed_t worldlow = 0;
+    
+    if (!back) {
+        // One-sided: a solid wall
+        ds->flags |= DS_SOLID;
+        ds->midtexture = (int16_t)mid;
+        markfloor = markceiling = true;
+        if (line_flags & ML_DONTPEGBOTTOM) {
+            ds->midtexturemid = front->floor_height + texture_height(mid) - r->viewz;
+        } else {
+            ds->midtexturemid = worldtop;
+        }
+        ds->midtexturemid += side->row_offset;
+    } else {
+        worldhigh = back->ceiling_height - r->viewz;
+        worldlow = back->floor_height - r->viewz;
+        
+        // Sky hack: no upper wall between two skies
+        if (sky && back->ceiling_flat == r->sky_flat) {
+            worldtop = worldhigh;
+        }
+        
+        // A plane only needs drawing here where it changes
+        markfloor = worldlow != worldbottom || back->floor_flat != front->floor_flat ||
+                    back->light != front->light;
+        markceiling = worldhigh != worldtop || back->ceiling_flat != front->ceiling_flat ||
+                      back->light != front->light;
+        if (back->ceiling_height <= front->floor_height || back->floor_height >= front->ceiling_height) {
+            // Closed door
+            markceiling = markfloor = true;
+        }
+        
+        if (worldhigh < worldtop) {
+            ds->toptexture = (int16_t)top;
+            if (line_flags & ML_DONTPEGTOP) {
+                ds->toptexturemid = worldtop;
+            } else {
+                ds->toptexturemid = back->ceiling_height + texture_height(top) - r->viewz;
+            }
+        }
+        if (worldlow > worldbottom) {
+            ds->bottomtexture = (int16_t)bottom;
+            ds->bottomtexturemid = (line_flags & ML_DONTPEGBOTTOM) ? worldtop : worldlow;
+        }
+        ds->toptexturemid += side->row_offset;
+        ds->bottomtexturemid += side->row_offset;
+        
+        if (mid) {
+            // Masked mid texture, drawn after all walls (R_RenderMaskedSegRange)
+            ds->flags |= DS_MASKED;
+            ds->midtexture = (int16_t)mid;
+            if (line_flags & ML_DONTPEGBOTTOM) {
+                fixed_t floor = front->floor_height > back->floor_height ? front->floor_height : back->floor_height;
+                ds->midtexturemid = floor + texture_height(mid) - r->viewz;
+            } else {
+                fixed_t ceiling = front->ceiling_height < back->ceiling_height ? front->ceiling_height : back->ceiling_height;
+                ds->midtexturemid = ceiling - r->viewz;
+            }
+            ds->midtexturemid += side->row_offset;
+            r->masked[r->num_masked++] = (uint8_t)r->num_drawsegs;
+        }
+    }
+    
+    if ((ds->flags & DS_SOLID) || ds->toptexture || ds->bottomtexture || mid) {
+        ds->flags |= DS_TEXTURED;
+        
+        // Texture column at the seg's perpendicular foot
+        offsetangle = normalangle - rw_angle1;
+        if (offsetangle > ANG180) {
+            offsetangle = -offsetangle;
+        }
+        if (offsetangle > ANG90) {
+            offsetangle = ANG90;
+        }
+        ds->offset = FixedMul(hyp, finesine(offsetangle >> ANGLETOFINESHIFT));
+        if (normalangle - rw_angle1 < ANG180) {
+            ds->offset = -ds->offset;
+        }
+        ds->offset += texture_offset + curline->offset;
+        ds->centerangle = ANG90 + r->viewangle - normalangle;
+        
+        // Fake contrast: walls along the axes are a step darker or lighter
+        int light = front->light >> LIGHTSEGSHIFT;
+        if (v1->y == v2->y) {
+            light--;
+        } else if (v1->x == v2->x) {
+            light++;
+        }
+        ds->light = (uint8_t)(light < 0 ? 0 : light >= LIGHTLEVELS ? LIGHTLEVELS - 1 : light);
+    }
+    
+    // Planes on the far side of the eye are never seen from here
+    if (front->floor_height >= r->viewz) {
+        markfloor = false;
+    }
+    if (front->ceiling_height <= r->viewz && !sky) {
+        markceiling = false;
+    }
+    if (markfloor) {
+        ds->flags |= DS_MARKFLOOR;
+        r_flat_data(front->floor_flat);
+    }
+    if (markceiling) {
+        ds->flags |= DS_MARKCEILING;
+        if (sky) {
+            ds->flags |= DS_SKY;
+        } else {
+            r_flat_data(front->ceiling_flat);
+        }
+    }
+    
+    ds->worldtop = worldtop >> 4;
+    ds->worldbottom = worldbottom >> 4;
+    ds->worldhigh = worldhigh >> 4;
+    ds->worldlow = worldlow >> 4;
+    r->num_drawsegs++;
+}
+
+/**
+ * Clip a solid wall range against the solid ranges so far, store the
+ * visible pieces and merge it in (R_ClipSolidWallSegment)
+ */
+static void clip_solid_wall_segment(int first, int last) {
+    r_cliprange_t *start = r->solidsegs;
+    r_cliprange_t *newend = r->solidsegs + r->num_solidsegs;
+    r_cliprange_t *next;
+    
+    // Find the first range that touches the range (adjacent pixels touch)
+    while (start->last < first - 1) {
+        start++;
+    }
+    
+    if (first < start->first) {
+        if (last < start->first - 1) {
+            // Entirely visible above start: insert a new range
+            store_wall_range(first, last);
+            if (r->num_solidsegs == MAXSOLIDSEGS) {
+                r->stats.overflows++;
+                return;
+            }
+            next = newend;
+            while (next != start) {
+                *next = *(next - 1);
+                next--;
+            }
+            next->first = (int16_t)first;
+            next->last = (int16_t)last;
+            r->num_solidsegs++;
+            return;
+        }
+        
+        // A fragment above start
+        store_wall_range(first, start->first - 1);
+        start->first = (int16_t)first;
+    }
+    
+    if (last <= start->last) {
+        return;
+    }
+    
+    // The fragments between ranges
+    next = start;
+    while (last >= (next + 1)->first - 1) {
+        store_wall_range(next->last + 1, (next + 1)->first - 1);
+        next++;
+        if (last <= next->last) {
+            start->last = next->last;
+            goto crunch;
+        }
+    }
+    
+    // A fragment after the last range it reaches
+    store_wall_range(next->last + 1, last);
+    start->last = (int16_t)last;
+
+crunch:
+    // Remove the ranges start now covers
+    if (next == start) {
+        return;
+    }
+    while (next++ != newend) {
+        *++start = *next;
+    }
+    r->num_solidsegs = (int)(start + 1 - r->solidsegs);
+}
+
+/**
+ * Store the visible pieces of a see-through range without marking it
+ * solid (R_ClipPassWallSegment)
+ */
+static void clip_pass_wall_segment(int first, int last) {
+    r_cliprange_t *start = r->solidsegs;
+    while (start->last < first - 1) {
+        start++;
+    }
+    
+    if (first < start->first) {
+        if (last < start->first - 1) {
+            store_wall_range(first, last);
+            return;
+        }
+        store_wall_range(first, start->first - 1);
+    }
+    
+    if (last <= start->last) {
+        return;
+    }
+    
+    while (last >= (start + 1)->first - 1) {
+        store_wall_range(start->last + 1, (start + 1)->first - 1);
+        start++;
+        if (last <= start->last) {
+            return;
+        }
+    }
+    
+    store_wall_range(start->last + 1, last);
+}
+
+/**
+ * Clip the angles of a span to the view, in place
+ * Returns false if the span is entirely outside the field of view
+ */
+static bool clip_to_view(angle_t *angle1, angle_t *angle2, angle_t span) {
+    angle_t clipangle = r->clipangle;
+    angle_t tspan = *angle1 + clipangle;
+    if (tspan > 2 * clipangle) {
+        tspan -= 2 * clipangle;
+        if (tspan >= span) {
+            return false;
+        }
+        *angle1 = clipangle;
+    }
+    tspan = clipangle - *angle2;
+    if (tspan > 2 * clipangle) {
+        tspan -= 2 * clipangle;
+        if (tspan >= span) {
+            return false;
+        }
+        *angle2 = -clipangle;
+    }
+    return true;
+}
+
+/**
+ * Clip a seg to the view and the solid ranges (R_AddLine)
+ */
+static void add_line(const level_seg_t *seg) {
+    const level_t *level = r->level;
+    const level_vertex_t *v1 = &level->vertexes[seg->v1];
+    const level_vertex_t *v2 = &level->vertexes[seg->v2];
+    curline = seg;
+    
+    angle_t angle1 = r_point_to_angle(v1->x, v1->y);
+    angle_t angle2 = r_point_to_angle(v2->x, v2->y);
+    
+    // Back side, or seen edge on
+    angle_t span = angle1 - angle2;
+    if (span >= ANG180) {
+        return;
+    }
+    rw_angle1 = angle1;
+    angle1 -= r->viewangle;
+    angle2 -= r->viewangle;
+    if (!clip_to_view(&angle1, &angle2, span)) {
+        return;
+    }
+    
+    int x1 = r_view_angle_to_x((angle1 + ANG90) >> ANGLETOFINESHIFT);
+    int x2 = r_view_angle_to_x((angle2 + ANG90) >> ANGLETOFINESHIFT);
+    if (x1 == x2) {
+        return;
+    }
+    
+    if (seg->back_sector == LEVEL_NONE) {
+        clip_solid_wall_segment(x1, x2 - 1);
+        return;
+    }
+    
+    const level_sector_state_t *front = &level->sector_state[seg->front_sector];
+    const level_sector_state_t *back = &level->sector_state[seg->back_sector];
+    
+    // Closed door
+    if (back->ceiling_height <= front->floor_height || back->floor_height >= front->ceiling_height) {
+        clip_solid_wall_segment(x1, x2 - 1);
+        return;
+    }
+    
+    // Identical sectors on both sides with nothing drawn on the line: skip
+    if (back->ceiling_height == front->ceiling_height && back->floor_height == front->floor_height &&
+        back->ceiling_flat == front->ceiling_flat && back->floor_flat == front->floor_flat &&
+        back->light == front->light) {
+        const level_line_t *line = &level->lines[seg->line];
+        fixed_t offset;
+        int top, bottom, mid;
+        side_textures(&level->sides[line->side[seg->side]], &offset, &top, &bottom, &mid);
+        if (mid == 0) {
+            return;
+        }
+    }
+    
+    clip_pass_wall_segment(x1, x2 - 1);
+}
+
+/**
+ * Check whether any part of a bounding box can be visible (R_CheckBBox)
+ */
+static bool check_bbox(const fixed_t *bbox) {
+    // Corners to test, by the view's position relative to the box
+    static const uint8_t checkcoord[12][4] = {
+        {3, 0, 2, 1}, {3, 0, 2, 0}, {3, 1, 2, 0}, {0, 0, 0, 0},
+        {2, 0, 2, 1}, {0, 0, 0, 0}, {3, 1, 3, 0}, {0, 0, 0, 0},
+        {2, 0, 3, 1}, {2, 1, 3, 1}, {2, 1, 3, 0}, {0, 0, 0, 0}
+    };
+    
+    int boxx, boxy;
+    if (r->viewx <= bbox[LEVEL_BOXLEFT]) {
+        boxx = 0;
+    } else if (r->viewx < bbox[LEVEL_BOXRIGHT]) {
+        boxx = 1;
+    } else {
+        boxx = 2;
+    }
+    if (r->viewy >= bbox[LEVEL_BOXTOP]) {
+        boxy = 0;
+    } else if (r->viewy > bbox[LEVEL_BOXBOTTOM]) {
+        boxy = 1;
+    } else {
+        boxy = 2;
+    }
+    
+    int boxpos = (boxy << 2) + boxx;
+    if (boxpos == 5) {
+        return true;    // Inside the box
+    }
+    
+    const uint8_t *coord = checkcoord[boxpos];
+    angle_t angle1 = r_point_to_angle(bbox[coord[0]], bbox[coord[1]]) - r->viewangle;
+    angle_t angle2 = r_point_to_angle(bbox[coord[2]], bbox[coord[3]]) - r->viewangle;
+    angle_t span = angle1 - angle2;
+    if (span >= ANG180) {
+        return true;    // Sitting on a line
+    }
+    if (!clip_to_view(&angle1, &angle2, span)) {
+        return false;
+    }
+    
+    int sx1 = r_view_angle_to_x((angle1 + ANG90) >> ANGLETOFINESHIFT);
+    int sx2 = r_view_angle_to_x((angle2 + ANG90) >> ANGLETOFINESHIFT);
+    if (sx1 == sx2) {
+        return false;
+    }
+    sx2--;
+    
+    // Hidden if one solid range covers it
+    const r_cliprange_t *start = r->solidsegs;
+    while (start->last < sx2) {
+        start++;
+    }
+    return !(sx1 >= start->first && sx2 <= start->last);
+}
+
+/**
+ * Add a subsector's sprites and segs (R_Subsector)
+ */
+static void render_subsector(int num) {
+    const level_subsector_t *sub = &r->level->subsectors[num];
+    r->stats.subsectors++;
+    r_add_sprites(sub->sector);
+    
+    const level_seg_t *seg = &r->level->segs[sub->first_seg];
+    for (uint32_t i = 0; i < sub->num_segs; i++) {
+        add_line(seg + i);
+    }
+}
+
+/**
+ * Walk a BSP subtree front to back (R_RenderBSPNode)
+ */
+static void render_node(uint32_t bspnum) {
+    while (!(bspnum & LEVEL_SUBSECTOR)) {
+        const level_node_t *node = &r->level->nodes[bspnum];
+        r->stats.nodes++;
+        
+        // Near side first, then the far side if its box can show
+        int side = r_point_on_side(r->viewx, r->viewy, node);
+        render_node(node->children[side]);
+        if (!check_bbox(node->bbox[side ^ 1])) {
+            return;
+        }
+        bspnum = node->children[side ^ 1];
+    }
+    render_subsector(bspnum & ~LEVEL_SUBSECTOR);
+}
+
+void r_render_bsp(void) {
+    // Sentinels beyond both screen edges
+    r->solidsegs[0].first = -0x7FFF;
+    r->solidsegs[0].last = -1;
+    r->solidsegs[1].first = R_WIDTH;
+    r->solidsegs[1].last = 0x7FFF;
+    r->num_solidsegs = 2;
+    
+    if (r->level->header->num_nodes == 0) {
+        render_subsector(0);
+    } else {
+        render_node(r->level->header->num_nodes - 1);
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * Column and plane drawers (Doom's r_draw.c)
+ * The inner loops. With PICO_DOOM_INTERP each core's interpolators do
+ * the texture addressing: interp0 steps a column's 16.16 texture
+ * coordinate and masks it to the texture height, interp1 turns a flat's
+ * (u, v) into a texel address. Each read of the result register is one
+ * bus access, replacing the shift, mask and add of the plain C loop.
+ * Host builds (and PICO_DOOM_INTERP=0) use the plain C loops, which
+ * produce the same pixels.
+ */
+
+#include "r_local.h"
+
+#ifndef PICO_DOOM_INTERP
+#define PICO_DOOM_INTERP 0
+#endif
+
+#if PICO_DOOM_INTERP
+#include "hardware/interp.h"
+#endif
+
+#define FLATBITS            6       // Flats are 64x64
+
+/**
+ * Column with a power-of-two texture height: the coordinate wraps by mask
+ */
+static void draw_column_pow2(uint8_t *dest, int ys, int count, const uint8_t *source, int bits,
+                             fixed_t frac, fixed_t fracstep, const uint8_t *colormap) {
+#if PICO_DOOM_INTERP
+    // Lane 0 accumulates frac; the full result is source + (frac >> 16 & mask)
+    interp_config cfg = interp_default_config();
+    interp_config_set_add_raw(&cfg, true);
+    interp_config_set_shift(&cfg, FRACBITS);
+    interp_config_set_mask(&cfg, 0, bits - 1);
+    interp_set_config(interp0, 0, &cfg);
+    interp_config zero = interp_default_config();
+    interp_config_set_mask(&zero, 0, 0);
+    interp_set_config(interp0, 1, &zero);
+    interp0->accum[0] = frac;
+    interp0->base[0] = fracstep;
+    interp0->accum[1] = 0;
+    interp0->base[1] = 0;
+    interp0->base[2] = (uintptr_t)source;
+    do {
+        *dest = colormap[*(const uint8_t *)interp0->pop[2]];
+        dest += ys;
+    } while (--count);
+#else
+    unsigned mask = (1u << bits) - 1;
+    do {
+        *dest = colormap[source[(frac >> FRACBITS) & mask]];
+        dest += ys;
+        frac += fracstep;
+    } while (--count);
+#endif
+}
+
+void r_draw_column(uint8_t *dest, int ys, int count, const uint8_t *source, int height,
+                   fixed_t frac, fixed_t fracstep, const uint8_t *colormap) {
+    if (count <= 0 || height <= 0) {
+        return;
+    }
+    if (height > 1 && (height & (height - 1)) == 0) {
+        draw_column_pow2(dest, ys, count, source, __builtin_ctz(height), frac, fracstep, colormap);
+        return;
+    }
+    
+    // Other heights wrap at the texture's own height (Doom masks to 128,
+    // which repeats garbage below short textures)
+    fixed_t limit = height << FRACBITS;
+    frac %= limit;
+    if (frac < 0) {
+        frac += limit;
+    }
+    if (fracstep >= limit) {
+        fracstep %= limit;
+    }
+    do {
+        *dest = colormap[source[frac >> FRACBITS]];
+        dest += ys;
+        frac += fracstep;
+        if (frac >= limit) {
+            frac -= limit;
+        }
+    } while (--count);
+}
+
+void r_draw_masked_column(uint8_t *dest, int ys, int count, const uint8_t *source, int height,
+                          fixed_t frac, fixed_t fracstep, const uint8_t *colormap, bool holes) {
+    // No wrapping: rows outside the texture are left alone, and with holes
+    // set so are texels of index 0 (TEXCOLS stores uncovered pixels as 0)
+    while (count-- > 0) {
+        uint32_t v = (uint32_t)(frac >> FRACBITS);
+        if (v < (uint32_t)height) {
+            uint8_t texel = source[v];
+            if (texel || !holes) {
+                *dest = colormap[texel];
+            }
+        }
+        dest += ys;
+        frac += fracstep;
+    }
+}
+
+void r_draw_plane_column(uint8_t *dest, int ys, int y1, int y2, const uint8_t *flat,
+                         fixed_t planeheight, int light, int x) {
+    // Ray direction of this column, pre-scaled by the distance correction,
+    // and by the plane height so each row needs one multiply per axis
+    unsigned angle = (r->viewangle + r->xtoviewangle[x]) >> ANGLETOFINESHIFT;
+    fixed_t hx = FixedMul(planeheight, FixedMul(finecosine(angle), r->distscale[x]));
+    fixed_t hy = FixedMul(planeheight, FixedMul(finesine(angle), r->distscale[x]));
+    const uint8_t *zlight = r->zlight[light];
+    const uint8_t *colormaps = r->colormaps;
+    fixed_t viewx = r->viewx;
+    fixed_t viewy = -r->viewy;
+
+#if PICO_DOOM_INTERP
+    // Full result: flat + (u >> 16 & 63) + (v >> 10 & 63 * 64)
+    interp_config cfg = interp_default_config();
+    interp_config_set_shift(&cfg, FRACBITS);
+    interp_config_set_mask(&cfg, 0, FLATBITS - 1);
+    interp_set_config(interp1, 0, &cfg);
+    cfg = interp_default_config();
+    interp_config_set_shift(&cfg, FRACBITS - FLATBITS);
+    interp_config_set_mask(&cfg, FLATBITS, 2 * FLATBITS - 1);
+    interp_set_config(interp1, 1, &cfg);
+    interp1->base[0] = 0;
+    interp1->base[1] = 0;
+    interp1->base[2] = (uintptr_t)flat;
+#endif
+
+    dest += y1 * ys;
+    for (int y = y1; y <= y2; y++) {
+        fixed_t slope = r->yslope[y];
+        fixed_t u = viewx + FixedMul(slope, hx);
+        fixed_t v = viewy - FixedMul(slope, hy);
+        
+        // Distance sets the light: planeheight * yslope
+        unsigned index = (unsigned)FixedMul(planeheight, slope) >> LIGHTZSHIFT;
+        const uint8_t *colormap = colormaps + zlight[index < MAXLIGHTZ ? index : MAXLIGHTZ - 1] * 256;
+
+#if PICO_DOOM_INTERP
+        interp1->accum[0] = u;
+        interp1->accum[1] = v;
+        *dest = colormap[*(const uint8_t *)interp1->peek[2]];
+#else
+        int spot = ((v >> (FRACBITS - FLATBITS)) & (63 * 64)) + ((u >> FRACBITS) & 63);
+        *dest = colormap[flat[spot]];
+#endif
+        dest += ys;
+    }
+}
@@ -0,0 +1,442 @@
+/**
+ * Renderer setup, view tables and geometry helpers (Doom's r_main.c)
+ */
+
+#include "r_local.h"
+#include "z_zone.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIELDOFVIEW         2048        // Fine angles: 90 degrees
+
+r_state_t *r = NULL;
+
+static fixed_t focallength;
+
+/**
+ * Screen column of a fine view angle, before the fencepost fix
+ * (Doom's viewangletox table, computed on demand instead of stored)
+ */
+static int angle_to_x_raw(unsigned fine) {
+    fixed_t t = finetangent(fine);
+    if (t > FRACUNIT * 2) {
+        return -1;
+    }
+    if (t < -FRACUNIT * 2) {
+        return R_WIDTH + 1;
+    }
+    t = FixedMul(t, focallength);
+    int x = (CENTERX * FRACUNIT - t + FRACUNIT - 1) >> FRACBITS;
+    if (x < -1) {
+        return -1;
+    }
+    return x > R_WIDTH + 1 ? R_WIDTH + 1 : x;
+}
+
+int r_view_angle_to_x(unsigned fine) {
+    int x = angle_to_x_raw(fine);
+    if (x == -1) {
+        return 0;
+    }
+    return x == R_WIDTH + 1 ? R_WIDTH : x;
+}
+
+/**
+ * Build the view tables (R_InitTextureMapping, R_ExecuteSetViewSize,
+ * R_InitLightTables) for the fixed 320x200 window
+ */
+static void init_view_tables(void) {
+    focallength = FixedDiv(CENTERX * FRACUNIT, finetangent(FINEANGLES / 4 + FIELDOFVIEW / 2));
+    
+    // xtoviewangle: the first fine angle whose column is at or left of x;
+    // columns fall as the angle grows, so a binary search finds it
+    for (int x = 0; x <= R_WIDTH; x++) {
+        unsigned lo = 0;
+        unsigned hi = FINEANGLES / 2;
+        while (lo < hi) {
+            unsigned mid = (lo + hi) / 2;
+            if (angle_to_x_raw(mid) > x) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        r->xtoviewangle[x] = (lo << ANGLETOFINESHIFT) - ANG90;
+    }
+    r->clipangle = r->xtoviewangle[0];
+    
+    for (int x = 0; x < R_WIDTH; x++) {
+        fixed_t cosadj = finecosine(r->xtoviewangle[x] >> ANGLETOFINESHIFT);
+        r->distscale[x] = FixedDiv(FRACUNIT, cosadj < 0 ? -cosadj : cosadj);
+    }
+    
+    for (int y = 0; y < R_HEIGHT; y++) {
+        fixed_t dy = ((y - CENTERY) << FRACBITS) + FRACUNIT / 2;
+        r->yslope[y] = FixedDiv(CENTERX * FRACUNIT, dy < 0 ? -dy : dy);
+    }
+    
+    for (int i = 0; i < LIGHTLEVELS; i++) {
+        int startmap = ((LIGHTLEVELS - 1 - i) * 2) * NUMCOLORMAPS / LIGHTLEVELS;
+        for (int j = 0; j < MAXLIGHTZ; j++) {
+            int scale = FixedDiv(CENTERX * FRACUNIT, (j + 1) << LIGHTZSHIFT) >> LIGHTSCALESHIFT;
+            int level = startmap - scale / DISTMAP;
+            if (level < 0) {
+                level = 0;
+            } else if (level >= NUMCOLORMAPS) {
+                level = NUMCOLORMAPS - 1;
+            }
+            r->zlight[i][j] = (uint8_t)level;
+        }
+    }
+}
+
+bool r_init(void) {
+    if (!r) {
+        r = (r_state_t *)Z_Malloc(sizeof(r_state_t), PU_STATIC, NULL);
+        if (!r) {
+            printf("Error: Out of memory for renderer state (%u bytes)\n", (unsigned)sizeof(r_state_t));
+            return false;
+        }
+    }
+    memset(r, 0, sizeof(*r));
+    init_view_tables();
+    printf("Renderer: %u bytes of state, %d drawsegs, %d sprites\n",
+           (unsigned)sizeof(r_state_t), MAXDRAWSEGS, MAXVISSPRITES);
+    return true;
+}
+
+angle_t r_point_to_angle(fixed_t x, fixed_t y) {
+    x -= r->viewx;
+    y -= r->viewy;
+    if (!x && !y) {
+        return 0;
+    }
+    
+    // Doom's R_PointToAngle: fold into an octant and look up the slope
+    if (x >= 0) {
+        if (y >= 0) {
+            if (x > y) {
+                return tantoangle[slope_div(y, x)];
+            }
+            return ANG90 - 1 - tantoangle[slope_div(x, y)];
+        }
+        y = -y;
+        if (x > y) {
+            return -tantoangle[slope_div(y, x)];
+        }
+        return ANG270 + tantoangle[slope_div(x, y)];
+    }
+    x = -x;
+    if (y >= 0) {
+        if (x > y) {
+            return ANG180 - 1 - tantoangle[slope_div(y, x)];
+        }
+        return ANG90 + tantoangle[slope_div(x, y)];
+    }
+    y = -y;
+    if (x > y) {
+        return ANG180 + tantoangle[slope_div(y, x)];
+    }
+    return ANG270 - 1 - tantoangle[slope_div(x, y)];
+}
+
+fixed_t r_point_to_dist(fixed_t x, fixed_t y) {
+    fixed_t dx = x - r->viewx;
+    fixed_t dy = y - r->viewy;
+    dx = dx < 0 ? -dx : dx;
+    dy = dy < 0 ? -dy : dy;
+    if (dy > dx) {
+        fixed_t temp = dx;
+        dx = dy;
+        dy = temp;
+    }
+    if (dx == 0) {
+        return 0;
+    }
+    
+    unsigned angle = (tantoangle[FixedDiv(dy, dx) >> DBITS] + ANG90) >> ANGLETOFINESHIFT;
+    return FixedDiv(dx, finesine(angle));
+}
+
+/**
+ * Side of a partition line a point is on (0 = front, 1 = back)
+ * Shared by nodes and segs (Doom's R_PointOnSide/R_PointOnSegSide)
+ */
+static int point_on_line_side(fixed_t x, fixed_t y, fixed_t lx, fixed_t ly, fixed_t ldx, fixed_t ldy) {
+    if (!ldx) {
+        if (x <= lx) {
+            return ldy > 0;
+        }
+        return ldy < 0;
+    }
+    if (!ldy) {
+        if (y <= ly) {
+            return ldx < 0;
+        }
+        return ldx > 0;
+    }
+    
+    fixed_t dx = x - lx;
+    fixed_t dy = y - ly;
+    
+    // Sign bits alone decide most cases
+    if ((ldy ^ ldx ^ dx ^ dy) & 0x80000000) {
+        return ((ldy ^ dx) & 0x80000000) ? 1 : 0;
+    }
+    
+    fixed_t left = FixedMul(ldy >> FRACBITS, dx);
+    fixed_t right = FixedMul(dy, ldx >> FRACBITS);
+    return right < left ? 0 : 1;
+}
+
+int r_point_on_side(fixed_t x, fixed_t y, const level_node_t *node) {
+    return point_on_line_side(x, y, node->x, node->y, node->dx, node->dy);
+}
+
+int r_point_on_seg_side(fixed_t x, fixed_t y, const level_seg_t *seg) {
+    const level_vertex_t *v1 = &r->level->vertexes[seg->v1];
+    const level_vertex_t *v2 = &r->level->vertexes[seg->v2];
+    return point_on_line_side(x, y, v1->x, v1->y, v2->x - v1->x, v2->y - v1->y);
+}
+
+int r_point_sector(const level_t *level, fixed_t x, fixed_t y) {
+    if (level->header->num_nodes == 0) {
+        return level->subsectors[0].sector;
+    }
+    
+    uint32_t nodenum = level->header->num_nodes - 1;
+    while (!(nodenum & LEVEL_SUBSECTOR)) {
+        const level_node_t *node = &level->nodes[nodenum];
+        nodenum = node->children[r_point_on_side(x, y, node)];
+    }
+    return level->subsectors[nodenum & ~LEVEL_SUBSECTOR].sector;
+}
+
+/**
+ * Get a flat or sprite patch for this frame (core 0)
+ * Raw lumps are read in place. Compressed ones are held at LEVEL until
+ * r_finish_frame(), so the draw lists can point into them.
+ * Returns NULL (counted in stats.missing) if the cache cannot hold it
+ */
+const uint8_t* r_frame_lump(int lump) {
+    if (!wad_set_lump_is_compressed(r->set, lump)) {
+        return wad_set_lump_data(r->set, lump);
+    }
+    
+    bool held = false;
+    for (int i = 0; i < r->num_frame_lumps && !held; i++) {
+        held = (r->frame_lumps[i] == lump);
+    }
+    if (!held && r->num_frame_lumps == MAXFRAMELUMPS) {
+        r->stats.missing++;
+        return NULL;
+    }
+    const uint8_t *data = wad_set_cache_lump(r->set, lump, LUMP_CACHE_LEVEL);
+    if (!data) {
+        r->stats.missing++;
+    } else if (!held) {
+        r->frame_lumps[r->num_frame_lumps++] = (uint16_t)lump;
+    }
+    return data;
+}
+
+void r_finish_frame(void) {
+    if (!r || r->num_frame_lumps == 0) {
+        return;
+    }
+    for (int i = 0; i < r->num_frame_lumps; i++) {
+        wad_set_change_tag(r->set, r->frame_lumps[i], LUMP_CACHE_PURGELEVEL);
+    }
+    r->num_frame_lumps = 0;
+    
+    // Released flats may move on the next miss; raw ones are looked up
+    // again too, which is only an index lookup
+    if (r->flat_data) {
+        memset(r->flat_data, 0, r->num_flats * sizeof(*r->flat_data));
+    }
+}
+
+const uint8_t* r_flat_data(int flat) {
+    if (flat < 0 || (uint32_t)flat >= r->num_flats) {
+        return NULL;
+    }
+    if (!r->flat_data[flat]) {
+        uint32_t count;
+        int lump = wad_set_namespace(r->set, WAD_NS_FLATS, &count)[flat];
+        if (wad_set_lump(r->set, lump)->size < 64 * 64) {
+            return NULL;
+        }
+        r->flat_data[flat] = r_frame_lump(lump);
+    }
+    return r->flat_data[flat];
+}
+
+bool r_set_level(const level_t *level, const wad_set_t *set,
+                 const tex_columns_t *textures, const char *sky) {
+    if (!r) {
+        return false;
+    }
+    r_clear_level();
+    r->set = set;
+    r->textures = textures;
+    
+    int lump = wad_set_find(set, "COLORMAP");
+    if (lump < 0 || wad_set_lump(set, lump)->size < NUMCOLORMAPS * 256) {
+        printf("Error: No usable COLORMAP\n");
+        return false;
+    }
+    r->colormaps = wad_set_cache_lump(set, lump, LUMP_CACHE_STATIC);
+    if (!r->colormaps) {
+        return false;
+    }
+    
+    r->sky_texture = textures ? tex_columns_find(textures, sky) : -1;
+    r->sky_flat = wad_set_find_in(set, WAD_NS_FLATS, "F_SKY1");
+    wad_set_namespace(set, WAD_NS_FLATS, &r->num_flats);
+    
+    // Per-level tables, dropped with the level arena
+    const level_header_t *h = level->header;
+    r->flat_data = (const uint8_t **)Z_Malloc(r->num_flats * sizeof(*r->flat_data), PU_LEVEL, NULL);
+    r->sprite_lumps = (uint16_t (*)[8])Z_Malloc(r_num_sprite_types() * sizeof(*r->sprite_lumps), PU_LEVEL, NULL);
+    r->thing_sprite = (uint8_t *)Z_Malloc(h->num_things, PU_LEVEL, NULL);
+    r->thing_next = (uint16_t *)Z_Malloc(h->num_things * sizeof(uint16_t), PU_LEVEL, NULL);
+    r->sector_things = (uint16_t *)Z_Malloc(h->num_sectors * sizeof(uint16_t), PU_LEVEL, NULL);
+    r->sector_seen = (uint8_t *)Z_Malloc(h->num_sectors, PU_LEVEL, NULL);
+    if ((r->num_flats && !r->flat_data) || !r->sprite_lumps || (h->num_things && (!r->thing_sprite || !r->thing_next)) ||
+        !r->sector_things || !r->sector_seen) {
+        printf("Error: Out of memory for renderer level tables\n");
+        return false;
+    }
+    memset(r->flat_data, 0, r->num_flats * sizeof(*r->flat_data));
+    memset(r->sprite_lumps, 0, r_num_sprite_types() * sizeof(*r->sprite_lumps));
+    memset(r->sector_things, 0xFF, h->num_sectors * sizeof(uint16_t));
+    
+    // Link things into their sectors (P_SetThingPosition) and pick their
+    // sprites once, rather than on every frame
+    for (uint32_t i = 0; i < h->num_things; i++) {
+        const level_thing_t *thing = &level->things[i];
+        int sector = r_point_sector(level, thing->x << FRACBITS, thing->y << FRACBITS);
+        r->thing_sprite[i] = (uint8_t)r_sprite_type(thing->type);
+        r->thing_next[i] = r->sector_things[sector];
+        r->sector_things[sector] = (uint16_t)i;
+    }
+    
+    r->prefetch_next = 0;
+    r->level = level;
+    return true;
+}
+
+/**
+ * Queue one flat for r_prefetch_level()
+ */
+static bool prefetch_flat(int flat) {
+    if (flat < 0 || (uint32_t)flat >= r->num_flats || flat == r->sky_flat || r->flat_data[flat]) {
+        return true;
+    }
+    uint32_t count;
+    int lump = wad_set_namespace(r->set, WAD_NS_FLATS, &count)[flat];
+    if (wad_set_lump(r->set, lump)->size < 64 * 64) {
+        return true;
+    }
+    return wad_set_prefetch_lump(r->set, lump, LUMP_CACHE_PURGELEVEL);
+}
+
+bool r_prefetch_level(void) {
+    if (!r || !r->level) {
+        return false;
+    }
+    
+    // Two flats per sector, then eight rotations per thing; lumps already
+    // cached or queued are skipped by the cache itself
+    const level_header_t *h = r->level->header;
+    uint32_t num_flat_items = h->num_sectors * 2;
+    uint32_t num_items = num_flat_items + h->num_things * 8;
+    
+    // Prefetches are PURGELEVEL (the first real lookup raises them to
+    // LEVEL) and stop at three quarters of the budget, so they neither
+    // crowd out the frame's CACHE lookups nor evict each other
+    lump_cache_stats_t stats;
+    lump_cache_get_stats(&stats);
+    if (stats.used_bytes >= stats.budget_bytes / 4 * 3) {
+        r->prefetch_next = num_items;
+    }
+    
+    while (r->prefetch_next < num_items) {
+        uint32_t item = r->prefetch_next;
+        bool queued;
+        if (item < num_flat_items) {
+            const level_sector_state_t *sector = &r->level->sector_state[item / 2];
+            queued = prefetch_flat((item & 1) ? sector->ceiling_flat : sector->floor_flat);
+        } else {
+            item -= num_flat_items;
+            int type = r->thing_sprite[item / 8];
+            queued = type == R_NOSPRITE || r_prefetch_sprite(type, item % 8 + 1);
+        }
+        if (!queued) {
+            // Every decoder busy: pick up here next time. Refused with
+            // nothing in flight means no room at all, so give up.
+            lump_cache_get_stats(&stats);
+            if (stats.pending == 0) {
+                r->prefetch_next = num_items;
+                return false;
+            }
+            return true;
+        }
+        r->prefetch_next++;
+    }
+    return false;
+}
+
+const char* r_sky_name(const char *map) {
+    static const char *skies[] = {"SKY1", "SKY2", "SKY3", "SKY4"};
+    if (map[0] == 'E' && map[2] == 'M') {
+        int episode = map[1] - '1';
+        return episode >= 0 && episode < 4 ? skies[episode] : skies[0];
+    }
+    int number = atoi(map + 3);
+    return skies[number < 12 ? 0 : number < 21 ? 1 : 2];
+}
+
+void r_clear_level(void) {
+    if (r) {
+        r_finish_frame();
+        r->level = NULL;
+        r->num_drawsegs = 0;
+        r->num_vissprites = 0;
+        r->num_masked = 0;
+    }
+}
+
+void r_setup_frame(const r_view_t *view) {
+    if (!r || !r->level) {
+        return;
+    }
+    r->viewx = view->x;
+    r->viewy = view->y;
+    r->viewz = view->z;
+    r->viewangle = view->angle;
+    r->viewsin = finesine(view->angle >> ANGLETOFINESHIFT);
+    r->viewcos = finecosine(view->angle >> ANGLETOFINESHIFT);
+    
+    r_finish_frame();
+    r->num_drawsegs = 0;
+    r->num_vissprites = 0;
+    r->num_masked = 0;
+    memset(&r->stats, 0, sizeof(r->stats));
+    memset(r->sector_seen, 0, r->level->header->num_sectors);
+    
+    r_render_bsp();
+    r_sort_sprites();
+    
+    r->stats.drawsegs = (uint16_t)r->num_drawsegs;
+    r->stats.sprites = (uint16_t)r->num_vissprites;
+}
+
+void r_get_stats(r_stats_t *stats) {
+    if (r) {
+        *stats = r->stats;
+    } else {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
@@ -0,0 +1,207 @@
+/**
+ * Column pass: walls, floors, ceilings and sky (Doom's r_segs.c and
+ * r_plane.c)
+ * Runs on either core for its own range of columns. Drawsegs are taken
+ * in the BSP's front-to-back order, so the per-column clip arrays grow
+ * exactly as in Doom's R_RenderSegLoop. The floor and ceiling rows a
+ * seg uncovers are drawn straight away instead of going into visplanes.
+ */
+
+#include "r_local.h"
+
+#define ANGLETOSKYSHIFT     22
+#define SKYTEXTUREMID       (100 * FRACUNIT)
+#define UNTEXTURED_COLOR    0x60    // Grey, for images packed without TEXCOLS
+
+/**
+ * Draw rows [yl, yh] of a wall column
+ */
+static void wall_column(uint8_t *column, int ys, int yl, int yh, int texture, int texturecolumn,
+                        fixed_t texturemid, fixed_t iscale, const uint8_t *colormap) {
+    if (yl > yh) {
+        return;
+    }
+    uint8_t *dest = column + yl * ys;
+    int count = yh - yl + 1;
+    
+    const tex_columns_t *textures = r->textures;
+    if (!textures || texture < 0 || (uint32_t)texture >= textures->num_textures) {
+        uint8_t color = colormap[UNTEXTURED_COLOR];
+        do {
+            *dest = color;
+            dest += ys;
+        } while (--count);
+        return;
+    }
+    
+    const uint8_t *source = tex_columns_get(textures, texture, texturecolumn);
+    fixed_t frac = texturemid + (yl - CENTERY) * iscale;
+    r_draw_column(dest, ys, count, source, textures->textures[texture].height, frac, iscale, colormap);
+}
+
+/**
+ * Draw rows [y1, y2] of the sky (R_DrawPlanes, sky case)
+ */
+static void sky_column(uint8_t *column, int ys, int y1, int y2, int x) {
+    uint8_t *dest = column + y1 * ys;
+    int count = y2 - y1 + 1;
+    const tex_columns_t *textures = r->textures;
+    if (r->sky_texture < 0) {
+        do {
+            *dest = 0;
+            dest += ys;
+        } while (--count);
+        return;
+    }
+    
+    // The sky does not change with distance: full bright, one texel per row
+    int angle = (r->viewangle + r->xtoviewangle[x]) >> ANGLETOSKYSHIFT;
+    const uint8_t *source = tex_columns_get(textures, r->sky_texture, angle);
+    fixed_t frac = SKYTEXTUREMID + (y1 - CENTERY) * FRACUNIT;
+    r_draw_column(dest, ys, count, source, textures->textures[r->sky_texture].height,
+                  frac, FRACUNIT, r->colormaps);
+}
+
+/**
+ * Draw one seg's columns [x1, x2] (R_RenderSegLoop)
+ */
+static void render_seg_columns(const r_drawseg_t *ds, int x1, int x2, uint8_t *data, int xs, int ys) {
+    const level_t *level = r->level;
+    const level_sector_state_t *front = &level->sector_state[level->segs[ds->seg].front_sector];
+    bool markfloor = (ds->flags & DS_MARKFLOOR) != 0;
+    bool markceiling = (ds->flags & DS_MARKCEILING) != 0;
+    bool sky = (ds->flags & DS_SKY) != 0;
+    
+    // Plane parameters, shared by every column of the seg
+    const uint8_t *floor_flat = markfloor ? r_flat_cached(front->floor_flat) : NULL;
+    const uint8_t *ceiling_flat = markceiling && !sky ? r_flat_cached(front->ceiling_flat) : NULL;
+    fixed_t floor_height = front->floor_height - r->viewz;
+    fixed_t ceiling_height = front->ceiling_height - r->viewz;
+    floor_height = floor_height < 0 ? -floor_height : floor_height;
+    ceiling_height = ceiling_height < 0 ? -ceiling_height : ceiling_height;
+    int plane_light = r_sector_light(front->light);
+    
+    const fixed_t centeryfrac = CENTERY << (FRACBITS - 4);
+    
+    for (int x = x1; x <= x2; x++) {
+        uint8_t *column = &data[x * xs];
+        int16_t *ceilingclip = &r->ceilingclip[x];
+        int16_t *floorclip = &r->floorclip[x];
+        fixed_t scale = ds->scale1 + (x - ds->x1) * ds->scalestep;
+        
+        // Visible part of the opening
+        fixed_t topfrac = centeryfrac - FixedMul(ds->worldtop, scale);
+        fixed_t bottomfrac = centeryfrac - FixedMul(ds->worldbottom, scale);
+        int yl = (topfrac + HEIGHTUNIT - 1) >> HEIGHTBITS;
+        if (yl < *ceilingclip + 1) {
+            yl = *ceilingclip + 1;
+        }
+        
+        if (markceiling) {
+            int top = *ceilingclip + 1;
+            int bottom = yl - 1;
+            if (bottom >= *floorclip) {
+                bottom = *floorclip - 1;
+            }
+            if (top <= bottom) {
+                if (sky) {
+                    sky_column(column, ys, top, bottom, x);
+                } else if (ceiling_flat) {
+                    r_draw_plane_column(column, ys, top, bottom, ceiling_flat, ceiling_height, plane_light, x);
+                }
+            }
+        }
+        
+        int yh = bottomfrac >> HEIGHTBITS;
+        if (yh >= *floorclip) {
+            yh = *floorclip - 1;
+        }
+        
+        if (markfloor) {
+            int top = yh + 1;
+            int bottom = *floorclip - 1;
+            if (top <= *ceilingclip) {
+                top = *ceilingclip + 1;
+            }
+            if (top <= bottom && floor_flat) {
+                r_draw_plane_column(column, ys, top, bottom, floor_flat, floor_height, plane_light, x);
+            }
+        }
+        
+        int texturecolumn = 0;
+        fixed_t iscale = 0;
+        const uint8_t *colormap = r->colormaps;
+        if (ds->flags & DS_TEXTURED) {
+            unsigned angle = (ds->centerangle + r->xtoviewangle[x]) >> ANGLETOFINESHIFT;
+            texturecolumn = (ds->offset - FixedMul(finetangent(angle), ds->distance)) >> FRACBITS;
+            colormap = r->colormaps + r_scale_light(ds->light, scale) * 256;
+            iscale = (fixed_t)FixedRecip(scale);
+        }
+        
+        if (ds->flags & DS_SOLID) {
+            wall_column(column, ys, yl, yh, ds->midtexture, texturecolumn, ds->midtexturemid, iscale, colormap);
+            *ceilingclip = R_HEIGHT;
+            *floorclip = -1;
+            continue;
+        }
+        
+        // Two-sided: upper and lower walls around the opening
+        if (ds->toptexture) {
+            int mid = (centeryfrac - FixedMul(ds->worldhigh, scale)) >> HEIGHTBITS;
+            if (mid >= *floorclip) {
+                mid = *floorclip - 1;
+            }
+            if (mid >= yl) {
+                wall_column(column, ys, yl, mid, ds->toptexture, texturecolumn, ds->toptexturemid, iscale, colormap);
+                *ceilingclip = (int16_t)mid;
+            } else {
+                *ceilingclip = (int16_t)(yl - 1);
+            }
+        } else if (markceiling) {
+            *ceilingclip = (int16_t)(yl - 1);
+        }
+        
+        if (ds->bottomtexture) {
+            int mid = (centeryfrac - FixedMul(ds->worldlow, scale) + HEIGHTUNIT - 1) >> HEIGHTBITS;
+            if (mid <= *ceilingclip) {
+                mid = *ceilingclip + 1;
+            }
+            if (mid <= yh) {
+                wall_column(column, ys, mid, yh, ds->bottomtexture, texturecolumn, ds->bottomtexturemid, iscale, colormap);
+                *floorclip = (int16_t)mid;
+            } else {
+                *floorclip = (int16_t)(yh + 1);
+            }
+        } else if (markfloor) {
+            *floorclip = (int16_t)(yh + 1);
+        }
+    }
+}
+
+void r_draw_columns(uint8_t *data, int xs, int ys, int x0, int x1) {
+    if (!r || !r->level) {
+        return;
+    }
+    if (x0 < 0) {
+        x0 = 0;
+    }
+    if (x1 > R_WIDTH) {
+        x1 = R_WIDTH;
+    }
+    
+    for (int x = x0; x < x1; x++) {
+        r->ceilingclip[x] = -1;
+        r->floorclip[x] = R_HEIGHT;
+    }
+    
+    for (int i = 0; i < r->num_drawsegs; i++) {
+        const r_drawseg_t *ds = &r->drawsegs[i];
+        int a = ds->x1 > x0 ? ds->x1 : x0;
+        int b = ds->x2 < x1 - 1 ? ds->x2 : x1 - 1;
+        if (a <= b) {
+            render_seg_columns(ds, a, b, data, xs, ys);
+        }
+    }
+    
+    r_draw_masked(data, xs, ys, x0, x1);
+}
@@ -0,0 +1,960 @@
+/**
+ * Trigonometry tables for the renderer
+ * Generated once (like Doom's tables.c) and kept in flash:
+ *   r_sine_quarter[i]  = FRACUNIT * sin((i + 0.5) * 2pi / FINEANGLES), first quadrant
+ *   r_tangent_half[i]  = FRACUNIT * tan((i + 0.5) * 2pi / FINEANGLES), 0 to 90 degrees
+ *   tantoangle[i]      = atan(i / SLOPERANGE) as a binary angle
+ * The half-sample offset makes both symmetric, so the accessors in
+ * r_tables.h rebuild Doom's full finesine/finetangent from them.
+ */
+
+#include "r_tables.h"
+
+const fixed_t r_sine_quarter[FINEANGLES / 4] = {
+    25, 75, 126, 176, 226, 276, 327, 377,
+    427, 478, 528, 578, 628, 679, 729, 779,
+    829, 880, 930, 980, 1030, 1081, 1131, 1181,
+    1231, 1282, 1332, 1382, 1432, 1483, 1533, 1583,
+    1633, 1684, 1734, 1784, 1834, 1885, 1935, 1985,
+    2035, 2086, 2136, 2186, 2236, 2287, 2337, 2387,
+    2437, 2488, 2538, 2588, 2638, 2688, 2739, 2789,
+    2839, 2889, 2940, 2990, 3040, 3090, 3140, 3191,
+    3241, 3291, 3341, 3391, 3442, 3492, 3542, 3592,
+    3642, 3693, 3743, 3793, 3843, 3893, 3943, 3994,
+    4044, 4094, 4144, 4194, 4244, 4295, 4345, 4395,
+    4445, 4495, 4545, 4596, 4646, 4696, 4746, 4796,
+    4846, 4896, 4946, 4997, 5047, 5097, 5147, 5197,
+    5247, 5297, 5347, 5397, 5448, 5498, 5548, 5598,
+    5648, 5698, 5748, 5798, 5848, 5898, 5948, 5998,
+    6048, 6098, 6148, 6199, 6249, 6299, 6349, 6399,
+    6449, 6499, 6549, 6599, 6649, 6699, 6749, 6799,
+    6849, 6899, 6949, 6999, 7049, 7099, 7149, 7199,
+    7249, 7298, 7348, 7398, 7448, 7498, 7548, 7598,
+    7648, 7698, 7748, 7798, 7848, 7898, 7947, 7997,
+    8047, 8097, 8147, 8197, 8247, 8297, 8346, 8396,
+    8446, 8496, 8546, 8596, 8646, 8695, 8745, 8795,
+    8845, 8895, 8944, 8994, 9044, 9094, 9144, 9193,
+    9243, 9293, 9343, 9392, 9442, 9492, 9542, 9591,
+    9641, 9691, 9740, 9790, 9840, 9890, 9939, 9989,
+    10039, 10088, 10138, 10188, 10237, 10287, 10336, 10386,
+    10436, 10485, 10535, 10585, 10634, 10684, 10733, 10783,
+    10833, 10882, 10932, 10981, 11031, 11080, 11130, 11179,
+    11229, 11278, 11328, 11377, 11427, 11476, 11526, 11575,
+    11625, 11674, 11724, 11773, 11823, 11872, 11922, 11971,
+    12020, 12070, 12119, 12169, 12218, 12267, 12317, 12366,
+    12415, 12465, 12514, 12564, 12613, 12662, 12711, 12761,
+    12810, 12859, 12909, 12958, 13007, 13056, 13106, 13155,
+    13204, 13253, 13303, 13352, 13401, 13450, 13499, 13549,
+    13598, 13647, 13696, 13745, 13794, 13844, 13893, 13942,
+    13991, 14040, 14089, 14138, 14187, 14236, 14285, 14334,
+    14384, 14433, 14482, 14531, 14580, 14629, 14678, 14727,
+    14776, 14825, 14874, 14922, 14971, 15020, 15069, 15118,
+    15167, 15216, 15265, 15314, 15363, 15411, 15460, 15509,
+    15558, 15607, 15656, 15704, 15753, 15802, 15851, 15900,
+    15948, 15997, 16046, 16095, 16143, 16192, 16241, 16289,
+    16338, 16387, 16435, 16484, 16533, 16581, 16630, 16679,
+    16727, 16776, 16824, 16873, 16922, 16970, 17019, 17067,
+    17116, 17164, 17213, 17261, 17310, 17358, 17407, 17455,
+    17504, 17552, 17600, 17649, 17697, 17746, 17794, 17842,
+    17891, 17939, 17987, 18036, 18084, 18132, 18181, 18229,
+    18277, 18325, 18374, 18422, 18470, 18518, 18567, 18615,
+    18663, 18711, 18759, 18808, 18856, 18904, 18952, 19000,
+    19048, 19096, 19144, 19192, 19240, 19288, 19337, 19385,
+    19433, 19481, 19529, 19577, 19624, 19672, 19720, 19768,
+    19816, 19864, 19912, 19960, 20008, 20056, 20103, 20151,
+    20199, 20247, 20295, 20343, 20390, 20438, 20486, 20534,
+    20581, 20629, 20677, 20724, 20772, 20820, 20867, 20915,
+    20963, 21010, 21058, 21106, 21153, 21201, 21248, 21296,
+    21343, 21391, 21438, 21486, 21533, 21581, 21628, 21676,
+    21723, 21771, 21818, 21865, 21913, 21960, 22007, 22055,
+    22102, 22149, 22197, 22244, 22291, 22339, 22386, 22433,
+    22480, 22527, 22575, 22622, 22669, 22716, 22763, 22810,
+    22858, 22905, 22952, 22999, 23046, 23093, 23140, 23187,
+    23234, 23281, 23328, 23375, 23422, 23469, 23516, 23563,
+    23610, 23656, 23703, 23750, 23797, 23844, 23891, 23937,
+    23984, 24031, 24078, 24124, 24171, 24218, 24265, 24311,
+    24358, 24405, 24451, 24498, 24545, 24591, 24638, 24684,
+    24731, 24777, 24824, 24870, 24917, 24963, 25010, 25056,
+    25103, 25149, 25196, 25242, 25288, 25335, 25381, 25427,
+    25474, 25520, 25566, 25613, 25659, 25705, 25751, 25798,
+    25844, 25890, 25936, 25982, 26028, 26075, 26121, 26167,
+    26213, 26259, 26305, 26351, 26397, 26443, 26489, 26535,
+    26581, 26627, 26673, 26719, 26765, 26810, 26856, 26902,
+    26948, 26994, 27040, 27085, 27131, 27177, 27223, 27268,
+    27314, 27360, 27405, 27451, 27497, 27542, 27588, 27633,
+    27679, 27725, 27770, 27816, 27861, 27907, 27952, 27998,
+    28043, 28088, 28134, 28179, 28225, 28270, 28315, 28361,
+    28406, 28451, 28496, 28542, 28587, 28632, 28677, 28723,
+    28768, 28813, 28858, 28903, 28948, 28993, 29038, 29083,
+    29129, 29174, 29219, 29264, 29308, 29353, 29398, 29443,
+    29488, 29533, 29578, 29623, 29668, 29712, 29757, 29802,
+    29847, 29891, 29936, 29981, 30026, 30070, 30115, 30160,
+    30204, 30249, 30293, 30338, 30382, 30427, 30472, 30516,
+    30560, 30605, 30649, 30694, 30738, 30783, 30827, 30871,
+    30916, 30960, 31004, 31049, 31093, 31137, 31181, 31225,
+    31270, 31314, 31358, 31402, 31446, 31490, 31534, 31578,
+    31622, 31666, 31710, 31754, 31798, 31842, 31886, 31930,
+    31974, 32018, 32062, 32106, 32149, 32193, 32237, 32281,
+    32324, 32368, 32412, 32456, 32499, 32543, 32586, 32630,
+    32674, 32717, 32761, 32804, 32848, 32891, 32935, 32978,
+    33022, 33065, 33108, 33152, 33195, 33238, 33282, 33325,
+    33368, 33412, 33455, 33498, 33541, 33584, 33628, 33671,
+    33714, 33757, 33800, 33843, 33886, 33929, 33972, 34015,
+    34058, 34101, 34144, 34187, 34230, 34272, 34315, 34358,
+    34401, 34444, 34486, 34529, 34572, 34615, 34657, 34700,
+    34743, 34785, 34828, 34870, 34913, 34955, 34998, 35040,
+    35083, 35125, 35168, 35210, 35252, 35295, 35337, 35380,
+    35422, 35464, 35506, 35549, 35591, 35633, 35675, 35717,
+    35759, 35802, 35844, 35886, 35928, 35970, 36012, 36054,
+    36096, 36138, 36180, 36222, 36263, 36305, 36347, 36389,
+    36431, 36473, 36514, 36556, 36598, 36639, 36681, 36723,
+    36764, 36806, 36848, 36889, 36931, 36972, 37014, 37055,
+    37097, 37138, 37179, 37221, 37262, 37303, 37345, 37386,
+    37427, 37469, 37510, 37551, 37592, 37633, 37674, 37716,
+    37757, 37798, 37839, 37880, 37921, 37962, 38003, 38044,
+    38085, 38126, 38166, 38207, 38248, 38289, 38330, 38370,
+    38411, 38452, 38493, 38533, 38574, 38615, 38655, 38696,
+    38736, 38777, 38817, 38858, 38898, 38939, 38979, 39020,
+    39060, 39100, 39141, 39181, 39221, 39261, 39302, 39342,
+    39382, 39422, 39462, 39503, 39543, 39583, 39623, 39663,
+    39703, 39743, 39783, 39823, 39863, 39902, 39942, 39982,
+    40022, 40062, 40102, 40141, 40181, 40221, 40260, 40300,
+    40340, 40379, 40419, 40458, 40498, 40537, 40577, 40616,
+    40656, 40695, 40735, 40774, 40813, 40853, 40892, 40931,
+    40970, 41010, 41049, 41088, 41127, 41166, 41205, 41244,
+    41283, 41323, 41362, 41401, 41439, 41478, 41517, 41556,
+    41595, 41634, 41673, 41711, 41750, 41789, 41828, 41866,
+    41905, 41944, 41982, 42021, 42059, 42098, 42136, 42175,
+    42213, 42252, 42290, 42329, 42367, 42405, 42444, 42482,
+    42520, 42558, 42597, 42635, 42673, 42711, 42749, 42787,
+    42825, 42863, 42901, 42939, 42977, 43015, 43053, 43091,
+    43129, 43167, 43205, 43242, 43280, 43318, 43356, 43393,
+    43431, 43469, 43506, 43544, 43581, 43619, 43656, 43694,
+    43731, 43769, 43806, 43843, 43881, 43918, 43955, 43993,
+    44030, 44067, 44104, 44141, 44179, 44216, 44253, 44290,
+    44327, 44364, 44401, 44438, 44475, 44512, 44549, 44585,
+    44622, 44659, 44696, 44733, 44769, 44806, 44843, 44879,
+    44916, 44953, 44989, 45026, 45062, 45099, 45135, 45172,
+    45208, 45244, 45281, 45317, 45353, 45390, 45426, 45462,
+    45498, 45534, 45571, 45607, 45643, 45679, 45715, 45751,
+    45787, 45823, 45859, 45895, 45930, 45966, 46002, 46038,
+    46074, 46109, 46145, 46181, 46216, 46252, 46288, 46323,
+    46359, 46394, 46430, 46465, 46501, 46536, 46571, 46607,
+    46642, 46677, 46713, 46748, 46783, 46818, 46853, 46889,
+    46924, 46959, 46994, 47029, 47064, 47099, 47134, 47169,
+    47204, 47238, 47273, 47308, 47343, 47378, 47412, 47447,
+    47482, 47516, 47551, 47585, 47620, 47654, 47689, 47723,
+    47758, 47792, 47827, 47861, 47895, 47930, 47964, 47998,
+    48032, 48067, 48101, 48135, 48169, 48203, 48237, 48271,
+    48305, 48339, 48373, 48407, 48441, 48474, 48508, 48542,
+    48576, 48610, 48643, 48677, 48711, 48744, 48778, 48811,
+    48845, 48878, 48912, 48945, 48979, 49012, 49045, 49079,
+    49112, 49145, 49179, 49212, 49245, 49278, 49311, 49344,
+    49377, 49410, 49443, 49476, 49509, 49542, 49575, 49608,
+    49641, 49674, 49706, 49739, 49772, 49805, 49837, 49870,
+    49902, 49935, 49968, 50000, 50033, 50065, 50097, 50130,
+    50162, 50195, 50227, 50259, 50291, 50324, 50356, 50388,
+    50420, 50452, 50484, 50516, 50548, 50580, 50612, 50644,
+    50676, 50708, 50740, 50771, 50803, 50835, 50867, 50898,
+    50930, 50962, 50993, 51025, 51056, 51088, 51119, 51151,
+    51182, 51213, 51245, 51276, 51307, 51339, 51370, 51401,
+    51432, 51463, 51495, 51526, 51557, 51588, 51619, 51650,
+    51681, 51711, 51742, 51773, 51804, 51835, 51865, 51896,
+    51927, 51957, 51988, 52019, 52049, 52080, 52110, 52141,
+    52171, 52202, 52232, 52262, 52293, 52323, 52353, 52383,
+    52414, 52444, 52474, 52504, 52534, 52564, 52594, 52624,
+    52654, 52684, 52714, 52744, 52773, 52803, 52833, 52863,
+    52892, 52922, 52952, 52981, 53011, 53040, 53070, 53099,
+    53129, 53158, 53188, 53217, 53246, 53276, 53305, 53334,
+    53363, 53392, 53422, 53451, 53480, 53509, 53538, 53567,
+    53596, 53625, 53653, 53682, 53711, 53740, 53769, 53797,
+    53826, 53855, 53883, 53912, 53941, 53969, 53998, 54026,
+    54054, 54083, 54111, 54140, 54168, 54196, 54224, 54253,
+    54281, 54309, 54337, 54365, 54393, 54421, 54449, 54477,
+    54505, 54533, 54561, 54589, 54617, 54644, 54672, 54700,
+    54727, 54755, 54783, 54810, 54838, 54865, 54893, 54920,
+    54948, 54975, 55002, 55030, 55057, 55084, 55111, 55139,
+    55166, 55193, 55220, 55247, 55274, 55301, 55328, 55355,
+    55382, 55409, 55435, 55462, 55489, 55516, 55542, 55569,
+    55596, 55622, 55649, 55675, 55702, 55728, 55755, 55781,
+    55808, 55834, 55860, 55887, 55913, 55939, 55965, 55991,
+    56017, 56043, 56069, 56095, 56121, 56147, 56173, 56199,
+    56225, 56251, 56277, 56302, 56328, 56354, 56379, 56405,
+    56431, 56456, 56482, 56507, 56533, 56558, 56583, 56609,
+    56634, 56659, 56684, 56710, 56735, 56760, 56785, 56810,
+    56835, 56860, 56885, 56910, 56935, 56960, 56985, 57010,
+    57034, 57059, 57084, 57109, 57133, 57158, 57182, 57207,
+    57231, 57256, 57280, 57305, 57329, 57353, 57378, 57402,
+    57426, 57450, 57475, 57499, 57523, 57547, 57571, 57595,
+    57619, 57643, 57667, 57691, 57714, 57738, 57762, 57786,
+    57809, 57833, 57857, 57880, 57904, 57927, 57951, 57974,
+    57998, 58021, 58045, 58068, 58091, 58114, 58138, 58161,
+    58184, 58207, 58230, 58253, 58276, 58299, 58322, 58345,
+    58368, 58391, 58414, 58436, 58459, 58482, 58504, 58527,
+    58550, 58572, 58595, 58617, 58640, 58662, 58685, 58707,
+    58729, 58751, 58774, 58796, 58818, 58840, 58862, 58885,
+    58907, 58929, 58951, 58972, 58994, 59016, 59038, 59060,
+    59082, 59103, 59125, 59147, 59168, 59190, 59212, 59233,
+    59255, 59276, 59297, 59319, 59340, 59362, 59383, 59404,
+    59425, 59446, 59468, 59489, 59510, 59531, 59552, 59573,
+    59594, 59615, 59635, 59656, 59677, 59698, 59719, 59739,
+    59760, 59781, 59801, 59822, 59842, 59863, 59883, 59903,
+    59924, 59944, 59964, 59985, 60005, 60025, 60045, 60065,
+    60086, 60106, 60126, 60146, 60166, 60185, 60205, 60225,
+    60245, 60265, 60284, 60304, 60324, 60343, 60363, 60383,
+    60402, 60422, 60441, 60460, 60480, 60499, 60518, 60538,
+    60557, 60576, 60595, 60614, 60634, 60653, 60672, 60691,
+    60710, 60728, 60747, 60766, 60785, 60804, 60823, 60841,
+    60860, 60879, 60897, 60916, 60934, 60953, 60971, 60990,
+    61008, 61026, 61045, 61063, 61081, 61099, 61117, 61136,
+    61154, 61172, 61190, 61208, 61226, 61244, 61261, 61279,
+    61297, 61315, 61333, 61350, 61368, 61386, 61403, 61421,
+    61438, 61456, 61473, 61491, 61508, 61525, 61543, 61560,
+    61577, 61594, 61611, 61628, 61646, 61663, 61680, 61697,
+    61713, 61730, 61747, 61764, 61781, 61798, 61814, 61831,
+    61848, 61864, 61881, 61897, 61914, 61930, 61947, 61963,
+    61979, 61996, 62012, 62028, 62045, 62061, 62077, 62093,
+    62109, 62125, 62141, 62157, 62173, 62189, 62205, 62220,
+    62236, 62252, 62268, 62283, 62299, 62314, 62330, 62346,
+    62361, 62376, 62392, 62407, 62423, 62438, 62453, 62468,
+    62483, 62499, 62514, 62529, 62544, 62559, 62574, 62589,
+    62604, 62618, 62633, 62648, 62663, 62677, 62692, 62707,
+    62721, 62736, 62750, 62765, 62779, 62794, 62808, 62822,
+    62837, 62851, 62865, 62879, 62894, 62908, 62922, 62936,
+    62950, 62964, 62978, 62992, 63005, 63019, 63033, 63047,
+    63060, 63074, 63088, 63101, 63115, 63128, 63142, 63155,
+    63169, 63182, 63195, 63209, 63222, 63235, 63248, 63262,
+    63275, 63288, 63301, 63314, 63327, 63340, 63353, 63365,
+    63378, 63391, 63404, 63416, 63429, 63442, 63454, 63467,
+    63479, 63492, 63504, 63517, 63529, 63541, 63554, 63566,
+    63578, 63590, 63602, 63614, 63627, 63639, 63651, 63663,
+    63674, 63686, 63698, 63710, 63722, 63733, 63745, 63757,
+    63768, 63780, 63792, 63803, 63814, 63826, 63837, 63849,
+    63860, 63871, 63882, 63894, 63905, 63916, 63927, 63938,
+    63949, 63960, 63971, 63982, 63993, 64004, 64014, 64025,
+    64036, 64047, 64057, 64068, 64078, 64089, 64099, 64110,
+    64120, 64131, 64141, 64151, 64161, 64172, 64182, 64192,
+    64202, 64212, 64222, 64232, 64242, 64252, 64262, 64272,
+    64282, 64291, 64301, 64311, 64320, 64330, 64340, 64349,
+    64359, 64368, 64378, 64387, 64396, 64406, 64415, 64424,
+    64433, 64443, 64452, 64461, 64470, 64479, 64488, 64497,
+    64506, 64514, 64523, 64532, 64541, 64550, 64558, 64567,
+    64575, 64584, 64593, 64601, 64609, 64618, 64626, 64635,
+    64643, 64651, 64659, 64667, 64676, 64684, 64692, 64700,
+    64708, 64716, 64724, 64732, 64739, 64747, 64755, 64763,
+    64770, 64778, 64786, 64793, 64801, 64808, 64816, 64823,
+    64830, 64838, 64845, 64852, 64859, 64867, 64874, 64881,
+    64888, 64895, 64902, 64909, 64916, 64923, 64930, 64936,
+    64943, 64950, 64957, 64963, 64970, 64976, 64983, 64989,
+    64996, 65002, 65009, 65015, 65021, 65028, 65034, 65040,
+    65046, 65052, 65058, 65064, 65070, 65076, 65082, 65088,
+    65094, 65100, 65106, 65111, 65117, 65123, 65128, 65134,
+    65139, 65145, 65150, 65156, 65161, 65167, 65172, 65177,
+    65182, 65188, 65193, 65198, 65203, 65208, 65213, 65218,
+    65223, 65228, 65233, 65237, 65242, 65247, 65252, 65256,
+    65261, 65265, 65270, 65275, 65279, 65283, 65288, 65292,
+    65296, 65301, 65305, 65309, 65313, 65317, 65322, 65326,
+    65330, 65334, 65338, 65341, 65345, 65349, 65353, 65357,
+    65360, 65364, 65368, 65371, 65375, 65378, 65382, 65385,
+    65388, 65392, 65395, 65398, 65402, 65405, 65408, 65411,
+    65414, 65417, 65420, 65423, 65426, 65429, 65432, 65435,
+    65437, 65440, 65443, 65446, 65448, 65451, 65453, 65456,
+    65458, 65461, 65463, 65465, 65468, 65470, 65472, 65474,
+    65477, 65479, 65481, 65483, 65485, 65487, 65489, 65491,
+    65493, 65494, 65496, 65498, 65500, 65501, 65503, 65504,
+    65506, 65507, 65509, 65510, 65512, 65513, 65514, 65516,
+    65517, 65518, 65519, 65520, 65521, 65522, 65523, 65524,
+    65525, 65526, 65527, 65528, 65529, 65529, 65530, 65531,
+    65531, 65532, 65532, 65533, 65533, 65534, 65534, 65535,
+    65535, 65535, 65535, 65536, 65536, 65536, 65536, 65536,
+};
+
+const fixed_t r_tangent_half[FINEANGLES / 4] = {
+    25, 75, 126, 176, 226, 276,
+    327, 377, 427, 478, 528, 578,
+    628, 679, 729, 779, 829, 880,
+    930, 980, 1031, 1081, 1131, 1181,
+    1232, 1282, 1332, 1383, 1433, 1483,
+    1533, 1584, 1634, 1684, 1735, 1785,
+    1835, 1885, 1936, 1986, 2036, 2087,
+    2137, 2187, 2238, 2288, 2338, 2389,
+    2439, 2489, 2540, 2590, 2640, 2691,
+    2741, 2791, 2842, 2892, 2943, 2993,
+    3043, 3094, 3144, 3194, 3245, 3295,
+    3346, 3396, 3446, 3497, 3547, 3598,
+    3648, 3698, 3749, 3799, 3850, 3900,
+    3951, 4001, 4052, 4102, 4152, 4203,
+    4253, 4304, 4354, 4405, 4455, 4506,
+    4556, 4607, 4657, 4708, 4758, 4809,
+    4859, 4910, 4961, 5011, 5062, 5112,
+    5163, 5213, 5264, 5315, 5365, 5416,
+    5466, 5517, 5568, 5618, 5669, 5720,
+    5770, 5821, 5872, 5922, 5973, 6024,
+    6074, 6125, 6176, 6226, 6277, 6328,
+    6379, 6429, 6480, 6531, 6582, 6632,
+    6683, 6734, 6785, 6836, 6886, 6937,
+    6988, 7039, 7090, 7141, 7191, 7242,
+    7293, 7344, 7395, 7446, 7497, 7548,
+    7599, 7650, 7701, 7752, 7803, 7854,
+    7905, 7956, 8007, 8058, 8109, 8160,
+    8211, 8262, 8313, 8364, 8415, 8466,
+    8517, 8568, 8619, 8671, 8722, 8773,
+    8824, 8875, 8926, 8978, 9029, 9080,
+    9131, 9183, 9234, 9285, 9336, 9388,
+    9439, 9490, 9542, 9593, 9644, 9696,
+    9747, 9798, 9850, 9901, 9953, 10004,
+    10056, 10107, 10158, 10210, 10261, 10313,
+    10364, 10416, 10467, 10519, 10571, 10622,
+    10674, 10725, 10777, 10829, 10880, 10932,
+    10984, 11035, 11087, 11139, 11190, 11242,
+    11294, 11346, 11397, 11449, 11501, 11553,
+    11605, 11657, 11708, 11760, 11812, 11864,
+    11916, 11968, 12020, 12072, 12124, 12176,
+    12228, 12280, 12332, 12384, 12436, 12488,
+    12540, 12592, 12644, 12697, 12749, 12801,
+    12853, 12905, 12958, 13010, 13062, 13114,
+    13167, 13219, 13271, 13324, 13376, 13428,
+    13481, 13533, 13585, 13638, 13690, 13743,
+    13795, 13848, 13900, 13953, 14005, 14058,
+    14111, 14163, 14216, 14268, 14321, 14374,
+    14426, 14479, 14532, 14585, 14637, 14690,
+    14743, 14796, 14849, 14902, 14954, 15007,
+    15060, 15113, 15166, 15219, 15272, 15325,
+    15378, 15431, 15484, 15537, 15590, 15643,
+    15697, 15750, 15803, 15856, 15909, 15963,
+    16016, 16069, 16122, 16176, 16229, 16282,
+    16336, 16389, 16443, 16496, 16550, 16603,
+    16657, 16710, 16764, 16817, 16871, 16924,
+    16978, 17032, 17085, 17139, 17193, 17246,
+    17300, 17354, 17408, 17462, 17515, 17569,
+    17623, 17677, 17731, 17785, 17839, 17893,
+    17947, 18001, 18055, 18109, 18163, 18217,
+    18272, 18326, 18380, 18434, 18488, 18543,
+    18597, 18651, 18706, 18760, 18815, 18869,
+    18923, 18978, 19032, 19087, 19141, 19196,
+    19251, 19305, 19360, 19414, 19469, 19524,
+    19579, 19633, 19688, 19743, 19798, 19853,
+    19908, 19962, 20017, 20072, 20127, 20182,
+    20237, 20293, 20348, 20403, 20458, 20513,
+    20568, 20624, 20679, 20734, 20789, 20845,
+    20900, 20955, 21011, 21066, 21122, 21177,
+    21233, 21288, 21344, 21400, 21455, 21511,
+    21567, 21622, 21678, 21734, 21790, 21845,
+    21901, 21957, 22013, 22069, 22125, 22181,
+    22237, 22293, 22349, 22405, 22462, 22518,
+    22574, 22630, 22686, 22743, 22799, 22855,
+    22912, 22968, 23025, 23081, 23138, 23194,
+    23251, 23308, 23364, 23421, 23478, 23534,
+    23591, 23648, 23705, 23761, 23818, 23875,
+    23932, 23989, 24046, 24103, 24160, 24217,
+    24275, 24332, 24389, 24446, 24504, 24561,
+    24618, 24676, 24733, 24790, 24848, 24905,
+    24963, 25021, 25078, 25136, 25193, 25251,
+    25309, 25367, 25424, 25482, 25540, 25598,
+    25656, 25714, 25772, 25830, 25888, 25946,
+    26005, 26063, 26121, 26179, 26238, 26296,
+    26354, 26413, 26471, 26530, 26588, 26647,
+    26705, 26764, 26823, 26881, 26940, 26999,
+    27058, 27116, 27175, 27234, 27293, 27352,
+    27411, 27470, 27529, 27589, 27648, 27707,
+    27766, 27826, 27885, 27944, 28004, 28063,
+    28123, 28182, 28242, 28301, 28361, 28421,
+    28481, 28540, 28600, 28660, 28720, 28780,
+    28840, 28900, 28960, 29020, 29080, 29140,
+    29201, 29261, 29321, 29382, 29442, 29502,
+    29563, 29623, 29684, 29744, 29805, 29866,
+    29927, 29987, 30048, 30109, 30170, 30231,
+    30292, 30353, 30414, 30475, 30536, 30597,
+    30659, 30720, 30781, 30843, 30904, 30965,
+    31027, 31089, 31150, 31212, 31273, 31335,
+    31397, 31459, 31521, 31583, 31645, 31707,
+    31769, 31831, 31893, 31955, 32017, 32080,
+    32142, 32204, 32267, 32329, 32392, 32454,
+    32517, 32580, 32642, 32705, 32768, 32831,
+    32894, 32957, 33020, 33083, 33146, 33209,
+    33272, 33335, 33399, 33462, 33525, 33589,
+    33652, 33716, 33779, 33843, 33907, 33970,
+    34034, 34098, 34162, 34226, 34290, 34354,
+    34418, 34482, 34547, 34611, 34675, 34739,
+    34804, 34868, 34933, 34997, 35062, 35127,
+    35191, 35256, 35321, 35386, 35451, 35516,
+    35581, 35646, 35711, 35776, 35842, 35907,
+    35972, 36038, 36103, 36169, 36235, 36300,
+    36366, 36432, 36498, 36563, 36629, 36695,
+    36761, 36827, 36894, 36960, 37026, 37092,
+    37159, 37225, 37292, 37358, 37425, 37492,
+    37558, 37625, 37692, 37759, 37826, 37893,
+    37960, 38027, 38095, 38162, 38229, 38297,
+    38364, 38432, 38499, 38567, 38635, 38702,
+    38770, 38838, 38906, 38974, 39042, 39110,
+    39178, 39247, 39315, 39383, 39452, 39520,
+    39589, 39658, 39726, 39795, 39864, 39933,
+    40002, 40071, 40140, 40209, 40278, 40347,
+    40417, 40486, 40556, 40625, 40695, 40765,
+    40834, 40904, 40974, 41044, 41114, 41184,
+    41254, 41324, 41395, 41465, 41535, 41606,
+    41676, 41747, 41818, 41889, 41959, 42030,
+    42101, 42172, 42243, 42315, 42386, 42457,
+    42529, 42600, 42672, 42743, 42815, 42887,
+    42959, 43030, 43102, 43174, 43247, 43319,
+    43391, 43463, 43536, 43608, 43681, 43753,
+    43826, 43899, 43972, 44045, 44118, 44191,
+    44264, 44337, 44410, 44484, 44557, 44631,
+    44704, 44778, 44852, 44926, 45000, 45074,
+    45148, 45222, 45296, 45371, 45445, 45519,
+    45594, 45669, 45743, 45818, 45893, 45968,
+    46043, 46118, 46193, 46269, 46344, 46419,
+    46495, 46570, 46646, 46722, 46798, 46874,
+    46950, 47026, 47102, 47178, 47255, 47331,
+    47408, 47484, 47561, 47638, 47715, 47792,
+    47869, 47946, 48023, 48100, 48178, 48255,
+    48333, 48410, 48488, 48566, 48644, 48722,
+    48800, 48878, 48956, 49035, 49113, 49192,
+    49270, 49349, 49428, 49507, 49586, 49665,
+    49744, 49823, 49903, 49982, 50062, 50141,
+    50221, 50301, 50381, 50461, 50541, 50621,
+    50701, 50782, 50862, 50943, 51024, 51104,
+    51185, 51266, 51347, 51428, 51510, 51591,
+    51673, 51754, 51836, 51918, 51999, 52081,
+    52163, 52246, 52328, 52410, 52493, 52575,
+    52658, 52741, 52824, 52907, 52990, 53073,
+    53156, 53239, 53323, 53407, 53490, 53574,
+    53658, 53742, 53826, 53910, 53995, 54079,
+    54164, 54248, 54333, 54418, 54503, 54588,
+    54673, 54758, 54844, 54929, 55015, 55101,
+    55187, 55273, 55359, 55445, 55531, 55618,
+    55704, 55791, 55877, 55964, 56051, 56138,
+    56226, 56313, 56400, 56488, 56576, 56663,
+    56751, 56839, 56927, 57016, 57104, 57193,
+    57281, 57370, 57459, 57548, 57637, 57726,
+    57815, 57905, 57994, 58084, 58174, 58264,
+    58354, 58444, 58534, 58625, 58715, 58806,
+    58897, 58988, 59079, 59170, 59261, 59353,
+    59444, 59536, 59628, 59720, 59812, 59904,
+    59996, 60089, 60181, 60274, 60367, 60460,
+    60553, 60646, 60740, 60833, 60927, 61020,
+    61114, 61208, 61303, 61397, 61491, 61586,
+    61681, 61776, 61871, 61966, 62061, 62156,
+    62252, 62348, 62443, 62539, 62635, 62732,
+    62828, 62925, 63021, 63118, 63215, 63312,
+    63409, 63507, 63604, 63702, 63800, 63898,
+    63996, 64094, 64193, 64291, 64390, 64489,
+    64588, 64687, 64786, 64886, 64985, 65085,
+    65185, 65285, 65385, 65486, 65586, 65687,
+    65788, 65889, 65990, 66091, 66193, 66294,
+    66396, 66498, 66600, 66702, 66805, 66907,
+    67010, 67113, 67216, 67319, 67423, 67526,
+    67630, 67734, 67838, 67942, 68046, 68151,
+    68256, 68361, 68466, 68571, 68676, 68782,
+    68887, 68993, 69099, 69206, 69312, 69419,
+    69525, 69632, 69739, 69847, 69954, 70062,
+    70170, 70278, 70386, 70494, 70603, 70711,
+    70820, 70929, 71038, 71148, 71257, 71367,
+    71477, 71587, 71698, 71808, 71919, 72030,
+    72141, 72252, 72364, 72475, 72587, 72699,
+    72811, 72924, 73036, 73149, 73262, 73375,
+    73489, 73602, 73716, 73830, 73944, 74058,
+    74173, 74288, 74403, 74518, 74633, 74749,
+    74865, 74980, 75097, 75213, 75330, 75446,
+    75563, 75681, 75798, 75916, 76033, 76151,
+    76270, 76388, 76507, 76626, 76745, 76864,
+    76984, 77103, 77223, 77343, 77464, 77584,
+    77705, 77826, 77947, 78069, 78191, 78313,
+    78435, 78557, 78680, 78803, 78926, 79049,
+    79172, 79296, 79420, 79544, 79669, 79793,
+    79918, 80043, 80169, 80294, 80420, 80546,
+    80673, 80799, 80926, 81053, 81180, 81308,
+    81436, 81564, 81692, 81820, 81949, 82078,
+    82207, 82337, 82466, 82596, 82727, 82857,
+    82988, 83119, 83250, 83382, 83513, 83645,
+    83778, 83910, 84043, 84176, 84309, 84443,
+    84577, 84711, 84845, 84980, 85115, 85250,
+    85386, 85521, 85657, 85794, 85930, 86067,
+    86204, 86341, 86479, 86617, 86755, 86894,
+    87032, 87172, 87311, 87450, 87590, 87731,
+    87871, 88012, 88153, 88294, 88436, 88578,
+    88720, 88863, 89005, 89149, 89292, 89436,
+    89580, 89724, 89869, 90014, 90159, 90304,
+    90450, 90597, 90743, 90890, 91037, 91184,
+    91332, 91480, 91628, 91777, 91926, 92075,
+    92225, 92375, 92525, 92676, 92827, 92978,
+    93130, 93282, 93434, 93587, 93740, 93893,
+    94046, 94200, 94355, 94509, 94664, 94820,
+    94975, 95131, 95288, 95444, 95601, 95759,
+    95917, 96075, 96233, 96392, 96551, 96711,
+    96871, 97031, 97191, 97352, 97514, 97676,
+    97838, 98000, 98163, 98326, 98490, 98654,
+    98818, 98983, 99148, 99314, 99479, 99646,
+    99812, 99979, 100147, 100315, 100483, 100652,
+    100821, 100990, 101160, 101330, 101501, 101672,
+    101843, 102015, 102187, 102360, 102533, 102707,
+    102881, 103055, 103230, 103405, 103581, 103757,
+    103933, 104110, 104287, 104465, 104643, 104822,
+    105001, 105180, 105360, 105541, 105722, 105903,
+    106085, 106267, 106450, 106633, 106816, 107000,
+    107185, 107370, 107555, 107741, 107927, 108114,
+    108302, 108489, 108678, 108866, 109055, 109245,
+    109435, 109626, 109817, 110009, 110201, 110394,
+    110587, 110780, 110975, 111169, 111364, 111560,
+    111756, 111953, 112150, 112348, 112546, 112745,
+    112944, 113144, 113344, 113545, 113747, 113949,
+    114151, 114354, 114558, 114762, 114966, 115172,
+    115378, 115584, 115791, 115998, 116206, 116415,
+    116624, 116834, 117044, 117255, 117466, 117678,
+    117891, 118104, 118318, 118532, 118747, 118963,
+    119179, 119396, 119613, 119831, 120050, 120269,
+    120489, 120710, 120931, 121152, 121375, 121598,
+    121821, 122046, 122271, 122496, 122722, 122949,
+    123177, 123405, 123634, 123863, 124093, 124324,
+    124556, 124788, 125021, 125254, 125488, 125723,
+    125959, 126195, 126432, 126670, 126908, 127147,
+    127387, 127628, 127869, 128111, 128354, 128597,
+    128841, 129086, 129332, 129578, 129826, 130073,
+    130322, 130572, 130822, 131073, 131324, 131577,
+    131830, 132084, 132339, 132595, 132851, 133108,
+    133366, 133625, 133885, 134145, 134407, 134669,
+    134932, 135195, 135460, 135725, 135992, 136259,
+    136527, 136796, 137065, 137336, 137607, 137880,
+    138153, 138427, 138702, 138978, 139254, 139532,
+    139811, 140090, 140371, 140652, 140934, 141217,
+    141501, 141787, 142073, 142360, 142647, 142936,
+    143226, 143517, 143809, 144102, 144395, 144690,
+    144986, 145283, 145581, 145879, 146179, 146480,
+    146782, 147085, 147389, 147694, 148000, 148307,
+    148615, 148925, 149235, 149547, 149859, 150173,
+    150487, 150803, 151120, 151438, 151758, 152078,
+    152399, 152722, 153046, 153371, 153697, 154024,
+    154353, 154683, 155013, 155346, 155679, 156013,
+    156349, 156686, 157024, 157364, 157704, 158046,
+    158390, 158734, 159080, 159427, 159775, 160125,
+    160476, 160828, 161182, 161537, 161893, 162251,
+    162610, 162971, 163332, 163696, 164060, 164426,
+    164793, 165162, 165532, 165904, 166277, 166652,
+    167028, 167405, 167784, 168165, 168547, 168930,
+    169315, 169702, 170090, 170480, 170871, 171263,
+    171658, 172054, 172451, 172850, 173251, 173653,
+    174057, 174463, 174870, 175279, 175690, 176102,
+    176517, 176932, 177350, 177769, 178190, 178613,
+    179037, 179464, 179892, 180322, 180753, 181187,
+    181622, 182060, 182499, 182940, 183383, 183827,
+    184274, 184723, 185173, 185626, 186080, 186537,
+    186995, 187456, 187918, 188383, 188850, 189318,
+    189789, 190262, 190737, 191214, 191693, 192175,
+    192658, 193144, 193632, 194122, 194614, 195109,
+    195606, 196105, 196607, 197111, 197617, 198125,
+    198636, 199149, 199665, 200183, 200703, 201226,
+    201752, 202280, 202810, 203343, 203878, 204416,
+    204957, 205500, 206046, 206594, 207146, 207699,
+    208256, 208815, 209377, 209942, 210509, 211079,
+    211653, 212229, 212807, 213389, 213974, 214561,
+    215152, 215745, 216342, 216941, 217544, 218150,
+    218758, 219370, 219985, 220604, 221225, 221850,
+    222478, 223109, 223743, 224381, 225022, 225667,
+    226315, 226966, 227621, 228280, 228941, 229607,
+    230276, 230949, 231625, 232305, 232989, 233676,
+    234367, 235062, 235761, 236464, 237170, 237881,
+    238596, 239314, 240037, 240763, 241494, 242229,
+    242968, 243711, 244459, 245210, 245967, 246727,
+    247492, 248261, 249035, 249814, 250597, 251384,
+    252176, 252973, 253775, 254581, 255392, 256208,
+    257029, 257855, 258686, 259522, 260363, 261209,
+    262061, 262917, 263779, 264647, 265519, 266397,
+    267281, 268170, 269065, 269965, 270871, 271783,
+    272701, 273624, 274554, 275489, 276431, 277378,
+    278332, 279292, 280258, 281231, 282210, 283196,
+    284188, 285187, 286192, 287205, 288224, 289250,
+    290282, 291322, 292369, 293424, 294485, 295554,
+    296630, 297714, 298806, 299905, 301012, 302126,
+    303249, 304379, 305518, 306665, 307820, 308983,
+    310155, 311335, 312524, 313722, 314928, 316144,
+    317368, 318602, 319845, 321097, 322359, 323630,
+    324911, 326202, 327502, 328813, 330133, 331464,
+    332806, 334157, 335520, 336893, 338277, 339672,
+    341078, 342496, 343924, 345365, 346817, 348281,
+    349757, 351245, 352745, 354258, 355783, 357321,
+    358872, 360436, 362014, 363604, 365209, 366827,
+    368459, 370105, 371766, 373441, 375131, 376835,
+    378555, 380290, 382041, 383807, 385589, 387388,
+    389203, 391034, 392882, 394748, 396630, 398530,
+    400448, 402385, 404339, 406312, 408304, 410315,
+    412345, 414395, 416465, 418555, 420666, 422798,
+    424951, 427126, 429322, 431541, 433782, 436046,
+    438333, 440643, 442978, 445337, 447721, 450130,
+    452564, 455025, 457511, 460025, 462565, 465134,
+    467730, 470355, 473009, 475693, 478406, 481150,
+    483926, 486733, 489572, 492444, 495349, 498288,
+    501261, 504270, 507314, 510394, 513512, 516667,
+    519861, 523094, 526367, 529680, 533034, 536431,
+    539871, 543354, 546882, 550455, 554075, 557742,
+    561457, 565221, 569036, 572901, 576819, 580790,
+    584815, 588896, 593034, 597229, 601484, 605798,
+    610175, 614614, 619117, 623687, 628323, 633029,
+    637804, 642651, 647572, 652568, 657641, 662792,
+    668024, 673339, 678738, 684223, 689797, 695462,
+    701220, 707072, 713023, 719074, 725227, 731486,
+    737853, 744331, 750923, 757631, 764460, 771412,
+    778490, 785699, 793041, 800521, 808143, 815910,
+    823827, 831898, 840128, 848521, 857083, 865818,
+    874732, 883830, 893118, 902603, 912290, 922186,
+    932299, 942634, 953200, 964004, 975055, 986361,
+    997931, 1009775, 1021902, 1034322, 1047047, 1060088,
+    1073456, 1087164, 1101226, 1115655, 1130465, 1145673,
+    1161294, 1177346, 1193846, 1210814, 1228269, 1246234,
+    1264730, 1283783, 1303416, 1323658, 1344537, 1366083,
+    1388330, 1411311, 1435064, 1459629, 1485048, 1511366,
+    1538631, 1566897, 1596219, 1626657, 1658276, 1691147,
+    1725345, 1760953, 1798060, 1836762, 1877164, 1919382,
+    1963539, 2009774, 2058236, 2109091, 2162519, 2218723,
+    2277923, 2340365, 2406325, 2476108, 2550055, 2628553,
+    2712033, 2800986, 2895969, 2997616, 3106654, 3223920,
+    3350383, 3487167, 3635592, 3797208, 3973856, 4167737,
+    4381502, 4618374, 4882316, 5178248, 5512363, 5892561,
+    6329082, 6835443, 7429865, 8137506, 8994121, 10052288,
+    11392629, 13145377, 15535482, 18987849, 24412987, 34178222,
+    56963748, 170891311,
+};
+
+const angle_t tantoangle[SLOPERANGE + 1] = {
+    0, 333772, 667544, 1001316, 1335087, 1668857,
+    2002627, 2336396, 2670163, 3003930, 3337695, 3671458,
+    4005219, 4338979, 4672737, 5006492, 5340245, 5673996,
+    6007743, 6341488, 6675230, 7008969, 7342704, 7676436,
+    8010164, 8343888, 8677609, 9011325, 9345037, 9678744,
+    10012447, 10346145, 10679838, 11013526, 11347209, 11680887,
+    12014559, 12348225, 12681885, 13015539, 13349187, 13682829,
+    14016464, 14350092, 14683714, 15017328, 15350936, 15684536,
+    16018129, 16351714, 16685291, 17018860, 17352421, 17685974,
+    18019519, 18353055, 18686582, 19020100, 19353609, 19687109,
+    20020600, 20354081, 20687552, 21021014, 21354465, 21687907,
+    22021338, 22354758, 22688168, 23021567, 23354956, 23688333,
+    24021698, 24355053, 24688395, 25021726, 25355046, 25688353,
+    26021647, 26354930, 26688200, 27021457, 27354701, 27687933,
+    28021151, 28354356, 28687547, 29020725, 29353889, 29687039,
+    30020175, 30353296, 30686403, 31019496, 31352574, 31685637,
+    32018685, 32351718, 32684735, 33017737, 33350723, 33683693,
+    34016647, 34349585, 34682507, 35015413, 35348301, 35681173,
+    36014028, 36346866, 36679687, 37012490, 37345276, 37678044,
+    38010794, 38343526, 38676240, 39008935, 39341612, 39674271,
+    40006910, 40339531, 40672133, 41004715, 41337277, 41669821,
+    42002344, 42334848, 42667331, 42999794, 43332237, 43664660,
+    43997061, 44329442, 44661802, 44994141, 45326458, 45658754,
+    45991028, 46323281, 46655512, 46987720, 47319906, 47652070,
+    47984212, 48316331, 48648426, 48980499, 49312549, 49644576,
+    49976578, 50308558, 50640513, 50972445, 51304353, 51636236,
+    51968095, 52299929, 52631739, 52963524, 53295284, 53627018,
+    53958728, 54290411, 54622070, 54953702, 55285309, 55616889,
+    55948444, 56279972, 56611473, 56942948, 57274396, 57605816,
+    57937210, 58268576, 58599915, 58931227, 59262510, 59593766,
+    59924994, 60256193, 60587364, 60918507, 61249621, 61580706,
+    61911762, 62242789, 62573787, 62904755, 63235694, 63566603,
+    63897482, 64228331, 64559150, 64889938, 65220696, 65551424,
+    65882120, 66212786, 66543421, 66874024, 67204596, 67535137,
+    67865646, 68196123, 68526568, 68856981, 69187361, 69517709,
+    69848025, 70178308, 70508558, 70838775, 71168959, 71499109,
+    71829226, 72159309, 72489359, 72819375, 73149356, 73479304,
+    73809217, 74139095, 74468939, 74798748, 75128522, 75458261,
+    75787964, 76117633, 76447265, 76776862, 77106424, 77435949,
+    77765438, 78094891, 78424307, 78753687, 79083030, 79412336,
+    79741605, 80070837, 80400031, 80729189, 81058308, 81387390,
+    81716434, 82045440, 82374407, 82703337, 83032227, 83361080,
+    83689893, 84018668, 84347403, 84676099, 85004756, 85333373,
+    85661951, 85990489, 86318987, 86647445, 86975863, 87304240,
+    87632577, 87960873, 88289129, 88617343, 88945516, 89273648,
+    89601739, 89929788, 90257796, 90585762, 90913686, 91241567,
+    91569407, 91897204, 92224959, 92552671, 92880340, 93207966,
+    93535549, 93863089, 94190586, 94518039, 94845448, 95172814,
+    95500135, 95827413, 96154646, 96481835, 96808980, 97136079,
+    97463134, 97790145, 98117110, 98444030, 98770904, 99097733,
+    99424517, 99751254, 100077946, 100404592, 100731191, 101057745,
+    101384251, 101710712, 102037125, 102363492, 102689811, 103016084,
+    103342309, 103668486, 103994617, 104320699, 104646734, 104972720,
+    105298659, 105624549, 105950391, 106276184, 106601929, 106927624,
+    107253271, 107578869, 107904418, 108229917, 108555367, 108880767,
+    109206117, 109531417, 109856668, 110181868, 110507018, 110832118,
+    111157167, 111482165, 111807112, 112132009, 112456854, 112781648,
+    113106391, 113431082, 113755721, 114080309, 114404845, 114729328,
+    115053760, 115378139, 115702466, 116026740, 116350962, 116675130,
+    116999246, 117323308, 117647318, 117971273, 118295176, 118619025,
+    118942819, 119266560, 119590247, 119913880, 120237459, 120560983,
+    120884452, 121207867, 121531227, 121854532, 122177782, 122500976,
+    122824116, 123147200, 123470228, 123793200, 124116117, 124438977,
+    124761782, 125084530, 125407222, 125729857, 126052436, 126374958,
+    126697423, 127019830, 127342181, 127664475, 127986711, 128308889,
+    128631010, 128953073, 129275078, 129597025, 129918914, 130240744,
+    130562517, 130884230, 131205885, 131527481, 131849018, 132170496,
+    132491915, 132813274, 133134574, 133455815, 133776996, 134098117,
+    134419178, 134740179, 135061119, 135382000, 135702820, 136023579,
+    136344278, 136664916, 136985493, 137306009, 137626463, 137946857,
+    138267189, 138587459, 138907668, 139227815, 139547900, 139867922,
+    140187883, 140507782, 140827618, 141147391, 141467102, 141786750,
+    142106335, 142425858, 142745317, 143064712, 143384045, 143703314,
+    144022519, 144341660, 144660738, 144979751, 145298701, 145617586,
+    145936407, 146255164, 146573856, 146892483, 147211045, 147529543,
+    147847975, 148166342, 148484644, 148802881, 149121052, 149439157,
+    149757197, 150075171, 150393078, 150710920, 151028695, 151346404,
+    151664047, 151981623, 152299132, 152616575, 152933950, 153251259,
+    153568500, 153885674, 154202781, 154519820, 154836791, 155153695,
+    155470531, 155787299, 156103999, 156420631, 156737194, 157053689,
+    157370116, 157686473, 158002763, 158318983, 158635134, 158951216,
+    159267229, 159583173, 159899047, 160214851, 160530586, 160846251,
+    161161847, 161477372, 161792827, 162108212, 162423527, 162738771,
+    163053945, 163369048, 163684080, 163999041, 164313932, 164628751,
+    164943499, 165258176, 165572781, 165887315, 166201777, 166516168,
+    166830486, 167144733, 167458907, 167773010, 168087040, 168400997,
+    168714883, 169028695, 169342435, 169656102, 169969696, 170283217,
+    170596665, 170910040, 171223341, 171536569, 171849723, 172162803,
+    172475810, 172788743, 173101602, 173414387, 173727097, 174039734,
+    174352296, 174664783, 174977196, 175289534, 175601797, 175913985,
+    176226098, 176538137, 176850100, 177161987, 177473799, 177785536,
+    178097197, 178408782, 178720291, 179031725, 179343082, 179654363,
+    179965568, 180276696, 180587749, 180898724, 181209623, 181520445,
+    181831190, 182141859, 182452450, 182762964, 183073401, 183383760,
+    183694042, 184004247, 184314374, 184624423, 184934394, 185244287,
+    185554102, 185863839, 186173498, 186483079, 186792581, 187102004,
+    187411349, 187720615, 188029803, 188338911, 188647941, 188956891,
+    189265762, 189574554, 189883266, 190191899, 190500453, 190808926,
+    191117320, 191425634, 191733868, 192042022, 192350096, 192658089,
+    192966003, 193273835, 193581588, 193889259, 194196850, 194504360,
+    194811789, 195119138, 195426405, 195733591, 196040695, 196347719,
+    196654661, 196961521, 197268300, 197574997, 197881612, 198188145,
+    198494596, 198800965, 199107252, 199413457, 199719579, 200025619,
+    200331577, 200637451, 200943243, 201248953, 201554579, 201860122,
+    202165583, 202470960, 202776254, 203081464, 203386591, 203691635,
+    203996595, 204301471, 204606264, 204910973, 205215597, 205520138,
+    205824595, 206128967, 206433255, 206737459, 207041579, 207345613,
+    207649563, 207953429, 208257210, 208560905, 208864516, 209168042,
+    209471483, 209774838, 210078108, 210381293, 210684392, 210987406,
+    211290334, 211593176, 211895933, 212198604, 212501188, 212803687,
+    213106100, 213408426, 213710666, 214012820, 214314887, 214616868,
+    214918762, 215220569, 215522290, 215823924, 216125471, 216426931,
+    216728303, 217029589, 217330787, 217631898, 217932922, 218233858,
+    218534707, 218835467, 219136141, 219436726, 219737224, 220037633,
+    220337955, 220638188, 220938333, 221238390, 221538359, 221838239,
+    222138031, 222437734, 222737348, 223036874, 223336311, 223635659,
+    223934919, 224234089, 224533170, 224832162, 225131064, 225429878,
+    225728602, 226027236, 226325781, 226624236, 226922602, 227220878,
+    227519064, 227817160, 228115166, 228413082, 228710908, 229008644,
+    229306289, 229603844, 229901309, 230198683, 230495967, 230793160,
+    231090262, 231387274, 231684195, 231981025, 232277764, 232574411,
+    232870968, 233167434, 233463808, 233760091, 234056282, 234352382,
+    234648391, 234944308, 235240133, 235535867, 235831508, 236127058,
+    236422516, 236717882, 237013156, 237308337, 237603427, 237898424,
+    238193329, 238488141, 238782861, 239077489, 239372024, 239666466,
+    239960815, 240255072, 240549235, 240843306, 241137284, 241431169,
+    241724960, 242018659, 242312264, 242605776, 242899194, 243192519,
+    243485751, 243778888, 244071933, 244364883, 244657740, 244950503,
+    245243172, 245535747, 245828228, 246120615, 246412908, 246705107,
+    246997212, 247289222, 247581137, 247872959, 248164686, 248456318,
+    248747855, 249039298, 249330647, 249621900, 249913059, 250204122,
+    250495091, 250785965, 251076743, 251367426, 251658015, 251948508,
+    252238905, 252529207, 252819414, 253109525, 253399541, 253689461,
+    253979285, 254269014, 254558647, 254848184, 255137625, 255426970,
+    255716219, 256005372, 256294429, 256583390, 256872255, 257161023,
+    257449695, 257738270, 258026749, 258315132, 258603418, 258891607,
+    259179700, 259467696, 259755595, 260043398, 260331103, 260618712,
+    260906223, 261193638, 261480955, 261768176, 262055299, 262342325,
+    262629253, 262916084, 263202818, 263489454, 263775993, 264062435,
+    264348778, 264635024, 264921172, 265207223, 265493176, 265779031,
+    266064788, 266350447, 266636008, 266921470, 267206835, 267492102,
+    267777270, 268062341, 268347313, 268632186, 268916961, 269201638,
+    269486216, 269770696, 270055077, 270339359, 270623543, 270907628,
+    271191615, 271475502, 271759291, 272042980, 272326571, 272610063,
+    272893455, 273176749, 273459943, 273743039, 274026035, 274308931,
+    274591729, 274874427, 275157025, 275439525, 275721924, 276004224,
+    276286425, 276568526, 276850527, 277132429, 277414230, 277695932,
+    277977534, 278259037, 278540439, 278821741, 279102944, 279384046,
+    279665048, 279945950, 280226752, 280507454, 280788055, 281068556,
+    281348957, 281629257, 281909457, 282189557, 282469556, 282749454,
+    283029252, 283308949, 283588546, 283868041, 284147437, 284426731,
+    284705924, 284985017, 285264009, 285542900, 285821690, 286100378,
+    286378966, 286657453, 286935838, 287214123, 287492306, 287770388,
+    288048369, 288326248, 288604026, 288881703, 289159278, 289436752,
+    289714125, 289991396, 290268565, 290545633, 290822599, 291099463,
+    291376226, 291652887, 291929446, 292205903, 292482259, 292758513,
+    293034664, 293310714, 293586662, 293862508, 294138252, 294413894,
+    294689433, 294964871, 295240206, 295515439, 295790570, 296065599,
+    296340525, 296615349, 296890071, 297164690, 297439207, 297713622,
+    297987934, 298262143, 298536250, 298810254, 299084156, 299357955,
+    299631651, 299905245, 300178736, 300452124, 300725410, 300998592,
+    301271672, 301544649, 301817523, 302090294, 302362962, 302635527,
+    302907989, 303180348, 303452604, 303724757, 303996806, 304268753,
+    304540596, 304812336, 305083973, 305355507, 305626937, 305898264,
+    306169488, 306440608, 306711625, 306982539, 307253349, 307524055,
+    307794658, 308065158, 308335554, 308605846, 308876035, 309146120,
+    309416102, 309685979, 309955754, 310225424, 310494991, 310764453,
+    311033813, 311303068, 311572219, 311841267, 312110210, 312379050,
+    312647786, 312916418, 313184946, 313453370, 313721690, 313989905,
+    314258017, 314526025, 314793928, 315061728, 315329423, 315597014,
+    315864501, 316131883, 316399162, 316666336, 316933406, 317200371,
+    317467232, 317733989, 318000642, 318267190, 318533634, 318799973,
+    319066208, 319332338, 319598364, 319864285, 320130102, 320395815,
+    320661422, 320926926, 321192324, 321457618, 321722808, 321987892,
+    322252872, 322517748, 322782518, 323047184, 323311746, 323576202,
+    323840554, 324104801, 324368943, 324632980, 324896913, 325160740,
+    325424463, 325688081, 325951594, 326215002, 326478305, 326741503,
+    327004596, 327267585, 327530468, 327793246, 328055919, 328318487,
+    328580951, 328843309, 329105562, 329367710, 329629752, 329891690,
+    330153523, 330415250, 330676872, 330938389, 331199801, 331461108,
+    331722309, 331983406, 332244397, 332505282, 332766063, 333026738,
+    333287308, 333547773, 333808132, 334068386, 334328534, 334588578,
+    334848516, 335108348, 335368076, 335627697, 335887214, 336146625,
+    336405930, 336665131, 336924225, 337183215, 337442098, 337700877,
+    337959550, 338218117, 338476579, 338734935, 338993186, 339251331,
+    339509371, 339767305, 340025134, 340282857, 340540475, 340797987,
+    341055393, 341312694, 341569889, 341826978, 342083962, 342340841,
+    342597613, 342854280, 343110842, 343367298, 343623648, 343879892,
+    344136031, 344392064, 344647991, 344903813, 345159529, 345415139,
+    345670644, 345926042, 346181336, 346436523, 346691605, 346946580,
+    347201451, 347456215, 347710874, 347965427, 348219874, 348474215,
+    348728451, 348982580, 349236604, 349490523, 349744335, 349998042,
+    350251643, 350505138, 350758527, 351011810, 351264988, 351518060,
+    351771026, 352023886, 352276640, 352529289, 352781832, 353034268,
+    353286599, 353538825, 353790944, 354042957, 354294865, 354546667,
+    354798363, 355049953, 355301437, 355552816, 355804088, 356055255,
+    356306316, 356557271, 356808120, 357058864, 357309501, 357560033,
+    357810458, 358060778, 358310992, 358561101, 358811103, 359060999,
+    359310790, 359560475, 359810054, 360059527, 360308894, 360558155,
+    360807311, 361056361, 361305304, 361554142, 361802875, 362051501,
+    362300021, 362548436, 362796745, 363044948, 363293045, 363541036,
+    363788922, 364036701, 364284375, 364531943, 364779405, 365026762,
+    365274012, 365521157, 365768196, 366015129, 366261957, 366508678,
+    366755294, 367001804, 367248208, 367494507, 367740699, 367986786,
+    368232767, 368478643, 368724412, 368970076, 369215634, 369461087,
+    369706433, 369951674, 370196809, 370441839, 370686763, 370931581,
+    371176293, 371420900, 371665401, 371909796, 372154086, 372398270,
+    372642348, 372886320, 373130187, 373373949, 373617604, 373861154,
+    374104599, 374347937, 374591171, 374834298, 375077320, 375320237,
+    375563047, 375805753, 376048352, 376290846, 376533235, 376775518,
+    377017695, 377259767, 377501734, 377743594, 377985350, 378227000,
+    378468544, 378709983, 378951317, 379192545, 379433667, 379674684,
+    379915596, 380156402, 380397103, 380637698, 380878188, 381118573,
+    381358852, 381599026, 381839095, 382079058, 382318916, 382558669,
+    382798316, 383037858, 383277294, 383516626, 383755852, 383994973,
+    384233988, 384472899, 384711704, 384950404, 385188999, 385427488,
+    385665872, 385904152, 386142326, 386380395, 386618358, 386856217,
+    387093970, 387331619, 387569162, 387806600, 388043934, 388281162,
+    388518285, 388755303, 388992216, 389229024, 389465727, 389702325,
+    389938818, 390175207, 390411490, 390647668, 390883742, 391119710,
+    391355574, 391591333, 391826987, 392062536, 392297980, 392533320,
+    392768555, 393003685, 393238710, 393473630, 393708446, 393943157,
+    394177763, 394412265, 394646662, 394880954, 395115141, 395349224,
+    395583203, 395817077, 396050846, 396284510, 396518070, 396751526,
+    396984877, 397218123, 397451265, 397684303, 397917236, 398150065,
+    398382789, 398615408, 398847924, 399080335, 399312642, 399544844,
+    399776942, 400008935, 400240825, 400472610, 400704291, 400935867,
+    401167340, 401398708, 401629972, 401861132, 402092187, 402323139,
+    402553986, 402784729, 403015369, 403245904, 403476335, 403706662,
+    403936885, 404167004, 404397019, 404626930, 404856737, 405086441,
+    405316040, 405545535, 405774927, 406004215, 406233399, 406462479,
+    406691455, 406920328, 407149097, 407377762, 407606323, 407834781,
+    408063135, 408291385, 408519532, 408747575, 408975514, 409203350,
+    409431083, 409658712, 409886237, 410113659, 410340977, 410568192,
+    410795304, 411022312, 411249216, 411476018, 411702716, 411929310,
+    412155802, 412382190, 412608475, 412834656, 413060734, 413286710,
+    413512582, 413738350, 413964016, 414189578, 414415038, 414640394,
+    414865648, 415090798, 415315845, 415540789, 415765631, 415990369,
+    416215005, 416439537, 416663967, 416888294, 417112518, 417336639,
+    417560657, 417784573, 418008386, 418232096, 418455703, 418679208,
+    418902610, 419125910, 419349107, 419572201, 419795193, 420018082,
+    420240869, 420463553, 420686135, 420908614, 421130991, 421353266,
+    421575438, 421797508, 422019476, 422241341, 422463104, 422684764,
+    422906323, 423127779, 423349133, 423570385, 423791535, 424012583,
+    424233528, 424454372, 424675114, 424895753, 425116291, 425336726,
+    425557060, 425777292, 425997422, 426217450, 426437376, 426657200,
+    426876923, 427096544, 427316063, 427535480, 427754796, 427974010,
+    428193123, 428412134, 428631043, 428849851, 429068557, 429287162,
+    429505665, 429724067, 429942367, 430160566, 430378664, 430596660,
+    430814555, 431032349, 431250041, 431467632, 431685122, 431902511,
+    432119799, 432336985, 432554071, 432771055, 432987938, 433204721,
+    433421402, 433637982, 433854461, 434070840, 434287117, 434503294,
+    434719370, 434935345, 435151219, 435366993, 435582666, 435798238,
+    436013709, 436229080, 436444350, 436659520, 436874589, 437089557,
+    437304425, 437519193, 437733860, 437948427, 438162893, 438377259,
+    438591524, 438805690, 439019755, 439233720, 439447584, 439661349,
+    439875013, 440088577, 440302041, 440515405, 440728669, 440941832,
+    441154896, 441367860, 441580724, 441793488, 442006152, 442218717,
+    442431181, 442643546, 442855811, 443067976, 443280042, 443492008,
+    443703874, 443915641, 444127308, 444338876, 444550344, 444761712,
+    444972981, 445184151, 445395221, 445606192, 445817064, 446027836,
+    446238509, 446449082, 446659557, 446869932, 447080208, 447290385,
+    447500463, 447710442, 447920322, 448130103, 448339785, 448549368,
+    448758852, 448968237, 449177523, 449386710, 449595799, 449804789,
+    450013680, 450222472, 450431166, 450639761, 450848258, 451056656,
+    451264955, 451473156, 451681259, 451889263, 452097168, 452304975,
+    452512684, 452720295, 452927807, 453135221, 453342536, 453549754,
+    453756873, 453963895, 454170818, 454377643, 454584370, 454790999,
+    454997530, 455203963, 455410298, 455616535, 455822675, 456028716,
+    456234660, 456440506, 456646255, 456851905, 457057458, 457262914,
+    457468272, 457673532, 457878695, 458083760, 458288728, 458493598,
+    458698371, 458903047, 459107625, 459312106, 459516490, 459720776,
+    459924966, 460129058, 460333053, 460536951, 460740752, 460944456,
+    461148063, 461351572, 461554985, 461758301, 461961521, 462164643,
+    462367669, 462570597, 462773429, 462976165, 463178803, 463381346,
+    463583791, 463786140, 463988392, 464190548, 464392608, 464594571,
+    464796437, 464998207, 465199881, 465401459, 465602940, 465804325,
+    466005614, 466206807, 466407904, 466608904, 466809809, 467010617,
+    467211330, 467411947, 467612467, 467812892, 468013221, 468213454,
+    468413591, 468613633, 468813579, 469013429, 469213183, 469412842,
+    469612406, 469811873, 470011246, 470210522, 470409704, 470608790,
+    470807781, 471006676, 471205476, 471404181, 471602790, 471801304,
+    471999724, 472198048, 472396277, 472594410, 472792449, 472990393,
+    473188242, 473385996, 473583655, 473781220, 473978689, 474176064,
+    474373344, 474570529, 474767620, 474964616, 475161517, 475358324,
+    475555037, 475751655, 475948178, 476144607, 476340942, 476537182,
+    476733328, 476929380, 477125337, 477321200, 477516969, 477712644,
+    477908225, 478103712, 478299105, 478494404, 478689608, 478884719,
+    479079736, 479274660, 479469489, 479664225, 479858867, 480053415,
+    480247869, 480442230, 480636498, 480830671, 481024752, 481218738,
+    481412632, 481606432, 481800138, 481993751, 482187271, 482380698,
+    482574031, 482767272, 482960419, 483153473, 483346434, 483539301,
+    483732076, 483924758, 484117347, 484309843, 484502246, 484694557,
+    484886774, 485078899, 485270931, 485462871, 485654717, 485846471,
+    486038133, 486229702, 486421179, 486612563, 486803855, 486995054,
+    487186161, 487377176, 487568098, 487758928, 487949666, 488140312,
+    488330866, 488521327, 488711697, 488901974, 489092160, 489282254,
+    489472255, 489662165, 489851983, 490041710, 490231344, 490420887,
+    490610338, 490799698, 490988966, 491178142, 491367227, 491556220,
+    491745122, 491933932, 492122652, 492311279, 492499816, 492688261,
+    492876615, 493064878, 493253049, 493441130, 493629119, 493817018,
+    494004825, 494192542, 494380167, 494567702, 494755146, 494942499,
+    495129761, 495316932, 495504013, 495691003, 495877903, 496064712,
+    496251430, 496438058, 496624595, 496811042, 496997399, 497183665,
+    497369841, 497555927, 497741922, 497927827, 498113642, 498299367,
+    498485002, 498670547, 498856002, 499041366, 499226641, 499411826,
+    499596921, 499781927, 499966842, 500151668, 500336404, 500521050,
+    500705607, 500890074, 501074452, 501258740, 501442939, 501627048,
+    501811068, 501994998, 502178839, 502362591, 502546254, 502729827,
+    502913311, 503096706, 503280012, 503463229, 503646357, 503829396,
+    504012346, 504195207, 504377980, 504560663, 504743258, 504925764,
+    505108181, 505290509, 505472749, 505654901, 505836964, 506018938,
+    506200824, 506382621, 506564330, 506745951, 506927483, 507108927,
+    507290283, 507471550, 507652730, 507833821, 508014824, 508195740,
+    508376567, 508557306, 508737957, 508918521, 509098996, 509279384,
+    509459684, 509639896, 509820021, 510000058, 510180007, 510359869,
+    510539643, 510719329, 510898929, 511078440, 511257865, 511437202,
+    511616452, 511795614, 511974689, 512153677, 512332578, 512511392,
+    512690119, 512868759, 513047311, 513225777, 513404156, 513582448,
+    513760653, 513938772, 514116803, 514294748, 514472606, 514650378,
+    514828063, 515005661, 515183173, 515360599, 515537938, 515715190,
+    515892356, 516069436, 516246430, 516423337, 516600159, 516776894,
+    516953542, 517130105, 517306582, 517482973, 517659277, 517835496,
+    518011629, 518187676, 518363638, 518539513, 518715303, 518891007,
+    519066625, 519242158, 519417606, 519592967, 519768243, 519943434,
+    520118540, 520293560, 520468494, 520643343, 520818108, 520992786,
+    521167380, 521341889, 521516312, 521690650, 521864904, 522039072,
+    522213156, 522387154, 522561068, 522734897, 522908641, 523082300,
+    523255875, 523429364, 523602770, 523776091, 523949327, 524122478,
+    524295546, 524468528, 524641427, 524814241, 524986971, 525159616,
+    525332177, 525504654, 525677047, 525849356, 526021581, 526193721,
+    526365778, 526537751, 526709640, 526881445, 527053166, 527224803,
+    527396357, 527567826, 527739213, 527910515, 528081734, 528252869,
+    528423921, 528594890, 528765775, 528936576, 529107295, 529277929,
+    529448481, 529618949, 529789335, 529959637, 530129856, 530299991,
+    530470044, 530640014, 530809901, 530979705, 531149426, 531319064,
+    531488619, 531658092, 531827482, 531996789, 532166014, 532335156,
+    532504215, 532673192, 532842087, 533010899, 533179628, 533348276,
+    533516840, 533685323, 533853723, 534022042, 534190278, 534358431,
+    534526503, 534694493, 534862401, 535030227, 535197970, 535365632,
+    535533213, 535700711, 535868127, 536035462, 536202715, 536369887,
+    536536977, 536703985, 536870912,
+};
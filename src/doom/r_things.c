@@ -0,0 +1,462 @@
+/**
+ * Sprites and masked mid textures (Doom's r_things.c)
+ * Core 0 projects the things of each sector the BSP walk reaches and
+ * sorts them far to near. The masked pass then runs per column on
+ * either core: sprites and masked mid textures covering the column are
+ * painted far to near, each clipped by the walls in front of it. Doom
+ * keeps per-drawseg clip arrays for this; here the clip rows are
+ * recomputed from the drawseg, which needs no memory per column.
+ */
+
+#include "r_local.h"
+#include <string.h>
+
+#define SPRITE_FLIP         0x8000  // In sprite_lumps: draw mirrored
+#define SPRITE_MISSING      0xFFFF  // In sprite_lumps: no lump for this rotation
+
+// Sprite type flags
+#define SPR_BRIGHT          0x01    // Full bright
+#define SPR_HANG            0x02    // Hangs from the ceiling
+
+// Thing options (doomdata.h)
+#define MTF_MEDIUM          0x0002  // Present on skill 3 ("Hurt me plenty")
+#define MTF_NOTSINGLE       0x0010  // Multiplayer only
+
+/**
+ * Spawn sprite of a thing type: the first frame of its spawn state
+ */
+typedef struct {
+    int16_t doomednum;
+    char name[5];
+    char frame;
+    uint8_t flags;
+} r_sprite_type_t;
+
+static const r_sprite_type_t sprite_types[] = {
+    // Monsters
+    {3004, "POSS", 'A', 0}, {9, "SPOS", 'A', 0}, {65, "CPOS", 'A', 0},
+    {3001, "TROO", 'A', 0}, {3002, "SARG", 'A', 0}, {58, "SARG", 'A', 0},
+    {3006, "SKUL", 'A', SPR_BRIGHT}, {3005, "HEAD", 'A', 0}, {3003, "BOSS", 'A', 0},
+    {69, "BOS2", 'A', 0}, {68, "BSPI", 'A', 0}, {71, "PAIN", 'A', 0},
+    {66, "SKEL", 'A', 0}, {67, "FATT", 'A', 0}, {64, "VILE", 'A', 0},
+    {16, "CYBR", 'A', 0}, {7, "SPID", 'A', 0}, {84, "SSWV", 'A', 0},
+    // Weapons and ammo
+    {2001, "SHOT", 'A', 0}, {82, "SGN2", 'A', 0}, {2002, "MGUN", 'A', 0},
+    {2003, "LAUN", 'A', 0}, {2004, "PLAS", 'A', 0}, {2005, "CSAW", 'A', 0},
+    {2006, "BFUG", 'A', 0}, {2007, "CLIP", 'A', 0}, {2048, "AMMO", 'A', 0},
+    {2008, "SHEL", 'A', 0}, {2049, "SBOX", 'A', 0}, {2010, "ROCK", 'A', 0},
+    {2046, "BROK", 'A', 0}, {2047, "CELL", 'A', 0}, {17, "CELP", 'A', 0},
+    {8, "BPAK", 'A', 0},
+    // Health, armor, powerups and keys
+    {2011, "STIM", 'A', 0}, {2012, "MEDI", 'A', 0}, {2014, "BON1", 'A', 0},
+    {2015, "BON2", 'A', 0}, {2018, "ARM1", 'A', 0}, {2019, "ARM2", 'A', 0},
+    {2013, "SOUL", 'A', SPR_BRIGHT}, {83, "MEGA", 'A', SPR_BRIGHT},
+    {2022, "PINV", 'A', SPR_BRIGHT}, {2023, "PSTR", 'A', SPR_BRIGHT},
+    {2024, "PINS", 'A', SPR_BRIGHT}, {2025, "SUIT", 'A', SPR_BRIGHT},
+    {2026, "PMAP", 'A', SPR_BRIGHT}, {2045, "PVIS", 'A', SPR_BRIGHT},
+    {5, "BKEY", 'A', 0}, {6, "YKEY", 'A', 0}, {13, "RKEY", 'A', 0},
+    {40, "BSKU", 'A', 0}, {39, "YSKU", 'A', 0}, {38, "RSKU", 'A', 0},
+    // Decorations
+    {2035, "BAR1", 'A', 0}, {70, "FCAN", 'A', SPR_BRIGHT}, {43, "TRE1", 'A', 0},
+    {54, "TRE2", 'A', 0}, {47, "SMIT", 'A', 0}, {48, "ELEC", 'A', 0},
+    {34, "CAND", 'A', SPR_BRIGHT}, {35, "CBRA", 'A', SPR_BRIGHT},
+    {44, "TBLU", 'A', SPR_BRIGHT}, {45, "TGRN", 'A', SPR_BRIGHT},
+    {46, "TRED", 'A', SPR_BRIGHT}, {55, "SMBT", 'A', SPR_BRIGHT},
+    {56, "SMGT", 'A', SPR_BRIGHT}, {57, "SMRT", 'A', SPR_BRIGHT},
+    {85, "TLMP", 'A', SPR_BRIGHT}, {86, "TLP2", 'A', SPR_BRIGHT},
+    {2028, "COLU", 'A', SPR_BRIGHT}, {30, "COL1", 'A', 0}, {31, "COL2", 'A', 0},
+    {32, "COL3", 'A', 0}, {33, "COL4", 'A', 0}, {36, "COL5", 'A', 0},
+    {37, "COL6", 'A', 0}, {41, "CEYE", 'A', SPR_BRIGHT}, {42, "FSKU", 'A', SPR_BRIGHT},
+    // Corpses and gore
+    {15, "PLAY", 'N', 0}, {10, "PLAY", 'W', 0}, {12, "PLAY", 'W', 0},
+    {18, "POSS", 'L', 0}, {19, "SPOS", 'L', 0}, {20, "TROO", 'M', 0},
+    {21, "SARG", 'N', 0}, {22, "HEAD", 'L', 0}, {24, "POL5", 'A', 0},
+    {25, "POL1", 'A', 0}, {26, "POL6", 'A', 0}, {27, "POL4", 'A', 0},
+    {28, "POL2", 'A', 0}, {29, "POL3", 'A', SPR_BRIGHT},
+    {49, "GOR1", 'A', SPR_HANG}, {50, "GOR2", 'A', SPR_HANG}, {51, "GOR3", 'A', SPR_HANG},
+    {52, "GOR4", 'A', SPR_HANG}, {53, "GOR5", 'A', SPR_HANG}, {59, "GOR2", 'A', SPR_HANG},
+    {60, "GOR4", 'A', SPR_HANG}, {61, "GOR3", 'A', SPR_HANG}, {62, "GOR5", 'A', SPR_HANG},
+    {63, "GOR1", 'A', SPR_HANG}, {73, "HDB1", 'A', SPR_HANG}, {74, "HDB2", 'A', SPR_HANG},
+    {75, "HDB3", 'A', SPR_HANG}, {76, "HDB4", 'A', SPR_HANG}, {77, "HDB5", 'A', SPR_HANG},
+    {78, "HDB6", 'A', SPR_HANG},
+};
+
+#define NUM_SPRITE_TYPES ((int)(sizeof(sprite_types) / sizeof(sprite_types[0])))
+
+int r_num_sprite_types(void) {
+    return NUM_SPRITE_TYPES;
+}
+
+int r_sprite_type(int doomednum) {
+    for (int i = 0; i < NUM_SPRITE_TYPES; i++) {
+        if (sprite_types[i].doomednum == doomednum) {
+            return i;
+        }
+    }
+    return R_NOSPRITE;
+}
+
+static inline int16_t read16(const uint8_t *p) {
+    return (int16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t read32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Find the lump for a rotation (1-8) of a sprite type's frame
+ * Rotation 0 covers all angles; "XXXXA2A8" serves rotation 2 as drawn
+ * and rotation 8 mirrored. Resolved once per level and remembered.
+ */
+static uint16_t sprite_lump(int type, int rotation) {
+    uint16_t *slot = &r->sprite_lumps[type][rotation - 1];
+    if (*slot) {
+        return *slot;
+    }
+    
+    const r_sprite_type_t *def = &sprite_types[type];
+    char name[9];
+    memcpy(name, def->name, 4);
+    name[4] = def->frame;
+    name[6] = 0;
+    name[8] = 0;
+    
+    name[5] = '0';
+    int lump = wad_set_find(r->set, name);
+    uint16_t flip = 0;
+    if (lump < 0) {
+        name[5] = (char)('0' + rotation);
+        lump = wad_set_find(r->set, name);
+    }
+    if (lump < 0) {
+        // Mirrored pairs: 2/8, 3/7, 4/6
+        int partner = 10 - rotation;
+        name[6] = def->frame;
+        name[5] = (char)('0' + rotation);
+        name[7] = (char)('0' + partner);
+        lump = wad_set_find(r->set, name);
+        if (lump < 0) {
+            name[5] = (char)('0' + partner);
+            name[7] = (char)('0' + rotation);
+            lump = wad_set_find(r->set, name);
+            flip = SPRITE_FLIP;
+        }
+    }
+    
+    *slot = lump < 0 ? SPRITE_MISSING : (uint16_t)(lump | flip);
+    return *slot;
+}
+
+bool r_prefetch_sprite(int type, int rotation) {
+    uint16_t lump = sprite_lump(type, rotation);
+    if (lump == SPRITE_MISSING) {
+        return true;
+    }
+    return wad_set_prefetch_lump(r->set, lump & ~SPRITE_FLIP, LUMP_CACHE_PURGELEVEL);
+}
+
+/**
+ * Project one thing into a vissprite (R_ProjectSprite)
+ */
+static void project_sprite(int index, const level_sector_state_t *sector) {
+    const level_thing_t *thing = &r->level->things[index];
+    int type = r->thing_sprite[index];
+    if (type == R_NOSPRITE || (thing->options & MTF_NOTSINGLE) || !(thing->options & MTF_MEDIUM)) {
+        return;
+    }
+    
+    fixed_t gx = thing->x << FRACBITS;
+    fixed_t gy = thing->y << FRACBITS;
+    fixed_t tr_x = gx - r->viewx;
+    fixed_t tr_y = gy - r->viewy;
+    
+    // Depth, then sideways offset, in view space
+    fixed_t tz = FixedMul(tr_x, r->viewcos) + FixedMul(tr_y, r->viewsin);
+    if (tz < MINZ) {
+        return;
+    }
+    fixed_t xscale = FixedDiv(CENTERX * FRACUNIT, tz);
+    fixed_t tx = FixedMul(tr_x, r->viewsin) - FixedMul(tr_y, r->viewcos);
+    if ((tx < 0 ? -tx : tx) > (tz << 2)) {
+        return;
+    }
+    
+    // Rotation seen from the view
+    angle_t facing = ANG45 * (angle_t)(thing->angle / 45);
+    int rotation = (int)((r_point_to_angle(gx, gy) - facing + (unsigned)(ANG45 / 2) * 9) >> 29) + 1;
+    uint16_t lump = sprite_lump(type, rotation);
+    if (lump == SPRITE_MISSING) {
+        return;
+    }
+    const uint8_t *patch = r_frame_lump(lump & ~SPRITE_FLIP);
+    if (!patch) {
+        return;
+    }
+    int width = read16(patch);
+    int height = read16(patch + 2);
+    int leftoffset = read16(patch + 4);
+    int topoffset = read16(patch + 6);
+    if (width <= 0) {
+        return;
+    }
+    
+    tx -= leftoffset << FRACBITS;
+    int x1 = (CENTERX * FRACUNIT + FixedMul(tx, xscale)) >> FRACBITS;
+    if (x1 > R_WIDTH) {
+        return;
+    }
+    tx += width << FRACBITS;
+    int x2 = ((CENTERX * FRACUNIT + FixedMul(tx, xscale)) >> FRACBITS) - 1;
+    if (x2 < 0) {
+        return;
+    }
+    if (r->num_vissprites == MAXVISSPRITES) {
+        r->stats.overflows++;
+        return;
+    }
+    
+    fixed_t gz = (sprite_types[type].flags & SPR_HANG) ?
+                 sector->ceiling_height - (height << FRACBITS) : sector->floor_height;
+    
+    r_vissprite_t *vis = &r->vissprites[r->num_vissprites++];
+    vis->gx = gx;
+    vis->gy = gy;
+    vis->scale = xscale;
+    vis->texturemid = gz + (topoffset << FRACBITS) - r->viewz;
+    vis->x1 = (int16_t)(x1 < 0 ? 0 : x1);
+    vis->x2 = (int16_t)(x2 >= R_WIDTH ? R_WIDTH - 1 : x2);
+    vis->patch = patch;
+    
+    fixed_t iscale = FixedDiv(FRACUNIT, xscale);
+    if (lump & SPRITE_FLIP) {
+        vis->startfrac = (width << FRACBITS) - 1;
+        vis->xiscale = -iscale;
+    } else {
+        vis->startfrac = 0;
+        vis->xiscale = iscale;
+    }
+    if (vis->x1 > x1) {
+        vis->startfrac += vis->xiscale * (vis->x1 - x1);
+    }
+    
+    vis->colormap = (sprite_types[type].flags & SPR_BRIGHT) ? 0 :
+                    (uint8_t)r_scale_light(r_sector_light(sector->light), xscale);
+}
+
+void r_add_sprites(int sector) {
+    if (r->sector_seen[sector]) {
+        return;
+    }
+    r->sector_seen[sector] = 1;
+    
+    const level_sector_state_t *state = &r->level->sector_state[sector];
+    for (uint16_t i = r->sector_things[sector]; i != LEVEL_NONE; i = r->thing_next[i]) {
+        project_sprite(i, state);
+    }
+}
+
+void r_sort_sprites(void) {
+    // Insertion sort by scale, smallest (farthest) first
+    for (int i = 0; i < r->num_vissprites; i++) {
+        fixed_t scale = r->vissprites[i].scale;
+        int j = i;
+        while (j > 0 && r->vissprites[r->sprite_order[j - 1]].scale > scale) {
+            r->sprite_order[j] = r->sprite_order[j - 1];
+            j--;
+        }
+        r->sprite_order[j] = (uint8_t)i;
+    }
+}
+
+/**
+ * Narrow [top, bottom] (exclusive clip rows) to what a drawseg leaves
+ * open at column x: the rows its column loop left in ceilingclip and
+ * floorclip
+ */
+static void clip_to_drawseg(const r_drawseg_t *ds, int x, int *top, int *bottom) {
+    if (ds->flags & DS_SOLID) {
+        *top = R_HEIGHT;
+        *bottom = -1;
+        return;
+    }
+    
+    const fixed_t centeryfrac = CENTERY << (FRACBITS - 4);
+    fixed_t scale = ds->scale1 + (x - ds->x1) * ds->scalestep;
+    
+    int ceiling;
+    if (ds->worldhigh < ds->worldtop) {
+        ceiling = (centeryfrac - FixedMul(ds->worldhigh, scale)) >> HEIGHTBITS;
+    } else {
+        ceiling = ((centeryfrac - FixedMul(ds->worldtop, scale) + HEIGHTUNIT - 1) >> HEIGHTBITS) - 1;
+    }
+    if (ceiling > *top) {
+        *top = ceiling;
+    }
+    
+    int floor;
+    if (ds->worldlow > ds->worldbottom) {
+        floor = (centeryfrac - FixedMul(ds->worldlow, scale) + HEIGHTUNIT - 1) >> HEIGHTBITS;
+    } else {
+        floor = ((centeryfrac - FixedMul(ds->worldbottom, scale)) >> HEIGHTBITS) + 1;
+    }
+    if (floor < *bottom) {
+        *bottom = floor;
+    }
+}
+
+/**
+ * Check whether a drawseg is in front of a sprite (R_DrawSprite)
+ */
+static bool drawseg_in_front(const r_drawseg_t *ds, const r_vissprite_t *spr) {
+    fixed_t scale1 = ds->scale1;
+    fixed_t scale2 = ds->scale1 + (ds->x2 - ds->x1) * ds->scalestep;
+    fixed_t lowscale = scale1 < scale2 ? scale1 : scale2;
+    fixed_t highscale = scale1 < scale2 ? scale2 : scale1;
+    if (highscale < spr->scale) {
+        return false;
+    }
+    if (lowscale < spr->scale && !r_point_on_seg_side(spr->gx, spr->gy, &r->level->segs[ds->seg])) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Draw column x of a sprite (R_DrawVisSprite and R_DrawMaskedColumn)
+ */
+static void draw_sprite_column(const r_vissprite_t *spr, int x, uint8_t *column, int ys) {
+    int top = -1;
+    int bottom = R_HEIGHT;
+    for (int i = 0; i < r->num_drawsegs && top < bottom - 1; i++) {
+        const r_drawseg_t *ds = &r->drawsegs[i];
+        if (x >= ds->x1 && x <= ds->x2 && drawseg_in_front(ds, spr)) {
+            clip_to_drawseg(ds, x, &top, &bottom);
+        }
+    }
+    if (top >= bottom - 1) {
+        return;
+    }
+    
+    const uint8_t *patch = spr->patch;
+    int width = read16(patch);
+    int texturecolumn = (spr->startfrac + spr->xiscale * (x - spr->x1)) >> FRACBITS;
+    if (texturecolumn < 0 || texturecolumn >= width) {
+        return;
+    }
+    
+    fixed_t spryscale = spr->scale;
+    fixed_t iscale = spr->xiscale < 0 ? -spr->xiscale : spr->xiscale;
+    fixed_t sprtopscreen = CENTERY * FRACUNIT - FixedMul(spr->texturemid, spryscale);
+    const uint8_t *colormap = r->colormaps + spr->colormap * 256;
+    
+    // Posts: top delta, length, pad, pixels, pad; 0xFF ends the column
+    const uint8_t *post = patch + read32(patch + 8 + texturecolumn * 4);
+    while (post[0] != 0xFF) {
+        int topdelta = post[0];
+        int length = post[1];
+        fixed_t topscreen = sprtopscreen + spryscale * topdelta;
+        fixed_t bottomscreen = topscreen + spryscale * length;
+        int yl = (topscreen + FRACUNIT - 1) >> FRACBITS;
+        int yh = (bottomscreen - 1) >> FRACBITS;
+        if (yh >= bottom) {
+            yh = bottom - 1;
+        }
+        if (yl <= top) {
+            yl = top + 1;
+        }
+        if (yl <= yh) {
+            fixed_t texturemid = spr->texturemid - (topdelta << FRACBITS);
+            fixed_t frac = texturemid + (yl - CENTERY) * iscale;
+            r_draw_masked_column(column + yl * ys, ys, yh - yl + 1, post + 3, length,
+                                 frac, iscale, colormap, false);
+        }
+        post += length + 4;
+    }
+}
+
+/**
+ * Draw column x of a masked mid texture (R_RenderMaskedSegRange)
+ * index: position of the drawseg; everything before it is in front
+ */
+static void draw_masked_seg_column(int index, int x, uint8_t *column, int ys) {
+    const r_drawseg_t *ds = &r->drawsegs[index];
+    const tex_columns_t *textures = r->textures;
+    if (!textures || ds->midtexture < 0 || (uint32_t)ds->midtexture >= textures->num_textures) {
+        return;
+    }
+    
+    // The opening of the line itself, then every nearer wall
+    int top = -1;
+    int bottom = R_HEIGHT;
+    clip_to_drawseg(ds, x, &top, &bottom);
+    for (int i = 0; i < index && top < bottom - 1; i++) {
+        const r_drawseg_t *front = &r->drawsegs[i];
+        if (x >= front->x1 && x <= front->x2) {
+            clip_to_drawseg(front, x, &top, &bottom);
+        }
+    }
+    if (top >= bottom - 1) {
+        return;
+    }
+    
+    fixed_t scale = ds->scale1 + (x - ds->x1) * ds->scalestep;
+    unsigned angle = (ds->centerangle + r->xtoviewangle[x]) >> ANGLETOFINESHIFT;
+    int texturecolumn = (ds->offset - FixedMul(finetangent(angle), ds->distance)) >> FRACBITS;
+    const texcols_texture_t *tex = &textures->textures[ds->midtexture];
+    const uint8_t *source = tex_columns_get(textures, ds->midtexture, texturecolumn);
+    
+    fixed_t iscale = (fixed_t)FixedRecip(scale);
+    fixed_t frac = ds->midtexturemid + (top + 1 - CENTERY) * iscale;
+    const uint8_t *colormap = r->colormaps + r_scale_light(ds->light, scale) * 256;
+    r_draw_masked_column(column + (top + 1) * ys, ys, bottom - top - 1, source, tex->height,
+                         frac, iscale, colormap, (tex->flags & TEXCOLS_HOLES) != 0);
+}
+
+void r_draw_masked(uint8_t *data, int xs, int ys, int x0, int x1) {
+    if (r->num_vissprites == 0 && r->num_masked == 0) {
+        return;
+    }
+    
+    for (int x = x0; x < x1; x++) {
+        uint8_t *column = &data[x * xs];
+        
+        // Merge sprites (far to near) with masked segs (far to near: the
+        // end of the near-to-far list first) by their scale at this column
+        int s = 0;
+        int m = r->num_masked - 1;
+        for (;;) {
+            while (s < r->num_vissprites) {
+                const r_vissprite_t *spr = &r->vissprites[r->sprite_order[s]];
+                if (x >= spr->x1 && x <= spr->x2) {
+                    break;
+                }
+                s++;
+            }
+            while (m >= 0) {
+                const r_drawseg_t *ds = &r->drawsegs[r->masked[m]];
+                if (x >= ds->x1 && x <= ds->x2) {
+                    break;
+                }
+                m--;
+            }
+            if (s >= r->num_vissprites && m < 0) {
+                break;
+            }
+            
+            // A sprite goes first unless the masked seg is behind it
+            bool sprite_first = m < 0;
+            if (!sprite_first && s < r->num_vissprites) {
+                const r_vissprite_t *spr = &r->vissprites[r->sprite_order[s]];
+                sprite_first = drawseg_in_front(&r->drawsegs[r->masked[m]], spr);
+            }
+            if (sprite_first) {
+                draw_sprite_column(&r->vissprites[r->sprite_order[s]], x, column, ys);
+                s++;
+            } else {
+                draw_masked_seg_column(r->masked[m], x, column, ys);
+                m--;
+            }
+        }
+    }
+}
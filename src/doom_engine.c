@@ -1,21 +1,75 @@
 /**
  * Doom engine wrapper implementation
- * Stub for now - full integration will be done in phases
+ * Loads the WAD and levels, moves the player from the input or a demo
+ * and drives the renderer; the kernel benchmark runs until a level is
+ * loaded
  */
 
 #include "doom_engine.h"
 #include "display_adapter.h"
 #include "wad_loader.h"
+#include "wad_image.h"
+#include "wad_set.h"
+#include "tex_columns.h"
+#include "level_loader.h"
+#include "z_zone.h"
+#include "render_split.h"
+#include "kernel_bench.h"
+#include "r_render.h"
+#include "p_player.h"
+#include "g_demo.h"
 #include <stdio.h>
 #include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/regs/addressmap.h"
+
+// Flash offset of the WAD, flashed separately from the firmware (see
+// docs/WAD_SETUP.md)
+#ifndef PICO_DOOM_WAD_FLASH_OFFSET
+#define PICO_DOOM_WAD_FLASH_OFFSET WAD_IMAGE_DEFAULT_FLASH_OFFSET
+#endif
+
+// SRAM for decompressed lumps from a compressed WAD image
+#ifndef PICO_DOOM_LUMP_CACHE_KB
+#define PICO_DOOM_LUMP_CACHE_KB 32
+#endif
+
+// SRAM reserved for pinned copies of the hottest lumps; capture and
+// telemetry builds give up what their buffers take from the zone
+#ifndef PICO_DOOM_PIN_KB
+#define PICO_DOOM_PIN_KB (ZONE_DEBUG_KB < 16 ? 16 - ZONE_DEBUG_KB : 0)
+#endif
+
+// Start in the kernel benchmark even once a level has loaded
+#ifndef PICO_DOOM_KERNEL_BENCH
+#define PICO_DOOM_KERNEL_BENCH 0
+#endif
+
+// End of the firmware in flash (from the SDK linker script)
+extern char __flash_binary_end;
 
 // Global game state
 static bool doom_initialized = false;
-static uint32_t frame_count = 0;
-static int test_pattern_mode = 0;  // 0=color bars, 1=checkerboard, 2=gradient
+static uint32_t gametic = 0;      // Tics run (doom_update calls)
+static bool bench_mode = PICO_DOOM_KERNEL_BENCH;  // Kernel benchmark instead of the view
+static const char *bench_kernel = NULL;  // Last kernel run, NULL if it could not run
+static bool toggle_held = false;  // weapon_next seen on the previous tic
 static wad_file_t *loaded_wad = NULL;
+static wad_set_t wad_set;       // loaded_wad plus any PWADs stacked on it
+static tex_columns_t wall_columns;  // Precomposited textures (TEXCOLS), if packed
+static level_t level;           // Current level (compact format, geometry in flash)
+static bool level_view = false; // Renderer attached to the level
+static bool level_prefetch = false;  // Level's flats and sprites still being queued
+static p_player_t player;       // Player 1
 
-// Simple 8-bit Doom palette (first 16 colors for test)
+// Timedemo: a demo's tics run back to back instead of at 35 Hz
+static bool demo_active = false;
+static bool demo_render = true; // Draw the demo's frames
+static g_demo_t demo;
+static g_timedemo_t timedemo;
+static char demo_name[9];
+
+// Simple 8-bit Doom palette (first 16 colors, used without a WAD)
 // Format: R, G, B for each color
 static const uint8_t test_palette[] = {
     0x00, 0x00, 0x00,  // 0: Black
@@ -36,27 +90,121 @@ static const uint8_t test_palette[] = {
     0x80, 0x80, 0xFF,  // 15: Lavender
 };
 
+// Full 256-color palette used without a WAD
+// 0-15: the named colors above, 16-255: 15 red x 16 green levels
+#define GRADIENT_BASE    16
+#define GRADIENT_R_STEPS 15
+#define GRADIENT_G_STEPS 16
+static uint8_t fallback_palette[256 * 3];
+
+/**
+ * Build the fallback palette
+ */
+static void build_fallback_palette(void) {
+    memset(fallback_palette, 0, sizeof(fallback_palette));
+    memcpy(fallback_palette, test_palette, sizeof(test_palette));
+    
+    for (int r = 0; r < GRADIENT_R_STEPS; r++) {
+        for (int g = 0; g < GRADIENT_G_STEPS; g++) {
+            uint8_t *rgb = &fallback_palette[(GRADIENT_BASE + r * GRADIENT_G_STEPS + g) * 3];
+            rgb[0] = r * 255 / (GRADIENT_R_STEPS - 1);
+            rgb[1] = g * 255 / (GRADIENT_G_STEPS - 1);
+            rgb[2] = 0xC0;
+        }
+    }
+}
+
+/**
+ * Hand the display its palettes
+ * Uses PLAYPAL from the loaded WAD (all 14 palettes are expanded at every
+ * gamma level up front), or the fallback palette without a WAD.
+ */
+static void setup_palettes(void) {
+    if (wad_set.num_wads) {
+        int lump = wad_set_find(&wad_set, "PLAYPAL");
+        const wad_lump_t *playpal = wad_set_lump(&wad_set, lump);
+        const uint8_t *data = wad_set_lump_data(&wad_set, lump);
+        if (data) {
+            int count = playpal->size / 768;
+            if (count > DISPLAY_NUM_PALETTES) {
+                count = DISPLAY_NUM_PALETTES;
+            }
+            if (display_load_palettes(data, count)) {
+                return;
+            }
+        }
+        printf("WARNING: No usable PLAYPAL, using test palette\n");
+    }
+    
+    display_load_palettes(fallback_palette, 1);
+}
+
+/**
+ * Pin the hottest lumps into SRAM
+ * Uses the profile stored in the WAD image (LUMPPROF, see wadpack
+ * --profile) if there is one, otherwise the live profile when profiling.
+ * Run at WAD load, and again at level load once the live profile has
+ * seen some play.
+ */
+static void pin_hot_lumps(void) {
+    int lump = wad_set_find(&wad_set, "LUMPPROF");
+    if (lump >= 0) {
+        const wad_lump_t *entry = wad_set_lump(&wad_set, lump);
+        wad_set_pin_hot(&wad_set, (const char *)wad_set_lump_data(&wad_set, lump), entry->size);
+    } else if (loaded_wad->access) {
+        wad_set_pin_hot(&wad_set, NULL, 0);
+    }
+}
+
 /**
- * Convert RGB888 to RGB565
+ * Map the precomposited wall textures from the image (wadpack --texcols)
+ * wadpack never compresses TEXCOLS, so this is a flash pointer; the
+ * STATIC tag only matters for images built some other way.
  */
-static inline uint16_t rgb888_to_rgb565(uint8_t r, uint8_t g, uint8_t b) {
-    // RGB888 -> RGB565
-    // R: 8 bits -> 5 bits (shift right 3)
-    // G: 8 bits -> 6 bits (shift right 2)
-    // B: 8 bits -> 5 bits (shift right 3)
-    uint16_t rgb565 = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
-    return __builtin_bswap16(rgb565);  // Byte swap for ST7789
+static void setup_wall_columns(void) {
+    memset(&wall_columns, 0, sizeof(wall_columns));
+    const wad_lump_t *lump = wad_find_lump(loaded_wad, "TEXCOLS");
+    if (!lump) {
+        return;
+    }
+    const uint8_t *data = wad_cache_lump(loaded_wad, lump, LUMP_CACHE_STATIC);
+    if (data && tex_columns_init(&wall_columns, data, lump->size)) {
+        printf("Wall textures: %lu precomposited in flash\n", wall_columns.num_textures);
+    }
+}
+
+/**
+ * Finish setting up once a WAD has been loaded into loaded_wad
+ */
+static void wad_loaded(void) {
+#if PICO_DOOM_WAD_BENCHMARK
+    wad_benchmark_lookups(loaded_wad, time_us_64);
+#endif
+#if PICO_DOOM_LUMP_PROFILE
+    wad_profile_enable(loaded_wad);
+#endif
+    wad_set_add(&wad_set, loaded_wad);
+    setup_palettes();
+    pin_hot_lumps();
+    setup_wall_columns();
 }
 
 bool doom_init(void) {
     printf("Initializing Doom engine...\n");
     doom_initialized = true;
-    frame_count = 0;
-    test_pattern_mode = 0;
+    gametic = 0;
+    bench_mode = PICO_DOOM_KERNEL_BENCH;
     loaded_wad = NULL;
-    printf("Doom engine initialized (stub mode)\n");
-    printf("Test patterns available: color bars (0), checkerboard (1), gradient (2)\n");
-    printf("Use weapon_up/down buttons to cycle through patterns\n");
+    wad_set_init(&wad_set);
+    lump_cache_init(PICO_DOOM_LUMP_CACHE_KB * 1024, time_us_64);
+    lump_pin_init(PICO_DOOM_PIN_KB * 1024);
+    build_fallback_palette();
+    setup_palettes();
+    if (!r_init()) {
+        printf("WARNING: No renderer, only the kernel benchmark\n");
+    }
+    printf("Doom engine initialized\n");
+    printf("The kernel benchmark runs until a level loads; weapon_up toggles it\n");
     return true;
 }
 
@@ -68,16 +216,104 @@ bool doom_load_wad(const char *wad_path) {
     
     printf("Loading WAD file: %s\n", wad_path);
     
-    // TODO: Implement flash/filesystem WAD loading
-    // For now, just show instructions on how to provide WAD data
-    printf("WAD loading not yet implemented (Phase 3)\n");
-    printf("To load a WAD file:\n");
-    printf("  1. Extract DOOM1.WAD contents\n");
-    printf("  2. Store in flash storage\n");
-    printf("  3. Call wad_load_from_memory() with the data\n");
-    printf("\nUsing test rendering patterns for now\n");
+    // The WAD lives at a fixed flash offset and is used in place through
+    // the XIP window. The path only names it for the log.
+    const uint8_t *flash_wad = (const uint8_t *)(XIP_BASE + PICO_DOOM_WAD_FLASH_OFFSET);
+    uint32_t max_size = PICO_FLASH_SIZE_BYTES - PICO_DOOM_WAD_FLASH_OFFSET;
     
-    return false;  // Return false since we're stubbed
+    if ((uintptr_t)&__flash_binary_end > (uintptr_t)flash_wad) {
+        printf("Error: Firmware overlaps the WAD at flash offset 0x%X\n", PICO_DOOM_WAD_FLASH_OFFSET);
+        return false;
+    }
+    
+    level_view = false;
+    demo_active = false;
+    r_clear_level();
+    level_free(&level);
+    memset(&wall_columns, 0, sizeof(wall_columns));
+    lump_pin_clear();
+    wad_set_free(&wad_set);
+    if (loaded_wad) {
+        wad_free(loaded_wad);
+        loaded_wad = NULL;
+    }
+    
+    char magic[4];
+    memcpy(magic, flash_wad, sizeof(magic));
+    uint32_t image_magic = WAD_IMAGE_MAGIC;
+    if (memcmp(magic, &image_magic, 4) == 0) {
+        // Packed image: directory and index used in place
+        loaded_wad = wad_map_image(flash_wad, max_size);
+    } else if (memcmp(magic, "IWAD", 4) == 0 || memcmp(magic, "PWAD", 4) == 0) {
+        // Raw WAD: lump data stays in flash, directory is indexed in RAM
+        loaded_wad = wad_load_from_memory(flash_wad, max_size);
+    } else {
+        printf("No WAD found at flash offset 0x%X\n", PICO_DOOM_WAD_FLASH_OFFSET);
+        printf("Pack one with tools/wadpack and flash its UF2 (see docs/WAD_SETUP.md)\n");
+        printf("\nRunning the kernel benchmark instead\n");
+        return false;
+    }
+    
+    if (!loaded_wad) {
+        return false;
+    }
+    
+    wad_loaded();
+    return true;
+}
+
+/**
+ * Turn the key states into a ticcmd (G_BuildTiccmd, walking speed)
+ */
+static void build_ticcmd(const doom_input_t *input, ticcmd_t *cmd) {
+    memset(cmd, 0, sizeof(*cmd));
+    if (input->forward) {
+        cmd->forwardmove += P_FORWARDMOVE;
+    }
+    if (input->backward) {
+        cmd->forwardmove -= P_FORWARDMOVE;
+    }
+    if (input->strafe_right) {
+        cmd->sidemove += P_SIDEMOVE;
+    }
+    if (input->strafe_left) {
+        cmd->sidemove -= P_SIDEMOVE;
+    }
+    if (input->turn_left) {
+        cmd->angleturn += P_ANGLETURN;
+    }
+    if (input->turn_right) {
+        cmd->angleturn -= P_ANGLETURN;
+    }
+    if (input->fire) {
+        cmd->buttons |= P_BT_ATTACK;
+    }
+    if (input->use) {
+        cmd->buttons |= P_BT_USE;
+    }
+}
+
+/**
+ * Run the timedemo's next tic
+ * Each tic is timed from the start of the last one, so it includes the
+ * frame drawn and presented for it.
+ */
+static void demo_tic(void) {
+    uint64_t now = time_us_64();
+    if (demo.tics) {
+        g_timedemo_tic(&timedemo, now, demo_render);
+    } else {
+        g_timedemo_start(&timedemo, now);
+    }
+    
+    ticcmd_t cmd;
+    if (!g_demo_read(&demo, &cmd)) {
+        g_timedemo_report(&timedemo, demo_name);
+        demo_active = false;
+        printf("Timedemo %s finished, back to live input\n", demo_name);
+        return;
+    }
+    p_player_tic(&level, &player, &cmd);
 }
 
 void doom_update(const doom_input_t *input) {
@@ -85,23 +321,52 @@ void doom_update(const doom_input_t *input) {
         return;
     }
     
-    // Check for input to change test pattern
-    if (input) {
-        if (input->weapon_next) {
-            test_pattern_mode = (test_pattern_mode + 1) % 3;
-            printf("Switched to test pattern mode: %d\n", test_pattern_mode);
+    if (demo_active) {
+        // The demo drives the player; live input waits for it to end
+        demo_tic();
+    } else if (input) {
+        // weapon_up switches between the view and the benchmark, once per press
+        if (input->weapon_next && !toggle_held && level_view) {
+            bench_mode = !bench_mode;
+            if (!bench_mode) {
+                kernel_bench_stop();
+            }
+            printf("Switched to %s\n", bench_mode ? "kernel benchmark" : "level view");
         }
-        if (input->weapon_prev && test_pattern_mode > 0) {
-            test_pattern_mode--;
-            printf("Switched to test pattern mode: %d\n", test_pattern_mode);
+        toggle_held = input->weapon_next;
+        
+        if (level_view && !bench_mode) {
+            ticcmd_t cmd;
+            build_ticcmd(input, &cmd);
+            p_player_tic(&level, &player, &cmd);
         }
     }
     
-    // TODO: Update game logic with input
-    frame_count++;
+    gametic++;
 }
 
-void doom_render(uint16_t *framebuffer) {
+/**
+ * Frame state shared by both cores while they draw
+ * Snapshotted on core 0 before the split, so core 1 never sees a half-
+ * updated game state.
+ */
+typedef struct {
+    uint8_t *data;
+    int width;
+    int height;
+    int xs;
+    int ys;
+} render_frame_t;
+
+/**
+ * Draw columns [x0, x1) of the 3D view (runs on either core)
+ */
+static void draw_view_columns(void *ctx, int x0, int x1) {
+    const render_frame_t *frame = (const render_frame_t *)ctx;
+    r_draw_columns(frame->data, frame->xs, frame->ys, x0, x1);
+}
+
+void doom_render(uint8_t *framebuffer) {
     if (!doom_initialized || !framebuffer) {
         return;
     }
@@ -112,61 +377,39 @@ void doom_render(uint16_t *framebuffer) {
         return;
     }
     
-    int width = fb->width;
-    int height = fb->height;
-    
-    // Render test pattern based on current mode
-    switch (test_pattern_mode) {
-        case 0: {
-            // Color bar pattern (vertical stripes)
-            uint16_t colors[] = {
-                rgb888_to_rgb565(test_palette[0], test_palette[1], test_palette[2]),    // Black
-                rgb888_to_rgb565(test_palette[3], test_palette[4], test_palette[5]),    // Red
-                rgb888_to_rgb565(test_palette[6], test_palette[7], test_palette[8]),    // Green
-                rgb888_to_rgb565(test_palette[9], test_palette[10], test_palette[11]),  // Blue
-                rgb888_to_rgb565(test_palette[12], test_palette[13], test_palette[14]), // Yellow
-                rgb888_to_rgb565(test_palette[15], test_palette[16], test_palette[17]), // Magenta
-            };
-            int num_colors = sizeof(colors) / sizeof(colors[0]);
-            int bar_width = width / num_colors;
-            
-            for (int y = 0; y < height; y++) {
-                for (int x = 0; x < width; x++) {
-                    int color_idx = (x / bar_width) % num_colors;
-                    fb->data[y * width + x] = colors[color_idx];
-                }
-            }
-            break;
-        }
-        
-        case 1: {
-            // Checkerboard pattern
-            int checker_size = 8;
-            for (int y = 0; y < height; y++) {
-                for (int x = 0; x < width; x++) {
-                    int checker = ((x / checker_size) + (y / checker_size)) & 1;
-                    uint16_t color = checker ? 
-                        rgb888_to_rgb565(255, 255, 255) :  // White
-                        rgb888_to_rgb565(0, 0, 0);          // Black
-                    fb->data[y * width + x] = color;
-                }
-            }
-            break;
-        }
-        
-        case 2: {
-            // Gradient pattern (left-right)
-            for (int y = 0; y < height; y++) {
-                for (int x = 0; x < width; x++) {
-                    uint8_t r = (x * 255) / width;
-                    uint8_t g = (y * 255) / height;
-                    uint8_t b = 128 + ((frame_count * 2) % 128);
-                    fb->data[y * width + x] = rgb888_to_rgb565(r, g, b);
-                }
-            }
-            break;
-        }
+    // Core 1 only reads this until render_split_run returns
+    render_frame_t frame;
+    frame.data = fb->data;
+    frame.width = fb->width;
+    frame.height = fb->height;
+    frame.xs = fb->x_step;
+    frame.ys = fb->y_step;
+    
+    // A timedemo without rendering only runs tics
+    if (demo_active && !demo_render) {
+        return;
     }
+    
+    // One benchmark kernel per frame, on core 0 alone
+    if (bench_mode || !level_view) {
+        bench_kernel = kernel_bench_step(frame.data, frame.xs, frame.ys, frame.width, frame.height);
+        return;
+    }
+    
+    // Columns are independent, so the two cores split them. The BSP walk
+    // that builds the view's draw lists runs on core 0 first.
+    r_view_t view;
+    p_player_view(&player, &view);
+    r_setup_frame(&view);
+    render_split_run(draw_view_columns, &frame, frame.width);
+    r_finish_frame();
+}
+
+bool doom_service_lumps(uint32_t max_bytes) {
+    if (level_prefetch) {
+        level_prefetch = level_view && r_prefetch_level();
+    }
+    return lump_cache_service(max_bytes);
 }
 
 void doom_get_state(char *buffer, int max_len) {
@@ -174,14 +417,143 @@ void doom_get_state(char *buffer, int max_len) {
         return;
     }
     
-    const char *mode_names[] = {"Bars", "Check", "Grad"};
-    const char *mode_name = (test_pattern_mode < 3) ? mode_names[test_pattern_mode] : "Unknown";
+    if (demo_active && !demo_render) {
+        snprintf(buffer, max_len, "Tic: %lu | Timedemo %s: tic %lu", gametic, demo_name, demo.tics);
+        return;
+    }
+    
+    if (level_view && !bench_mode) {
+        r_stats_t stats;
+        r_get_stats(&stats);
+        snprintf(buffer, max_len, "Tic: %lu | Nodes %u Segs %u Spr %u Drop %u Miss %u", gametic,
+                 stats.nodes, stats.drawsegs, stats.sprites, stats.overflows, stats.missing);
+        return;
+    }
+    
+    snprintf(buffer, max_len, "Tic: %lu | Bench: %s", gametic, bench_kernel ? bench_kernel : "not running");
+}
+
+bool doom_load_level(const char *map) {
+    if (!loaded_wad) {
+        return false;
+    }
+    if (!map) {
+        map = wad_set_find(&wad_set, "E1M1") >= 0 ? "E1M1" : "MAP01";
+    }
+    
+    level_view = false;
+    level_prefetch = false;
+    demo_active = false;
+    kernel_bench_stop();
+    r_clear_level();
+    level_free(&level);
+    Z_FreeTags(PU_LEVEL, PU_PURGELEVEL - 1);
+    lump_cache_purge_tag(LUMP_CACHE_LEVEL);
+    
+    // The live profile has now seen the last level's lumps. Repinning
+    // rewrites the pinned copies and drops cached ones, so do it before
+    // the level, the renderer or the wall store take pointers to them.
+    pin_hot_lumps();
+    setup_wall_columns();
+    
+    level_load_stats_t stats;
+    if (!level_load(&level, &wad_set, map, time_us_64, &stats)) {
+        return false;
+    }
+    printf("Level %s: %lu vertexes, %lu lines, %lu sectors, %lu subsectors\n", map,
+           level.header->num_vertexes, level.header->num_lines,
+           level.header->num_sectors, level.header->num_subsectors);
+    printf("Level load: %lu us | %lu bytes SRAM arena | %lu bytes read in place from flash\n",
+           stats.load_us, stats.ram_bytes, stats.flash_bytes);
+    
+#if PICO_DOOM_LEVEL_COMPARE
+    level_load_stats_t classic;
+    if (level_load_classic(&wad_set, doom_get_wall_columns(), map, time_us_64, &classic)) {
+        printf("Classic load: %lu us | %lu bytes SRAM (compact uses %lu%%)\n",
+               classic.load_us, classic.ram_bytes,
+               classic.ram_bytes ? stats.ram_bytes * 100 / classic.ram_bytes : 0);
+    }
+#endif
+    
+    if (!p_spawn_player(&level, &player)) {
+        printf("WARNING: %s has no player 1 start\n", map);
+    }
+    level_view = r_set_level(&level, &wad_set, doom_get_wall_columns(), r_sky_name(map));
+    if (!level_view) {
+        printf("WARNING: Renderer could not attach to %s, running the kernel benchmark\n", map);
+    }
+    
+    level_prefetch = level_view;
+    return true;
+}
+
+bool doom_timedemo(const char *name, bool render) {
+    if (!loaded_wad) {
+        return false;
+    }
+    int lump = wad_set_find(&wad_set, name);
+    if (lump < 0) {
+        printf("Error: Demo %s not found\n", name);
+        return false;
+    }
+    const wad_lump_t *entry = wad_set_lump(&wad_set, lump);
+    
+    // The header names the map; loading it purges the level cache, so the
+    // demo is cached again for the level once it is in
+    if (!g_demo_open(&demo, wad_set_cache_lump(&wad_set, lump, LUMP_CACHE_PURGELEVEL), entry->size)) {
+        return false;
+    }
+    char map[9];
+    g_demo_map_name(&demo, wad_set_find(&wad_set, "E1M1") < 0, map);
+    if (!doom_load_level(map)) {
+        printf("Error: Demo %s needs %s\n", name, map);
+        return false;
+    }
+    if (!level_view ||
+        !g_demo_open(&demo, wad_set_cache_lump(&wad_set, lump, LUMP_CACHE_LEVEL), entry->size)) {
+        return false;
+    }
     
-    snprintf(buffer, max_len, "Frame: %lu | Pattern: %s", frame_count, mode_name);
+    snprintf(demo_name, sizeof(demo_name), "%s", name);
+    demo_active = true;
+    demo_render = render;
+    if (bench_mode) {
+        bench_mode = false;
+        kernel_bench_stop();
+    }
+    printf("Timedemo %s: %s, skill %u, version %u, %u player(s), %s\n", demo_name, map,
+           demo.skill + 1, demo.version, demo.num_players, render ? "rendering" : "not rendering");
+    return true;
+}
+
+bool doom_timedemo_active(bool *render) {
+    if (render) {
+        *render = demo_render;
+    }
+    return demo_active;
+}
+
+const level_t* doom_get_level(void) {
+    return level.header ? &level : NULL;
+}
+
+const tex_columns_t* doom_get_wall_columns(void) {
+    return wall_columns.base ? &wall_columns : NULL;
+}
+
+void doom_dump_lump_profile(uint32_t max_lumps) {
+    wad_set_dump_profile(&wad_set, max_lumps);
 }
 
 void doom_shutdown(void) {
     printf("Shutting down Doom engine\n");
+    level_view = false;
+    demo_active = false;
+    r_clear_level();
+    level_free(&level);
+    memset(&wall_columns, 0, sizeof(wall_columns));
+    lump_pin_clear();
+    wad_set_free(&wad_set);
     if (loaded_wad) {
         wad_free(loaded_wad);
         loaded_wad = NULL;
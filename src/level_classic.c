@@ -0,0 +1,404 @@
+/**
+ * Classic level loader, for comparison with the compact format
+ *
+ * Loads a map from its raw lumps the way p_setup.c does, into the
+ * engine's pointer-based structs (r_defs.h layouts for a 32-bit target),
+ * including the REJECT and BLOCKMAP copies and P_GroupLines' per-sector
+ * line arrays. It measures the time and RAM, then frees everything.
+ */
+
+#include "level_loader.h"
+#include "z_zone.h"
+#include <stdio.h>
+#include <string.h>
+
+// Lumps after the map marker
+enum {
+    ML_THINGS = 1, ML_LINEDEFS, ML_SIDEDEFS, ML_VERTEXES, ML_SEGS,
+    ML_SSECTORS, ML_NODES, ML_SECTORS, ML_REJECT, ML_BLOCKMAP
+};
+
+#define CLASSIC_MAX_ALLOCS 16
+
+#define MAPBLOCKSHIFT (FRACBITS + 7)
+#define MAXRADIUS     (32 * FRACUNIT)
+
+typedef struct {
+    void *prev, *next, *function;       // thinker_t
+    fixed_t x, y, z;
+} classic_degenmobj_t;
+
+typedef struct {
+    fixed_t x, y;
+} classic_vertex_t;
+
+typedef struct classic_line_s classic_line_t;
+
+typedef struct {
+    fixed_t floorheight, ceilingheight;
+    int16_t floorpic, ceilingpic;
+    int16_t lightlevel, special, tag;
+    int soundtraversed;
+    void *soundtarget;
+    int blockbox[4];
+    classic_degenmobj_t soundorg;
+    int validcount;
+    void *thinglist;
+    void *specialdata;
+    int linecount;
+    classic_line_t **lines;
+} classic_sector_t;
+
+typedef struct {
+    fixed_t textureoffset, rowoffset;
+    int16_t toptexture, bottomtexture, midtexture;
+    classic_sector_t *sector;
+} classic_side_t;
+
+struct classic_line_s {
+    classic_vertex_t *v1, *v2;
+    fixed_t dx, dy;
+    int16_t flags, special, tag;
+    int16_t sidenum[2];
+    fixed_t bbox[4];
+    int slopetype;
+    classic_sector_t *frontsector, *backsector;
+    int validcount;
+    void *specialdata;
+};
+
+typedef struct {
+    classic_vertex_t *v1, *v2;
+    fixed_t offset;
+    angle_t angle;
+    classic_side_t *sidedef;
+    classic_line_t *linedef;
+    classic_sector_t *frontsector, *backsector;
+} classic_seg_t;
+
+typedef struct {
+    classic_sector_t *sector;
+    int16_t numlines, firstline;
+} classic_subsector_t;
+
+typedef struct {
+    fixed_t x, y, dx, dy;
+    fixed_t bbox[2][4];
+    uint16_t children[2];
+} classic_node_t;
+
+/**
+ * Allocation tracking, so the RAM can be reported and freed
+ */
+typedef struct {
+    void *blocks[CLASSIC_MAX_ALLOCS];
+    uint32_t num_blocks;
+    uint32_t bytes;
+} classic_allocs_t;
+
+static void *classic_alloc(classic_allocs_t *allocs, uint32_t size) {
+    if (allocs->num_blocks == CLASSIC_MAX_ALLOCS) {
+        return NULL;
+    }
+    void *block = Z_Malloc(size ? size : 1, PU_LEVEL, NULL);
+    if (block) {
+        memset(block, 0, size);
+        allocs->blocks[allocs->num_blocks++] = block;
+        allocs->bytes += size;
+    }
+    return block;
+}
+
+static int16_t rd16(const uint8_t *p) {
+    return (int16_t)(p[0] | (p[1] << 8));
+}
+
+/**
+ * Map lump data; the loader is done with each lump before it asks for
+ * the next, like W_CacheLumpNum(PU_STATIC) followed by Z_Free
+ */
+static const uint8_t *map_lump(const wad_set_t *set, int marker, int which, uint32_t *size) {
+    const wad_lump_t *entry = wad_set_lump(set, marker + which);
+    *size = entry ? entry->size : 0;
+    return entry ? wad_set_lump_data(set, marker + which) : NULL;
+}
+
+/**
+ * R_TextureNumForName
+ */
+static int16_t texture_number(const tex_columns_t *textures, const uint8_t *raw) {
+    if (raw[0] == '-' || !textures) {
+        return 0;
+    }
+    char name[9] = {0};
+    memcpy(name, raw, 8);
+    int number = tex_columns_find(textures, name);
+    return number < 0 ? 0 : number;
+}
+
+static int16_t flat_number(const wad_set_t *set, const uint8_t *raw) {
+    char name[9] = {0};
+    memcpy(name, raw, 8);
+    int number = wad_set_find_in(set, WAD_NS_FLATS, name);
+    return number < 0 ? 0 : number;
+}
+
+bool level_load_classic(const wad_set_t *set, const tex_columns_t *textures, const char *map,
+                        uint64_t (*clock_us)(void), level_load_stats_t *stats) {
+    uint64_t start = clock_us ? clock_us() : 0;
+    classic_allocs_t allocs;
+    memset(&allocs, 0, sizeof(allocs));
+    bool ok = false;
+    
+    int marker = wad_set_find(set, map);
+    if (marker < 0 || (uint32_t)marker + ML_BLOCKMAP >= set->num_lumps) {
+        printf("Error: Map %s not found\n", map);
+        return false;
+    }
+    
+    uint32_t size;
+    const uint8_t *data;
+    
+    // P_LoadVertexes
+    data = map_lump(set, marker, ML_VERTEXES, &size);
+    uint32_t num_vertexes = size / 4;
+    classic_vertex_t *vertexes = classic_alloc(&allocs, num_vertexes * sizeof(classic_vertex_t));
+    if (!data || !vertexes) {
+        goto done;
+    }
+    for (uint32_t i = 0; i < num_vertexes; i++) {
+        vertexes[i].x = rd16(data + i * 4) << FRACBITS;
+        vertexes[i].y = rd16(data + i * 4 + 2) << FRACBITS;
+    }
+    
+    // P_LoadSectors
+    data = map_lump(set, marker, ML_SECTORS, &size);
+    uint32_t num_sectors = size / 26;
+    classic_sector_t *sectors = classic_alloc(&allocs, num_sectors * sizeof(classic_sector_t));
+    if (!data || !sectors) {
+        goto done;
+    }
+    for (uint32_t i = 0; i < num_sectors; i++) {
+        const uint8_t *p = data + i * 26;
+        classic_sector_t *sec = &sectors[i];
+        sec->floorheight = rd16(p) << FRACBITS;
+        sec->ceilingheight = rd16(p + 2) << FRACBITS;
+        sec->floorpic = flat_number(set, p + 4);
+        sec->ceilingpic = flat_number(set, p + 12);
+        sec->lightlevel = rd16(p + 20);
+        sec->special = rd16(p + 22);
+        sec->tag = rd16(p + 24);
+    }
+    
+    // P_LoadSideDefs
+    data = map_lump(set, marker, ML_SIDEDEFS, &size);
+    uint32_t num_sides = size / 30;
+    classic_side_t *sides = classic_alloc(&allocs, num_sides * sizeof(classic_side_t));
+    if (!data || !sides) {
+        goto done;
+    }
+    for (uint32_t i = 0; i < num_sides; i++) {
+        const uint8_t *p = data + i * 30;
+        classic_side_t *side = &sides[i];
+        uint16_t sector = rd16(p + 28);
+        if (sector >= num_sectors) {
+            goto done;
+        }
+        side->textureoffset = rd16(p) << FRACBITS;
+        side->rowoffset = rd16(p + 2) << FRACBITS;
+        side->toptexture = texture_number(textures, p + 4);
+        side->bottomtexture = texture_number(textures, p + 12);
+        side->midtexture = texture_number(textures, p + 20);
+        side->sector = &sectors[sector];
+    }
+    
+    // P_LoadLineDefs
+    data = map_lump(set, marker, ML_LINEDEFS, &size);
+    uint32_t num_lines = size / 14;
+    classic_line_t *lines = classic_alloc(&allocs, num_lines * sizeof(classic_line_t));
+    if (!data || !lines) {
+        goto done;
+    }
+    for (uint32_t i = 0; i < num_lines; i++) {
+        const uint8_t *p = data + i * 14;
+        classic_line_t *ld = &lines[i];
+        uint16_t v1 = rd16(p), v2 = rd16(p + 2);
+        ld->flags = rd16(p + 4);
+        ld->special = rd16(p + 6);
+        ld->tag = rd16(p + 8);
+        ld->sidenum[0] = rd16(p + 10);
+        ld->sidenum[1] = rd16(p + 12);
+        if (v1 >= num_vertexes || v2 >= num_vertexes ||
+            (uint16_t)ld->sidenum[0] >= num_sides ||
+            (ld->sidenum[1] != -1 && (uint16_t)ld->sidenum[1] >= num_sides)) {
+            goto done;
+        }
+        ld->v1 = &vertexes[v1];
+        ld->v2 = &vertexes[v2];
+        ld->dx = ld->v2->x - ld->v1->x;
+        ld->dy = ld->v2->y - ld->v1->y;
+        if (!ld->dx) {
+            ld->slopetype = LEVEL_SLOPE_VERTICAL;
+        } else if (!ld->dy) {
+            ld->slopetype = LEVEL_SLOPE_HORIZONTAL;
+        } else {
+            ld->slopetype = ((ld->dx > 0) == (ld->dy > 0)) ? LEVEL_SLOPE_POSITIVE : LEVEL_SLOPE_NEGATIVE;
+        }
+        ld->bbox[LEVEL_BOXLEFT] = ld->v1->x < ld->v2->x ? ld->v1->x : ld->v2->x;
+        ld->bbox[LEVEL_BOXRIGHT] = ld->v1->x < ld->v2->x ? ld->v2->x : ld->v1->x;
+        ld->bbox[LEVEL_BOXBOTTOM] = ld->v1->y < ld->v2->y ? ld->v1->y : ld->v2->y;
+        ld->bbox[LEVEL_BOXTOP] = ld->v1->y < ld->v2->y ? ld->v2->y : ld->v1->y;
+        ld->frontsector = sides[ld->sidenum[0]].sector;
+        ld->backsector = ld->sidenum[1] != -1 ? sides[ld->sidenum[1]].sector : NULL;
+    }
+    
+    // P_LoadSubsectors
+    data = map_lump(set, marker, ML_SSECTORS, &size);
+    uint32_t num_subsectors = size / 4;
+    classic_subsector_t *subsectors = classic_alloc(&allocs, num_subsectors * sizeof(classic_subsector_t));
+    if (!data || !subsectors) {
+        goto done;
+    }
+    for (uint32_t i = 0; i < num_subsectors; i++) {
+        subsectors[i].numlines = rd16(data + i * 4);
+        subsectors[i].firstline = rd16(data + i * 4 + 2);
+    }
+    
+    // P_LoadNodes
+    data = map_lump(set, marker, ML_NODES, &size);
+    uint32_t num_nodes = size / 28;
+    classic_node_t *nodes = classic_alloc(&allocs, num_nodes * sizeof(classic_node_t));
+    if (!data || !nodes) {
+        goto done;
+    }
+    for (uint32_t i = 0; i < num_nodes; i++) {
+        const uint8_t *p = data + i * 28;
+        classic_node_t *node = &nodes[i];
+        node->x = rd16(p) << FRACBITS;
+        node->y = rd16(p + 2) << FRACBITS;
+        node->dx = rd16(p + 4) << FRACBITS;
+        node->dy = rd16(p + 6) << FRACBITS;
+        for (int c = 0; c < 2; c++) {
+            node->children[c] = rd16(p + 24 + c * 2);
+            for (int b = 0; b < 4; b++) {
+                node->bbox[c][b] = rd16(p + 8 + c * 8 + b * 2) << FRACBITS;
+            }
+        }
+    }
+    
+    // P_LoadSegs
+    data = map_lump(set, marker, ML_SEGS, &size);
+    uint32_t num_segs = size / 12;
+    classic_seg_t *segs = classic_alloc(&allocs, num_segs * sizeof(classic_seg_t));
+    if (!data || !segs) {
+        goto done;
+    }
+    for (uint32_t i = 0; i < num_segs; i++) {
+        const uint8_t *p = data + i * 12;
+        classic_seg_t *li = &segs[i];
+        uint16_t v1 = rd16(p), v2 = rd16(p + 2), linedef = rd16(p + 6), side = rd16(p + 8);
+        if (v1 >= num_vertexes || v2 >= num_vertexes || linedef >= num_lines || side > 1 ||
+            lines[linedef].sidenum[side] == -1) {
+            goto done;
+        }
+        classic_line_t *ldef = &lines[linedef];
+        li->v1 = &vertexes[v1];
+        li->v2 = &vertexes[v2];
+        li->angle = (angle_t)(uint16_t)rd16(p + 4) << 16;
+        li->offset = rd16(p + 10) << FRACBITS;
+        li->linedef = ldef;
+        li->sidedef = &sides[ldef->sidenum[side]];
+        li->frontsector = li->sidedef->sector;
+        li->backsector = NULL;
+        if ((ldef->flags & LEVEL_ML_TWOSIDED) && ldef->sidenum[side ^ 1] != -1) {
+            li->backsector = sides[ldef->sidenum[side ^ 1]].sector;
+        }
+    }
+    
+    // BLOCKMAP and REJECT are copied into the zone at PU_LEVEL
+    data = map_lump(set, marker, ML_BLOCKMAP, &size);
+    int16_t *blockmap = classic_alloc(&allocs, size);
+    if (!data || !blockmap || size < 8) {
+        goto done;
+    }
+    memcpy(blockmap, data, size);
+    uint32_t num_links = (uint32_t)(blockmap[2] * blockmap[3]);
+    if (!classic_alloc(&allocs, num_links * sizeof(void *))) {
+        goto done;
+    }
+    data = map_lump(set, marker, ML_REJECT, &size);
+    uint8_t *reject = classic_alloc(&allocs, size);
+    if (!reject) {
+        goto done;
+    }
+    if (data) {
+        memcpy(reject, data, size);
+    }
+    
+    // P_GroupLines
+    for (uint32_t i = 0; i < num_subsectors; i++) {
+        if ((uint32_t)(uint16_t)subsectors[i].firstline >= num_segs) {
+            goto done;
+        }
+        subsectors[i].sector = segs[(uint16_t)subsectors[i].firstline].sidedef->sector;
+    }
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < num_lines; i++) {
+        total++;
+        lines[i].frontsector->linecount++;
+        if (lines[i].backsector && lines[i].backsector != lines[i].frontsector) {
+            lines[i].backsector->linecount++;
+            total++;
+        }
+    }
+    classic_line_t **linebuffer = classic_alloc(&allocs, total * sizeof(classic_line_t *));
+    if (!linebuffer) {
+        goto done;
+    }
+    fixed_t bmaporgx = blockmap[0] << FRACBITS;
+    fixed_t bmaporgy = blockmap[1] << FRACBITS;
+    for (uint32_t s = 0; s < num_sectors; s++) {
+        classic_sector_t *sector = &sectors[s];
+        fixed_t bbox[4] = {INT32_MIN, INT32_MAX, INT32_MAX, INT32_MIN};
+        sector->lines = linebuffer;
+        for (uint32_t i = 0; i < num_lines; i++) {
+            classic_line_t *li = &lines[i];
+            if (li->frontsector == sector || li->backsector == sector) {
+                *linebuffer++ = li;
+                for (int v = 0; v < 2; v++) {
+                    const classic_vertex_t *vx = v ? li->v2 : li->v1;
+                    if (vx->x < bbox[LEVEL_BOXLEFT]) bbox[LEVEL_BOXLEFT] = vx->x;
+                    if (vx->x > bbox[LEVEL_BOXRIGHT]) bbox[LEVEL_BOXRIGHT] = vx->x;
+                    if (vx->y < bbox[LEVEL_BOXBOTTOM]) bbox[LEVEL_BOXBOTTOM] = vx->y;
+                    if (vx->y > bbox[LEVEL_BOXTOP]) bbox[LEVEL_BOXTOP] = vx->y;
+                }
+            }
+        }
+        sector->soundorg.x = (fixed_t)(((int64_t)bbox[LEVEL_BOXRIGHT] + bbox[LEVEL_BOXLEFT]) / 2);
+        sector->soundorg.y = (fixed_t)(((int64_t)bbox[LEVEL_BOXTOP] + bbox[LEVEL_BOXBOTTOM]) / 2);
+        int block = (bbox[LEVEL_BOXTOP] - bmaporgy + MAXRADIUS) >> MAPBLOCKSHIFT;
+        sector->blockbox[LEVEL_BOXTOP] = block >= blockmap[3] ? blockmap[3] - 1 : block;
+        block = (bbox[LEVEL_BOXBOTTOM] - bmaporgy - MAXRADIUS) >> MAPBLOCKSHIFT;
+        sector->blockbox[LEVEL_BOXBOTTOM] = block < 0 ? 0 : block;
+        block = (bbox[LEVEL_BOXRIGHT] - bmaporgx + MAXRADIUS) >> MAPBLOCKSHIFT;
+        sector->blockbox[LEVEL_BOXRIGHT] = block >= blockmap[2] ? blockmap[2] - 1 : block;
+        block = (bbox[LEVEL_BOXLEFT] - bmaporgx - MAXRADIUS) >> MAPBLOCKSHIFT;
+        sector->blockbox[LEVEL_BOXLEFT] = block < 0 ? 0 : block;
+    }
+    ok = true;
+
+done:
+    if (!ok) {
+        printf("Error: Classic load of %s failed (malformed map or out of memory after %lu bytes)\n",
+               map, allocs.bytes);
+    } else if (stats) {
+        stats->load_us = clock_us ? (uint32_t)(clock_us() - start) : 0;
+        stats->ram_bytes = allocs.bytes;
+        stats->flash_bytes = 0;
+    }
+    // Newest first, so each block pops straight off the level arena
+    for (uint32_t i = allocs.num_blocks; i > 0; i--) {
+        Z_Free(allocs.blocks[i - 1]);
+    }
+    return ok;
+}
@@ -0,0 +1,243 @@
+/**
+ * Compact level loader implementation
+ */
+
+#include "level_loader.h"
+#include <stdio.h>
+#include "z_zone.h"
+#include <string.h>
+
+/**
+ * Check that a table lies inside the lump and is 4-byte aligned
+ */
+static bool table_ok(uint32_t offset, uint32_t count, uint32_t entry_size, uint32_t size) {
+    return (offset & 3) == 0 && offset <= size && count <= (size - offset) / entry_size;
+}
+
+/**
+ * Check every index once so the engine can follow them unchecked
+ */
+static bool validate(const level_t *level) {
+    const level_header_t *h = level->header;
+    
+    for (uint32_t i = 0; i < h->num_lines; i++) {
+        const level_line_t *line = &level->lines[i];
+        if (line->v1 >= h->num_vertexes || line->v2 >= h->num_vertexes ||
+            line->side[0] >= h->num_sides ||
+            (line->side[1] != LEVEL_NONE && line->side[1] >= h->num_sides) ||
+            line->front_sector >= h->num_sectors ||
+            (line->back_sector != LEVEL_NONE && line->back_sector >= h->num_sectors)) {
+            printf("Error: Level line %lu is malformed\n", i);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < h->num_sides; i++) {
+        const level_side_t *side = &level->sides[i];
+        if (side->sector >= h->num_sectors ||
+            (side->dynamic != LEVEL_NONE && side->dynamic >= h->num_dynamic_sides)) {
+            printf("Error: Level side %lu is malformed\n", i);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < h->num_sectors; i++) {
+        const level_sector_t *sec = &level->sectors[i];
+        if (sec->floor_flat >= h->num_flats || sec->ceiling_flat >= h->num_flats ||
+            sec->first_line > h->num_sector_lines ||
+            sec->line_count > h->num_sector_lines - sec->first_line) {
+            printf("Error: Level sector %lu is malformed\n", i);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < h->num_sector_lines; i++) {
+        if (level->sector_lines[i] >= h->num_lines) {
+            printf("Error: Level sector line list is malformed\n");
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < h->num_segs; i++) {
+        const level_seg_t *seg = &level->segs[i];
+        if (seg->v1 >= h->num_vertexes || seg->v2 >= h->num_vertexes ||
+            seg->line >= h->num_lines || seg->side > 1 || seg->front_sector >= h->num_sectors ||
+            (seg->back_sector != LEVEL_NONE && seg->back_sector >= h->num_sectors)) {
+            printf("Error: Level seg %lu is malformed\n", i);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < h->num_subsectors; i++) {
+        const level_subsector_t *sub = &level->subsectors[i];
+        if (sub->sector >= h->num_sectors || sub->first_seg > h->num_segs ||
+            sub->num_segs > h->num_segs - sub->first_seg) {
+            printf("Error: Level subsector %lu is malformed\n", i);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < h->num_nodes; i++) {
+        for (int c = 0; c < 2; c++) {
+            uint16_t child = level->nodes[i].children[c];
+            if ((child & LEVEL_SUBSECTOR) ? (uint32_t)(child & ~LEVEL_SUBSECTOR) >= h->num_subsectors
+                                          : child >= h->num_nodes) {
+                printf("Error: Level node %lu is malformed\n", i);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool level_load(level_t *level, const wad_set_t *set, const char *map,
+                uint64_t (*clock_us)(void), level_load_stats_t *stats) {
+    uint64_t start = clock_us ? clock_us() : 0;
+    memset(level, 0, sizeof(*level));
+    
+    char name[16];
+    snprintf(name, sizeof(name), "%s%s", LEVEL_LUMP_PREFIX, map);
+    int lump = wad_set_find(set, name);
+    if (lump < 0) {
+        printf("Error: No compact level %s (pack with wadpack --levels)\n", name);
+        return false;
+    }
+    if (wad_set_lump_is_compressed(set, lump)) {
+        printf("Error: %s is compressed; the level must be read in place\n", name);
+        return false;
+    }
+    
+    const wad_lump_t *entry = wad_set_lump(set, lump);
+    const uint8_t *data = wad_set_cache_lump(set, lump, LUMP_CACHE_STATIC);
+    uint32_t size = entry->size;
+    const level_header_t *h = (const level_header_t *)data;
+    if (!data || ((uintptr_t)data & 3) || size < sizeof(level_header_t) ||
+        h->magic != LEVEL_MAGIC || h->version != LEVEL_VERSION) {
+        printf("Error: %s is not a compact level\n", name);
+        return false;
+    }
+    
+    if (!table_ok(h->vertexes_offset, h->num_vertexes, sizeof(level_vertex_t), size) ||
+        !table_ok(h->lines_offset, h->num_lines, sizeof(level_line_t), size) ||
+        !table_ok(h->sides_offset, h->num_sides, sizeof(level_side_t), size) ||
+        !table_ok(h->sectors_offset, h->num_sectors, sizeof(level_sector_t), size) ||
+        !table_ok(h->sector_lines_offset, h->num_sector_lines, sizeof(uint16_t), size) ||
+        !table_ok(h->segs_offset, h->num_segs, sizeof(level_seg_t), size) ||
+        !table_ok(h->subsectors_offset, h->num_subsectors, sizeof(level_subsector_t), size) ||
+        !table_ok(h->nodes_offset, h->num_nodes, sizeof(level_node_t), size) ||
+        !table_ok(h->things_offset, h->num_things, sizeof(level_thing_t), size) ||
+        !table_ok(h->flats_offset, h->num_flats, 8, size) ||
+        !table_ok(h->blockmap_offset, h->blockmap_size, 1, size) ||
+        !table_ok(h->reject_offset, h->reject_size, 1, size) ||
+        h->blockmap_size < 8) {
+        printf("Error: %s tables extend beyond the lump\n", name);
+        return false;
+    }
+    
+    level->header = h;
+    level->vertexes = (const level_vertex_t *)(data + h->vertexes_offset);
+    level->lines = (const level_line_t *)(data + h->lines_offset);
+    level->sides = (const level_side_t *)(data + h->sides_offset);
+    level->sectors = (const level_sector_t *)(data + h->sectors_offset);
+    level->sector_lines = (const uint16_t *)(data + h->sector_lines_offset);
+    level->segs = (const level_seg_t *)(data + h->segs_offset);
+    level->subsectors = (const level_subsector_t *)(data + h->subsectors_offset);
+    level->nodes = (const level_node_t *)(data + h->nodes_offset);
+    level->things = (const level_thing_t *)(data + h->things_offset);
+    level->blockmap = (const int16_t *)(data + h->blockmap_offset);
+    level->reject = data + h->reject_offset;
+    if (!validate(level)) {
+        memset(level, 0, sizeof(*level));
+        return false;
+    }
+    
+    level->bmap_orgx = level->blockmap[0] << FRACBITS;
+    level->bmap_orgy = level->blockmap[1] << FRACBITS;
+    level->bmap_width = level->blockmap[2];
+    level->bmap_height = level->blockmap[3];
+    if (level->bmap_width <= 0 || level->bmap_height <= 0 ||
+        4 + (uint32_t)(level->bmap_width * level->bmap_height) > h->blockmap_size / 2) {
+        printf("Error: %s blockmap is malformed\n", name);
+        memset(level, 0, sizeof(*level));
+        return false;
+    }
+    for (int32_t i = 0; i < level->bmap_width * level->bmap_height; i++) {
+        if ((uint16_t)level->blockmap[4 + i] >= h->blockmap_size / 2) {
+            printf("Error: %s blockmap cell %ld is out of range\n", name, i);
+            memset(level, 0, sizeof(*level));
+            return false;
+        }
+    }
+    
+    // One arena for everything the game changes
+    uint32_t sector_bytes = h->num_sectors * sizeof(level_sector_state_t);
+    uint32_t line_bytes = h->num_lines * sizeof(level_line_state_t);
+    uint32_t side_bytes = h->num_dynamic_sides * sizeof(level_side_state_t);
+    uint32_t link_bytes = level->bmap_width * level->bmap_height * sizeof(void *);
+    level->arena_size = sector_bytes + line_bytes + side_bytes + link_bytes;
+    level->arena = (uint8_t *)Z_Malloc(level->arena_size, PU_LEVEL, NULL);
+    if (!level->arena) {
+        printf("Error: Out of memory for %s arena (%lu bytes)\n", name, level->arena_size);
+        memset(level, 0, sizeof(*level));
+        return false;
+    }
+    level->sector_state = (level_sector_state_t *)level->arena;
+    level->line_state = (level_line_state_t *)(level->arena + sector_bytes);
+    level->side_state = (level_side_state_t *)(level->arena + sector_bytes + line_bytes);
+    level->blocklinks = (void **)(level->arena + sector_bytes + line_bytes + side_bytes);
+    memset(level->blocklinks, 0, link_bytes);
+    
+    // Flat numbers: resolve each of the level's flat names once
+    const char (*flats)[8] = (const char (*)[8])(data + h->flats_offset);
+    for (uint32_t i = 0; i < h->num_sectors; i++) {
+        const level_sector_t *sec = &level->sectors[i];
+        level_sector_state_t *state = &level->sector_state[i];
+        state->floor_height = sec->floor_height;
+        state->ceiling_height = sec->ceiling_height;
+        state->light = sec->light;
+        state->special = sec->special;
+        state->floor_flat = -1;
+        state->ceiling_flat = -1;
+    }
+    for (uint32_t f = 0; f < h->num_flats; f++) {
+        char flat[9] = {0};
+        memcpy(flat, flats[f], 8);
+        int number = wad_set_find_in(set, WAD_NS_FLATS, flat);
+        if (number < 0) {
+            printf("Warning: %s: flat %s not found\n", name, flat);
+            number = 0;
+        }
+        for (uint32_t i = 0; i < h->num_sectors; i++) {
+            if (level->sectors[i].floor_flat == f) {
+                level->sector_state[i].floor_flat = number;
+            }
+            if (level->sectors[i].ceiling_flat == f) {
+                level->sector_state[i].ceiling_flat = number;
+            }
+        }
+    }
+    
+    for (uint32_t i = 0; i < h->num_lines; i++) {
+        level->line_state[i].flags = level->lines[i].flags;
+        level->line_state[i].special = level->lines[i].special;
+    }
+    for (uint32_t i = 0; i < h->num_sides; i++) {
+        const level_side_t *side = &level->sides[i];
+        if (side->dynamic != LEVEL_NONE) {
+            level_side_state_t *state = &level->side_state[side->dynamic];
+            state->texture_offset = side->texture_offset;
+            state->top_texture = side->top_texture;
+            state->bottom_texture = side->bottom_texture;
+            state->mid_texture = side->mid_texture;
+            state->reserved = 0;
+        }
+    }
+    
+    if (stats) {
+        stats->load_us = clock_us ? (uint32_t)(clock_us() - start) : 0;
+        stats->ram_bytes = level->arena_size;
+        stats->flash_bytes = size;
+    }
+    return true;
+}
+
+void level_free(level_t *level) {
+    if (level) {
+        Z_Free(level->arena);
+        memset(level, 0, sizeof(*level));
+    }
+}
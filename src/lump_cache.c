@@ -0,0 +1,373 @@
+/**
+ * Decompressed lump cache implementation
+ */
+
+#include "lump_cache.h"
+#include "lz4_stream.h"
+#include <stdio.h>
+#include <string.h>
+#include "z_zone.h"
+
+#define CACHE_BUCKETS   64      // Hash buckets (power of two)
+#define CACHE_DECODERS  4       // Prefetches in flight
+#define CACHE_REPORT_US 1000000 // Minimum time between error messages
+
+/**
+ * Cache entry, followed by the decompressed lump
+ */
+typedef struct cache_entry {
+    struct cache_entry *prev;       // LRU list, most recent at the head
+    struct cache_entry *next;
+    struct cache_entry *hash_next;
+    const void *key;
+    uint32_t size;
+    uint8_t tag;                    // lump_cache_tag_t
+    bool complete;
+    int8_t decoder;                 // Slot in decoders[], -1 if none
+    uint8_t reserved;
+    uint8_t data[];                 // 4-byte aligned
+} cache_entry_t;
+
+/**
+ * In-flight prefetch
+ */
+typedef struct {
+    lz4_stream_t stream;
+    cache_entry_t *entry;           // NULL = free slot
+} cache_decoder_t;
+
+static cache_entry_t *buckets[CACHE_BUCKETS];
+static cache_entry_t *lru_head = NULL;
+static cache_entry_t *lru_tail = NULL;
+static cache_decoder_t decoders[CACHE_DECODERS];
+static uint32_t budget = 0;
+static uint64_t (*clock_fn)(void) = NULL;
+static lump_cache_stats_t stats;
+static bool reported = false;           // An error has been printed
+static uint64_t report_us = 0;          // When the last one was
+
+static inline uint32_t bucket_of(const void *key) {
+    return ((uintptr_t)key >> 4) & (CACHE_BUCKETS - 1);
+}
+
+static inline uint64_t now_us(void) {
+    return clock_fn ? clock_fn() : 0;
+}
+
+/**
+ * Rate-limit error messages: a lookup that fails once fails again every
+ * frame, and printing stalls the frame over USB. Returns true at most once
+ * per CACHE_REPORT_US (only the first time without a clock); the stats
+ * count every error.
+ */
+static bool should_report(void) {
+    uint64_t now = now_us();
+    if (reported && now - report_us < CACHE_REPORT_US) {
+        return false;
+    }
+    reported = true;
+    report_us = now;
+    return true;
+}
+
+static cache_entry_t *find(const void *key) {
+    for (cache_entry_t *e = buckets[bucket_of(key)]; e; e = e->hash_next) {
+        if (e->key == key) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void lru_unlink(cache_entry_t *e) {
+    if (e->prev) {
+        e->prev->next = e->next;
+    } else {
+        lru_head = e->next;
+    }
+    if (e->next) {
+        e->next->prev = e->prev;
+    } else {
+        lru_tail = e->prev;
+    }
+    e->prev = e->next = NULL;
+}
+
+static void lru_push_head(cache_entry_t *e) {
+    e->prev = NULL;
+    e->next = lru_head;
+    if (lru_head) {
+        lru_head->prev = e;
+    } else {
+        lru_tail = e;
+    }
+    lru_head = e;
+}
+
+/**
+ * Keep the least purgeable of an entry's tag and a new lookup's
+ * A lookup at CACHE must not expose a STATIC or LEVEL entry to eviction;
+ * lump_cache_change_tag() is the way to lower a tag.
+ */
+static inline void raise_tag(cache_entry_t *e, lump_cache_tag_t tag) {
+    if (tag < e->tag) {
+        e->tag = tag;
+    }
+}
+
+/**
+ * Mark an entry most recently used
+ */
+static void touch(cache_entry_t *e) {
+    if (lru_head != e) {
+        lru_unlink(e);
+        lru_push_head(e);
+    }
+}
+
+/**
+ * Remove and free an entry
+ */
+static void evict(cache_entry_t *e) {
+    cache_entry_t **link = &buckets[bucket_of(e->key)];
+    while (*link != e) {
+        link = &(*link)->hash_next;
+    }
+    *link = e->hash_next;
+    
+    lru_unlink(e);
+    if (e->decoder >= 0) {
+        decoders[e->decoder].entry = NULL;
+        stats.pending--;
+    }
+    stats.used_bytes -= sizeof(cache_entry_t) + e->size;
+    stats.entries--;
+    Z_Free(e);
+}
+
+/**
+ * Pick the entry to evict: least recently used CACHE, then PURGELEVEL
+ */
+static cache_entry_t *pick_victim(void) {
+    for (int tag = LUMP_CACHE_CACHE; tag >= LUMP_CACHE_PURGELEVEL; tag--) {
+        for (cache_entry_t *e = lru_tail; e; e = e->prev) {
+            if (e->tag == tag) {
+                return e;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Allocate and link a new entry, evicting to make room
+ */
+static cache_entry_t *allocate(const void *key, uint32_t size, lump_cache_tag_t tag) {
+    uint32_t need = sizeof(cache_entry_t) + size;
+    if (need > budget) {
+        return NULL;
+    }
+    
+    cache_entry_t *e = NULL;
+    while (true) {
+        if (stats.used_bytes + need <= budget) {
+            // The cache keeps its own LRU, so its blocks are PU_STATIC to the zone
+            e = (cache_entry_t *)Z_Malloc(need, PU_STATIC, NULL);
+            if (e) {
+                break;
+            }
+        }
+        // Over budget, or the zone is fragmented: make room and retry
+        cache_entry_t *victim = pick_victim();
+        if (!victim) {
+            return NULL;
+        }
+        evict(victim);
+        stats.evictions++;
+    }
+    
+    e->key = key;
+    e->size = size;
+    e->tag = tag;
+    e->complete = false;
+    e->decoder = -1;
+    e->reserved = 0;
+    e->hash_next = buckets[bucket_of(key)];
+    buckets[bucket_of(key)] = e;
+    lru_push_head(e);
+    stats.used_bytes += need;
+    stats.entries++;
+    return e;
+}
+
+void lump_cache_init(uint32_t budget_bytes, uint64_t (*clock_us)(void)) {
+    while (lru_head) {
+        evict(lru_head);
+    }
+    memset(buckets, 0, sizeof(buckets));
+    memset(decoders, 0, sizeof(decoders));
+    memset(&stats, 0, sizeof(stats));
+    reported = false;
+    budget = budget_bytes;
+    clock_fn = clock_us;
+    stats.budget_bytes = budget_bytes;
+}
+
+const uint8_t* lump_cache_get(const void *key, const uint8_t *src, uint32_t src_size,
+                              uint32_t size, lump_cache_tag_t tag) {
+    cache_entry_t *e = find(key);
+    if (e && e->complete) {
+        stats.hits++;
+        raise_tag(e, tag);
+        touch(e);
+        return e->data;
+    }
+    
+    stats.misses++;
+    uint64_t start = now_us();
+    lz4_stream_t local;
+    lz4_stream_t *stream = &local;
+    
+    if (e) {
+        // Prefetch still running: finish it now
+        stream = &decoders[e->decoder].stream;
+        raise_tag(e, tag);
+        touch(e);
+    } else {
+        e = allocate(key, size, tag);
+        if (!e) {
+            stats.failures++;
+            if (should_report()) {
+                printf("Error: Lump cache cannot fit %u bytes (%u/%u used, %u failures)\n",
+                       size, stats.used_bytes, budget, stats.failures);
+            }
+            return NULL;
+        }
+        lz4_stream_init(stream, src, src_size, e->data, size);
+    }
+    
+    uint32_t before = stream->dst_pos;
+    lz4_stream_result_t result = lz4_stream_run(stream, size);
+    stats.decompressed_bytes += stream->dst_pos - before;
+    
+    if (e->decoder >= 0) {
+        decoders[e->decoder].entry = NULL;
+        e->decoder = -1;
+        stats.pending--;
+    }
+    
+    uint32_t elapsed = (uint32_t)(now_us() - start);
+    stats.decompress_us += elapsed;
+    if (elapsed > stats.max_stall_us) {
+        stats.max_stall_us = elapsed;
+    }
+    
+    if (result != LZ4_STREAM_DONE) {
+        stats.corrupt++;
+        if (should_report()) {
+            printf("Error: Corrupt compressed lump (%u bytes)\n", size);
+        }
+        evict(e);
+        return NULL;
+    }
+    e->complete = true;
+    return e->data;
+}
+
+bool lump_cache_prefetch(const void *key, const uint8_t *src, uint32_t src_size,
+                         uint32_t size, lump_cache_tag_t tag) {
+    cache_entry_t *found = find(key);
+    if (found) {
+        raise_tag(found, tag);
+        return true;
+    }
+    
+    int slot = -1;
+    for (int i = 0; i < CACHE_DECODERS; i++) {
+        if (!decoders[i].entry) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        return false;
+    }
+    
+    cache_entry_t *e = allocate(key, size, tag);
+    if (!e) {
+        return false;
+    }
+    e->decoder = slot;
+    decoders[slot].entry = e;
+    lz4_stream_init(&decoders[slot].stream, src, src_size, e->data, size);
+    stats.pending++;
+    return true;
+}
+
+bool lump_cache_service(uint32_t max_bytes) {
+    if (stats.pending == 0) {
+        return false;
+    }
+    
+    uint64_t start = now_us();
+    for (int i = 0; i < CACHE_DECODERS && max_bytes > 0; i++) {
+        cache_entry_t *e = decoders[i].entry;
+        if (!e) {
+            continue;
+        }
+        
+        lz4_stream_t *stream = &decoders[i].stream;
+        uint32_t before = stream->dst_pos;
+        lz4_stream_result_t result = lz4_stream_run(stream, max_bytes);
+        uint32_t produced = stream->dst_pos - before;
+        stats.decompressed_bytes += produced;
+        max_bytes -= produced;
+        
+        if (result == LZ4_STREAM_DONE) {
+            e->complete = true;
+            e->decoder = -1;
+            decoders[i].entry = NULL;
+            stats.pending--;
+        } else if (result == LZ4_STREAM_ERROR) {
+            stats.corrupt++;
+            if (should_report()) {
+                printf("Error: Corrupt compressed lump (%u bytes)\n", e->size);
+            }
+            evict(e);
+        }
+    }
+    stats.decompress_us += (uint32_t)(now_us() - start);
+    
+    return stats.pending > 0;
+}
+
+void lump_cache_change_tag(const void *key, lump_cache_tag_t tag) {
+    cache_entry_t *e = find(key);
+    if (e) {
+        e->tag = tag;
+    }
+}
+
+void lump_cache_drop(const void *key) {
+    cache_entry_t *e = find(key);
+    if (e) {
+        evict(e);
+    }
+}
+
+void lump_cache_purge_tag(lump_cache_tag_t tag) {
+    cache_entry_t *e = lru_head;
+    while (e) {
+        cache_entry_t *next = e->next;
+        if (e->tag == tag) {
+            evict(e);
+        }
+        e = next;
+    }
+}
+
+void lump_cache_get_stats(lump_cache_stats_t *out) {
+    if (out) {
+        *out = stats;
+    }
+}
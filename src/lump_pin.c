@@ -0,0 +1,119 @@
+/**
+ * Pinned lump implementation
+ */
+
+#include "lump_pin.h"
+#include <stdio.h>
+#include <string.h>
+#include "z_zone.h"
+
+#define PIN_BITMAP_BITS 1024    // Quick-reject filter (power of two)
+
+/**
+ * Pinned copy
+ */
+typedef struct {
+    uintptr_t key;
+    const uint8_t *data;
+} pin_entry_t;
+
+static uint8_t *pin_block = NULL;
+static uint32_t pin_budget = 0;
+static uint32_t pin_used = 0;
+static pin_entry_t pins[LUMP_PIN_MAX];      // Sorted by key
+static uint32_t num_pins = 0;
+static uint32_t pin_bitmap[PIN_BITMAP_BITS / 32];
+static uint32_t pin_hits = 0;
+
+static inline uint32_t bitmap_bit(uintptr_t key) {
+    // Directory entries are 16 bytes apart
+    return (key >> 4) & (PIN_BITMAP_BITS - 1);
+}
+
+bool lump_pin_init(uint32_t budget_bytes) {
+    Z_Free(pin_block);
+    pin_block = NULL;
+    pin_budget = 0;
+    lump_pin_clear();
+    
+    if (budget_bytes == 0) {
+        return true;
+    }
+    pin_block = (uint8_t *)Z_Malloc(budget_bytes, PU_STATIC, NULL);
+    if (!pin_block) {
+        printf("Error: Failed to reserve %u bytes for pinned lumps\n", budget_bytes);
+        return false;
+    }
+    pin_budget = budget_bytes;
+    return true;
+}
+
+bool lump_pin_add(const void *key, const uint8_t *data, uint32_t size) {
+    uint32_t aligned = (size + 3) & ~3u;
+    if (!data || num_pins >= LUMP_PIN_MAX || aligned > pin_budget - pin_used ||
+        lump_pin_find(key)) {
+        return false;
+    }
+    
+    uint8_t *copy = pin_block + pin_used;
+    memcpy(copy, data, size);
+    pin_used += aligned;
+    
+    // Insertion keeps the table sorted; only done at load time
+    uintptr_t k = (uintptr_t)key;
+    uint32_t i = num_pins++;
+    while (i > 0 && pins[i - 1].key > k) {
+        pins[i] = pins[i - 1];
+        i--;
+    }
+    pins[i].key = k;
+    pins[i].data = copy;
+    
+    uint32_t bit = bitmap_bit(k);
+    pin_bitmap[bit >> 5] |= 1u << (bit & 31);
+    return true;
+}
+
+const uint8_t* lump_pin_find(const void *key) {
+    uintptr_t k = (uintptr_t)key;
+    uint32_t bit = bitmap_bit(k);
+    if (!(pin_bitmap[bit >> 5] & (1u << (bit & 31)))) {
+        return NULL;
+    }
+    
+    uint32_t lo = 0;
+    uint32_t hi = num_pins;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) >> 1;
+        if (pins[mid].key < k) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < num_pins && pins[lo].key == k) {
+        pin_hits++;
+        return pins[lo].data;
+    }
+    return NULL;
+}
+
+void lump_pin_clear(void) {
+    num_pins = 0;
+    pin_used = 0;
+    pin_hits = 0;
+    memset(pin_bitmap, 0, sizeof(pin_bitmap));
+}
+
+uint32_t lump_pin_space(void) {
+    return pin_budget - pin_used;
+}
+
+void lump_pin_get_stats(lump_pin_stats_t *stats) {
+    if (stats) {
+        stats->pinned = num_pins;
+        stats->used_bytes = pin_used;
+        stats->budget_bytes = pin_budget;
+        stats->hits = pin_hits;
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * Resumable LZ4 block decoder implementation
+ *
+ * Sequence layout: token (literal length << 4 | match length - 4), extra
+ * literal length bytes (while 255), literals, 16-bit offset, extra match
+ * length bytes. The last sequence stops after its literals.
+ */
+
+#include "lz4_stream.h"
+#include <string.h>
+
+/**
+ * Read a length continued by 255 bytes
+ * Returns false if the input runs out
+ */
+static bool read_length(lz4_stream_t *s, uint32_t *length) {
+    uint8_t b;
+    do {
+        if (s->src_pos >= s->src_size) {
+            return false;
+        }
+        b = s->src[s->src_pos++];
+        *length += b;
+    } while (b == 255);
+    return true;
+}
+
+void lz4_stream_init(lz4_stream_t *stream, const uint8_t *src, uint32_t src_size,
+                     uint8_t *dst, uint32_t dst_size) {
+    memset(stream, 0, sizeof(*stream));
+    stream->src = src;
+    stream->src_size = src_size;
+    stream->dst = dst;
+    stream->dst_size = dst_size;
+}
+
+lz4_stream_result_t lz4_stream_run(lz4_stream_t *s, uint32_t max_out) {
+    while (true) {
+        // Finish any copy in progress
+        if (s->literal_left) {
+            uint32_t n = s->literal_left;
+            if (n > max_out) {
+                n = max_out;
+            }
+            if (n == 0) {
+                return LZ4_STREAM_MORE;
+            }
+            memcpy(&s->dst[s->dst_pos], &s->src[s->src_pos], n);
+            s->src_pos += n;
+            s->dst_pos += n;
+            s->literal_left -= n;
+            max_out -= n;
+            continue;
+        }
+        if (s->match_left) {
+            uint32_t n = s->match_left;
+            if (n > max_out) {
+                n = max_out;
+            }
+            if (n == 0) {
+                return LZ4_STREAM_MORE;
+            }
+            // Byte by byte: overlapping matches repeat recent output
+            uint8_t *out = &s->dst[s->dst_pos];
+            const uint8_t *from = out - s->match_offset;
+            for (uint32_t i = 0; i < n; i++) {
+                out[i] = from[i];
+            }
+            s->dst_pos += n;
+            s->match_left -= n;
+            max_out -= n;
+            continue;
+        }
+        
+        if (s->need_match) {
+            // End of block: the last sequence has literals only
+            if (s->src_pos == s->src_size) {
+                return (s->dst_pos == s->dst_size) ? LZ4_STREAM_DONE : LZ4_STREAM_ERROR;
+            }
+            if (s->src_pos + 2 > s->src_size) {
+                return LZ4_STREAM_ERROR;
+            }
+            uint32_t offset = s->src[s->src_pos] | (s->src[s->src_pos + 1] << 8);
+            s->src_pos += 2;
+            
+            uint32_t length = s->token & 0x0F;
+            if (length == 15 && !read_length(s, &length)) {
+                return LZ4_STREAM_ERROR;
+            }
+            length += LZ4_MIN_MATCH;
+            
+            if (offset == 0 || offset > s->dst_pos || length > s->dst_size - s->dst_pos) {
+                return LZ4_STREAM_ERROR;
+            }
+            s->match_offset = offset;
+            s->match_left = length;
+            s->need_match = false;
+            continue;
+        }
+        
+        // Next sequence
+        if (s->src_pos >= s->src_size) {
+            return (s->dst_pos == s->dst_size) ? LZ4_STREAM_DONE : LZ4_STREAM_ERROR;
+        }
+        s->token = s->src[s->src_pos++];
+        uint32_t length = s->token >> 4;
+        if (length == 15 && !read_length(s, &length)) {
+            return LZ4_STREAM_ERROR;
+        }
+        if (length > s->src_size - s->src_pos || length > s->dst_size - s->dst_pos) {
+            return LZ4_STREAM_ERROR;
+        }
+        s->literal_left = length;
+        s->need_match = true;
+    }
+}
@@ -13,9 +13,51 @@
 #include "display_adapter.h"
 #include "input_handler.h"
 #include "doom_engine.h"
+#include "lump_cache.h"
+#include "lump_pin.h"
+#include "z_zone.h"
+#include "boot_timeline.h"
+#include "tic_scheduler.h"
+#include "render_split.h"
+#include "frame_telemetry.h"
+#if PICO_DOOM_CAPTURE || PICO_DOOM_TELEMETRY
+#include "usb_stream.h"
+#endif
+#if PICO_DOOM_CAPTURE
+#include "frame_capture.h"
+#endif
 
 #define LED_PIN 25
 
+// Decompressed lump bytes produced per frame while scanout runs
+#define LUMP_CACHE_SERVICE_BYTES 8192
+
+// Lump profile dump interval and length (PICO_DOOM_LUMP_PROFILE builds)
+#define LUMP_PROFILE_INTERVAL_US 30000000
+#define LUMP_PROFILE_MAX_LUMPS   128
+
+// Most game tics run before one frame; a longer stall drops game time
+#define MAX_CATCHUP_TICS 4
+
+// Bytes of queued capture and telemetry data pushed to USB per loop
+// iteration
+#define USB_POLL_BYTES 4096
+
+// Stream per-stage frame timings over USB (tools/telemetry_report.py)
+#ifndef PICO_DOOM_TELEMETRY
+#define PICO_DOOM_TELEMETRY 0
+#endif
+
+// Demo lump to play as a timedemo once the first level is up ("" for none)
+#ifndef PICO_DOOM_TIMEDEMO
+#define PICO_DOOM_TIMEDEMO ""
+#endif
+
+// Draw the timedemo's frames (0 runs its tics only)
+#ifndef PICO_DOOM_TIMEDEMO_RENDER
+#define PICO_DOOM_TIMEDEMO_RENDER 1
+#endif
+
 /**
  * Initialize the Pico hardware
  */
@@ -35,8 +77,26 @@ void init_hardware(void) {
  */
 void init_display(void) {
     printf("Initializing display...\n");
-    display_init();
-    display_clear(0x0000);  // Clear to black
+    
+    display_config_t config;
+    display_default_config(&config);
+#if PICO_DOOM_TRIPLE_BUFFER
+    config.num_buffers = 3;
+#endif
+#if PICO_DOOM_RGB444
+    config.color_mode = DISPLAY_COLOR_RGB444;
+#endif
+#if PICO_DOOM_COLUMN_MAJOR
+    config.layout = DISPLAY_LAYOUT_COLUMN_MAJOR;
+#endif
+#ifdef PICO_DOOM_FRAME_PACING
+    config.pace_policy = PICO_DOOM_FRAME_PACING;
+#endif
+#if PICO_DOOM_FAST_BOOT
+    config.defer_panel_init = true;
+#endif
+    display_init(&config);
+    display_clear(0);  // Clear to black (palette index 0)
     printf("Display ready: %dx%d\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
 }
 
@@ -53,14 +113,32 @@ void init_input(void) {
  * Initialize Doom engine
  */
 void init_doom(void) {
-    if (!doom_init()) {
+    int phase = boot_phase_begin("doom init");
+    bool ok = doom_init();
+    boot_phase_end(phase);
+    if (!ok) {
         printf("ERROR: Failed to initialize Doom engine\n");
         return;
     }
     
-    // Try to load WAD file from flash
-    if (!doom_load_wad("/wad/doom1.wad")) {
+    // Try to load WAD file from flash (maps it and builds the palette table)
+    phase = boot_phase_begin("wad");
+    ok = doom_load_wad("/wad/doom1.wad");
+    boot_phase_end(phase);
+    if (!ok) {
         printf("WARNING: Could not load WAD file\n");
+        return;
+    }
+    
+    phase = boot_phase_begin("first level");
+    ok = doom_load_level(NULL);
+    boot_phase_end(phase);
+    if (!ok) {
+        printf("WARNING: Could not load the first level\n");
+    }
+    
+    if (PICO_DOOM_TIMEDEMO[0] && !doom_timedemo(PICO_DOOM_TIMEDEMO, PICO_DOOM_TIMEDEMO_RENDER)) {
+        printf("WARNING: Could not start timedemo %s\n", PICO_DOOM_TIMEDEMO);
     }
 }
 
@@ -72,9 +150,27 @@ void game_loop(void) {
     
     uint32_t frame = 0;
     uint64_t last_status = time_us_64();
+#if PICO_DOOM_LUMP_PROFILE
+    uint64_t last_profile = last_status;
+#endif
     doom_input_t doom_input = {0};
+    bool boot_dumped = false;
+    bool boot_presented = false;
+    
+    // The game runs at 35 Hz; frames render as fast as the display allows
+    tic_scheduler_t tics;
+    tic_scheduler_init(&tics, MAX_CATCHUP_TICS, last_status);
+    
+    // Core 1 draws part of each frame between scanouts
+    render_split_set_dual(PICO_DOOM_DUAL_CORE_RENDER);
+#if PICO_DOOM_RENDER_COMPARE
+    render_split_stats_t single_run = {0};
+#endif
     
     while (true) {
+        // Each stage of the frame starts where the last one was recorded
+        uint64_t stage = time_us_64();
+        
         // Update input
         input_update();
         
@@ -89,19 +185,59 @@ void game_loop(void) {
         doom_input.use = input_is_key_down(DOOM_KEY_USE);
         doom_input.weapon_next = input_is_key_down(DOOM_KEY_WEAPON_UP);
         doom_input.weapon_prev = input_is_key_down(DOOM_KEY_WEAPON_DOWN);
+        stage = frame_telemetry_end(TELEMETRY_INPUT, frame, stage);
         
-        // Update Doom engine
-        doom_update(&doom_input);
+        // Run the game tics due since the last frame (none if rendering
+        // is ahead of 35 Hz, several after a slow frame). A timedemo runs
+        // one tic per frame as fast as they go, and without rendering
+        // skips the display stages (the rest of the loop still runs).
+        bool render = true;
+        bool demo_render;
+        if (doom_timedemo_active(&demo_render)) {
+            doom_update(&doom_input);
+            render = demo_render;
+        } else {
+            uint32_t due = tic_scheduler_due(&tics, time_us_64());
+            for (uint32_t t = 0; t < due; t++) {
+                doom_update(&doom_input);
+            }
+        }
+        stage = frame_telemetry_end(TELEMETRY_UPDATE, frame, stage);
         
-        // Get framebuffer and render
-        framebuffer_t *fb = display_get_framebuffer();
-        doom_render(fb->data);
+        if (render) {
+            // Get framebuffer and render
+            framebuffer_t *fb = display_get_framebuffer();
+            doom_render(fb->data);
+            stage = frame_telemetry_end(TELEMETRY_RENDER, frame, stage);
+            
+            // Swap buffers
+            display_swap_buffers();
+            stage = frame_telemetry_end(TELEMETRY_SWAP, frame, stage);
+            if (!boot_presented) {
+                boot_mark("first frame presented");
+                boot_presented = true;
+            }
+            
+#if PICO_DOOM_CAPTURE
+            // Buffer stays intact until the next present, so encode it now
+            frame_capture_submit(fb, frame);
+#endif
+        }
+#if PICO_DOOM_CAPTURE || PICO_DOOM_TELEMETRY
+        frame_telemetry_flush();
+        usb_stream_poll(USB_POLL_BYTES);
+#endif
         
-        // Swap buffers
-        display_swap_buffers();
+        // Decompress the level's lumps while core 1 scans out, so the
+        // engine does not stall on them later
+        doom_service_lumps(LUMP_CACHE_SERVICE_BYTES);
+        stage = frame_telemetry_end(TELEMETRY_SERVICE, frame, stage);
         
         // Wait for display to be ready
-        display_wait_vsync();
+        if (render) {
+            display_wait_vsync();
+            frame_telemetry_end(TELEMETRY_VSYNC, frame, stage);
+        }
         
         frame++;
         
@@ -113,6 +249,117 @@ void game_loop(void) {
             doom_get_state(doom_state, sizeof(doom_state));
             printf("Frame %u | FPS: %.1f | %s | %s\n", 
                    frame, fps, input_get_debug_string(), doom_state);
+            
+            tic_stats_t tic;
+            tic_scheduler_get_stats(&tics, now, &tic);
+            tic_scheduler_reset_stats(&tics, now);
+            printf("Tics: %.1f/s | frames %.1f/s (%lu without a tic) | catch-up: %lu frames, max %lu tics, %lu tics dropped\n",
+                   tic.tics_per_sec, tic.frames_per_sec, tic.idle_frames,
+                   tic.catchup_frames, tic.max_tics, tic.dropped_tics);
+            
+            render_split_stats_t split;
+            render_split_get_stats(&split);
+            render_split_reset_stats();
+#if PICO_DOOM_RENDER_COMPARE
+            // Alternate modes each second and compare the last run of each
+            if (split.single_frames > 0) {
+                single_run = split;
+                render_split_set_dual(true);
+            } else if (split.dual_frames > 0 && single_run.single_us > 0) {
+                printf("Render compare: single core %lu us | dual core %lu us (%.2fx) | core 0 %lu us, core 1 %lu us, split at column %u/%u\n",
+                       single_run.single_us, split.dual_us, (float)single_run.single_us / split.dual_us,
+                       split.core0_us, split.core1_us, split.split, split.width);
+                render_split_set_dual(false);
+            } else {
+                render_split_set_dual(false);
+            }
+#else
+            if (split.dual_frames > 0) {
+                printf("Render: %lu us per frame on two cores (core 0 %lu us, core 1 %lu us, waited %lu us) | split at column %u/%u\n",
+                       split.dual_us, split.core0_us, split.core1_us, split.wait_us, split.split, split.width);
+            } else if (split.single_frames > 0) {
+                printf("Render: %lu us per frame on core 0\n", split.single_us);
+            }
+#endif
+            
+            display_scanout_stats_t scan;
+            display_get_scanout_stats(&scan);
+            printf("Scanout: %lu us | Core 1 busy: %lu us (%lu us free) | SPI: %lu bytes in %u rects (%lu%% of full frame)\n",
+                   scan.scanout_us, scan.core1_busy_us,
+                   scan.scanout_us - scan.core1_busy_us,
+                   scan.bytes, scan.rects,
+                   scan.bytes * 100 / scan.full_frame_bytes);
+            
+            // Full-frame cost of this transport against plain RGB565
+            uint32_t rgb565_bytes = DOOM_WIDTH * DOOM_HEIGHT * sizeof(pixel_t);
+            printf("Transport: %s | full frame %lu bytes (RGB565 %lu) | SPI cap %.1f fps (RGB565 %.1f) | %.0f KB/s used\n",
+                   scan.color_mode == DISPLAY_COLOR_RGB444 ? "RGB444" : "RGB565",
+                   scan.full_frame_bytes, rgb565_bytes,
+                   (float)scan.spi_bytes_per_sec / scan.full_frame_bytes,
+                   (float)scan.spi_bytes_per_sec / rgb565_bytes,
+                   fps * scan.bytes / 1024.0f);
+            printf("Stalls (%u buffers): render %lu us | scanout idle %lu us\n",
+                   scan.num_buffers, scan.render_stall_us, scan.scanout_idle_us);
+            
+            frame_pace_stats_t pace;
+            frame_pace_policy_t policy;
+            display_get_pace_stats(&pace, &policy);
+            printf("Pacing: %s | frame %lu us (jitter %lu us, min %lu, max %lu) | missed %lu\n",
+                   frame_pacer_policy_name(policy), pace.mean_us, pace.stddev_us,
+                   pace.min_us, pace.max_us, pace.missed);
+            
+#if PICO_DOOM_CAPTURE
+            frame_capture_stats_t cap;
+            frame_capture_get_stats(&cap);
+            printf("Capture: %lu frames (%lu complete) | %lu KB encoded from %lu KB | %lu bands dropped\n",
+                   cap.frames, cap.complete, cap.bytes / 1024, cap.raw_bytes / 1024,
+                   cap.bands_dropped);
+#endif
+#if PICO_DOOM_TELEMETRY
+            printf("Telemetry: %lu records dropped on core 0, %lu on core 1 | %lu USB packets dropped\n",
+                   frame_telemetry_dropped(0), frame_telemetry_dropped(1), usb_stream_dropped());
+#endif
+            lump_cache_stats_t cache;
+            lump_cache_get_stats(&cache);
+            if (cache.hits + cache.misses > 0) {
+                printf("Lump cache: %lu hits, %lu misses, %lu evictions, %lu failures, %lu corrupt | %lu/%lu KB in %lu lumps | decompress %lu KB in %lu us (worst stall %lu us)\n",
+                       cache.hits, cache.misses, cache.evictions, cache.failures, cache.corrupt,
+                       cache.used_bytes / 1024, cache.budget_bytes / 1024, cache.entries,
+                       cache.decompressed_bytes / 1024, cache.decompress_us, cache.max_stall_us);
+            }
+            
+            lump_pin_stats_t pins;
+            lump_pin_get_stats(&pins);
+            if (pins.pinned > 0) {
+                printf("Pinned lumps: %lu in %lu/%lu KB | %lu SRAM hits\n",
+                       pins.pinned, pins.used_bytes / 1024, pins.budget_bytes / 1024, pins.hits);
+            }
+            
+            zone_stats_t zone;
+            zone_get_stats(&zone);
+            printf("Zone: %lu/%lu KB used (peak %lu KB) | largest free %lu KB in %lu fragments | level arena %lu KB | %lu purged, %lu failed\n",
+                   zone.used_bytes / 1024, zone.total_bytes / 1024, zone.peak_used / 1024,
+                   zone.largest_free / 1024, zone.free_blocks, zone.level_bytes / 1024,
+                   zone.purged_blocks, zone.failed_allocs);
+            printf("Zone tags:");
+            for (int tag = PU_STATIC; tag < PU_NUM_TAGS; tag++) {
+                if (zone.tag_blocks[tag] > 0) {
+                    printf(" %s %lu KB/%lu", zone_tag_name(tag), zone.tag_bytes[tag] / 1024, zone.tag_blocks[tag]);
+                }
+            }
+            printf("\n");
+            
+#if PICO_DOOM_LUMP_PROFILE
+            if (now - last_profile >= LUMP_PROFILE_INTERVAL_US) {
+                doom_dump_lump_profile(LUMP_PROFILE_MAX_LUMPS);
+                last_profile = now;
+            }
+#endif
+            // Core 1's first scanout is long done by now
+            if (!boot_dumped) {
+                boot_timeline_dump();
+                boot_dumped = true;
+            }
             last_status = now;
             
             // Blink LED
@@ -136,7 +383,9 @@ void core1_entry(void) {
  */
 int main(void) {
     // Initialize hardware
+    int phase = boot_phase_begin("hardware");
     init_hardware();
+    boot_phase_end(phase);
     
     printf("\n");
     printf("================================\n");
@@ -144,16 +393,45 @@ int main(void) {
     printf("================================\n");
     printf("RAM: %d KB available\n", 264);
     printf("Flash: %d MB available\n", 2);
+    printf("Zone: %d KB reserved\n", PICO_DOOM_ZONE_KB);
     printf("\n");
     
+    // All allocations come from the zone, so it goes first
+    Z_Init();
+    
     // Initialize subsystems
+    phase = boot_phase_begin("display");
     init_display();
+    boot_phase_end(phase);
+    
+#if PICO_DOOM_FAST_BOOT
+    // Core 1 resets the panel while core 0 maps the WAD, builds the
+    // palette table and loads the first level; presented frames wait in
+    // the queue until the panel is up
+    printf("Starting Core 1 for rendering...\n");
+    multicore_launch_core1(core1_entry);
+#endif
+    
+    phase = boot_phase_begin("input");
     init_input();
+    boot_phase_end(phase);
     init_doom();
     
+#if PICO_DOOM_CAPTURE || PICO_DOOM_TELEMETRY
+    usb_stream_init();
+#endif
+#if PICO_DOOM_CAPTURE
+    frame_capture_start(PICO_DOOM_CAPTURE_STRIDE, 0);
+#endif
+#if PICO_DOOM_TELEMETRY
+    frame_telemetry_start();
+#endif
+    
+#if !PICO_DOOM_FAST_BOOT
     // Start rendering on Core 1
     printf("Starting Core 1 for rendering...\n");
     multicore_launch_core1(core1_entry);
+#endif
     
     // Run game loop on Core 0
     game_loop();
@@ -0,0 +1,153 @@
+/**
+ * Dual-core split rendering implementation
+ */
+
+#include "render_split.h"
+#include <string.h>
+#include "pico/stdlib.h"
+
+// Each core keeps at least this fraction of the columns (1/8), so a bad
+// measurement cannot starve either side
+#define MIN_SHARE_SHIFT 3
+
+/**
+ * Mailbox from core 0 to core 1
+ * Core 0 fills the job, then bumps posted; core 1 runs it, fills in its
+ * time, then sets done = posted. Each field has a single writer.
+ */
+typedef struct {
+    render_columns_fn fn;
+    void *ctx;
+    int x0;
+    int x1;
+    volatile uint32_t core1_us;
+    volatile uint32_t posted;
+    volatile uint32_t done;
+} render_mailbox_t;
+
+static render_mailbox_t mailbox;
+static volatile bool core1_ready = false;   // Core 1 is polling the mailbox
+static bool dual_mode = true;
+static int split = -1;                      // -1 until the first dual frame
+
+// Statistics (core 0)
+static uint32_t single_frames, dual_frames;
+static uint64_t single_sum, dual_sum, core0_sum, core1_sum, wait_sum;
+static uint16_t last_width;
+
+void render_split_set_dual(bool dual) {
+    dual_mode = dual;
+}
+
+/**
+ * Move the split toward equal finish times
+ * Per-column cost on each core predicts the next frame; the new split is
+ * averaged with the old one so a single noisy frame only moves it halfway.
+ */
+static void rebalance(int width, uint32_t core0_us, uint32_t core1_us) {
+    int n0 = split;
+    int n1 = width - split;
+    if (core0_us == 0 || core1_us == 0) {
+        return;
+    }
+    
+    // Solve c0 * s = c1 * (width - s) with c = time / columns
+    uint64_t c0 = ((uint64_t)core0_us << 16) / n0;
+    uint64_t c1 = ((uint64_t)core1_us << 16) / n1;
+    int target = (int)((uint64_t)width * c1 / (c0 + c1));
+    
+    int next = (split + target + 1) / 2;
+    int min_cols = width >> MIN_SHARE_SHIFT;
+    if (next < min_cols) {
+        next = min_cols;
+    } else if (next > width - min_cols) {
+        next = width - min_cols;
+    }
+    split = next;
+}
+
+void render_split_run(render_columns_fn fn, void *ctx, int width) {
+    uint64_t start = time_us_64();
+    last_width = (uint16_t)width;
+    
+    if (!dual_mode || !core1_ready || width < 2) {
+        fn(ctx, 0, width);
+        single_sum += time_us_64() - start;
+        single_frames++;
+        return;
+    }
+    
+    if (split <= 0 || split >= width) {
+        split = width / 2;
+    }
+    
+    // Post core 1's share
+    mailbox.fn = fn;
+    mailbox.ctx = ctx;
+    mailbox.x0 = split;
+    mailbox.x1 = width;
+    __dmb();  // Job must be visible before the new sequence number
+    uint32_t seq = mailbox.posted + 1;
+    mailbox.posted = seq;
+    __sev();
+    
+    fn(ctx, 0, split);
+    uint64_t core0_done = time_us_64();
+    
+    while (mailbox.done != seq) {
+        __wfe();
+    }
+    __dmb();
+    uint64_t end = time_us_64();
+    
+    uint32_t core0_us = (uint32_t)(core0_done - start);
+    uint32_t core1_us = mailbox.core1_us;
+    dual_sum += end - start;
+    core0_sum += core0_us;
+    core1_sum += core1_us;
+    wait_sum += end - core0_done;
+    dual_frames++;
+    
+    rebalance(width, core0_us, core1_us);
+}
+
+bool render_split_service(void) {
+    core1_ready = true;
+    
+    uint32_t seq = mailbox.posted;
+    if (mailbox.done == seq) {
+        return false;
+    }
+    __dmb();  // Read the job only after seeing the sequence number
+    
+    uint64_t start = time_us_64();
+    mailbox.fn(mailbox.ctx, mailbox.x0, mailbox.x1);
+    mailbox.core1_us = (uint32_t)(time_us_64() - start);
+    __dmb();  // Pixels and time must land before core 0 sees done
+    mailbox.done = seq;
+    __sev();
+    return true;
+}
+
+void render_split_get_stats(render_split_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->dual = dual_mode;
+    stats->single_frames = single_frames;
+    stats->dual_frames = dual_frames;
+    if (single_frames > 0) {
+        stats->single_us = (uint32_t)(single_sum / single_frames);
+    }
+    if (dual_frames > 0) {
+        stats->dual_us = (uint32_t)(dual_sum / dual_frames);
+        stats->core0_us = (uint32_t)(core0_sum / dual_frames);
+        stats->core1_us = (uint32_t)(core1_sum / dual_frames);
+        stats->wait_us = (uint32_t)(wait_sum / dual_frames);
+    }
+    stats->split = split > 0 ? (uint16_t)split : 0;
+    stats->width = last_width;
+}
+
+void render_split_reset_stats(void) {
+    single_frames = dual_frames = 0;
+    single_sum = dual_sum = core0_sum = core1_sum = wait_sum = 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * Precomposited texture column store implementation
+ */
+
+#include "tex_columns.h"
+#include "wad_image.h"
+#include <stdio.h>
+#include <string.h>
+
+bool tex_columns_init(tex_columns_t *store, const uint8_t *lump, uint32_t size) {
+    memset(store, 0, sizeof(*store));
+    if (!lump || size < sizeof(texcols_header_t) || ((uintptr_t)lump & 3)) {
+        printf("Error: Invalid TEXCOLS lump\n");
+        return false;
+    }
+    
+    const texcols_header_t *header = (const texcols_header_t *)lump;
+    if (header->magic != TEXCOLS_MAGIC || header->version != TEXCOLS_VERSION) {
+        printf("Error: TEXCOLS lump has bad magic or version\n");
+        return false;
+    }
+    if (header->textures_offset > size ||
+        header->num_textures > (size - header->textures_offset) / sizeof(texcols_texture_t) ||
+        header->columns_offset > size ||
+        header->num_columns > (size - header->columns_offset) / sizeof(uint32_t)) {
+        printf("Error: TEXCOLS tables extend beyond the lump\n");
+        return false;
+    }
+    
+    // Check every texture's columns once so lookups need no bounds checks
+    const texcols_texture_t *textures = (const texcols_texture_t *)(lump + header->textures_offset);
+    const uint32_t *offsets = (const uint32_t *)(lump + header->columns_offset);
+    for (uint32_t t = 0; t < header->num_textures; t++) {
+        const texcols_texture_t *tex = &textures[t];
+        if (tex->width == 0 || tex->first_column > header->num_columns ||
+            tex->width > header->num_columns - tex->first_column) {
+            printf("Error: TEXCOLS texture %u is malformed\n", t);
+            return false;
+        }
+        for (uint32_t c = 0; c < tex->width; c++) {
+            uint32_t offset = offsets[tex->first_column + c];
+            if (offset > size || tex->height > size - offset) {
+                printf("Error: TEXCOLS texture %u column %u is out of range\n", t, c);
+                return false;
+            }
+        }
+    }
+    
+    store->base = lump;
+    store->textures = textures;
+    store->column_offsets = offsets;
+    store->num_textures = header->num_textures;
+    return true;
+}
+
+int tex_columns_find(const tex_columns_t *store, const char *name) {
+    if (!store || !store->textures || !name) {
+        return -1;
+    }
+    
+    char key[8];
+    wad_normalize_name(key, name);
+    uint32_t w0 = wad_name_word(key);
+    uint32_t w1 = wad_name_word(key + 4);
+    
+    // Called at level setup only (a few hundred sidedefs): scan
+    for (uint32_t t = 0; t < store->num_textures; t++) {
+        const char *tn = store->textures[t].name;
+        if (wad_name_word(tn) == w0 && wad_name_word(tn + 4) == w1) {
+            return t;
+        }
+    }
+    return -1;
+}
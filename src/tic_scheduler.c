@@ -0,0 +1,70 @@
+/**
+ * Tic scheduler implementation
+ * Pure timing logic; the caller supplies all timestamps
+ */
+
+#include "tic_scheduler.h"
+#include <string.h>
+
+void tic_scheduler_init(tic_scheduler_t *sched, uint32_t max_catchup, uint64_t now) {
+    memset(sched, 0, sizeof(*sched));
+    sched->start = now;
+    sched->max_catchup = max_catchup ? max_catchup : 1;
+    tic_scheduler_reset_stats(sched, now);
+}
+
+uint32_t tic_scheduler_due(tic_scheduler_t *sched, uint64_t now) {
+    // Tics whose start time has passed; tic n starts at n/35 s, computed
+    // from tic 0 each time so the cadence never accumulates rounding
+    uint64_t elapsed = now > sched->start ? now - sched->start : 0;
+    uint64_t target = elapsed * TICRATE / 1000000 + 1;
+    
+    uint32_t due = 0;
+    if (target > sched->gametic) {
+        uint64_t behind = target - sched->gametic;
+        if (behind > sched->max_catchup) {
+            sched->dropped_tics += (uint32_t)(behind - sched->max_catchup);
+            behind = sched->max_catchup;
+        }
+        due = (uint32_t)behind;
+        sched->gametic = target;
+    }
+    
+    sched->frames++;
+    sched->tics += due;
+    if (due == 0) {
+        sched->idle_frames++;
+    } else if (due > 1) {
+        sched->catchup_frames++;
+    }
+    if (due > sched->max_tics) {
+        sched->max_tics = due;
+    }
+    return due;
+}
+
+void tic_scheduler_get_stats(const tic_scheduler_t *sched, uint64_t now, tic_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->tics = sched->tics;
+    stats->frames = sched->frames;
+    stats->catchup_frames = sched->catchup_frames;
+    stats->idle_frames = sched->idle_frames;
+    stats->dropped_tics = sched->dropped_tics;
+    stats->max_tics = sched->max_tics;
+    
+    uint64_t window = now - sched->window_start;
+    if (window > 0) {
+        stats->tics_per_sec = sched->tics * 1000000.0f / (float)window;
+        stats->frames_per_sec = sched->frames * 1000000.0f / (float)window;
+    }
+}
+
+void tic_scheduler_reset_stats(tic_scheduler_t *sched, uint64_t now) {
+    sched->window_start = now;
+    sched->tics = 0;
+    sched->frames = 0;
+    sched->catchup_frames = 0;
+    sched->idle_frames = 0;
+    sched->dropped_tics = 0;
+    sched->max_tics = 0;
+}
@@ -6,7 +6,65 @@
 #include "wad_loader.h"
 #include <stdio.h>
 #include <string.h>
-#include <stdlib.h>
+#include "z_zone.h"
+#include <stddef.h>
+
+// Mapped images hand their directory out as wad_lump_t
+_Static_assert(sizeof(wad_image_lump_t) == sizeof(wad_lump_t) &&
+               offsetof(wad_image_lump_t, offset) == offsetof(wad_lump_t, filepos) &&
+               offsetof(wad_image_lump_t, size) == offsetof(wad_lump_t, size) &&
+               offsetof(wad_image_lump_t, name) == offsetof(wad_lump_t, name),
+               "wad_image_lump_t must match wad_lump_t");
+
+/**
+ * Build the name index over the (already normalized) directory
+ * Slots hold lump number + 1. Lumps are inserted in directory order and a
+ * repeated name replaces the earlier entry, so the last lump wins. The
+ * table is kept at most 3/4 full so every probe sequence ends at an empty
+ * slot.
+ */
+static bool build_index(wad_file_t *wad) {
+    if (wad->num_lumps > 0xFFFF) {
+        printf("Warning: %u lumps is too many to index, using linear lookup\n", wad->num_lumps);
+        return false;
+    }
+    
+    uint32_t slots = wad_hash_slots(wad->num_lumps);
+    
+    uint16_t *hash = (uint16_t *)Z_Malloc(slots * sizeof(uint16_t), PU_STATIC, NULL);
+    if (!hash) {
+        printf("Warning: Failed to allocate lump index, using linear lookup\n");
+        return false;
+    }
+    memset(hash, 0, slots * sizeof(uint16_t));
+    wad->hash = hash;
+    wad->hash_mask = slots - 1;
+    
+    for (uint32_t i = 0; i < wad->num_lumps; i++) {
+        uint32_t w0 = wad_name_word(wad->lumps[i].name);
+        uint32_t w1 = wad_name_word(wad->lumps[i].name + 4);
+        uint32_t slot = wad_hash_name(w0, w1) & wad->hash_mask;
+        
+        while (hash[slot]) {
+            const wad_lump_t *other = &wad->lumps[hash[slot] - 1];
+            if (wad_name_word(other->name) == w0 && wad_name_word(other->name + 4) == w1) {
+                break;
+            }
+            slot = (slot + 1) & wad->hash_mask;
+        }
+        hash[slot] = i + 1;
+    }
+    
+    return true;
+}
+
+/**
+ * Whether count entries of entry_size bytes at offset lie within size
+ * bytes, without overflowing
+ */
+static inline bool image_range_ok(uint32_t offset, uint32_t count, uint32_t entry_size, uint32_t size) {
+    return offset <= size && count <= (size - offset) / entry_size;
+}
 
 wad_file_t* wad_load_from_memory(const uint8_t *data, uint32_t size) {
     if (!data || size < sizeof(wad_header_t)) {
@@ -14,65 +72,213 @@ wad_file_t* wad_load_from_memory(const uint8_t *data, uint32_t size) {
         return NULL;
     }
     
-    // Read header
-    const wad_header_t *header = (const wad_header_t *)data;
+    // Copy the header out: data may be any alignment (e.g. in flash), and
+    // Cortex-M0+ faults on unaligned word loads
+    wad_header_t header;
+    memcpy(&header, data, sizeof(header));
     
     // Validate header
-    if (memcmp(header->identification, "IWAD", 4) != 0 && 
-        memcmp(header->identification, "PWAD", 4) != 0) {
+    if (memcmp(header.identification, "IWAD", 4) != 0 && 
+        memcmp(header.identification, "PWAD", 4) != 0) {
         printf("Error: Not a valid WAD file (bad magic)\n");
         return NULL;
     }
     
+    // Load lump directory
+    uint32_t lump_table_offset = header.infotableofs;
+    if (lump_table_offset > size ||
+        header.numlumps > (size - lump_table_offset) / sizeof(wad_lump_t)) {
+        printf("Error: Lump table extends beyond WAD size\n");
+        return NULL;
+    }
+    
     // Allocate WAD structure
-    wad_file_t *wad = (wad_file_t *)malloc(sizeof(wad_file_t));
+    wad_file_t *wad = (wad_file_t *)Z_Malloc(sizeof(wad_file_t), PU_STATIC, NULL);
     if (!wad) {
         printf("Error: Failed to allocate WAD structure\n");
         return NULL;
     }
     
     // Copy header
-    memcpy(&wad->header, header, sizeof(wad_header_t));
-    wad->is_iwad = (memcmp(header->identification, "IWAD", 4) == 0);
+    wad->header = header;
+    wad->is_iwad = (memcmp(header.identification, "IWAD", 4) == 0);
     wad->data = data;
     wad->data_size = size;
-    wad->num_lumps = header->numlumps;
+    wad->num_lumps = header.numlumps;
+    wad->hash = NULL;
+    wad->hash_mask = 0;
+    wad->mapped = false;
+    wad->pack = NULL;
+    wad->access = NULL;
     
-    // Load lump directory
-    uint32_t lump_table_offset = header->infotableofs;
-    if (lump_table_offset + (header->numlumps * sizeof(wad_lump_t)) > size) {
-        printf("Error: Lump table extends beyond WAD size\n");
-        free(wad);
+    // Allocate and copy lump directory (memcpy again, as the table may be
+    // unaligned)
+    wad_lump_t *lumps = (wad_lump_t *)Z_Malloc(header.numlumps * sizeof(wad_lump_t), PU_STATIC, NULL);
+    if (!lumps) {
+        printf("Error: Failed to allocate lump directory\n");
+        Z_Free(wad);
         return NULL;
     }
     
-    const wad_lump_t *lump_table = (const wad_lump_t *)(data + lump_table_offset);
+    memcpy(lumps, data + lump_table_offset, header.numlumps * sizeof(wad_lump_t));
     
-    // Allocate and copy lump directory
-    wad->lumps = (wad_lump_t *)malloc(header->numlumps * sizeof(wad_lump_t));
-    if (!wad->lumps) {
-        printf("Error: Failed to allocate lump directory\n");
-        free(wad);
-        return NULL;
+    // Names are matched case-insensitively as two words
+    for (uint32_t i = 0; i < wad->num_lumps; i++) {
+        wad_normalize_name(lumps[i].name, lumps[i].name);
     }
-    
-    memcpy(wad->lumps, lump_table, header->numlumps * sizeof(wad_lump_t));
+    wad->lumps = lumps;
+    build_index(wad);
     
     printf("WAD loaded successfully: %s\n", wad->is_iwad ? "IWAD" : "PWAD");
-    printf("  Lumps: %d\n", header->numlumps);
+    printf("  Lumps: %d\n", header.numlumps);
     printf("  Size: %d bytes\n", size);
     
     return wad;
 }
 
-wad_lump_t* wad_find_lump(wad_file_t *wad, const char *name) {
+wad_file_t* wad_map_image(const uint8_t *image, uint32_t size) {
+    if (!image || size < sizeof(wad_image_header_t)) {
+        printf("Error: Invalid WAD image\n");
+        return NULL;
+    }
+    
+    // Copy the header out rather than trusting the pointer's alignment
+    wad_image_header_t header;
+    memcpy(&header, image, sizeof(header));
+    
+    if (header.magic != WAD_IMAGE_MAGIC) {
+        printf("Error: Not a packed WAD image (bad magic)\n");
+        return NULL;
+    }
+    if (header.version != WAD_IMAGE_VERSION) {
+        printf("Error: WAD image version %u, expected %u\n", header.version, WAD_IMAGE_VERSION);
+        return NULL;
+    }
+    
+    // Counts are capped before any size is multiplied out, and every range
+    // is checked as offset <= end && count <= (end - offset) / entry size
+    uint32_t image_size = header.image_size;
+    if (image_size > size ||
+        header.num_lumps > WAD_IMAGE_MAX_LUMPS ||
+        header.hash_slots == 0 || header.hash_slots > WAD_IMAGE_MAX_HASH_SLOTS ||
+        (header.hash_slots & (header.hash_slots - 1)) ||
+        header.hash_slots * 3 < header.num_lumps * 4 ||
+        (header.dir_offset & 3) || (header.hash_offset & 1) ||
+        !image_range_ok(header.dir_offset, header.num_lumps, sizeof(wad_image_lump_t), image_size) ||
+        !image_range_ok(header.hash_offset, header.hash_slots, sizeof(uint16_t), image_size) ||
+        (header.pack_offset &&
+         ((header.pack_offset & 3) ||
+          !image_range_ok(header.pack_offset, header.num_lumps, sizeof(wad_image_pack_t), image_size)))) {
+        printf("Error: WAD image header is inconsistent\n");
+        return NULL;
+    }
+    uint32_t dir_bytes = header.num_lumps * sizeof(wad_image_lump_t);
+    uint32_t hash_bytes = header.hash_slots * sizeof(uint16_t);
+    uint32_t pack_bytes = header.num_lumps * sizeof(wad_image_pack_t);
+    
+    // Cheap integrity check: the directory and index only, not the data
+    uint32_t sum = wad_image_checksum(image + header.dir_offset, dir_bytes);
+    sum ^= wad_image_checksum(image + header.hash_offset, hash_bytes);
+    if (header.pack_offset) {
+        sum ^= wad_image_checksum(image + header.pack_offset, pack_bytes);
+    }
+    if (sum != header.dir_checksum) {
+        printf("Error: WAD image directory checksum mismatch\n");
+        return NULL;
+    }
+    
+    // The checksum only catches damage: check what lookups will trust too.
+    // Every lump's stored bytes lie in the image, every index slot names a
+    // lump, and some slot is empty so every probe sequence ends.
+    const wad_image_lump_t *dir = (const wad_image_lump_t *)(image + header.dir_offset);
+    const wad_image_pack_t *pack = header.pack_offset ?
+        (const wad_image_pack_t *)(image + header.pack_offset) : NULL;
+    for (uint32_t i = 0; i < header.num_lumps; i++) {
+        uint32_t stored = (pack && pack[i].method != WAD_LUMP_RAW) ? pack[i].stored_size : dir[i].size;
+        if (!image_range_ok(dir[i].offset, stored, 1, image_size)) {
+            printf("Error: WAD image lump %u extends beyond the image\n", i);
+            return NULL;
+        }
+    }
+    const uint16_t *hash = (const uint16_t *)(image + header.hash_offset);
+    uint32_t used = 0;
+    for (uint32_t slot = 0; slot < header.hash_slots; slot++) {
+        if (hash[slot] > header.num_lumps) {
+            printf("Error: WAD image index slot %u names lump %u of %u\n",
+                   slot, hash[slot] - 1, header.num_lumps);
+            return NULL;
+        }
+        used += (hash[slot] != 0);
+    }
+    if (used >= header.hash_slots) {
+        printf("Error: WAD image index has no empty slot\n");
+        return NULL;
+    }
+    
+    wad_file_t *wad = (wad_file_t *)Z_Malloc(sizeof(wad_file_t), PU_STATIC, NULL);
+    if (!wad) {
+        printf("Error: Failed to allocate WAD structure\n");
+        return NULL;
+    }
+    
+    // Present it like a WAD whose directory happens to be pre-indexed
+    memcpy(wad->header.identification, (header.flags & WAD_IMAGE_IWAD) ? "IWAD" : "PWAD", 4);
+    wad->header.numlumps = header.num_lumps;
+    wad->header.infotableofs = header.dir_offset;
+    wad->is_iwad = (header.flags & WAD_IMAGE_IWAD) != 0;
+    wad->num_lumps = header.num_lumps;
+    wad->data = image;
+    wad->data_size = header.image_size;
+    wad->lumps = (const wad_lump_t *)dir;
+    wad->hash = hash;
+    wad->hash_mask = header.hash_slots - 1;
+    wad->mapped = true;
+    wad->pack = pack;
+    wad->access = NULL;
+    
+    printf("WAD image mapped: %s, %u lumps, %u bytes (%u hot)\n",
+           wad->is_iwad ? "IWAD" : "PWAD", header.num_lumps, header.image_size, header.hot_size);
+    
+    return wad;
+}
+
+const wad_lump_t* wad_find_lump(wad_file_t *wad, const char *name) {
     if (!wad || !name) {
         return NULL;
     }
+    if (!wad->hash) {
+        return wad_find_lump_linear(wad, name);
+    }
     
-    for (uint32_t i = 0; i < wad->num_lumps; i++) {
-        // WAD lump names are 8-char, space-padded
-        if (strncmp(wad->lumps[i].name, name, 8) == 0) {
+    char key[8];
+    wad_normalize_name(key, name);
+    uint32_t w0 = wad_name_word(key);
+    uint32_t w1 = wad_name_word(key + 4);
+    
+    for (uint32_t slot = wad_hash_name(w0, w1) & wad->hash_mask; wad->hash[slot];
+         slot = (slot + 1) & wad->hash_mask) {
+        const wad_lump_t *lump = &wad->lumps[wad->hash[slot] - 1];
+        if (wad_name_word(lump->name) == w0 && wad_name_word(lump->name + 4) == w1) {
+            return lump;
+        }
+    }
+    
+    return NULL;
+}
+
+const wad_lump_t* wad_find_lump_linear(wad_file_t *wad, const char *name) {
+    if (!wad || !name) {
+        return NULL;
+    }
+    
+    char key[8];
+    wad_normalize_name(key, name);
+    uint32_t w0 = wad_name_word(key);
+    uint32_t w1 = wad_name_word(key + 4);
+    
+    // Scan backwards so the last lump wins
+    for (uint32_t i = wad->num_lumps; i-- > 0; ) {
+        if (wad_name_word(wad->lumps[i].name) == w0 && wad_name_word(wad->lumps[i].name + 4) == w1) {
             return &wad->lumps[i];
         }
     }
@@ -80,30 +286,159 @@ wad_lump_t* wad_find_lump(wad_file_t *wad, const char *name) {
     return NULL;
 }
 
-const uint8_t* wad_get_lump_data(wad_file_t *wad, wad_lump_t *lump) {
+void wad_benchmark_lookups(wad_file_t *wad, uint64_t (*clock_us)(void)) {
+    if (!wad || !clock_us) {
+        return;
+    }
+    
+    // Every directory name, as the engine's startup would ask for them
+    char name[9];
+    name[8] = '\0';
+    uint32_t mismatches = 0;
+    
+    uint64_t start = clock_us();
+    for (uint32_t i = 0; i < wad->num_lumps; i++) {
+        memcpy(name, wad->lumps[i].name, 8);
+        if (!wad_find_lump_linear(wad, name)) {
+            mismatches++;
+        }
+    }
+    uint64_t linear_us = clock_us() - start;
+    
+    start = clock_us();
+    for (uint32_t i = 0; i < wad->num_lumps; i++) {
+        memcpy(name, wad->lumps[i].name, 8);
+        if (!wad_find_lump(wad, name)) {
+            mismatches++;
+        }
+    }
+    uint64_t hashed_us = clock_us() - start;
+    
+    // Both must agree, including on which duplicate wins
+    for (uint32_t i = 0; i < wad->num_lumps; i++) {
+        memcpy(name, wad->lumps[i].name, 8);
+        if (wad_find_lump(wad, name) != wad_find_lump_linear(wad, name)) {
+            mismatches++;
+        }
+    }
+    
+    printf("Lump lookup: %u names | linear %llu us | hashed %llu us (%u index slots) | %u mismatches\n",
+           wad->num_lumps, linear_us, hashed_us,
+           wad->hash ? wad->hash_mask + 1 : 0, mismatches);
+}
+
+/**
+ * How a lump is stored, or NULL if it is raw
+ */
+static const wad_image_pack_t *lump_pack(const wad_file_t *wad, const wad_lump_t *lump) {
+    if (!wad->pack) {
+        return NULL;
+    }
+    const wad_image_pack_t *pack = &wad->pack[lump - wad->lumps];
+    return (pack->method == WAD_LUMP_RAW) ? NULL : pack;
+}
+
+bool wad_lump_is_compressed(const wad_file_t *wad, const wad_lump_t *lump) {
+    return wad && lump && lump_pack(wad, lump) != NULL;
+}
+
+const uint8_t* wad_cache_lump(wad_file_t *wad, const wad_lump_t *lump, lump_cache_tag_t tag) {
     if (!wad || !lump) {
         return NULL;
     }
     
+    if (wad->access) {
+        wad_lump_access_t *access = &wad->access[lump - wad->lumps];
+        access->accesses++;
+        access->bytes += lump->size;
+    }
+    
+    // Pinned SRAM copy first (one bitmap test when not pinned)
+    const uint8_t *pinned = lump_pin_find(lump);
+    if (pinned) {
+        return pinned;
+    }
+    
+    const wad_image_pack_t *pack = lump_pack(wad, lump);
+    uint32_t stored = pack ? pack->stored_size : lump->size;
+    
     // Validate lump is within WAD bounds
-    if (lump->filepos + lump->size > wad->data_size) {
+    if (lump->filepos > wad->data_size || stored > wad->data_size - lump->filepos) {
         printf("Error: Lump extends beyond WAD data\n");
         return NULL;
     }
     
+    if (pack) {
+        return lump_cache_get(lump, wad->data + lump->filepos, stored, lump->size, tag);
+    }
+    
+    // Points straight into the WAD (flash when mapped from XIP); no copy.
+    // Raw WAD lumps may be unaligned: read multi-byte fields with memcpy.
     return wad->data + lump->filepos;
 }
 
+const uint8_t* wad_get_lump_data(wad_file_t *wad, const wad_lump_t *lump) {
+    return wad_cache_lump(wad, lump, LUMP_CACHE_CACHE);
+}
+
+bool wad_prefetch_lump(wad_file_t *wad, const wad_lump_t *lump, lump_cache_tag_t tag) {
+    if (!wad || !lump) {
+        return false;
+    }
+    
+    // Raw and pinned lumps are read without the cache
+    const wad_image_pack_t *pack = lump_pack(wad, lump);
+    if (!pack || lump_pin_find(lump)) {
+        return true;
+    }
+    if (lump->filepos > wad->data_size || pack->stored_size > wad->data_size - lump->filepos) {
+        return false;
+    }
+    return lump_cache_prefetch(lump, wad->data + lump->filepos, pack->stored_size, lump->size, tag);
+}
+
+bool wad_profile_enable(wad_file_t *wad) {
+    if (!wad) {
+        return false;
+    }
+    if (!wad->access) {
+        wad->access = (wad_lump_access_t *)Z_Malloc(wad->num_lumps * sizeof(wad_lump_access_t), PU_STATIC, NULL);
+        if (!wad->access) {
+            printf("Error: Failed to allocate lump access profile\n");
+            return false;
+        }
+        memset(wad->access, 0, wad->num_lumps * sizeof(wad_lump_access_t));
+    }
+    return true;
+}
+
+void wad_profile_reset(wad_file_t *wad) {
+    if (wad && wad->access) {
+        memset(wad->access, 0, wad->num_lumps * sizeof(wad_lump_access_t));
+    }
+}
+
 void wad_free(wad_file_t *wad) {
     if (!wad) {
         return;
     }
     
-    if (wad->lumps) {
-        free(wad->lumps);
+    // Cached copies are keyed by directory entry
+    if (wad->pack) {
+        for (uint32_t i = 0; i < wad->num_lumps; i++) {
+            lump_cache_drop(&wad->lumps[i]);
+        }
+    }
+    
+    Z_Free(wad->access);
+    
+    // A mapped image owns its directory and index
+    if (!wad->mapped) {
+        Z_Free((void *)wad->lumps);
+        Z_Free((void *)wad->hash);
     }
     
-    free(wad);
+    Z_Free(wad);
 }
 
 void wad_print_info(wad_file_t *wad) {
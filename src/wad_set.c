@@ -0,0 +1,471 @@
+/**
+ * WAD set implementation
+ */
+
+#include "wad_set.h"
+#include "wad_image.h"
+#include <stdio.h>
+#include <string.h>
+#include "z_zone.h"
+
+// Marker names per namespace; both spellings are used in the wild
+static const char *ns_start[WAD_NS_COUNT][2] = {
+    {"S_START", "SS_START"}, {"F_START", "FF_START"}, {"P_START", "PP_START"}
+};
+static const char *ns_end[WAD_NS_COUNT][2] = {
+    {"S_END", "SS_END"}, {"F_END", "FF_END"}, {"P_END", "PP_END"}
+};
+
+/**
+ * Compare a normalized directory name against a C string
+ */
+static bool name_is(const char *name, const char *str) {
+    char key[8];
+    wad_normalize_name(key, str);
+    return memcmp(name, key, 8) == 0;
+}
+
+/**
+ * Zero-size lumps named *_START / *_END (e.g. F1_START inside F_START)
+ */
+static bool is_marker(const wad_lump_t *lump) {
+    if (lump->size != 0) {
+        return false;
+    }
+    char name[9] = {0};
+    memcpy(name, lump->name, 8);
+    size_t len = strlen(name);
+    return (len > 6 && strcmp(name + len - 6, "_START") == 0) ||
+           (len > 4 && strcmp(name + len - 4, "_END") == 0);
+}
+
+/**
+ * Insert a lump into an open-addressed index; a repeated name replaces
+ * the earlier entry
+ */
+static void index_insert(uint16_t *hash, uint32_t mask, const wad_set_t *set,
+                             const char *name, uint16_t value) {
+    uint32_t w0 = wad_name_word(name);
+    uint32_t w1 = wad_name_word(name + 4);
+    uint32_t slot = wad_hash_name(w0, w1) & mask;
+    
+    while (hash[slot]) {
+        const wad_lump_t *other = wad_set_lump(set, hash[slot] - 1);
+        if (wad_name_word(other->name) == w0 && wad_name_word(other->name + 4) == w1) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    hash[slot] = value;
+}
+
+/**
+ * Rebuild the merged name index over every WAD in the set
+ */
+static bool build_index(wad_set_t *set) {
+    uint32_t slots = wad_hash_slots(set->num_lumps);
+    uint16_t *hash = (uint16_t *)Z_Malloc(slots * sizeof(uint16_t), PU_STATIC, NULL);
+    if (!hash) {
+        printf("Error: Failed to allocate WAD set index\n");
+        return false;
+    }
+    memset(hash, 0, slots * sizeof(uint16_t));
+    
+    Z_Free(set->hash);
+    set->hash = hash;
+    set->hash_mask = slots - 1;
+    
+    for (uint32_t i = 0; i < set->num_lumps; i++) {
+        index_insert(hash, set->hash_mask, set, wad_set_lump(set, i)->name, i + 1);
+    }
+    return true;
+}
+
+/**
+ * Rebuild one namespace list
+ * Walks every WAD's START..END range in load order. A later lump with the
+ * same name replaces the earlier one in place, keeping its position, so
+ * PWAD replacements keep the IWAD's numbering and new lumps go at the end.
+ */
+static bool build_namespace(wad_set_t *set, wad_namespace_t ns) {
+    // Upper bound: every lump in the set
+    uint16_t *list = (uint16_t *)Z_Malloc(set->num_lumps * sizeof(uint16_t), PU_STATIC, NULL);
+    uint32_t slots = wad_hash_slots(set->num_lumps);
+    uint16_t *seen = (uint16_t *)Z_Malloc(slots * sizeof(uint16_t), PU_STATIC, NULL);  // List position + 1
+    if (!list || !seen) {
+        printf("Error: Failed to allocate WAD set namespace\n");
+        Z_Free(list);
+        Z_Free(seen);
+        return false;
+    }
+    memset(seen, 0, slots * sizeof(uint16_t));
+    
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < set->num_wads; w++) {
+        const wad_file_t *wad = set->wads[w];
+        bool inside = false;
+        
+        for (uint32_t i = 0; i < wad->num_lumps; i++) {
+            const wad_lump_t *lump = &wad->lumps[i];
+            if (name_is(lump->name, ns_start[ns][0]) || name_is(lump->name, ns_start[ns][1])) {
+                inside = true;
+                continue;
+            }
+            if (name_is(lump->name, ns_end[ns][0]) || name_is(lump->name, ns_end[ns][1])) {
+                inside = false;
+                continue;
+            }
+            if (!inside || is_marker(lump)) {
+                continue;
+            }
+            
+            // Probe by name; seen[] maps to the list position
+            uint32_t w0 = wad_name_word(lump->name);
+            uint32_t w1 = wad_name_word(lump->name + 4);
+            uint32_t slot = wad_hash_name(w0, w1) & (slots - 1);
+            while (seen[slot]) {
+                const wad_lump_t *other = wad_set_lump(set, list[seen[slot] - 1]);
+                if (wad_name_word(other->name) == w0 && wad_name_word(other->name + 4) == w1) {
+                    break;
+                }
+                slot = (slot + 1) & (slots - 1);
+            }
+            
+            uint16_t lump_num = set->base[w] + i;
+            if (seen[slot]) {
+                list[seen[slot] - 1] = lump_num;
+            } else {
+                list[count] = lump_num;
+                seen[slot] = ++count;
+            }
+        }
+    }
+    Z_Free(seen);
+    
+    // Shrink to fit (the zone has no realloc; copy into an exact block)
+    if (count == 0) {
+        Z_Free(list);
+        list = NULL;
+    } else {
+        uint16_t *shrunk = (uint16_t *)Z_Malloc(count * sizeof(uint16_t), PU_STATIC, NULL);
+        if (shrunk) {
+            memcpy(shrunk, list, count * sizeof(uint16_t));
+            Z_Free(list);
+            list = shrunk;
+        }
+    }
+    Z_Free(set->ns_lumps[ns]);
+    set->ns_lumps[ns] = list;
+    set->ns_count[ns] = count;
+    return true;
+}
+
+void wad_set_init(wad_set_t *set) {
+    memset(set, 0, sizeof(*set));
+}
+
+bool wad_set_add(wad_set_t *set, wad_file_t *wad) {
+    if (!set || !wad) {
+        return false;
+    }
+    if (set->num_wads >= WAD_SET_MAX_WADS) {
+        printf("Error: WAD set is full (%d WADs)\n", WAD_SET_MAX_WADS);
+        return false;
+    }
+    if (set->num_lumps + wad->num_lumps > 0xFFFF) {
+        printf("Error: WAD set would exceed 65535 lumps\n");
+        return false;
+    }
+    
+    set->wads[set->num_wads] = wad;
+    set->base[set->num_wads] = set->num_lumps;
+    set->num_wads++;
+    set->num_lumps += wad->num_lumps;
+    
+    if (!build_index(set)) {
+        set->num_wads--;
+        set->num_lumps -= wad->num_lumps;
+        return false;
+    }
+    for (int ns = 0; ns < WAD_NS_COUNT; ns++) {
+        build_namespace(set, (wad_namespace_t)ns);
+    }
+    
+    printf("WAD set: %u WADs, %u lumps | %u sprites, %u flats, %u patches\n",
+           set->num_wads, set->num_lumps, set->ns_count[WAD_NS_SPRITES],
+           set->ns_count[WAD_NS_FLATS], set->ns_count[WAD_NS_PATCHES]);
+    return true;
+}
+
+int wad_set_find(const wad_set_t *set, const char *name) {
+    if (!set || !set->hash || !name) {
+        return -1;
+    }
+    
+    char key[8];
+    wad_normalize_name(key, name);
+    uint32_t w0 = wad_name_word(key);
+    uint32_t w1 = wad_name_word(key + 4);
+    
+    for (uint32_t slot = wad_hash_name(w0, w1) & set->hash_mask; set->hash[slot];
+         slot = (slot + 1) & set->hash_mask) {
+        const wad_lump_t *lump = wad_set_lump(set, set->hash[slot] - 1);
+        if (wad_name_word(lump->name) == w0 && wad_name_word(lump->name + 4) == w1) {
+            return set->hash[slot] - 1;
+        }
+    }
+    
+    return -1;
+}
+
+int wad_set_find_in(const wad_set_t *set, wad_namespace_t ns, const char *name) {
+    if (!set || ns >= WAD_NS_COUNT || !name) {
+        return -1;
+    }
+    
+    char key[8];
+    wad_normalize_name(key, name);
+    uint32_t w0 = wad_name_word(key);
+    uint32_t w1 = wad_name_word(key + 4);
+    
+    // Namespaces are small (tens to hundreds of lumps): scan the slice
+    for (uint32_t i = 0; i < set->ns_count[ns]; i++) {
+        const wad_lump_t *lump = wad_set_lump(set, set->ns_lumps[ns][i]);
+        if (wad_name_word(lump->name) == w0 && wad_name_word(lump->name + 4) == w1) {
+            return i;
+        }
+    }
+    
+    return -1;
+}
+
+const uint16_t* wad_set_namespace(const wad_set_t *set, wad_namespace_t ns, uint32_t *count) {
+    if (!set || ns >= WAD_NS_COUNT) {
+        if (count) {
+            *count = 0;
+        }
+        return NULL;
+    }
+    if (count) {
+        *count = set->ns_count[ns];
+    }
+    return set->ns_lumps[ns];
+}
+
+/**
+ * WAD holding a set lump, and that lump's index within it
+ */
+static wad_file_t *lump_wad(const wad_set_t *set, uint32_t lump, uint32_t *index) {
+    uint32_t w = set->num_wads - 1;
+    while (set->base[w] > lump) {
+        w--;
+    }
+    *index = lump - set->base[w];
+    return set->wads[w];
+}
+
+const wad_lump_t* wad_set_lump(const wad_set_t *set, int lump) {
+    if (!set || lump < 0 || (uint32_t)lump >= set->num_lumps) {
+        return NULL;
+    }
+    
+    // Few WADs: walk down from the top
+    uint32_t w = set->num_wads - 1;
+    while (set->base[w] > (uint32_t)lump) {
+        w--;
+    }
+    return &set->wads[w]->lumps[lump - set->base[w]];
+}
+
+const uint8_t* wad_set_lump_data(const wad_set_t *set, int lump) {
+    return wad_set_cache_lump(set, lump, LUMP_CACHE_CACHE);
+}
+
+const uint8_t* wad_set_cache_lump(const wad_set_t *set, int lump, lump_cache_tag_t tag) {
+    if (!set || lump < 0 || (uint32_t)lump >= set->num_lumps) {
+        return NULL;
+    }
+    
+    uint32_t index;
+    wad_file_t *wad = lump_wad(set, lump, &index);
+    return wad_cache_lump(wad, &wad->lumps[index], tag);
+}
+
+void wad_set_change_tag(const wad_set_t *set, int lump, lump_cache_tag_t tag) {
+    if (!set || lump < 0 || (uint32_t)lump >= set->num_lumps) {
+        return;
+    }
+    
+    uint32_t index;
+    wad_file_t *wad = lump_wad(set, lump, &index);
+    lump_cache_change_tag(&wad->lumps[index], tag);
+}
+
+bool wad_set_prefetch_lump(const wad_set_t *set, int lump, lump_cache_tag_t tag) {
+    if (!set || lump < 0 || (uint32_t)lump >= set->num_lumps) {
+        return false;
+    }
+    
+    uint32_t index;
+    wad_file_t *wad = lump_wad(set, lump, &index);
+    return wad_prefetch_lump(wad, &wad->lumps[index], tag);
+}
+
+bool wad_set_lump_is_compressed(const wad_set_t *set, int lump) {
+    if (!set || lump < 0 || (uint32_t)lump >= set->num_lumps) {
+        return false;
+    }
+    
+    uint32_t index;
+    wad_file_t *wad = lump_wad(set, lump, &index);
+    return wad_lump_is_compressed(wad, &wad->lumps[index]);
+}
+
+void wad_set_free(wad_set_t *set) {
+    if (!set) {
+        return;
+    }
+    Z_Free(set->hash);
+    for (int ns = 0; ns < WAD_NS_COUNT; ns++) {
+        Z_Free(set->ns_lumps[ns]);
+    }
+    wad_set_init(set);
+}
+
+/**
+ * Live profile candidate
+ */
+typedef struct {
+    uint16_t lump;            // Set lump number
+    uint32_t score;           // Lookups per KB
+} profile_rank_t;
+
+/**
+ * Collect the set's accessed lumps, hottest first
+ * Only the lump each name resolves to is ranked; shadowed lumps are never
+ * read. Returns the number of entries written to ranks.
+ */
+static uint32_t rank_profile(const wad_set_t *set, profile_rank_t *ranks, uint32_t max) {
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < set->num_wads; w++) {
+        const wad_file_t *wad = set->wads[w];
+        if (!wad->access) {
+            continue;
+        }
+        for (uint32_t i = 0; i < wad->num_lumps; i++) {
+            const wad_lump_access_t *access = &wad->access[i];
+            if (access->accesses == 0 || wad->lumps[i].size == 0) {
+                continue;
+            }
+            
+            uint32_t kb = (wad->lumps[i].size + 1023) / 1024;
+            profile_rank_t rank = {(uint16_t)(set->base[w] + i), access->accesses / kb};
+            
+            // Insertion into a sorted top-N list
+            uint32_t pos = (count < max) ? count++ : max;
+            while (pos > 0 && ranks[pos - 1].score < rank.score) {
+                if (pos < max) {
+                    ranks[pos] = ranks[pos - 1];
+                }
+                pos--;
+            }
+            if (pos < max) {
+                ranks[pos] = rank;
+            }
+        }
+    }
+    return count;
+}
+
+void wad_set_dump_profile(const wad_set_t *set, uint32_t max_lumps) {
+    if (!set || max_lumps == 0) {
+        return;
+    }
+    
+    profile_rank_t *ranks = (profile_rank_t *)Z_Malloc(max_lumps * sizeof(profile_rank_t), PU_STATIC, NULL);
+    if (!ranks) {
+        printf("Error: Failed to allocate profile ranking\n");
+        return;
+    }
+    uint32_t count = rank_profile(set, ranks, max_lumps);
+    
+    printf("--- lump profile: %u lumps, hottest first (NAME # lookups bytes) ---\n", count);
+    for (uint32_t r = 0; r < count; r++) {
+        uint32_t index;
+        const wad_file_t *wad = lump_wad(set, ranks[r].lump, &index);
+        printf("%-8.8s  # %lu %lu\n", wad->lumps[index].name,
+               wad->access[index].accesses, wad->access[index].bytes);
+    }
+    printf("--- end lump profile ---\n");
+    Z_Free(ranks);
+}
+
+/**
+ * Pin one set lump (decompressing it if needed)
+ */
+static bool pin_lump(wad_set_t *set, int lump) {
+    uint32_t index;
+    wad_file_t *wad = lump_wad(set, lump, &index);
+    const wad_lump_t *entry = &wad->lumps[index];
+    if (entry->size == 0 || entry->size > lump_pin_space()) {
+        return false;
+    }
+    
+    // Read without counting it as an access
+    wad_lump_access_t *access = wad->access;
+    wad->access = NULL;
+    const uint8_t *data = wad_get_lump_data(wad, entry);
+    wad->access = access;
+    
+    bool pinned = lump_pin_add(entry, data, entry->size);
+    lump_cache_drop(entry);  // The pinned copy replaces any cached one
+    return pinned;
+}
+
+uint32_t wad_set_pin_hot(wad_set_t *set, const char *list, uint32_t len) {
+    if (!set || set->num_wads == 0) {
+        return 0;
+    }
+    lump_pin_clear();
+    
+    uint32_t pinned = 0;
+    if (list) {
+        // Stored profile: one name per line, anything after it ignored
+        uint32_t pos = 0;
+        while (pos < len) {
+            char name[9];
+            uint32_t n = 0;
+            while (pos < len && (list[pos] == ' ' || list[pos] == '\t')) {
+                pos++;
+            }
+            while (pos < len && n < 8 && list[pos] != ' ' && list[pos] != '\t' &&
+                   list[pos] != '#' && list[pos] != '\r' && list[pos] != '\n') {
+                name[n++] = list[pos++];
+            }
+            name[n] = '\0';
+            while (pos < len && list[pos] != '\n') {
+                pos++;
+            }
+            pos++;
+            
+            int lump = (n > 0) ? wad_set_find(set, name) : -1;
+            if (lump >= 0 && pin_lump(set, lump)) {
+                pinned++;
+            }
+        }
+    } else {
+        profile_rank_t ranks[LUMP_PIN_MAX];
+        uint32_t count = rank_profile(set, ranks, LUMP_PIN_MAX);
+        for (uint32_t r = 0; r < count; r++) {
+            if (pin_lump(set, ranks[r].lump)) {
+                pinned++;
+            }
+        }
+    }
+    
+    lump_pin_stats_t stats;
+    lump_pin_get_stats(&stats);
+    printf("Pinned %u hot lumps in SRAM (%u/%u bytes) from %s profile\n",
+           pinned, stats.used_bytes, stats.budget_bytes, list ? "stored" : "live");
+    return pinned;
+}
@@ -0,0 +1,370 @@
+/**
+ * Zone memory implementation
+ *
+ * Region layout:
+ *   [ general block list ........ | level arena (grows down) ]
+ *   base                      level_top                    end
+ *
+ * The last block in the list always ends at level_top. When it is free,
+ * the arena grows by taking bytes off its end; dropping the arena gives
+ * them back.
+ */
+
+#include "z_zone.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ZONE_ID          0x1D4A11u
+#define ZONE_ALIGN       8
+#define MINFRAGMENT      64          // Smallest free block worth splitting off
+#define LEVEL_BUCKETS    16          // Freed level blocks, by size
+
+typedef struct memblock_s {
+    uint32_t size;                   // Header included
+    int tag;                         // PU_FREE if free
+    void **user;
+    uint32_t id;                     // ZONE_ID while allocated
+    struct memblock_s *next;
+    struct memblock_s *prev;
+} memblock_t;
+
+_Static_assert(PICO_DOOM_ZONE_KB + ZONE_DEBUG_KB <= ZONE_SRAM_KB,
+               "PICO_DOOM_ZONE_KB leaves no SRAM for the capture/telemetry buffers");
+
+static uint8_t zone_region[PICO_DOOM_ZONE_KB * 1024] __attribute__((aligned(ZONE_ALIGN)));
+
+static memblock_t blocklist;         // Sentinel: never free, links the ring
+static memblock_t *rover;
+static uint8_t *level_top;           // Start of the level arena
+static memblock_t *level_free[LEVEL_BUCKETS];
+static zone_stats_t stats;
+
+static inline uint32_t header_size(void) {
+    return (sizeof(memblock_t) + ZONE_ALIGN - 1) & ~(ZONE_ALIGN - 1);
+}
+
+static inline void *block_data(memblock_t *block) {
+    return (uint8_t *)block + header_size();
+}
+
+static inline memblock_t *data_block(void *ptr) {
+    return (memblock_t *)((uint8_t *)ptr - header_size());
+}
+
+static inline bool in_level_arena(const memblock_t *block) {
+    return (const uint8_t *)block >= level_top && (const uint8_t *)block < zone_region + sizeof(zone_region);
+}
+
+static void account(int tag, int32_t bytes, int32_t blocks) {
+    stats.tag_bytes[tag] += bytes;
+    stats.tag_blocks[tag] += blocks;
+    stats.used_bytes += bytes;
+    if (stats.used_bytes > stats.peak_used) {
+        stats.peak_used = stats.used_bytes;
+    }
+}
+
+void Z_Init(void) {
+    memset(&stats, 0, sizeof(stats));
+    memset(level_free, 0, sizeof(level_free));
+    stats.total_bytes = sizeof(zone_region);
+    
+    memblock_t *block = (memblock_t *)zone_region;
+    block->size = sizeof(zone_region);
+    block->tag = PU_FREE;
+    block->user = NULL;
+    block->id = 0;
+    block->next = block->prev = &blocklist;
+    
+    blocklist.size = 0;
+    blocklist.tag = PU_STATIC;
+    blocklist.user = (void **)&blocklist;
+    blocklist.id = ZONE_ID;
+    blocklist.next = blocklist.prev = block;
+    
+    rover = block;
+    level_top = zone_region + sizeof(zone_region);
+}
+
+/**
+ * Free a general block, merging it with free neighbours
+ */
+static void free_block(memblock_t *block) {
+    if (block->user) {
+        *block->user = NULL;
+    }
+    account(block->tag, -(int32_t)block->size, -1);
+    block->tag = PU_FREE;
+    block->user = NULL;
+    block->id = 0;
+    
+    memblock_t *other = block->prev;
+    if (other->tag == PU_FREE) {
+        other->size += block->size;
+        other->next = block->next;
+        other->next->prev = other;
+        if (block == rover) {
+            rover = other;
+        }
+        block = other;
+    }
+    
+    other = block->next;
+    if (other->tag == PU_FREE) {
+        block->size += other->size;
+        block->next = other->next;
+        block->next->prev = block;
+        if (other == rover) {
+            rover = block;
+        }
+    }
+}
+
+/**
+ * Allocate from the level arena: reuse a freed block of the same size,
+ * else take the bytes off the end of the last (free) list block
+ */
+static memblock_t *level_alloc(uint32_t size) {
+    memblock_t **link = &level_free[(size / ZONE_ALIGN) % LEVEL_BUCKETS];
+    while (*link) {
+        if ((*link)->size == size) {
+            memblock_t *block = *link;
+            *link = block->next;
+            return block;
+        }
+        link = &(*link)->next;
+    }
+    
+    memblock_t *tail = blocklist.prev;
+    if (tail == &blocklist || tail->tag != PU_FREE || tail->size < size + MINFRAGMENT) {
+        return NULL;
+    }
+    tail->size -= size;
+    level_top -= size;
+    stats.level_bytes += size;
+    memblock_t *block = (memblock_t *)level_top;
+    block->size = size;
+    return block;
+}
+
+void* Z_Malloc(uint32_t size, int tag, void **user) {
+    if (tag <= 0 || tag >= PU_NUM_TAGS || tag == PU_FREE) {
+        printf("Error: Z_Malloc: bad tag %d\n", tag);
+        return NULL;
+    }
+    if (tag >= PU_PURGELEVEL && !user) {
+        printf("Error: Z_Malloc: purgable block without a user\n");
+        return NULL;
+    }
+    size = ((size + ZONE_ALIGN - 1) & ~(ZONE_ALIGN - 1)) + header_size();
+    
+    memblock_t *base = NULL;
+    if (tag == PU_LEVEL) {
+        base = level_alloc(size);
+    }
+    
+    if (!base) {
+        // Doom's rover scan: walk forward from the rover, purging
+        // purgable blocks, until a free run is big enough
+        base = rover;
+        if (base->prev->tag == PU_FREE) {
+            base = base->prev;
+        }
+        memblock_t *scan = base;
+        memblock_t *start = base->prev;
+        do {
+            if (scan == start) {
+                stats.failed_allocs++;
+                return NULL;
+            }
+            if (scan->tag != PU_FREE) {
+                if (scan->tag < PU_PURGELEVEL) {
+                    base = scan = scan->next;
+                } else {
+                    base = base->prev;
+                    free_block(scan);
+                    stats.purged_blocks++;
+                    base = base->next;
+                    scan = base->next;
+                }
+            } else {
+                scan = scan->next;
+            }
+        } while (base->tag != PU_FREE || base->size < size);
+        
+        uint32_t extra = base->size - size;
+        if (extra > MINFRAGMENT) {
+            memblock_t *rest = (memblock_t *)((uint8_t *)base + size);
+            rest->size = extra;
+            rest->tag = PU_FREE;
+            rest->user = NULL;
+            rest->id = 0;
+            rest->prev = base;
+            rest->next = base->next;
+            rest->next->prev = rest;
+            base->next = rest;
+            base->size = size;
+        }
+        rover = base->next;
+    }
+    
+    base->tag = tag;
+    base->user = user;
+    base->id = ZONE_ID;
+    account(tag, base->size, 1);
+    
+    void *data = block_data(base);
+    if (user) {
+        *user = data;
+    }
+    return data;
+}
+
+void Z_Free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    memblock_t *block = data_block(ptr);
+    if (block->id != ZONE_ID) {
+        printf("Error: Z_Free: pointer %p is not a zone block\n", ptr);
+        return;
+    }
+    
+    if (!in_level_arena(block)) {
+        free_block(block);
+        return;
+    }
+    
+    if (block->user) {
+        *block->user = NULL;
+    }
+    account(block->tag, -(int32_t)block->size, -1);
+    block->id = 0;
+    block->user = NULL;
+    
+    // The newest arena block goes straight back to the list's tail
+    memblock_t *tail = blocklist.prev;
+    if ((uint8_t *)block == level_top && tail != &blocklist && tail->tag == PU_FREE) {
+        tail->size += block->size;
+        level_top += block->size;
+        stats.level_bytes -= block->size;
+        return;
+    }
+    memblock_t **bucket = &level_free[(block->size / ZONE_ALIGN) % LEVEL_BUCKETS];
+    block->next = *bucket;
+    *bucket = block;
+}
+
+/**
+ * Drop the whole level arena and give its bytes back to the list
+ */
+static void free_level_arena(void) {
+    uint8_t *end = zone_region + sizeof(zone_region);
+    if (level_top == end) {
+        return;
+    }
+    
+    // Clear the user pointers of blocks still allocated
+    for (uint8_t *p = level_top; p < end; p += ((memblock_t *)p)->size) {
+        memblock_t *block = (memblock_t *)p;
+        if (block->id == ZONE_ID) {
+            if (block->user) {
+                *block->user = NULL;
+            }
+            account(block->tag, -(int32_t)block->size, -1);
+            block->id = 0;
+        }
+    }
+    
+    memblock_t *tail = blocklist.prev;
+    if (tail != &blocklist && tail->tag == PU_FREE) {
+        tail->size += end - level_top;
+    } else {
+        memblock_t *block = (memblock_t *)level_top;
+        block->size = end - level_top;
+        block->tag = PU_FREE;
+        block->user = NULL;
+        block->id = 0;
+        block->prev = tail;
+        block->next = &blocklist;
+        tail->next = block;
+        blocklist.prev = block;
+    }
+    level_top = end;
+    stats.level_bytes = 0;
+    memset(level_free, 0, sizeof(level_free));
+}
+
+void Z_FreeTags(int low_tag, int high_tag) {
+    if (low_tag <= PU_LEVEL && high_tag >= PU_LEVEL) {
+        free_level_arena();
+    }
+    
+    // Skip the walk if no list block carries a tag in range
+    uint32_t blocks = 0;
+    for (int tag = low_tag; tag <= high_tag && tag < PU_NUM_TAGS; tag++) {
+        if (tag > 0) {
+            blocks += stats.tag_blocks[tag];
+        }
+    }
+    if (blocks == 0) {
+        return;
+    }
+    
+    memblock_t *next;
+    for (memblock_t *block = blocklist.next; block != &blocklist; block = next) {
+        next = block->next;
+        if (block->tag != PU_FREE && block->tag >= low_tag && block->tag <= high_tag) {
+            // Merging may swallow the next block; resume after the survivor
+            memblock_t *prev = block->prev;
+            free_block(block);
+            next = (prev->tag == PU_FREE ? prev : block)->next;
+        }
+    }
+}
+
+void Z_ChangeTag(void *ptr, int tag) {
+    memblock_t *block = data_block(ptr);
+    if (block->id != ZONE_ID) {
+        printf("Error: Z_ChangeTag: pointer %p is not a zone block\n", ptr);
+        return;
+    }
+    if (tag <= 0 || tag >= PU_NUM_TAGS || tag == PU_FREE) {
+        printf("Error: Z_ChangeTag: bad tag %d\n", tag);
+        return;
+    }
+    if (tag >= PU_PURGELEVEL && !block->user) {
+        printf("Error: Z_ChangeTag: purgable block without a user\n");
+        return;
+    }
+    if (in_level_arena(block) && tag != PU_LEVEL) {
+        printf("Error: Z_ChangeTag: level arena blocks stay PU_LEVEL\n");
+        return;
+    }
+    account(block->tag, -(int32_t)block->size, -1);
+    block->tag = tag;
+    account(tag, block->size, 1);
+}
+
+void zone_get_stats(zone_stats_t *out) {
+    stats.free_bytes = 0;
+    stats.largest_free = 0;
+    stats.free_blocks = 0;
+    for (memblock_t *block = blocklist.next; block != &blocklist; block = block->next) {
+        if (block->tag == PU_FREE) {
+            stats.free_bytes += block->size;
+            stats.free_blocks++;
+            if (block->size - header_size() > stats.largest_free) {
+                stats.largest_free = block->size - header_size();
+            }
+        }
+    }
+    *out = stats;
+}
+
+const char* zone_tag_name(int tag) {
+    static const char *names[PU_NUM_TAGS] = {
+        "?", "static", "sound", "music", "free", "level", "levspec", "purgelevel", "cache"
+    };
+    return (tag >= 0 && tag < PU_NUM_TAGS) ? names[tag] : "?";
+}
@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+"""
+Generate a small IWAD for the host renderer tests.
+
+    python3 tests/make_test_wad.py test.wad
+
+The WAD holds everything render_host needs: PLAYPAL, COLORMAP, patches,
+TEXTURE1, flats, sprites, one map (E1M1) with a BSP built here, and a
+300-tic DEMO1 that walks and turns through it. The palette is 8 hues x 32
+brightness steps so that wrong colormaps or lumps show up as wrong pixels.
+"""
+
+import argparse
+import math
+import struct
+
+
+def s16(*values):
+    return struct.pack("<%dh" % len(values), *values)
+
+
+def name8(name):
+    return name.ljust(8, b"\0")
+
+
+def colour(hue, brightness):
+    return hue * 32 + brightness
+
+
+# ---- Palette and colormaps
+
+HUES = [(255, 60, 60), (60, 255, 60), (60, 60, 255), (255, 255, 60),
+        (255, 60, 255), (60, 255, 255), (255, 160, 60), (200, 200, 200)]
+
+
+def make_playpal():
+    pal = b""
+    for c in range(256):
+        r, g, b = HUES[c // 32]
+        level = c % 32
+        pal += bytes([r * level // 31, g * level // 31, b * level // 31])
+    return pal * 14
+
+
+def make_colormap():
+    """32 darkening maps, the identity and an inverse map."""
+    maps = b""
+    for light in range(34):
+        for c in range(256):
+            if light < 32:
+                maps += bytes([(c // 32) * 32 + max(0, c % 32 - light)])
+            elif light == 32:
+                maps += bytes([c])
+            else:
+                maps += bytes([7 * 32 + 31 - c % 32])
+    return maps
+
+
+# ---- Graphics
+
+def patch(width, height, pixel, left=0, top=0, hole=None):
+    """A Doom patch; hole(x, y) marks transparent pixels."""
+    columns = []
+    body = b""
+    base = 8 + 4 * width
+    for x in range(width):
+        columns.append(base + len(body))
+        y = 0
+        while y < height:
+            if hole and hole(x, y):
+                y += 1
+                continue
+            y0 = y
+            post = b""
+            while y < height and not (hole and hole(x, y)) and y - y0 < 128:
+                post += bytes([pixel(x, y)])
+                y += 1
+            body += bytes([y0, len(post), 0]) + post + b"\0"
+        body += b"\xff"
+    header = struct.pack("<hhhh", width, height, left, top)
+    return header + b"".join(struct.pack("<I", o) for o in columns) + body
+
+
+def flat(pixel):
+    return bytes(pixel(x, y) for y in range(64) for x in range(64))
+
+
+def sprite(width, height, hue):
+    return patch(width, height, lambda x, y: colour(hue, 31 if (x + y) % 4 else 20),
+                 left=width // 2, top=height,
+                 hole=lambda x, y: ((x - width / 2) ** 2 / (width / 2) ** 2 +
+                                    (y - height / 2) ** 2 / (height / 2) ** 2 > 1))
+
+
+def texture(name, width, height, patches):
+    return (name8(name) + struct.pack("<ihhih", 0, width, height, 0, len(patches)) +
+            b"".join(struct.pack("<hhhhh", x, y, p, 1, 0) for x, y, p in patches))
+
+
+def make_graphics():
+    patches = [
+        (b"WALLP", patch(64, 128, lambda x, y: colour(
+            0, 31 if (y % 16) and ((x + (y // 16) * 8) % 32) else 20))),
+        (b"STEPP", patch(32, 32, lambda x, y: colour(3, 31 if (x // 8 + y // 8) % 2 else 24))),
+        (b"MASKP", patch(64, 64, lambda x, y: colour(5, 31),
+                         hole=lambda x, y: x % 16 < 8 and y % 16 < 8)),
+        (b"SKYP", patch(256, 128, lambda x, y: colour(
+            2, 10 + y * 20 // 128 if (x // 32) % 2 else 31 - y * 15 // 128))),
+    ]
+    pnames = struct.pack("<i", len(patches)) + b"".join(name8(n) for n, _ in patches)
+
+    textures = [
+        texture(b"AASHITTY", 64, 64, [(0, 0, 1)]),
+        texture(b"WALL", 64, 128, [(0, 0, 0)]),
+        texture(b"STEP", 32, 32, [(0, 0, 1)]),
+        texture(b"MASK", 64, 64, [(0, 0, 2)]),
+        texture(b"SKY1", 256, 128, [(0, 0, 3)]),
+    ]
+    offsets = []
+    body = b""
+    for t in textures:
+        offsets.append(4 + 4 * len(textures) + len(body))
+        body += t
+    texture1 = struct.pack("<i", len(textures)) + b"".join(struct.pack("<i", o) for o in offsets) + body
+
+    flats = [
+        (b"FLOOR", flat(lambda x, y: colour(1, 31 if (x // 8 + y // 8) % 2 else 16))),
+        (b"CEIL", flat(lambda x, y: colour(7, 28 if (x // 16 + y // 16) % 2 else 12))),
+        (b"PLAT", flat(lambda x, y: colour(4, 31 if x < 32 else 18))),
+        (b"F_SKY1", flat(lambda x, y: 0)),
+    ]
+    sprites = [
+        (b"BAR1A0", sprite(24, 32, 6)),
+        (b"TROOA1", sprite(40, 56, 0)),
+        (b"TROOA2A8", sprite(36, 56, 3)),
+        (b"TROOA3A7", sprite(20, 56, 3)),
+        (b"TROOA4A6", sprite(36, 56, 5)),
+        (b"TROOA5", sprite(40, 56, 5)),
+    ]
+    return pnames, texture1, patches, flats, sprites
+
+
+# ---- Map: room A, a sky room S north of it behind a masked wall, and a
+# raised platform P inside A
+
+SECTORS = [(0, 160, b"FLOOR", b"CEIL", 192),
+           (0, 224, b"FLOOR", b"F_SKY1", 255),
+           (32, 160, b"PLAT", b"CEIL", 160)]
+
+
+class Map:
+    def __init__(self):
+        self.vertexes = []
+        self.vertex_index = {}
+        self.lines = []
+
+    def vertex(self, x, y):
+        if (x, y) not in self.vertex_index:
+            self.vertex_index[(x, y)] = len(self.vertexes)
+            self.vertexes.append((x, y))
+        return self.vertex_index[(x, y)]
+
+    def line(self, a, b, front, back=None, front_tex=(b"-", b"-", b"WALL"),
+             back_tex=None, flags=1):
+        """The front side is on the right going from a to b."""
+        self.lines.append((self.vertex(*a), self.vertex(*b), front, back, front_tex, back_tex, flags))
+
+
+def make_geometry():
+    m = Map()
+    m.line((0, 0), (0, 384), 0)
+    m.line((512, 384), (512, 0), 0)
+    m.line((512, 0), (0, 0), 0)
+    open_wall = (b"WALL", b"-", b"-")
+    masked = (b"WALL", b"-", b"MASK")
+    m.line((0, 384), (192, 384), 0, 1, open_wall, open_wall, 4)
+    m.line((192, 384), (320, 384), 0, 1, masked, masked, 4)
+    m.line((320, 384), (512, 384), 0, 1, open_wall, open_wall, 4)
+    m.line((0, 384), (0, 640), 1)
+    m.line((0, 640), (512, 640), 1)
+    m.line((512, 640), (512, 384), 1)
+    step = (b"-", b"STEP", b"-")
+    none = (b"-", b"-", b"-")
+    for a, b in [((192, 128), (320, 128)), ((320, 128), (320, 256)),
+                 ((320, 256), (192, 256)), ((192, 256), (192, 128))]:
+        m.line(a, b, 0, 2, step, none, 4 | 0x10)
+    return m
+
+
+def side_of(px, py, x, y, dx, dy):
+    """0 front, 1 back, 2 on the partition line."""
+    left = dy * (px - x)
+    right = (py - y) * dx
+    return 0 if right < left else (1 if right > left else 2)
+
+
+class Bsp:
+    def __init__(self, m):
+        self.map = m
+        self.segs = []
+        self.subsectors = []
+        self.nodes = []
+
+    @staticmethod
+    def convex(segs):
+        for p in segs:
+            x, y = p[0]
+            dx, dy = p[1][0] - x, p[1][1] - y
+            for q in segs:
+                for pt in (q[0], q[1]):
+                    if side_of(pt[0], pt[1], x, y, dx, dy) == 1:
+                        return False
+        return True
+
+    @staticmethod
+    def bbox(segs):
+        xs = [p[0] for s in segs for p in s[:2]]
+        ys = [p[1] for s in segs for p in s[:2]]
+        return (max(ys), min(ys), min(xs), max(xs))
+
+    def split(self, segs, x, y, dx, dy):
+        front, back = [], []
+        splits = 0
+        for q in segs:
+            a = side_of(*q[0], x, y, dx, dy)
+            b = side_of(*q[1], x, y, dx, dy)
+            if a == 2 and b == 2:
+                same = (q[1][0] - q[0][0]) * dx + (q[1][1] - q[0][1]) * dy > 0
+                (front if same else back).append(q)
+            elif a != 1 and b != 1:
+                front.append(q)
+            elif a != 0 and b != 0:
+                back.append(q)
+            else:
+                (x1, y1), (x2, y2) = q[0], q[1]
+                t = ((x - x1) * dy - (y - y1) * dx) / ((x2 - x1) * dy - (y2 - y1) * dx)
+                ix, iy = round(x1 + t * (x2 - x1)), round(y1 + t * (y2 - y1))
+                q1 = (q[0], (ix, iy), q[2], q[3], q[4])
+                q2 = ((ix, iy), q[1], q[2], q[3], q[4] + math.hypot(ix - x1, iy - y1))
+                (front if a == 0 else back).append(q1)
+                (front if b == 0 else back).append(q2)
+                splits += 1
+        return front, back, splits
+
+    def build(self, segs):
+        """Returns the child reference for segs: a node, or 0x8000 | subsector."""
+        if self.convex(segs):
+            self.subsectors.append((len(segs), len(self.segs)))
+            self.segs.extend(segs)
+            return 0x8000 | (len(self.subsectors) - 1)
+        best = None
+        for p in segs:
+            x, y = p[0]
+            partition = (x, y, p[1][0] - x, p[1][1] - y)
+            front, back, splits = self.split(segs, *partition)
+            if front and back:
+                score = splits * 4 + abs(len(front) - len(back))
+                if best is None or score < best[0]:
+                    best = (score, partition, front, back)
+        _, partition, front, back = best
+        right = self.build(front)
+        left = self.build(back)
+        self.nodes.append((partition, self.bbox(front), self.bbox(back), right, left))
+        return len(self.nodes) - 1
+
+
+def bam(dx, dy):
+    return int(round(math.atan2(dy, dx) / (2 * math.pi) * 65536)) % 65536
+
+
+def make_map():
+    m = make_geometry()
+    sides = []
+    linedefs = []
+    segs = []
+    for i, (a, b, front, back, front_tex, back_tex, flags) in enumerate(m.lines):
+        front_side = len(sides)
+        sides.append((front_tex, front))
+        back_side = -1
+        segs.append((m.vertexes[a], m.vertexes[b], i, 0, 0))
+        if back is not None:
+            back_side = len(sides)
+            sides.append((back_tex, back))
+            segs.append((m.vertexes[b], m.vertexes[a], i, 1, 0))
+        linedefs.append((a, b, flags, 0, 0, front_side, back_side))
+
+    bsp = Bsp(m)
+    bsp.build(segs)
+
+    seg_data = b""
+    for s in bsp.segs:
+        angle = bam(s[1][0] - s[0][0], s[1][1] - s[0][1])
+        if angle > 32767:
+            angle -= 65536
+        seg_data += s16(m.vertex(*s[0]), m.vertex(*s[1]), angle, s[2], s[3], int(s[4]))
+
+    things = (s16(256, 32, 90, 1, 7) + s16(100, 300, 0, 2035, 7) + s16(420, 300, 270, 3001, 7) +
+              s16(256, 520, 270, 3001, 7) + s16(60, 100, 45, 3001, 7))
+
+    # Every block lists every line: the map is small
+    cols, rows = 5, 6
+    blockmap = s16(-8, -8, cols, rows)
+    blockmap += s16(*([4 + cols * rows] * (cols * rows)))
+    blockmap += s16(0, *range(len(linedefs)), -1)
+
+    return [
+        (b"E1M1", b""),
+        (b"THINGS", things),
+        (b"LINEDEFS", b"".join(s16(*l) for l in linedefs)),
+        (b"SIDEDEFS", b"".join(s16(0, 0) + name8(t[0]) + name8(t[1]) + name8(t[2]) + s16(sector)
+                               for t, sector in sides)),
+        (b"VERTEXES", b"".join(s16(*v) for v in m.vertexes)),
+        (b"SEGS", seg_data),
+        (b"SSECTORS", b"".join(s16(n, first) for n, first in bsp.subsectors)),
+        (b"NODES", b"".join(s16(*p) + s16(*r) + s16(*l) + struct.pack("<HH", rc, lc)
+                            for p, r, l, rc, lc in bsp.nodes)),
+        (b"SECTORS", b"".join(s16(f, c) + name8(fp) + name8(cp) + s16(light, 0, 0)
+                              for f, c, fp, cp, light in SECTORS)),
+        (b"REJECT", bytes((len(SECTORS) ** 2 + 7) // 8)),
+        (b"BLOCKMAP", blockmap),
+    ]
+
+
+# ---- Demo: v1.9 header, then forward/back, strafe and turn in a loop
+
+def make_demo(tics=300):
+    header = bytes([109, 2, 1, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0])
+    body = b""
+    for t in range(tics):
+        forward = 0x19 if (t // 40) % 2 == 0 else -0x19
+        side = 0x18 if t % 70 < 10 else 0
+        turn = 5 if t % 50 < 8 else 0
+        body += struct.pack("<bbBB", forward, side, turn, 0)
+    return header + body + b"\x80"
+
+
+def write_wad(path, lumps):
+    data = b""
+    directory = b""
+    for name, lump in lumps:
+        directory += struct.pack("<ii", 12 + len(data), len(lump)) + name8(name)
+        data += lump
+    with open(path, "wb") as f:
+        f.write(b"IWAD" + struct.pack("<ii", len(lumps), 12 + len(data)) + data + directory)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("output", help="WAD file to write")
+    args = ap.parse_args()
+
+    pnames, texture1, patches, flats, sprites = make_graphics()
+    lumps = [(b"PLAYPAL", make_playpal()), (b"COLORMAP", make_colormap()),
+             (b"PNAMES", pnames), (b"TEXTURE1", texture1), (b"DEMO1", make_demo())]
+    lumps += make_map()
+    lumps += [(b"P_START", b"")] + patches + [(b"P_END", b"")]
+    lumps += [(b"F_START", b"")] + flats + [(b"F_END", b"")]
+    lumps += [(b"S_START", b"")] + sprites + [(b"S_END", b"")]
+    write_wad(args.output, lumps)
+
+
+if __name__ == "__main__":
+    main()
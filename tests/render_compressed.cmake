@@ -0,0 +1,33 @@
+# Renders the test WAD's demo from a compressed image in a lump cache
+# smaller than the level's flats and sprites, and compares the last frame
+# with the same demo rendered from the raw image.
+# Run by ctest with PYTHON, MAKE_WAD, WADPACK, RENDER_HOST, CACHE_KB and
+# WORK_DIR defined.
+
+function(run)
+    execute_process(COMMAND ${ARGN}
+        WORKING_DIRECTORY ${WORK_DIR}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE output)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${ARGN} failed (${result}):\n${output}")
+    endif()
+    set(output "${output}" PARENT_SCOPE)
+endfunction()
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+run(${PYTHON} ${MAKE_WAD} test.wad)
+run(${WADPACK} --texcols --levels -o raw.bin test.wad)
+run(${WADPACK} --compress --texcols --levels -o compressed.bin test.wad)
+run(${RENDER_HOST} raw.bin --timedemo DEMO1 -o reference.ppm)
+run(${RENDER_HOST} compressed.bin --timedemo DEMO1 --cache-kb ${CACHE_KB} --compare reference.ppm)
+
+# The level must not fit, and each frame's flats and sprites still must
+if(NOT output MATCHES "Lump cache: [0-9]+ hits, [0-9]+ misses, ([0-9]+) evictions, ([0-9]+) failures")
+    message(FATAL_ERROR "No lump cache statistics:\n${output}")
+endif()
+if(CMAKE_MATCH_1 EQUAL 0 OR NOT CMAKE_MATCH_2 EQUAL 0)
+    message(FATAL_ERROR "Expected evictions and no failures in a ${CACHE_KB} KB cache:\n${output}")
+endif()
+message(STATUS "${output}")
@@ -0,0 +1,201 @@
+/**
+ * test_frame_pacer - frame pacing policies against a simulated clock
+ *
+ * Plays the core 1 loop (frame ready, ask the pacer, wait, present) with a
+ * fake microsecond clock and checks the intervals each policy produces.
+ * A TE run also simulates the panel's tearing-effect edges; like the
+ * device, it presents on the first real edge after the frame is ready.
+ */
+
+#include "frame_pacer.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+#define START_US        1000    // The pacer treats time 0 as "never"
+#define FRAMES          120
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __func__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+/**
+ * Simulated panel tearing-effect output
+ */
+typedef struct {
+    uint64_t phase;           // First edge
+    uint32_t period_us;       // 0 = no TE line
+} sim_panel_t;
+
+/**
+ * Last edge at or before now, 0 if none yet
+ */
+static uint64_t te_last(const sim_panel_t *panel, uint64_t now) {
+    if (!panel || !panel->period_us || now < panel->phase) {
+        return 0;
+    }
+    return panel->phase + (now - panel->phase) / panel->period_us * panel->period_us;
+}
+
+/**
+ * First edge after now
+ */
+static uint64_t te_next(const sim_panel_t *panel, uint64_t now) {
+    if (now < panel->phase) {
+        return panel->phase;
+    }
+    return te_last(panel, now) + panel->period_us;
+}
+
+/**
+ * Run frames through the pacer, each ready render_us[i % n] after the
+ * last one started scanout. Returns the simulated time at the end.
+ */
+static uint64_t simulate(frame_pacer_t *pacer, const sim_panel_t *panel, uint64_t now,
+                         const uint32_t *render_us, int n, int frames) {
+    for (int i = 0; i < frames; i++) {
+        now += render_us[i % n];
+        if (panel && panel->period_us) {
+            uint64_t edge = te_last(panel, now);
+            if (edge) {
+                frame_pacer_on_te(pacer, edge);
+            }
+        }
+        
+        uint64_t target = frame_pacer_next_present(pacer, now);
+        if (pacer->policy == FRAME_PACE_TE && panel && panel->period_us) {
+            // The device waits for the edge itself, not the prediction
+            CHECK(target == te_next(panel, now) || target == now,
+                  "predicted edge %llu, real edge %llu",
+                  (unsigned long long)target, (unsigned long long)te_next(panel, now));
+            now = te_next(panel, now);
+        } else if (target > now) {
+            now = target;
+        }
+        frame_pacer_presented(pacer, now);
+    }
+    return now;
+}
+
+/**
+ * Warm up, then run a measured window and return its statistics
+ */
+static void run_window(frame_pace_policy_t policy, const sim_panel_t *panel,
+                       const uint32_t *render_us, int n, frame_pace_stats_t *stats) {
+    frame_pacer_t pacer;
+    frame_pacer_init(&pacer, policy, START_US);
+    uint64_t now = simulate(&pacer, panel, START_US, render_us, n, 4);
+    frame_pacer_reset_stats(&pacer);
+    simulate(&pacer, panel, now, render_us, n, FRAMES);
+    frame_pacer_get_stats(&pacer, stats);
+}
+
+static void test_asap(void) {
+    const uint32_t render[] = {12345};
+    frame_pace_stats_t stats;
+    run_window(FRAME_PACE_ASAP, NULL, render, 1, &stats);
+    CHECK(stats.frames == FRAMES, "frames %lu", (unsigned long)stats.frames);
+    CHECK(stats.mean_us == 12345, "mean %lu", (unsigned long)stats.mean_us);
+    CHECK(stats.stddev_us == 0, "jitter %lu", (unsigned long)stats.stddev_us);
+    CHECK(stats.missed == 0, "missed %lu", (unsigned long)stats.missed);
+    
+    // Uneven frames are presented as they come
+    const uint32_t uneven[] = {5000, 20000};
+    run_window(FRAME_PACE_ASAP, NULL, uneven, 2, &stats);
+    CHECK(stats.min_us == 5000 && stats.max_us == 20000, "min %lu max %lu",
+          (unsigned long)stats.min_us, (unsigned long)stats.max_us);
+    CHECK(stats.stddev_us == 7500, "jitter %lu", (unsigned long)stats.stddev_us);
+}
+
+/**
+ * A fixed-rate policy: on-time frames land exactly on the cadence, even
+ * when render time varies, and late frames skip whole slots
+ */
+static void test_fixed_rate(frame_pace_policy_t policy, uint32_t period_us) {
+    const char *name = frame_pacer_policy_name(policy);
+    frame_pace_stats_t stats;
+    
+    const uint32_t fast[] = {4000, 9000, 15000};
+    run_window(policy, NULL, fast, 3, &stats);
+    CHECK(stats.frames == FRAMES, "%s frames %lu", name, (unsigned long)stats.frames);
+    CHECK(stats.min_us == period_us && stats.max_us == period_us,
+          "%s min %lu max %lu, want %lu", name, (unsigned long)stats.min_us,
+          (unsigned long)stats.max_us, (unsigned long)period_us);
+    CHECK(stats.stddev_us == 0, "%s jitter %lu", name, (unsigned long)stats.stddev_us);
+    CHECK(stats.missed == 0, "%s missed %lu", name, (unsigned long)stats.missed);
+    
+    // Every frame misses its slot by a little: each takes two slots
+    const uint32_t late[] = {period_us + 5000};
+    run_window(policy, NULL, late, 1, &stats);
+    CHECK(stats.min_us == 2 * period_us && stats.max_us == 2 * period_us,
+          "%s late min %lu max %lu", name, (unsigned long)stats.min_us,
+          (unsigned long)stats.max_us);
+    CHECK(stats.missed == FRAMES, "%s late missed %lu", name, (unsigned long)stats.missed);
+    
+    // A frame just past its slot goes out at once, not a slot later, and
+    // the next one is back on the cadence
+    const uint32_t edge[] = {10000, period_us + 500};
+    run_window(policy, NULL, edge, 2, &stats);
+    CHECK(stats.missed == 0, "%s tolerance missed %lu", name, (unsigned long)stats.missed);
+    CHECK(stats.min_us == period_us - 500 && stats.max_us == period_us + 500,
+          "%s tolerance min %lu max %lu", name, (unsigned long)stats.min_us,
+          (unsigned long)stats.max_us);
+}
+
+static void test_te(void) {
+    frame_pacer_t pacer;
+    frame_pace_stats_t stats;
+    
+    // No edge seen yet: present immediately
+    frame_pacer_init(&pacer, FRAME_PACE_TE, START_US);
+    CHECK(frame_pacer_next_present(&pacer, 50000) == 50000, "no TE should not wait");
+    
+    // Panel at the nominal rate: every frame on the next edge
+    sim_panel_t panel = {.phase = 3000, .period_us = 16667};
+    const uint32_t fast[] = {10000};
+    run_window(FRAME_PACE_TE, &panel, fast, 1, &stats);
+    CHECK(stats.min_us == 16667 && stats.max_us == 16667, "min %lu max %lu",
+          (unsigned long)stats.min_us, (unsigned long)stats.max_us);
+    CHECK(stats.stddev_us == 0, "jitter %lu", (unsigned long)stats.stddev_us);
+    
+    // Slower than one refresh: every other edge
+    const uint32_t slow[] = {20000};
+    run_window(FRAME_PACE_TE, &panel, slow, 1, &stats);
+    CHECK(stats.min_us == 33334 && stats.max_us == 33334, "slow min %lu max %lu",
+          (unsigned long)stats.min_us, (unsigned long)stats.max_us);
+    
+    // The refresh period estimate follows a panel off the nominal rate
+    frame_pacer_init(&pacer, FRAME_PACE_TE, START_US);
+    for (uint64_t edge = 2000; edge < 2000 + 64 * 16000; edge += 16000) {
+        frame_pacer_on_te(&pacer, edge);
+    }
+    CHECK(pacer.te_period_us >= 15950 && pacer.te_period_us <= 16050,
+          "period estimate %lu", (unsigned long)pacer.te_period_us);
+    
+    // Stale or repeated edges are ignored
+    uint64_t last = pacer.last_te;
+    frame_pacer_on_te(&pacer, last - 16000);
+    frame_pacer_on_te(&pacer, last);
+    CHECK(pacer.last_te == last, "stale edge accepted");
+}
+
+int main(void) {
+    test_asap();
+    test_fixed_rate(FRAME_PACE_35HZ, 28571);
+    test_fixed_rate(FRAME_PACE_30HZ, 33333);
+    test_fixed_rate(FRAME_PACE_17_5HZ, 57143);
+    test_te();
+    
+    if (failures) {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    printf("frame_pacer: all checks passed\n");
+    return 0;
+}
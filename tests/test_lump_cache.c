@@ -0,0 +1,228 @@
+/**
+ * test_lump_cache - purge tags, eviction order, prefetch and failures of the lump cache
+ *
+ * Runs the firmware's lump cache over the zone allocator with small LZ4
+ * blocks built here (one literal run each), so the test does not depend
+ * on the packer's compressor.
+ */
+
+#include "lump_cache.h"
+#include "z_zone.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LUMP_SIZE       1024
+#define NUM_LUMPS       8
+#define CACHE_BUDGET    (4 * (LUMP_SIZE + 64))   // Room for four lumps
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL %s:%d: ", __func__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        failures++; \
+    } \
+} while (0)
+
+/**
+ * A lump: its contents, its LZ4 block and a key (any unique address)
+ */
+typedef struct {
+    uint8_t data[LUMP_SIZE];
+    uint8_t block[LUMP_SIZE + 16];
+    uint32_t block_size;
+} test_lump_t;
+
+static test_lump_t lumps[NUM_LUMPS];
+
+/**
+ * Encode data as one LZ4 literal run (a valid block on its own)
+ */
+static uint32_t literal_block(uint8_t *out, const uint8_t *data, uint32_t size) {
+    uint8_t *p = out;
+    if (size < 15) {
+        *p++ = size << 4;
+    } else {
+        *p++ = 0xF0;
+        uint32_t rest = size - 15;
+        while (rest >= 255) {
+            *p++ = 255;
+            rest -= 255;
+        }
+        *p++ = rest;
+    }
+    memcpy(p, data, size);
+    return (p - out) + size;
+}
+
+static void make_lumps(void) {
+    for (int i = 0; i < NUM_LUMPS; i++) {
+        for (int j = 0; j < LUMP_SIZE; j++) {
+            lumps[i].data[j] = (uint8_t)(i * 37 + j * 7);
+        }
+        lumps[i].block_size = literal_block(lumps[i].block, lumps[i].data, LUMP_SIZE);
+    }
+}
+
+static const uint8_t *get(int i, lump_cache_tag_t tag) {
+    const uint8_t *p = lump_cache_get(&lumps[i], lumps[i].block, lumps[i].block_size,
+                                      LUMP_SIZE, tag);
+    CHECK(p && memcmp(p, lumps[i].data, LUMP_SIZE) == 0, "lump %d contents", i);
+    return p;
+}
+
+/**
+ * Whether a lump is cached, without changing anything: a prefetch of a
+ * cached lump only raises its tag, and CACHE raises nothing
+ */
+static bool cached(int i) {
+    lump_cache_stats_t before, after;
+    lump_cache_get_stats(&before);
+    lump_cache_prefetch(&lumps[i], lumps[i].block, lumps[i].block_size,
+                        LUMP_SIZE, LUMP_CACHE_CACHE);
+    lump_cache_get_stats(&after);
+    bool hit = (after.pending == before.pending);
+    while (lump_cache_service(LUMP_SIZE)) {
+    }
+    if (!hit) {
+        lump_cache_drop(&lumps[i]);
+    }
+    return hit;
+}
+
+/**
+ * Fill the cache with CACHE lookups of other lumps until it evicts
+ */
+static void pressure(int first) {
+    for (int i = first; i < NUM_LUMPS; i++) {
+        get(i, LUMP_CACHE_CACHE);
+    }
+}
+
+static void test_static_survives_cache_lookup(void) {
+    lump_cache_init(CACHE_BUDGET, NULL);
+    const uint8_t *a = get(0, LUMP_CACHE_STATIC);
+    CHECK(get(0, LUMP_CACHE_CACHE) == a, "hit moved the lump");
+    
+    pressure(1);
+    lump_cache_stats_t stats;
+    lump_cache_get_stats(&stats);
+    CHECK(stats.evictions > 0, "no eviction pressure (%u evictions)", stats.evictions);
+    CHECK(cached(0), "STATIC lump evicted after a CACHE lookup");
+    CHECK(get(0, LUMP_CACHE_CACHE) == a, "STATIC lump moved");
+}
+
+static void test_level_survives_until_purged(void) {
+    lump_cache_init(CACHE_BUDGET, NULL);
+    get(0, LUMP_CACHE_LEVEL);
+    get(0, LUMP_CACHE_PURGELEVEL);
+    get(0, LUMP_CACHE_CACHE);
+    pressure(1);
+    CHECK(cached(0), "LEVEL lump evicted after purgeable lookups");
+    
+    lump_cache_purge_tag(LUMP_CACHE_LEVEL);
+    CHECK(!cached(0), "LEVEL lump kept past lump_cache_purge_tag");
+}
+
+static void test_lookup_raises_tag(void) {
+    lump_cache_init(CACHE_BUDGET, NULL);
+    get(0, LUMP_CACHE_CACHE);
+    get(0, LUMP_CACHE_STATIC);
+    pressure(1);
+    CHECK(cached(0), "CACHE lump looked up as STATIC was evicted");
+    
+    // An explicit change still lowers it
+    lump_cache_change_tag(&lumps[0], LUMP_CACHE_CACHE);
+    pressure(1);
+    CHECK(!cached(0), "lump_cache_change_tag did not lower the tag");
+}
+
+static void test_eviction_order(void) {
+    // PURGELEVEL goes only after every CACHE entry
+    lump_cache_init(CACHE_BUDGET, NULL);
+    get(0, LUMP_CACHE_PURGELEVEL);
+    get(1, LUMP_CACHE_CACHE);
+    get(2, LUMP_CACHE_CACHE);
+    get(3, LUMP_CACHE_CACHE);
+    get(4, LUMP_CACHE_CACHE);
+    CHECK(cached(0), "PURGELEVEL evicted before CACHE");
+    CHECK(!cached(1), "least recently used CACHE lump kept");
+}
+
+static void test_prefetch(void) {
+    lump_cache_init(CACHE_BUDGET, NULL);
+    CHECK(lump_cache_prefetch(&lumps[0], lumps[0].block, lumps[0].block_size,
+                              LUMP_SIZE, LUMP_CACHE_LEVEL), "prefetch refused");
+    lump_cache_stats_t stats;
+    lump_cache_get_stats(&stats);
+    CHECK(stats.pending == 1, "pending %u", stats.pending);
+    
+    int slices = 0;
+    while (lump_cache_service(100)) {
+        slices++;
+    }
+    CHECK(slices == LUMP_SIZE / 100, "finished in %d slices", slices);
+    
+    lump_cache_get_stats(&stats);
+    uint32_t misses = stats.misses;
+    get(0, LUMP_CACHE_CACHE);
+    lump_cache_get_stats(&stats);
+    CHECK(stats.misses == misses && stats.hits == 1, "prefetched lump missed");
+    
+    // A lookup finishes a prefetch that is still running
+    lump_cache_prefetch(&lumps[1], lumps[1].block, lumps[1].block_size,
+                        LUMP_SIZE, LUMP_CACHE_CACHE);
+    lump_cache_service(300);
+    get(1, LUMP_CACHE_CACHE);
+    lump_cache_get_stats(&stats);
+    CHECK(stats.pending == 0, "pending %u after lookup", stats.pending);
+    
+    // The prefetched LEVEL lump is still kept under pressure
+    pressure(2);
+    CHECK(cached(0), "prefetched LEVEL lump evicted");
+}
+
+static void test_failures_counted(void) {
+    lump_cache_init(CACHE_BUDGET, NULL);
+    for (int i = 0; i < 4; i++) {
+        get(i, LUMP_CACHE_STATIC);
+    }
+    
+    // Full of STATIC lumps: every further lookup fails and is counted
+    lump_cache_stats_t stats;
+    for (int n = 0; n < 3; n++) {
+        CHECK(lump_cache_get(&lumps[4], lumps[4].block, lumps[4].block_size,
+                             LUMP_SIZE, LUMP_CACHE_CACHE) == NULL, "lookup %d fit", n);
+    }
+    lump_cache_get_stats(&stats);
+    CHECK(stats.failures == 3, "%u failures", stats.failures);
+    
+    // A truncated block cannot decompress
+    lump_cache_init(CACHE_BUDGET, NULL);
+    CHECK(lump_cache_get(&lumps[0], lumps[0].block, lumps[0].block_size / 2,
+                         LUMP_SIZE, LUMP_CACHE_CACHE) == NULL, "truncated lump decompressed");
+    lump_cache_get_stats(&stats);
+    CHECK(stats.corrupt == 1 && stats.entries == 0,
+          "%u corrupt, %u entries", stats.corrupt, stats.entries);
+}
+
+int main(void) {
+    Z_Init();
+    make_lumps();
+    
+    test_static_survives_cache_lookup();
+    test_level_survives_until_purged();
+    test_lookup_raises_tag();
+    test_eviction_order();
+    test_prefetch();
+    test_failures_counted();
+    
+    if (failures) {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    printf("lump_cache: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""
+Decode a PICO-DOOM frame capture stream into images.
+
+Record the USB serial port to a file while the firmware runs with
+PICO_DOOM_CAPTURE=ON, e.g.
+
+    cat /dev/ttyACM0 > run.bin
+
+then decode it:
+
+    python3 tools/capture_decode.py run.bin out/ [--png]
+
+Writes one image per complete frame (frame_NNNNNN.ppm or .png) and
+out/timing.csv with the device timestamp of every frame. Text printed by
+the firmware between packets is written to out/console.txt.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+SYNC = b"\xa5\x5a"
+HEADER_SIZE = 5
+TRAILER_SIZE = 2
+MAX_PAYLOAD = 4096
+
+PACKET_FRAME_BEGIN = 1
+PACKET_FRAME_BAND = 2
+PACKET_PALETTE = 3
+PACKET_FRAME_END = 4
+
+BAND_KEY = 0x01
+LAYOUT_COLUMN_MAJOR = 1
+
+
+def read_packets(data, console):
+    """Yield (type, payload) for every packet with a valid checksum."""
+    pos = 0
+    bad = 0
+    while True:
+        start = data.find(SYNC, pos)
+        if start < 0:
+            console.extend(data[pos:])
+            break
+        console.extend(data[pos:start])
+        if start + HEADER_SIZE > len(data):
+            break
+        ptype = data[start + 2]
+        length = data[start + 3] | (data[start + 4] << 8)
+        end = start + HEADER_SIZE + length
+        if length > MAX_PAYLOAD or end + TRAILER_SIZE > len(data):
+            # Not a packet (or truncated); resync one byte later
+            console.extend(data[start:start + 1])
+            pos = start + 1
+            continue
+        expect = data[end] | (data[end + 1] << 8)
+        if (sum(data[start + 2:end]) & 0xFFFF) != expect:
+            bad += 1
+            console.extend(data[start:start + 1])
+            pos = start + 1
+            continue
+        yield ptype, data[start + HEADER_SIZE:end]
+        pos = end + TRAILER_SIZE
+    if bad:
+        print("%d packets failed checksum" % bad, file=sys.stderr)
+
+
+def decode_band(payload, ref, size):
+    """Undo the RLE and XOR the result onto ref (bytes or None)."""
+    out = bytearray(size)
+    i = 0
+    o = 0
+    while i < len(payload) and o < size:
+        t = payload[i]
+        i += 1
+        if t < 0x80:
+            n = t + 1
+            out[o:o + n] = payload[i:i + n]
+            i += n
+        elif t < 0xC0:
+            n = (t & 0x3F) + 3
+            out[o:o + n] = bytes([payload[i]]) * n
+            i += 1
+        else:
+            n = (((t & 0x3F) << 8) | payload[i]) + 1
+            i += 1
+        o += n
+    if o != size:
+        raise ValueError("band decodes to %d bytes, expected %d" % (o, size))
+    if ref is not None:
+        out = bytearray(a ^ b for a, b in zip(out, ref))
+    return out
+
+
+def write_ppm(path, width, height, rgb):
+    with open(path, "wb") as f:
+        f.write(b"P6\n%d %d\n255\n" % (width, height))
+        f.write(rgb)
+
+
+def write_png(path, width, height, rgb):
+    def chunk(tag, body):
+        c = struct.pack(">I", len(body)) + tag + body
+        return c + struct.pack(">I", zlib.crc32(tag + body) & 0xFFFFFFFF)
+
+    stride = width * 3
+    raw = b"".join(b"\x00" + rgb[y * stride:(y + 1) * stride] for y in range(height))
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(raw, 6)))
+        f.write(chunk(b"IEND", b""))
+
+
+class Decoder:
+    def __init__(self, out_dir, png):
+        self.out_dir = out_dir
+        self.png = png
+        self.palettes = {}
+        self.bands = {}        # band -> (frame, bytes)
+        self.frame = None      # header of the frame being received
+        self.frames = 0
+        self.incomplete = 0
+        self.timing = []
+
+    def on_palette(self, payload):
+        (pid,) = struct.unpack_from("<H", payload, 0)
+        self.palettes[pid] = bytes(payload[2:2 + 768])
+
+    def on_begin(self, payload):
+        (frame, t_lo, t_hi, width, height, layout, num_bands,
+         band_size, palette) = struct.unpack_from("<IIIHHBBHH", payload, 0)
+        self.frame = dict(frame=frame, time_us=(t_hi << 32) | t_lo,
+                          width=width, height=height, layout=layout,
+                          num_bands=num_bands, band_size=band_size,
+                          palette=palette)
+
+    def on_band(self, payload):
+        if self.frame is None:
+            return
+        frame, band, flags = struct.unpack_from("<IBB", payload, 0)
+        if frame != self.frame["frame"]:
+            return
+        ref = None
+        if not flags & BAND_KEY:
+            prev = self.bands.get(band)
+            if prev is None or prev[0] != frame - 1:
+                # Missed the reference; wait for a keyframe band
+                self.bands.pop(band, None)
+                return
+            ref = prev[1]
+        try:
+            data = decode_band(payload[6:], ref, self.frame["band_size"])
+        except (ValueError, IndexError) as e:
+            print("frame %d band %d: %s" % (frame, band, e), file=sys.stderr)
+            self.bands.pop(band, None)
+            return
+        self.bands[band] = (frame, data)
+
+    def on_end(self, payload):
+        hdr = self.frame
+        self.frame = None
+        if hdr is None:
+            return
+        frame, sent = struct.unpack_from("<IB", payload, 0)
+        if frame != hdr["frame"]:
+            return
+        n = hdr["num_bands"]
+        complete = all(self.bands.get(b, (None,))[0] == frame for b in range(n))
+        self.timing.append((frame, hdr["time_us"], sent, int(complete)))
+        if not complete:
+            self.incomplete += 1
+            return
+        palette = self.palettes.get(hdr["palette"])
+        if palette is None:
+            self.incomplete += 1
+            return
+        self.emit(hdr, b"".join(self.bands[b][1] for b in range(n)), palette)
+
+    def emit(self, hdr, indexed, palette):
+        width, height = hdr["width"], hdr["height"]
+        if hdr["layout"] == LAYOUT_COLUMN_MAJOR:
+            # Stored column by column; transpose to rows
+            indexed = bytes(indexed[x * height + y]
+                            for y in range(height) for x in range(width))
+        rgb = bytearray(width * height * 3)
+        for i, c in enumerate(indexed):
+            rgb[i * 3:i * 3 + 3] = palette[c * 3:c * 3 + 3]
+        ext = "png" if self.png else "ppm"
+        path = os.path.join(self.out_dir, "frame_%06d.%s" % (hdr["frame"], ext))
+        (write_png if self.png else write_ppm)(path, width, height, bytes(rgb))
+        self.frames += 1
+
+    def write_timing(self):
+        path = os.path.join(self.out_dir, "timing.csv")
+        with open(path, "w") as f:
+            f.write("frame,time_us,delta_us,bands_sent,complete\n")
+            prev = None
+            for frame, t, sent, complete in self.timing:
+                delta = t - prev if prev is not None else 0
+                f.write("%d,%d,%d,%d,%d\n" % (frame, t, delta, sent, complete))
+                prev = t
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("capture", help="raw bytes recorded from the USB serial port")
+    ap.add_argument("out_dir", help="directory for images, timing.csv and console.txt")
+    ap.add_argument("--png", action="store_true", help="write PNG instead of PPM")
+    args = ap.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+    os.makedirs(args.out_dir, exist_ok=True)
+
+    dec = Decoder(args.out_dir, args.png)
+    handlers = {
+        PACKET_PALETTE: dec.on_palette,
+        PACKET_FRAME_BEGIN: dec.on_begin,
+        PACKET_FRAME_BAND: dec.on_band,
+        PACKET_FRAME_END: dec.on_end,
+    }
+    console = bytearray()
+    for ptype, payload in read_packets(data, console):
+        handler = handlers.get(ptype)
+        if handler:
+            handler(payload)
+
+    dec.write_timing()
+    with open(os.path.join(args.out_dir, "console.txt"), "wb") as f:
+        f.write(console)
+    print("%d frames written, %d incomplete" % (dec.frames, dec.incomplete))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,363 @@
+/**
+ * render_host - render one frame of a PICO-DOOM WAD image on the host
+ *
+ * Runs the firmware's renderer (src/doom) against an image packed with
+ * wadpack --texcols --levels and writes the frame as a PPM in the WAD's
+ * palette. The frame is drawn in two column ranges, as the two cores
+ * draw it, so a range that depends on the other shows up as a mismatch.
+ * With --compare the frame is checked against a reference PPM and the
+ * exit status is nonzero if any pixel differs, which makes it a
+ * regression test for renderer changes.
+ *
+ * With --timedemo it plays a demo (a lump of the image, or an .lmp file)
+ * through the firmware's demo code instead, every tic as soon as the last
+ * one is done, and prints the timedemo statistics. The frame written or
+ * compared is the demo's last, so a demo also checks that playback stays
+ * deterministic.
+ *
+ * Usage: render_host [options] image.bin
+ */
+
+#include "wad_loader.h"
+#include "wad_set.h"
+#include "tex_columns.h"
+#include "level_loader.h"
+#include "lump_cache.h"
+#include "z_zone.h"
+#include "r_render.h"
+#include "p_player.h"
+#include "g_demo.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#define LUMP_CACHE_KB       32      // Firmware default (PICO_DOOM_LUMP_CACHE_KB)
+
+static uint8_t frame[R_WIDTH * R_HEIGHT];
+static uint8_t rgb[R_WIDTH * R_HEIGHT * 3];
+static uint8_t *demo_file;     // --timedemo .lmp, kept until exit
+
+static uint64_t clock_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Read a whole file
+ */
+static uint8_t *read_file(const char *path, uint32_t *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Error: Cannot open %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    
+    uint8_t *data = (uint8_t *)malloc(len > 0 ? len : 1);
+    if (!data || fread(data, 1, len, f) != (size_t)len) {
+        fprintf(stderr, "Error: Cannot read %s\n", path);
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *size = (uint32_t)len;
+    return data;
+}
+
+/**
+ * Draw a frame in two ranges, as core 0 and core 1 draw it
+ * Returns the BSP time; columns receives the column time
+ */
+static uint64_t draw_frame(const r_view_t *view, int xs, int ys, int split, uint64_t *columns) {
+    uint64_t start = clock_us();
+    r_setup_frame(view);
+    uint64_t setup = clock_us();
+    r_draw_columns(frame, xs, ys, 0, split);
+    r_draw_columns(frame, xs, ys, split, R_WIDTH);
+    r_finish_frame();
+    *columns = clock_us() - setup;
+    return setup - start;
+}
+
+/**
+ * Get a demo by lump name, or from an .lmp file if the image has no such
+ * lump
+ */
+static const uint8_t *load_demo(const wad_set_t *set, const char *name, uint32_t *size) {
+    int lump = wad_set_find(set, name);
+    if (lump >= 0) {
+        *size = wad_set_lump(set, lump)->size;
+        return wad_set_cache_lump(set, lump, LUMP_CACHE_STATIC);
+    }
+    demo_file = read_file(name, size);
+    return demo_file;
+}
+
+static bool write_ppm(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "Error: Cannot create %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", R_WIDTH, R_HEIGHT);
+    bool ok = fwrite(rgb, 1, sizeof(rgb), f) == sizeof(rgb);
+    if (fclose(f) != 0 || !ok) {
+        fprintf(stderr, "Error: Cannot write %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Compare the frame against a reference PPM
+ * Returns the number of differing pixels, or -1 if the reference is unusable
+ */
+static int compare_ppm(const char *path) {
+    uint32_t size;
+    uint8_t *data = read_file(path, &size);
+    if (!data) {
+        return -1;
+    }
+    int width, height, maxval, header = 0;
+    if (sscanf((const char *)data, "P6 %d %d %d%n", &width, &height, &maxval, &header) != 3 ||
+        width != R_WIDTH || height != R_HEIGHT || maxval != 255 || header + 1 + sizeof(rgb) > size) {
+        fprintf(stderr, "Error: %s is not a %dx%d PPM\n", path, R_WIDTH, R_HEIGHT);
+        free(data);
+        return -1;
+    }
+    
+    const uint8_t *ref = data + header + 1;
+    int diffs = 0;
+    for (int i = 0; i < R_WIDTH * R_HEIGHT; i++) {
+        if (memcmp(&ref[i * 3], &rgb[i * 3], 3) != 0) {
+            if (diffs < 10) {
+                printf("  (%d, %d) differs\n", i % R_WIDTH, i / R_WIDTH);
+            }
+            diffs++;
+        }
+    }
+    free(data);
+    return diffs;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+        "Usage: render_host [options] image.bin\n"
+        "  --map NAME      Map to render (default E1M1, or MAP01)\n"
+        "  --view X Y A    View position in map units and angle in degrees\n"
+        "                  (default: player 1 start)\n"
+        "  --split N       First column drawn as the second range (default %d)\n"
+        "  --column-major  Draw into a column-major framebuffer, as\n"
+        "                  PICO_DOOM_COLUMN_MAJOR builds do\n"
+        "  -o FILE         Write the frame as a PPM\n"
+        "  --compare FILE  Compare with a reference PPM; exit 1 on any difference\n"
+        "  --timedemo DEMO Play a demo lump (e.g. DEMO1) or .lmp file as fast as\n"
+        "                  possible; the frame is the demo's last\n"
+        "  --no-render     Only run the demo's tics, not its frames\n"
+        "  --prefetch      Decompress the level's flats and sprites first, as\n"
+        "                  the firmware does in the background\n"
+        "  --cache-kb N    Lump cache budget for compressed images (default %d)\n",
+        R_WIDTH / 2, LUMP_CACHE_KB);
+}
+
+int main(int argc, char **argv) {
+    const char *image_path = NULL;
+    const char *map = NULL;
+    const char *out_path = NULL;
+    const char *compare_path = NULL;
+    const char *demo_path = NULL;
+    bool demo_render = true;
+    bool set_view = false;
+    bool column_major = false;
+    bool prefetch = false;
+    double view_x = 0, view_y = 0, view_angle = 0;
+    int split = R_WIDTH / 2;
+    int cache_kb = LUMP_CACHE_KB;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+            map = argv[++i];
+        } else if (strcmp(argv[i], "--view") == 0 && i + 3 < argc) {
+            view_x = atof(argv[++i]);
+            view_y = atof(argv[++i]);
+            view_angle = atof(argv[++i]);
+            set_view = true;
+        } else if (strcmp(argv[i], "--split") == 0 && i + 1 < argc) {
+            split = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--column-major") == 0) {
+            column_major = true;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+            compare_path = argv[++i];
+        } else if (strcmp(argv[i], "--timedemo") == 0 && i + 1 < argc) {
+            demo_path = argv[++i];
+        } else if (strcmp(argv[i], "--no-render") == 0) {
+            demo_render = false;
+        } else if (strcmp(argv[i], "--prefetch") == 0) {
+            prefetch = true;
+        } else if (strcmp(argv[i], "--cache-kb") == 0 && i + 1 < argc) {
+            cache_kb = atoi(argv[++i]);
+        } else if (argv[i][0] == '-' || image_path) {
+            usage();
+            return 1;
+        } else {
+            image_path = argv[i];
+        }
+    }
+    if (!image_path || split < 0 || split > R_WIDTH || cache_kb <= 0 || (demo_path && (map || set_view))) {
+        usage();
+        return 1;
+    }
+    
+    uint32_t size;
+    uint8_t *image = read_file(image_path, &size);
+    if (!image) {
+        return 1;
+    }
+    Z_Init();
+    lump_cache_init(cache_kb * 1024, clock_us);
+    wad_file_t *wad = wad_map_image(image, size);
+    if (!wad) {
+        fprintf(stderr, "Error: %s is not a WAD image (pack it with wadpack)\n", image_path);
+        return 1;
+    }
+    wad_set_t set;
+    wad_set_init(&set);
+    wad_set_add(&set, wad);
+    
+    tex_columns_t textures;
+    const tex_columns_t *wall_textures = NULL;
+    int lump = wad_set_find(&set, "TEXCOLS");
+    if (lump >= 0 && tex_columns_init(&textures, wad_set_lump_data(&set, lump), wad_set_lump(&set, lump)->size)) {
+        wall_textures = &textures;
+    } else {
+        printf("No TEXCOLS (pack with --texcols): walls are untextured\n");
+    }
+    
+    // A demo names its own map
+    g_demo_t demo;
+    char demo_map[9];
+    if (demo_path) {
+        uint32_t demo_size;
+        const uint8_t *demo_data = load_demo(&set, demo_path, &demo_size);
+        if (!demo_data || !g_demo_open(&demo, demo_data, demo_size)) {
+            return 1;
+        }
+        g_demo_map_name(&demo, wad_set_find(&set, "E1M1") < 0, demo_map);
+        map = demo_map;
+        printf("Demo %s: %s, skill %u, version %u, %u player(s)\n", demo_path, map,
+               demo.skill + 1, demo.version, demo.num_players);
+    }
+    if (!map) {
+        map = wad_set_find(&set, "E1M1") >= 0 ? "E1M1" : "MAP01";
+    }
+    level_t level;
+    memset(&level, 0, sizeof(level));
+    if (!r_init() || !level_load(&level, &set, map, clock_us, NULL) ||
+        !r_set_level(&level, &set, wall_textures, r_sky_name(map))) {
+        return 1;
+    }
+    
+    if (prefetch) {
+        // One firmware frame's worth of decompression per pass
+        bool queued = true, pending = true;
+        while (queued || pending) {
+            queued = r_prefetch_level();
+            pending = lump_cache_service(8192);
+        }
+        lump_cache_stats_t cache;
+        lump_cache_get_stats(&cache);
+        printf("Prefetched %u lumps (%u of %u bytes)\n", cache.entries,
+               cache.used_bytes, cache.budget_bytes);
+    }
+    
+    p_player_t player;
+    p_spawn_player(&level, &player);
+    r_view_t view;
+    p_player_view(&player, &view);
+    if (set_view) {
+        view.x = (fixed_t)(view_x * FRACUNIT);
+        view.y = (fixed_t)(view_y * FRACUNIT);
+        view.angle = (angle_t)(int64_t)(view_angle / 360.0 * 4294967296.0);
+        int sector = r_point_sector(&level, view.x, view.y);
+        view.z = level.sector_state[sector].floor_height + R_VIEWHEIGHT;
+    }
+    
+    int xs = column_major ? R_HEIGHT : 1;
+    int ys = column_major ? 1 : R_WIDTH;
+    memset(frame, 0, sizeof(frame));
+    uint64_t bsp_us = 0, columns_us = 0;
+    bool drawn = false;
+    
+    if (demo_path) {
+        // Each tic is timed from the start of the last, frame included
+        g_timedemo_t timedemo;
+        g_timedemo_start(&timedemo, clock_us());
+        ticcmd_t cmd;
+        while (g_demo_read(&demo, &cmd)) {
+            p_player_tic(&level, &player, &cmd);
+            if (demo_render) {
+                p_player_view(&player, &view);
+                bsp_us = draw_frame(&view, xs, ys, split, &columns_us);
+                drawn = true;
+            }
+            g_timedemo_tic(&timedemo, clock_us(), demo_render);
+        }
+        g_timedemo_report(&timedemo, demo_path);
+        p_player_view(&player, &view);
+    }
+    if (!drawn) {
+        bsp_us = draw_frame(&view, xs, ys, split, &columns_us);
+    }
+    
+    r_stats_t stats;
+    r_get_stats(&stats);
+    printf("%s at (%d, %d, %d) angle %.1f: %u nodes, %u subsectors, %u drawsegs, %u sprites, %u dropped, %u missing\n",
+           map, view.x >> FRACBITS, view.y >> FRACBITS, view.z >> FRACBITS,
+           view.angle * (360.0 / 4294967296.0), stats.nodes, stats.subsectors, stats.drawsegs,
+           stats.sprites, stats.overflows, stats.missing);
+    printf("BSP %lu us, columns %lu us (host)\n", (unsigned long)bsp_us, (unsigned long)columns_us);
+    
+    lump_cache_stats_t cache;
+    lump_cache_get_stats(&cache);
+    if (cache.misses || cache.failures || cache.corrupt) {
+        printf("Lump cache: %u hits, %u misses, %u evictions, %u failures, %u corrupt (%u KB budget)\n",
+               cache.hits, cache.misses, cache.evictions, cache.failures, cache.corrupt,
+               cache.budget_bytes / 1024);
+    }
+    
+    lump = wad_set_find(&set, "PLAYPAL");
+    const uint8_t *palette = lump >= 0 ? wad_set_lump_data(&set, lump) : NULL;
+    if (!palette || wad_set_lump(&set, lump)->size < 768) {
+        fprintf(stderr, "Error: No usable PLAYPAL\n");
+        return 1;
+    }
+    for (int y = 0; y < R_HEIGHT; y++) {
+        for (int x = 0; x < R_WIDTH; x++) {
+            memcpy(&rgb[(y * R_WIDTH + x) * 3], &palette[frame[x * xs + y * ys] * 3], 3);
+        }
+    }
+    
+    if (out_path && !write_ppm(out_path)) {
+        return 1;
+    }
+    if (compare_path) {
+        int diffs = compare_ppm(compare_path);
+        if (diffs < 0) {
+            return 1;
+        }
+        if (diffs > 0) {
+            printf("MISMATCH: %d of %d pixels differ from %s\n", diffs, R_WIDTH * R_HEIGHT, compare_path);
+            return 1;
+        }
+        printf("Matches %s\n", compare_path);
+    }
+    return 0;
+}
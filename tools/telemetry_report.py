@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""
+Report per-stage frame timings from a PICO-DOOM telemetry stream.
+
+Record the USB serial port to a file while the firmware runs with
+PICO_DOOM_TELEMETRY=ON, e.g.
+
+    cat /dev/ttyACM0 > run.bin
+
+then summarize it:
+
+    python3 tools/telemetry_report.py run.bin [--csv spans.csv] [--skip N]
+
+Prints, for every stage of the frame, the count, mean and percentiles of
+its duration and a histogram with power-of-two buckets. Three rows are
+derived from the records:
+
+    frame      start of one frame's input stage to the next
+    other      frame time not covered by a core 0 stage (status prints)
+    latency    end of the swap to the end of that frame's scanout
+
+Text printed by the firmware between packets is ignored (see
+capture_decode.py for a tool that keeps it). A stream that also carries
+frame captures is fine; their packets are skipped.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+HEADER_SIZE = 5
+TRAILER_SIZE = 2
+MAX_PAYLOAD = 4096
+
+PACKET_TELEMETRY = 5
+
+RECORD = struct.Struct("<IIHBB")     # start_us, length_us, frame, stage, core
+DROPPED = struct.Struct("<II")       # Records dropped per core, running count
+
+STAGES = ["input", "update", "render", "swap", "service", "vsync", "pace", "scanout"]
+CORE0_STAGES = range(0, 6)
+STAGE_INPUT = 0
+STAGE_SWAP = 3
+STAGE_SCANOUT = 7
+
+HIST_WIDTH = 40
+
+
+def read_packets(data):
+    """Yield (type, payload) for every packet with a valid checksum."""
+    pos = 0
+    bad = 0
+    while True:
+        start = data.find(SYNC, pos)
+        if start < 0 or start + HEADER_SIZE > len(data):
+            break
+        ptype = data[start + 2]
+        length = data[start + 3] | (data[start + 4] << 8)
+        end = start + HEADER_SIZE + length
+        if length > MAX_PAYLOAD or end + TRAILER_SIZE > len(data):
+            # Not a packet (or truncated); resync one byte later
+            pos = start + 1
+            continue
+        expect = data[end] | (data[end + 1] << 8)
+        if (sum(data[start + 2:end]) & 0xFFFF) != expect:
+            bad += 1
+            pos = start + 1
+            continue
+        yield ptype, data[start + HEADER_SIZE:end]
+        pos = end + TRAILER_SIZE
+    if bad:
+        print("%d packets failed checksum" % bad, file=sys.stderr)
+
+
+def read_records(data):
+    """Return the stage records in stream order and the drop counts."""
+    records = []
+    dropped = (0, 0)
+    for ptype, payload in read_packets(data):
+        if ptype != PACKET_TELEMETRY or len(payload) < DROPPED.size:
+            continue
+        dropped = DROPPED.unpack_from(payload, 0)
+        body = payload[DROPPED.size:]
+        for off in range(0, len(body) - RECORD.size + 1, RECORD.size):
+            records.append(RECORD.unpack_from(body, off))
+    return records, dropped
+
+
+def percentile(values, p):
+    """Nearest-rank percentile of sorted values."""
+    rank = max(0, min(len(values) - 1, int(round(p / 100.0 * len(values) + 0.5)) - 1))
+    return values[rank]
+
+
+def bucket(us):
+    """Power-of-two bucket: 0 for <1 us, n for [2^(n-1), 2^n)."""
+    return us.bit_length()
+
+
+def bucket_label(b):
+    if b == 0:
+        return "<1"
+    if b == 1:
+        return "1"
+    return "%d-%d" % (1 << (b - 1), (1 << b) - 1)
+
+
+def print_stats(rows):
+    print("%-9s %7s %8s %8s %8s %8s %8s %8s" %
+          ("stage", "count", "mean", "p50", "p90", "p99", "p99.9", "max"))
+    for name, values in rows:
+        if not values:
+            continue
+        values = sorted(values)
+        mean = sum(values) / float(len(values))
+        print("%-9s %7d %8.0f %8d %8d %8d %8d %8d" %
+              (name, len(values), mean, percentile(values, 50), percentile(values, 90),
+               percentile(values, 99), percentile(values, 99.9), values[-1]))
+    print("(all times in us)")
+
+
+def print_histogram(name, values):
+    counts = {}
+    for v in values:
+        b = bucket(v)
+        counts[b] = counts.get(b, 0) + 1
+    most = max(counts.values())
+    print("\n%s (us)" % name)
+    gap = False
+    for b in range(min(counts), max(counts) + 1):
+        n = counts.get(b, 0)
+        if n == 0:
+            # One marker for a run of empty buckets
+            if not gap:
+                print("  %13s" % "...")
+            gap = True
+            continue
+        gap = False
+        bar = "#" * ((n * HIST_WIDTH + most - 1) // most)
+        print("  %13s %7d %s" % (bucket_label(b), n, bar))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("stream", help="recorded USB serial output")
+    parser.add_argument("--csv", help="also write every span as CSV")
+    parser.add_argument("--skip", type=int, default=0,
+                        help="ignore the first N frames (boot, level load)")
+    args = parser.parse_args()
+
+    with open(args.stream, "rb") as f:
+        data = f.read()
+    records, dropped = read_records(data)
+    if not records:
+        print("No telemetry records in %s (build with PICO_DOOM_TELEMETRY=ON)" % args.stream,
+              file=sys.stderr)
+        return 1
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            out = csv.writer(f)
+            out.writerow(["core", "frame", "stage", "start_us", "length_us"])
+            for start, length, frame, stage, core in records:
+                name = STAGES[stage] if stage < len(STAGES) else str(stage)
+                out.writerow([core, frame, name, start, length])
+
+    # Frame numbers are 16 bits on the wire; unwrap them per core so the
+    # two cores' records of a frame can be matched
+    last_frame = [None, None]
+    base = [0, 0]
+    spans = []
+    for start, length, frame, stage, core in records:
+        core &= 1
+        if last_frame[core] is not None and frame < last_frame[core] and last_frame[core] - frame > 0x8000:
+            base[core] += 0x10000
+        last_frame[core] = frame
+        spans.append((start, length, base[core] + frame, stage, core))
+
+    first = min(s[2] for s in spans) + args.skip
+    spans = [s for s in spans if s[2] >= first]
+
+    by_stage = [[] for _ in STAGES]
+    frame_start = {}
+    core0_busy = {}
+    swap_end = {}
+    scanout_end = {}
+    for start, length, frame, stage, core in spans:
+        if stage >= len(STAGES):
+            continue
+        by_stage[stage].append(length)
+        if stage in CORE0_STAGES:
+            core0_busy[frame] = core0_busy.get(frame, 0) + length
+        if stage == STAGE_INPUT:
+            frame_start[frame] = start
+        elif stage == STAGE_SWAP:
+            swap_end[frame] = start + length
+        elif stage == STAGE_SCANOUT:
+            scanout_end[frame] = start + length
+
+    # Times are the low 32 bits of time_us_64(), so differences wrap
+    frame_time = []
+    other = []
+    for frame, start in frame_start.items():
+        following = frame_start.get(frame + 1)
+        if following is None:
+            continue
+        total = (following - start) & 0xFFFFFFFF
+        frame_time.append(total)
+        other.append(max(0, total - core0_busy.get(frame, 0)))
+    latency = [(scanout_end[f] - swap_end[f]) & 0xFFFFFFFF
+               for f in swap_end if f in scanout_end]
+
+    rows = [(STAGES[i], by_stage[i]) for i in range(len(STAGES))]
+    rows += [("frame", frame_time), ("other", other), ("latency", latency)]
+
+    frames = len(frame_start)
+    print("%d spans over %d frames | dropped on device: %d core 0, %d core 1" %
+          (len(spans), frames, dropped[0], dropped[1]))
+    if frame_time:
+        mean = sum(frame_time) / float(len(frame_time))
+        print("Mean frame %.0f us (%.1f fps)" % (mean, 1000000.0 / mean if mean else 0))
+    print()
+    print_stats(rows)
+    for name, values in rows:
+        if values:
+            print_histogram(name, values)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,433 @@
+/**
+ * Level converter implementation
+ *
+ * Follows p_setup.c: P_LoadVertexes, P_LoadSectors, P_LoadSideDefs,
+ * P_LoadLineDefs, P_LoadSegs, P_LoadSubsectors, P_LoadNodes and
+ * P_GroupLines, writing indices where the engine would store pointers.
+ */
+
+#include "levelconv.h"
+#include "level_format.h"
+#include "wad_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    ML_THINGS = 0, ML_LINEDEFS, ML_SIDEDEFS, ML_VERTEXES, ML_SEGS,
+    ML_SSECTORS, ML_NODES, ML_SECTORS, ML_REJECT, ML_BLOCKMAP
+};
+
+const char *levelconv_lump_names[LEVELCONV_MAP_LUMPS] = {
+    "THINGS", "LINEDEFS", "SIDEDEFS", "VERTEXES", "SEGS",
+    "SSECTORS", "NODES", "SECTORS", "REJECT", "BLOCKMAP"
+};
+
+// Raw record sizes (doomdata.h)
+#define MAPVERTEX_SIZE    4
+#define MAPLINEDEF_SIZE   14
+#define MAPSIDEDEF_SIZE   30
+#define MAPSECTOR_SIZE    26
+#define MAPSEG_SIZE       12
+#define MAPSUBSECTOR_SIZE 4
+#define MAPNODE_SIZE      28
+#define MAPTHING_SIZE     10
+
+// Blockmap cells are 128 units; sector blockboxes are padded by MAXRADIUS
+#define MAPBLOCKSHIFT     (FRACBITS + 7)
+#define MAXRADIUS         (32 * FRACUNIT)
+
+static int16_t get_s16(const uint8_t *p) {
+    return (int16_t)(p[0] | (p[1] << 8));
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t align4(uint32_t value) {
+    return (value + 3) & ~3u;
+}
+
+/**
+ * Texture names in texture number order (TEXTURE1 then TEXTURE2)
+ */
+typedef struct {
+    char (*names)[8];
+    uint32_t count;
+} texture_names_t;
+
+static void load_texture_names(texture_names_t *tn, texcomp_lookup_t lookup) {
+    const char *tables[] = {"TEXTURE1", "TEXTURE2"};
+    tn->names = NULL;
+    tn->count = 0;
+    for (int t = 0; t < 2; t++) {
+        uint32_t size;
+        const uint8_t *table = lookup(tables[t], &size);
+        if (!table || size < 4) {
+            continue;
+        }
+        uint32_t count = get_u32(table);
+        if (count > (size - 4) / 4) {
+            continue;
+        }
+        tn->names = realloc(tn->names, (tn->count + count) * 8);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t pos = get_u32(table + 4 + i * 4);
+            char raw[9] = {0};
+            if (pos + 8 <= size) {
+                memcpy(raw, table + pos, 8);
+            }
+            wad_normalize_name(tn->names[tn->count++], raw);
+        }
+    }
+}
+
+/**
+ * R_TextureNumForName: "-" is no texture
+ */
+static int16_t texture_number(const texture_names_t *tn, const uint8_t *raw_name,
+                              const char *map, levelconv_stats_t *stats) {
+    if (raw_name[0] == '-') {
+        return 0;
+    }
+    char raw[9] = {0};
+    char key[8];
+    memcpy(raw, raw_name, 8);
+    wad_normalize_name(key, raw);
+    for (uint32_t i = 0; i < tn->count; i++) {
+        if (memcmp(tn->names[i], key, 8) == 0) {
+            return (int16_t)i;
+        }
+    }
+    fprintf(stderr, "Warning: %s: texture %.8s not found\n", map, key);
+    stats->missing_textures++;
+    return 0;
+}
+
+/**
+ * Index of a flat name in the level's table, adding it if new
+ */
+static uint16_t flat_index(char (*flats)[8], uint32_t *count, const uint8_t *raw_name) {
+    char raw[9] = {0};
+    char key[8];
+    memcpy(raw, raw_name, 8);
+    wad_normalize_name(key, raw);
+    for (uint32_t i = 0; i < *count; i++) {
+        if (memcmp(flats[i], key, 8) == 0) {
+            return i;
+        }
+    }
+    memcpy(flats[*count], key, 8);
+    return (*count)++;
+}
+
+static void bbox_add(fixed_t *box, fixed_t x, fixed_t y) {
+    if (x < box[LEVEL_BOXLEFT]) box[LEVEL_BOXLEFT] = x;
+    if (x > box[LEVEL_BOXRIGHT]) box[LEVEL_BOXRIGHT] = x;
+    if (y < box[LEVEL_BOXBOTTOM]) box[LEVEL_BOXBOTTOM] = y;
+    if (y > box[LEVEL_BOXTOP]) box[LEVEL_BOXTOP] = y;
+}
+
+uint8_t *levelconv_build(const char *map, const levelconv_lump_t *lumps,
+                         texcomp_lookup_t lookup, uint32_t *out_size, levelconv_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < LEVELCONV_MAP_LUMPS; i++) {
+        stats->raw_bytes += lumps[i].size;
+    }
+    
+    level_header_t h;
+    memset(&h, 0, sizeof(h));
+    h.magic = LEVEL_MAGIC;
+    h.version = LEVEL_VERSION;
+    h.num_vertexes = lumps[ML_VERTEXES].size / MAPVERTEX_SIZE;
+    h.num_lines = lumps[ML_LINEDEFS].size / MAPLINEDEF_SIZE;
+    h.num_sides = lumps[ML_SIDEDEFS].size / MAPSIDEDEF_SIZE;
+    h.num_sectors = lumps[ML_SECTORS].size / MAPSECTOR_SIZE;
+    h.num_segs = lumps[ML_SEGS].size / MAPSEG_SIZE;
+    h.num_subsectors = lumps[ML_SSECTORS].size / MAPSUBSECTOR_SIZE;
+    h.num_nodes = lumps[ML_NODES].size / MAPNODE_SIZE;
+    h.num_things = lumps[ML_THINGS].size / MAPTHING_SIZE;
+    h.blockmap_size = lumps[ML_BLOCKMAP].size & ~1u;
+    h.reject_size = lumps[ML_REJECT].size;
+    
+    if (h.num_vertexes >= LEVEL_NONE || h.num_lines >= LEVEL_NONE || h.num_sides >= LEVEL_NONE ||
+        h.num_sectors >= LEVEL_NONE || h.num_subsectors >= LEVEL_SUBSECTOR ||
+        h.num_nodes >= LEVEL_SUBSECTOR) {
+        fprintf(stderr, "Error: %s is too big for the compact level format\n", map);
+        return NULL;
+    }
+    if (h.num_sectors == 0 || h.num_subsectors == 0 || h.blockmap_size < 8) {
+        fprintf(stderr, "Error: %s has no sectors, subsectors or blockmap\n", map);
+        return NULL;
+    }
+    
+    // P_GroupLines lists each line under its front sector and, if
+    // different, its back sector, so there are at most 2 per line
+    h.num_sector_lines = 0;
+    h.num_flats = 0;
+    
+    level_vertex_t *vertexes = calloc(h.num_vertexes + 1, sizeof(level_vertex_t));
+    level_line_t *lines = calloc(h.num_lines + 1, sizeof(level_line_t));
+    level_side_t *sides = calloc(h.num_sides + 1, sizeof(level_side_t));
+    level_sector_t *sectors = calloc(h.num_sectors, sizeof(level_sector_t));
+    uint16_t *sector_lines = calloc(h.num_lines * 2 + 1, sizeof(uint16_t));
+    level_seg_t *segs = calloc(h.num_segs + 1, sizeof(level_seg_t));
+    level_subsector_t *subsectors = calloc(h.num_subsectors, sizeof(level_subsector_t));
+    level_node_t *nodes = calloc(h.num_nodes + 1, sizeof(level_node_t));
+    char (*flats)[8] = calloc(h.num_sectors * 2, 8);
+    fixed_t (*sector_bbox)[4] = calloc(h.num_sectors, sizeof(*sector_bbox));
+    texture_names_t tn;
+    load_texture_names(&tn, lookup);
+    uint8_t *lump = NULL;
+    
+    // Vertexes
+    for (uint32_t i = 0; i < h.num_vertexes; i++) {
+        const uint8_t *p = lumps[ML_VERTEXES].data + i * MAPVERTEX_SIZE;
+        vertexes[i].x = get_s16(p) << FRACBITS;
+        vertexes[i].y = get_s16(p + 2) << FRACBITS;
+    }
+    
+    // Sectors
+    for (uint32_t i = 0; i < h.num_sectors; i++) {
+        const uint8_t *p = lumps[ML_SECTORS].data + i * MAPSECTOR_SIZE;
+        level_sector_t *sec = &sectors[i];
+        sec->floor_height = get_s16(p) << FRACBITS;
+        sec->ceiling_height = get_s16(p + 2) << FRACBITS;
+        sec->floor_flat = flat_index(flats, &h.num_flats, p + 4);
+        sec->ceiling_flat = flat_index(flats, &h.num_flats, p + 12);
+        sec->light = get_s16(p + 20);
+        sec->special = get_s16(p + 22);
+        sec->tag = get_u16(p + 24);
+    }
+    
+    // Sides
+    for (uint32_t i = 0; i < h.num_sides; i++) {
+        const uint8_t *p = lumps[ML_SIDEDEFS].data + i * MAPSIDEDEF_SIZE;
+        level_side_t *side = &sides[i];
+        side->texture_offset = get_s16(p) << FRACBITS;
+        side->row_offset = get_s16(p + 2) << FRACBITS;
+        side->top_texture = texture_number(&tn, p + 4, map, stats);
+        side->bottom_texture = texture_number(&tn, p + 12, map, stats);
+        side->mid_texture = texture_number(&tn, p + 20, map, stats);
+        side->sector = get_u16(p + 28);
+        side->dynamic = LEVEL_NONE;
+        if (side->sector >= h.num_sectors) {
+            fprintf(stderr, "Error: %s: side %u has bad sector %u\n", map, i, side->sector);
+            goto fail;
+        }
+    }
+    
+    // Lines
+    for (uint32_t i = 0; i < h.num_lines; i++) {
+        const uint8_t *p = lumps[ML_LINEDEFS].data + i * MAPLINEDEF_SIZE;
+        level_line_t *line = &lines[i];
+        line->v1 = get_u16(p);
+        line->v2 = get_u16(p + 2);
+        line->flags = get_u16(p + 4);
+        line->special = get_u16(p + 6);
+        line->tag = get_u16(p + 8);
+        line->side[0] = get_u16(p + 10);
+        line->side[1] = get_u16(p + 12);
+        if (line->v1 >= h.num_vertexes || line->v2 >= h.num_vertexes ||
+            line->side[0] >= h.num_sides ||
+            (line->side[1] != LEVEL_NONE && line->side[1] >= h.num_sides)) {
+            fprintf(stderr, "Error: %s: line %u is malformed\n", map, i);
+            goto fail;
+        }
+        
+        const level_vertex_t *v1 = &vertexes[line->v1];
+        const level_vertex_t *v2 = &vertexes[line->v2];
+        line->dx = v2->x - v1->x;
+        line->dy = v2->y - v1->y;
+        if (!line->dx) {
+            line->slope = LEVEL_SLOPE_VERTICAL;
+        } else if (!line->dy) {
+            line->slope = LEVEL_SLOPE_HORIZONTAL;
+        } else {
+            line->slope = ((line->dx > 0) == (line->dy > 0)) ? LEVEL_SLOPE_POSITIVE : LEVEL_SLOPE_NEGATIVE;
+        }
+        line->bbox[LEVEL_BOXLEFT] = v1->x < v2->x ? v1->x : v2->x;
+        line->bbox[LEVEL_BOXRIGHT] = v1->x < v2->x ? v2->x : v1->x;
+        line->bbox[LEVEL_BOXBOTTOM] = v1->y < v2->y ? v1->y : v2->y;
+        line->bbox[LEVEL_BOXTOP] = v1->y < v2->y ? v2->y : v1->y;
+        
+        line->front_sector = sides[line->side[0]].sector;
+        line->back_sector = line->side[1] != LEVEL_NONE ? sides[line->side[1]].sector : LEVEL_NONE;
+        
+        // Switches and scrolling walls change their sides during play
+        if (line->special) {
+            for (int s = 0; s < 2; s++) {
+                if (line->side[s] != LEVEL_NONE && sides[line->side[s]].dynamic == LEVEL_NONE) {
+                    sides[line->side[s]].dynamic = h.num_dynamic_sides++;
+                }
+            }
+        }
+    }
+    stats->dynamic_sides = h.num_dynamic_sides;
+    
+    // Segs
+    for (uint32_t i = 0; i < h.num_segs; i++) {
+        const uint8_t *p = lumps[ML_SEGS].data + i * MAPSEG_SIZE;
+        level_seg_t *seg = &segs[i];
+        seg->v1 = get_u16(p);
+        seg->v2 = get_u16(p + 2);
+        seg->angle = (angle_t)get_u16(p + 4) << 16;
+        seg->line = get_u16(p + 6);
+        seg->side = get_u16(p + 8);
+        seg->offset = get_s16(p + 10) << FRACBITS;
+        if (seg->v1 >= h.num_vertexes || seg->v2 >= h.num_vertexes ||
+            seg->line >= h.num_lines || seg->side > 1 ||
+            lines[seg->line].side[seg->side] == LEVEL_NONE) {
+            fprintf(stderr, "Error: %s: seg %u is malformed\n", map, i);
+            goto fail;
+        }
+        const level_line_t *line = &lines[seg->line];
+        seg->front_sector = sides[line->side[seg->side]].sector;
+        seg->back_sector = LEVEL_NONE;
+        if ((line->flags & LEVEL_ML_TWOSIDED) && line->side[seg->side ^ 1] != LEVEL_NONE) {
+            seg->back_sector = sides[line->side[seg->side ^ 1]].sector;
+        }
+    }
+    
+    // Subsectors take the sector of their first seg
+    for (uint32_t i = 0; i < h.num_subsectors; i++) {
+        const uint8_t *p = lumps[ML_SSECTORS].data + i * MAPSUBSECTOR_SIZE;
+        level_subsector_t *sub = &subsectors[i];
+        sub->num_segs = get_u16(p);
+        sub->first_seg = get_u16(p + 2);
+        if (sub->num_segs == 0 || sub->first_seg + sub->num_segs > h.num_segs) {
+            fprintf(stderr, "Error: %s: subsector %u is malformed\n", map, i);
+            goto fail;
+        }
+        sub->sector = segs[sub->first_seg].front_sector;
+    }
+    
+    // Nodes
+    for (uint32_t i = 0; i < h.num_nodes; i++) {
+        const uint8_t *p = lumps[ML_NODES].data + i * MAPNODE_SIZE;
+        level_node_t *node = &nodes[i];
+        node->x = get_s16(p) << FRACBITS;
+        node->y = get_s16(p + 2) << FRACBITS;
+        node->dx = get_s16(p + 4) << FRACBITS;
+        node->dy = get_s16(p + 6) << FRACBITS;
+        for (int c = 0; c < 2; c++) {
+            for (int b = 0; b < 4; b++) {
+                node->bbox[c][b] = get_s16(p + 8 + c * 8 + b * 2) << FRACBITS;
+            }
+            node->children[c] = get_u16(p + 24 + c * 2);
+            uint16_t child = node->children[c];
+            if ((child & LEVEL_SUBSECTOR) ? (child & ~LEVEL_SUBSECTOR) >= h.num_subsectors
+                                          : child >= h.num_nodes) {
+                fprintf(stderr, "Error: %s: node %u has a bad child\n", map, i);
+                goto fail;
+            }
+        }
+    }
+    
+    // P_GroupLines: line lists, bounding boxes, sound origins, blockboxes
+    fixed_t bmap_orgx = get_s16(lumps[ML_BLOCKMAP].data) << FRACBITS;
+    fixed_t bmap_orgy = get_s16(lumps[ML_BLOCKMAP].data + 2) << FRACBITS;
+    int32_t bmap_width = get_s16(lumps[ML_BLOCKMAP].data + 4);
+    int32_t bmap_height = get_s16(lumps[ML_BLOCKMAP].data + 6);
+    
+    for (uint32_t s = 0; s < h.num_sectors; s++) {
+        level_sector_t *sec = &sectors[s];
+        fixed_t *box = sector_bbox[s];
+        box[LEVEL_BOXTOP] = box[LEVEL_BOXRIGHT] = INT32_MIN;
+        box[LEVEL_BOXBOTTOM] = box[LEVEL_BOXLEFT] = INT32_MAX;
+        sec->first_line = h.num_sector_lines;
+        for (uint32_t i = 0; i < h.num_lines; i++) {
+            const level_line_t *line = &lines[i];
+            if (line->front_sector == s || line->back_sector == s) {
+                sector_lines[h.num_sector_lines++] = i;
+                bbox_add(box, vertexes[line->v1].x, vertexes[line->v1].y);
+                bbox_add(box, vertexes[line->v2].x, vertexes[line->v2].y);
+            }
+        }
+        sec->line_count = h.num_sector_lines - sec->first_line;
+        if (sec->line_count == 0) {
+            memset(box, 0, sizeof(sector_bbox[s]));
+        }
+        
+        sec->sound_x = (fixed_t)(((int64_t)box[LEVEL_BOXRIGHT] + box[LEVEL_BOXLEFT]) / 2);
+        sec->sound_y = (fixed_t)(((int64_t)box[LEVEL_BOXTOP] + box[LEVEL_BOXBOTTOM]) / 2);
+        
+        int32_t block = (box[LEVEL_BOXTOP] - bmap_orgy + MAXRADIUS) >> MAPBLOCKSHIFT;
+        sec->blockbox[LEVEL_BOXTOP] = block >= bmap_height ? bmap_height - 1 : block;
+        block = (box[LEVEL_BOXBOTTOM] - bmap_orgy - MAXRADIUS) >> MAPBLOCKSHIFT;
+        sec->blockbox[LEVEL_BOXBOTTOM] = block < 0 ? 0 : block;
+        block = (box[LEVEL_BOXRIGHT] - bmap_orgx + MAXRADIUS) >> MAPBLOCKSHIFT;
+        sec->blockbox[LEVEL_BOXRIGHT] = block >= bmap_width ? bmap_width - 1 : block;
+        block = (box[LEVEL_BOXLEFT] - bmap_orgx - MAXRADIUS) >> MAPBLOCKSHIFT;
+        sec->blockbox[LEVEL_BOXLEFT] = block < 0 ? 0 : block;
+    }
+    stats->lines = h.num_lines;
+    stats->sides = h.num_sides;
+    stats->sectors = h.num_sectors;
+    
+    // Layout: every table 4-byte aligned
+    uint32_t pos = align4(sizeof(h));
+    h.vertexes_offset = pos;
+    pos = align4(pos + h.num_vertexes * sizeof(level_vertex_t));
+    h.lines_offset = pos;
+    pos = align4(pos + h.num_lines * sizeof(level_line_t));
+    h.sides_offset = pos;
+    pos = align4(pos + h.num_sides * sizeof(level_side_t));
+    h.sectors_offset = pos;
+    pos = align4(pos + h.num_sectors * sizeof(level_sector_t));
+    h.sector_lines_offset = pos;
+    pos = align4(pos + h.num_sector_lines * sizeof(uint16_t));
+    h.segs_offset = pos;
+    pos = align4(pos + h.num_segs * sizeof(level_seg_t));
+    h.subsectors_offset = pos;
+    pos = align4(pos + h.num_subsectors * sizeof(level_subsector_t));
+    h.nodes_offset = pos;
+    pos = align4(pos + h.num_nodes * sizeof(level_node_t));
+    h.things_offset = pos;
+    pos = align4(pos + h.num_things * sizeof(level_thing_t));
+    h.flats_offset = pos;
+    pos = align4(pos + h.num_flats * 8);
+    h.blockmap_offset = pos;
+    pos = align4(pos + h.blockmap_size);
+    h.reject_offset = pos;
+    pos = align4(pos + h.reject_size);
+    
+    lump = calloc(1, pos);
+    memcpy(lump, &h, sizeof(h));
+    memcpy(lump + h.vertexes_offset, vertexes, h.num_vertexes * sizeof(level_vertex_t));
+    memcpy(lump + h.lines_offset, lines, h.num_lines * sizeof(level_line_t));
+    memcpy(lump + h.sides_offset, sides, h.num_sides * sizeof(level_side_t));
+    memcpy(lump + h.sectors_offset, sectors, h.num_sectors * sizeof(level_sector_t));
+    memcpy(lump + h.sector_lines_offset, sector_lines, h.num_sector_lines * sizeof(uint16_t));
+    memcpy(lump + h.segs_offset, segs, h.num_segs * sizeof(level_seg_t));
+    memcpy(lump + h.subsectors_offset, subsectors, h.num_subsectors * sizeof(level_subsector_t));
+    memcpy(lump + h.nodes_offset, nodes, h.num_nodes * sizeof(level_node_t));
+    for (uint32_t i = 0; i < h.num_things; i++) {
+        const uint8_t *p = lumps[ML_THINGS].data + i * MAPTHING_SIZE;
+        level_thing_t thing = {get_s16(p), get_s16(p + 2), get_s16(p + 4), get_s16(p + 6), get_s16(p + 8)};
+        memcpy(lump + h.things_offset + i * sizeof(level_thing_t), &thing, sizeof(thing));
+    }
+    memcpy(lump + h.flats_offset, flats, h.num_flats * 8);
+    memcpy(lump + h.blockmap_offset, lumps[ML_BLOCKMAP].data, h.blockmap_size);
+    memcpy(lump + h.reject_offset, lumps[ML_REJECT].data, h.reject_size);
+    *out_size = pos;
+
+fail:
+    free(vertexes);
+    free(lines);
+    free(sides);
+    free(sectors);
+    free(sector_lines);
+    free(segs);
+    free(subsectors);
+    free(nodes);
+    free(flats);
+    free(sector_bbox);
+    free(tn.names);
+    return lump;
+}
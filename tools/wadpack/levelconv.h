@@ -0,0 +1,48 @@
+/**
+ * Level converter for wadpack
+ * Builds a compact level lump (see include/level_format.h) from a map's
+ * raw lumps, doing P_SetupLevel's conversion work at pack time.
+ */
+
+#ifndef LEVELCONV_H
+#define LEVELCONV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "texcomp.h"
+
+// Lumps after the map marker, in order (ML_THINGS ... ML_BLOCKMAP)
+#define LEVELCONV_MAP_LUMPS 10
+
+extern const char *levelconv_lump_names[LEVELCONV_MAP_LUMPS];
+
+/**
+ * One raw map lump
+ */
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+} levelconv_lump_t;
+
+/**
+ * Conversion summary
+ */
+typedef struct {
+    uint32_t raw_bytes;           // Source map lumps
+    uint32_t lines;
+    uint32_t sides;
+    uint32_t dynamic_sides;
+    uint32_t sectors;
+    uint32_t missing_textures;
+} levelconv_stats_t;
+
+/**
+ * Convert one map
+ * lumps: the LEVELCONV_MAP_LUMPS lumps after the marker, in order
+ * lookup: finds TEXTURE1/TEXTURE2 for texture numbering
+ * Returns a malloc'd lump and sets size, or NULL if the map is malformed
+ */
+uint8_t *levelconv_build(const char *map, const levelconv_lump_t *lumps,
+                         texcomp_lookup_t lookup, uint32_t *size, levelconv_stats_t *stats);
+
+#endif // LEVELCONV_H
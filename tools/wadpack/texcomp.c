@@ -0,0 +1,300 @@
+/**
+ * Texture compositor implementation
+ *
+ * TEXTURE1/2: int32 count, int32 offsets[count], then per texture
+ *   name[8], int32 masked, int16 width, int16 height, int32 unused,
+ *   int16 patchcount, then patchcount x {int16 originx, originy, patch,
+ *   stepdir, colormap}
+ * PNAMES: int32 count, then count x name[8]
+ * Patch: int16 width, height, leftoffset, topoffset, int32 columnofs[width],
+ *   columns of posts {topdelta, length, pad, data[length], pad} ending in 0xFF
+ */
+
+#include "texcomp.h"
+#include "tex_columns.h"
+#include "wad_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEDUPE_BUCKETS 65536
+
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+} patch_ref_t;
+
+static uint16_t get_u16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+static int16_t get_s16(const uint8_t *p) {
+    return (int16_t)get_u16(p);
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Growable byte buffer
+ */
+typedef struct {
+    uint8_t *data;
+    uint32_t size;
+    uint32_t capacity;
+} buffer_t;
+
+static bool buffer_append(buffer_t *b, const void *data, uint32_t len) {
+    if (b->size + len > b->capacity) {
+        uint32_t capacity = b->capacity ? b->capacity : 65536;
+        while (capacity < b->size + len) {
+            capacity *= 2;
+        }
+        uint8_t *grown = (uint8_t *)realloc(b->data, capacity);
+        if (!grown) {
+            return false;
+        }
+        b->data = grown;
+        b->capacity = capacity;
+    }
+    memcpy(b->data + b->size, data, len);
+    b->size += len;
+    return true;
+}
+
+/**
+ * Draw one patch into a column-major texture buffer
+ * Returns false if the patch is malformed
+ */
+static bool draw_patch(uint8_t *pixels, uint8_t *covered, int width, int height,
+                       const patch_ref_t *patch, int origin_x, int origin_y) {
+    if (patch->size < 8) {
+        return false;
+    }
+    int patch_width = get_s16(patch->data);
+    if (patch_width <= 0 || 8 + (uint32_t)patch_width * 4 > patch->size) {
+        return false;
+    }
+    
+    int x1 = origin_x < 0 ? 0 : origin_x;
+    int x2 = origin_x + patch_width > width ? width : origin_x + patch_width;
+    for (int x = x1; x < x2; x++) {
+        uint32_t pos = get_u32(patch->data + 8 + (x - origin_x) * 4);
+        
+        while (true) {
+            if (pos >= patch->size) {
+                return false;
+            }
+            uint8_t top = patch->data[pos];
+            if (top == 0xFF) {
+                break;
+            }
+            if (pos + 3 > patch->size) {
+                return false;
+            }
+            uint32_t length = patch->data[pos + 1];
+            if (pos + 3 + length > patch->size) {
+                return false;
+            }
+            const uint8_t *src = patch->data + pos + 3;
+            
+            // Clip the post to the texture
+            int y = origin_y + top;
+            int count = (int)length;
+            if (y < 0) {
+                count += y;
+                src -= y;
+                y = 0;
+            }
+            if (y + count > height) {
+                count = height - y;
+            }
+            if (count > 0) {
+                memcpy(&pixels[x * height + y], src, count);
+                memset(&covered[x * height + y], 1, count);
+            }
+            pos += length + 4;
+        }
+    }
+    return true;
+}
+
+uint8_t *texcomp_build(texcomp_lookup_t lookup, uint32_t *out_size, texcomp_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    
+    // Patch table
+    uint32_t pnames_size;
+    const uint8_t *pnames = lookup("PNAMES", &pnames_size);
+    if (!pnames || pnames_size < 4) {
+        return NULL;
+    }
+    uint32_t num_patches = get_u32(pnames);
+    if (num_patches > (pnames_size - 4) / 8) {
+        fprintf(stderr, "Error: PNAMES is truncated\n");
+        return NULL;
+    }
+    patch_ref_t *patches = (patch_ref_t *)calloc(num_patches ? num_patches : 1, sizeof(patch_ref_t));
+    for (uint32_t i = 0; i < num_patches; i++) {
+        char name[9] = {0};
+        memcpy(name, pnames + 4 + i * 8, 8);
+        patches[i].data = lookup(name, &patches[i].size);
+        if (!patches[i].data) {
+            stats->missing_patches++;
+        }
+    }
+    
+    buffer_t textures = {0};
+    buffer_t offsets = {0};
+    buffer_t columns = {0};
+    
+    // Dedupe: chained by column index through next_column
+    uint32_t *buckets = (uint32_t *)malloc(DEDUPE_BUCKETS * sizeof(uint32_t));
+    memset(buckets, 0xFF, DEDUPE_BUCKETS * sizeof(uint32_t));
+    buffer_t chain = {0};       // uint32_t next per unique column
+    buffer_t chain_offset = {0}; // uint32_t data offset per unique column
+    buffer_t chain_height = {0}; // uint32_t height per unique column
+    
+    const char *tables[] = {"TEXTURE1", "TEXTURE2"};
+    for (int t = 0; t < 2; t++) {
+        uint32_t size;
+        const uint8_t *table = lookup(tables[t], &size);
+        if (!table || size < 4) {
+            continue;
+        }
+        uint32_t count = get_u32(table);
+        if (count > (size - 4) / 4) {
+            fprintf(stderr, "Error: %s is truncated\n", tables[t]);
+            goto fail;
+        }
+        
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t pos = get_u32(table + 4 + i * 4);
+            if (pos + 22 > size) {
+                fprintf(stderr, "Error: %s texture %u is out of range\n", tables[t], i);
+                goto fail;
+            }
+            const uint8_t *def = table + pos;
+            int width = get_s16(def + 12);
+            int height = get_s16(def + 14);
+            int patch_count = get_s16(def + 20);
+            if (width <= 0 || height <= 0 || patch_count < 0 ||
+                pos + 22 + (uint32_t)patch_count * 10 > size) {
+                fprintf(stderr, "Error: %s texture %u is malformed\n", tables[t], i);
+                goto fail;
+            }
+            
+            texcols_texture_t tex;
+            memset(&tex, 0, sizeof(tex));
+            char raw[9] = {0};
+            memcpy(raw, def, 8);
+            wad_normalize_name(tex.name, raw);
+            tex.width = width;
+            tex.height = height;
+            tex.width_mask = ((width & (width - 1)) == 0) ? width - 1 : 0;
+            tex.first_column = offsets.size / 4;
+            
+            // Composite, column-major
+            uint8_t *pixels = (uint8_t *)calloc(width * height, 1);
+            uint8_t *covered = (uint8_t *)calloc(width * height, 1);
+            for (int p = 0; p < patch_count; p++) {
+                const uint8_t *mp = def + 22 + p * 10;
+                uint16_t patch = get_u16(mp + 4);
+                if (patch >= num_patches || !patches[patch].data) {
+                    continue;
+                }
+                if (!draw_patch(pixels, covered, width, height, &patches[patch],
+                                get_s16(mp), get_s16(mp + 2))) {
+                    fprintf(stderr, "Warning: %.8s: patch %u is malformed\n", tex.name, patch);
+                }
+            }
+            if (memchr(covered, 0, width * height)) {
+                tex.flags |= TEXCOLS_HOLES;
+                stats->with_holes++;
+            }
+            
+            for (int x = 0; x < width; x++) {
+                const uint8_t *column = &pixels[x * height];
+                uint32_t h = wad_image_checksum(column, height) & (DEDUPE_BUCKETS - 1);
+                uint32_t found = 0xFFFFFFFFu;
+                for (uint32_t c = buckets[h]; c != 0xFFFFFFFFu; c = ((uint32_t *)chain.data)[c]) {
+                    uint32_t off = ((uint32_t *)chain_offset.data)[c];
+                    if (((uint32_t *)chain_height.data)[c] == (uint32_t)height &&
+                        memcmp(columns.data + off, column, height) == 0) {
+                        found = off;
+                        break;
+                    }
+                }
+                if (found == 0xFFFFFFFFu) {
+                    found = columns.size;
+                    uint32_t index = chain.size / 4;
+                    uint32_t hh = height;
+                    if (!buffer_append(&columns, column, height) ||
+                        !buffer_append(&chain, &buckets[h], 4) ||
+                        !buffer_append(&chain_offset, &found, 4) ||
+                        !buffer_append(&chain_height, &hh, 4)) {
+                        goto fail;
+                    }
+                    buckets[h] = index;
+                    stats->unique_columns++;
+                }
+                buffer_append(&offsets, &found, 4);  // Rebased below
+                stats->columns++;
+            }
+            free(pixels);
+            free(covered);
+            
+            buffer_append(&textures, &tex, sizeof(tex));
+            stats->textures++;
+        }
+    }
+    
+    if (stats->textures == 0) {
+        goto fail;
+    }
+    
+    // Assemble: header, textures, offsets, column data
+    texcols_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = TEXCOLS_MAGIC;
+    header.version = TEXCOLS_VERSION;
+    header.num_textures = stats->textures;
+    header.num_columns = stats->columns;
+    header.textures_offset = sizeof(header);
+    header.columns_offset = header.textures_offset + textures.size;
+    uint32_t data_offset = header.columns_offset + offsets.size;
+    
+    uint32_t *offs = (uint32_t *)offsets.data;
+    for (uint32_t i = 0; i < stats->columns; i++) {
+        offs[i] += data_offset;
+    }
+    
+    uint32_t total = data_offset + columns.size;
+    uint8_t *lump = (uint8_t *)malloc(total);
+    memcpy(lump, &header, sizeof(header));
+    memcpy(lump + header.textures_offset, textures.data, textures.size);
+    memcpy(lump + header.columns_offset, offsets.data, offsets.size);
+    memcpy(lump + data_offset, columns.data, columns.size);
+    *out_size = total;
+    
+    free(patches);
+    free(buckets);
+    free(textures.data);
+    free(offsets.data);
+    free(columns.data);
+    free(chain.data);
+    free(chain_offset.data);
+    free(chain_height.data);
+    return lump;
+    
+fail:
+    free(patches);
+    free(buckets);
+    free(textures.data);
+    free(offsets.data);
+    free(columns.data);
+    free(chain.data);
+    free(chain_offset.data);
+    free(chain_height.data);
+    return NULL;
+}
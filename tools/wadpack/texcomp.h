@@ -0,0 +1,37 @@
+/**
+ * Texture compositor for wadpack
+ * Builds the TEXCOLS lump (see include/tex_columns.h) from TEXTURE1,
+ * TEXTURE2 and PNAMES, doing R_GenerateComposite's work at pack time.
+ */
+
+#ifndef TEXCOMP_H
+#define TEXCOMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Look up a lump by name in the merged WADs (last one wins)
+ * Returns its data and sets size, or returns NULL
+ */
+typedef const uint8_t *(*texcomp_lookup_t)(const char *name, uint32_t *size);
+
+/**
+ * Compositing summary
+ */
+typedef struct {
+    uint32_t textures;
+    uint32_t columns;           // Columns across all textures
+    uint32_t unique_columns;    // Columns actually stored
+    uint32_t with_holes;        // Textures with uncovered pixels
+    uint32_t missing_patches;   // PNAMES entries with no lump
+} texcomp_stats_t;
+
+/**
+ * Build the TEXCOLS lump
+ * Returns a malloc'd lump and sets size, or NULL if there are no
+ * textures or the input is malformed
+ */
+uint8_t *texcomp_build(texcomp_lookup_t lookup, uint32_t *size, texcomp_stats_t *stats);
+
+#endif // TEXCOMP_H
@@ -0,0 +1,821 @@
+/**
+ * wadpack - pack an IWAD and PWADs into a PICO-DOOM flash image
+ *
+ * The image (see include/wad_image.h) carries a prebuilt, name-normalized
+ * directory and hash index, so the firmware maps it with no parse step
+ * and no RAM copy. Lumps are aligned for the XIP cache and the lumps read
+ * at startup are grouped together at the front of the data. With
+ * --compress, lumps that LZ4 shrinks enough are stored compressed and the
+ * firmware decompresses them into its lump cache. With --texcols, wall
+ * textures are composited into the TEXCOLS column store (texcomp.c), and
+ * with --levels each map is converted to a compact level lump
+ * (levelconv.c).
+ *
+ * Usage: wadpack [options] -o image.bin iwad.wad [pwad.wad ...]
+ */
+
+#include "wad_image.h"
+#include "lz4_stream.h"
+#include "texcomp.h"
+#include "levelconv.h"
+#include "level_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// UF2 block format (https://github.com/microsoft/uf2)
+#define UF2_MAGIC_START0    0x0A324655u
+#define UF2_MAGIC_START1    0x9E5D5157u
+#define UF2_MAGIC_END       0x0AB16F30u
+#define UF2_FLAG_FAMILY_ID  0x00002000u
+#define UF2_FAMILY_RP2040   0xE48BFF56u
+#define UF2_PAYLOAD_SIZE    256
+
+#define XIP_BASE            0x10000000u
+
+// Compress a lump only if it is at least this big and LZ4 saves 1/8
+#define COMPRESS_MIN_SIZE   64
+#define COMPRESS_MIN_GAIN   8
+
+// LZ4 block rules: the last match starts at least 12 bytes before the
+// end, and the last 5 bytes are always literals
+#define LZ4_MFLIMIT         12
+#define LZ4_LASTLITERALS    5
+#define LZ4_HASH_BITS       14
+
+// Lumps read while the engine starts up and sets up a level
+static const char *default_hot[] = {
+    "PLAYPAL", "COLORMAP", "PNAMES", "TEXTURE1", "TEXTURE2",
+    "STBAR", "STARMS", "STTNUM*", "STYSNUM*", "STGNUM*", "STFST*",
+    "STKEYS*", "SKY*", NULL
+};
+
+/**
+ * One input lump after merging
+ */
+typedef struct {
+    char name[8];             // Normalized
+    const uint8_t *data;
+    uint32_t size;
+    uint32_t offset;          // In the image, once placed
+    int hot_rank;             // Position in the hot list, -1 if cold
+    const uint8_t *stored;    // What goes in the image (data, or compressed)
+    uint32_t stored_size;
+    uint8_t method;           // WAD_LUMP_*
+    bool keep_raw;            // Read in place by the firmware: never compress
+} pack_lump_t;
+
+static pack_lump_t *lumps = NULL;
+static uint32_t num_lumps = 0;
+
+/**
+ * Read a whole file
+ */
+static uint8_t *read_file(const char *path, uint32_t *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Error: Cannot open %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    
+    uint8_t *data = (uint8_t *)malloc(len > 0 ? len : 1);
+    if (!data || fread(data, 1, len, f) != (size_t)len) {
+        fprintf(stderr, "Error: Cannot read %s\n", path);
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *size = (uint32_t)len;
+    return data;
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Append a WAD's directory to the merged lump list
+ * Returns the WAD type flag, or -1 on error
+ */
+static int add_wad(const char *path) {
+    uint32_t size;
+    uint8_t *data = read_file(path, &size);
+    if (!data) {
+        return -1;
+    }
+    
+    if (size < 12 || (memcmp(data, "IWAD", 4) != 0 && memcmp(data, "PWAD", 4) != 0)) {
+        fprintf(stderr, "Error: %s is not a WAD file\n", path);
+        return -1;
+    }
+    
+    uint32_t count = get_u32(data + 4);
+    uint32_t dir = get_u32(data + 8);
+    if (dir > size || count > (size - dir) / 16) {
+        fprintf(stderr, "Error: %s: directory extends beyond file\n", path);
+        return -1;
+    }
+    
+    lumps = (pack_lump_t *)realloc(lumps, (num_lumps + count) * sizeof(pack_lump_t));
+    if (!lumps) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return -1;
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *entry = data + dir + i * 16;
+        uint32_t pos = get_u32(entry);
+        uint32_t len = get_u32(entry + 4);
+        if (pos > size || len > size - pos) {
+            fprintf(stderr, "Error: %s: lump %u extends beyond file\n", path, i);
+            return -1;
+        }
+        
+        pack_lump_t *lump = &lumps[num_lumps++];
+        char raw[9] = {0};
+        memcpy(raw, entry + 8, 8);
+        wad_normalize_name(lump->name, raw);
+        lump->data = data + pos;
+        lump->size = len;
+        lump->offset = 0;
+        lump->hot_rank = -1;
+        lump->stored = lump->data;
+        lump->stored_size = len;
+        lump->method = WAD_LUMP_RAW;
+        lump->keep_raw = false;
+    }
+    
+    printf("  %s: %s, %u lumps\n", path, memcmp(data, "IWAD", 4) == 0 ? "IWAD" : "PWAD", count);
+    return memcmp(data, "IWAD", 4) == 0 ? WAD_IMAGE_IWAD : 0;
+}
+
+/**
+ * Append a lump profile as the LUMPPROF lump
+ * Only the lines between the firmware's begin/end markers are kept if
+ * they are present, so a raw serial log can be passed in.
+ */
+static bool add_profile(const char *path) {
+    uint32_t size;
+    uint8_t *data = read_file(path, &size);
+    if (!data) {
+        return false;
+    }
+    
+    const char *text = (const char *)data;
+    const char *begin = strstr(text, "--- lump profile");
+    if (begin) {
+        begin = strchr(begin, '\n');
+        const char *end = begin ? strstr(begin, "--- end lump profile") : NULL;
+        if (begin && end) {
+            text = begin + 1;
+            size = (uint32_t)(end - text);
+        }
+    }
+    
+    lumps = (pack_lump_t *)realloc(lumps, (num_lumps + 1) * sizeof(pack_lump_t));
+    if (!lumps) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return false;
+    }
+    pack_lump_t *lump = &lumps[num_lumps++];
+    memset(lump, 0, sizeof(*lump));
+    wad_normalize_name(lump->name, "LUMPPROF");
+    lump->data = (const uint8_t *)text;
+    lump->size = size;
+    lump->hot_rank = -1;
+    lump->stored = lump->data;
+    lump->stored_size = size;
+    lump->method = WAD_LUMP_RAW;
+    printf("  %s: lump profile, %u bytes\n", path, size);
+    return true;
+}
+
+/**
+ * Find a merged lump by name (last one wins); texcomp_lookup_t
+ */
+static const uint8_t *find_lump(const char *name, uint32_t *size) {
+    char key[8];
+    wad_normalize_name(key, name);
+    for (uint32_t i = num_lumps; i-- > 0;) {
+        if (memcmp(lumps[i].name, key, 8) == 0) {
+            *size = lumps[i].size;
+            return lumps[i].data;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Composite the wall textures and append them as the TEXCOLS lump
+ */
+static bool add_texcols(void) {
+    uint32_t size;
+    texcomp_stats_t stats;
+    uint8_t *data = texcomp_build(find_lump, &size, &stats);
+    if (!data) {
+        fprintf(stderr, "Error: No TEXTURE1/PNAMES to composite\n");
+        return false;
+    }
+    
+    lumps = (pack_lump_t *)realloc(lumps, (num_lumps + 1) * sizeof(pack_lump_t));
+    if (!lumps) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return false;
+    }
+    pack_lump_t *lump = &lumps[num_lumps++];
+    memset(lump, 0, sizeof(*lump));
+    wad_normalize_name(lump->name, "TEXCOLS");
+    lump->data = data;
+    lump->size = size;
+    lump->hot_rank = -1;
+    lump->stored = data;
+    lump->stored_size = size;
+    lump->method = WAD_LUMP_RAW;
+    lump->keep_raw = true;
+    printf("  TEXCOLS: %u textures (%u with holes), %u columns stored as %u, %u bytes\n",
+           stats.textures, stats.with_holes, stats.columns, stats.unique_columns, size);
+    if (stats.missing_patches) {
+        printf("  Warning: %u PNAMES entries have no patch lump\n", stats.missing_patches);
+    }
+    return true;
+}
+
+/**
+ * Convert every map to a compact level lump named LEVEL_LUMP_PREFIX + map
+ * A map is a marker followed by THINGS ... BLOCKMAP; when a PWAD replaces
+ * a map only its last copy is converted.
+ */
+static bool add_levels(void) {
+    uint32_t count = 0;
+    uint32_t raw_bytes = 0;
+    uint32_t packed_bytes = 0;
+    uint32_t end = num_lumps;
+    
+    for (uint32_t i = 0; i + LEVELCONV_MAP_LUMPS < end; i++) {
+        char expected[8];
+        wad_normalize_name(expected, levelconv_lump_names[0]);
+        if (memcmp(lumps[i + 1].name, expected, 8) != 0) {
+            continue;
+        }
+        
+        char map[9] = {0};
+        memcpy(map, lumps[i].name, 8);
+        if (strlen(map) + strlen(LEVEL_LUMP_PREFIX) > 8) {
+            fprintf(stderr, "Warning: %s: name too long for a level lump, not converted\n", map);
+            continue;
+        }
+        bool replaced = false;
+        for (uint32_t j = i + 1; j < end; j++) {
+            replaced |= memcmp(lumps[j].name, lumps[i].name, 8) == 0;
+        }
+        if (replaced) {
+            continue;
+        }
+        
+        levelconv_lump_t raw[LEVELCONV_MAP_LUMPS];
+        bool complete = true;
+        for (int l = 0; l < LEVELCONV_MAP_LUMPS; l++) {
+            wad_normalize_name(expected, levelconv_lump_names[l]);
+            complete &= memcmp(lumps[i + 1 + l].name, expected, 8) == 0;
+            raw[l].data = lumps[i + 1 + l].data;
+            raw[l].size = lumps[i + 1 + l].size;
+        }
+        if (!complete) {
+            fprintf(stderr, "Warning: %s: map lumps out of order, not converted\n", map);
+            continue;
+        }
+        
+        levelconv_stats_t stats;
+        uint32_t size;
+        uint8_t *data = levelconv_build(map, raw, find_lump, &size, &stats);
+        if (!data) {
+            return false;
+        }
+        
+        lumps = (pack_lump_t *)realloc(lumps, (num_lumps + 1) * sizeof(pack_lump_t));
+        if (!lumps) {
+            fprintf(stderr, "Error: Out of memory\n");
+            return false;
+        }
+        pack_lump_t *lump = &lumps[num_lumps++];
+        memset(lump, 0, sizeof(*lump));
+        char name[16];
+        snprintf(name, sizeof(name), "%s%s", LEVEL_LUMP_PREFIX, map);
+        wad_normalize_name(lump->name, name);
+        lump->data = data;
+        lump->size = size;
+        lump->hot_rank = -1;
+        lump->stored = data;
+        lump->stored_size = size;
+        lump->method = WAD_LUMP_RAW;
+        lump->keep_raw = true;
+        
+        count++;
+        raw_bytes += stats.raw_bytes;
+        packed_bytes += size;
+        if (stats.missing_textures) {
+            printf("  Warning: %s: %u texture references not found\n", map, stats.missing_textures);
+        }
+    }
+    
+    printf("  Levels: %u converted, %u bytes of map lumps -> %u bytes\n", count, raw_bytes, packed_bytes);
+    return true;
+}
+
+/**
+ * Match a lump name against a hot list pattern (trailing '*' = prefix)
+ */
+static bool name_matches(const char *name, const char *pattern) {
+    char full[9] = {0};
+    memcpy(full, name, 8);
+    
+    size_t len = strlen(pattern);
+    if (len > 0 && pattern[len - 1] == '*') {
+        return strncasecmp(full, pattern, len - 1) == 0;
+    }
+    return strcasecmp(full, pattern) == 0;
+}
+
+/**
+ * Rank lumps by the hot list; earlier patterns are placed first
+ */
+static void mark_hot(const char **patterns, int count) {
+    for (int p = 0; p < count; p++) {
+        for (uint32_t i = 0; i < num_lumps; i++) {
+            if (lumps[i].hot_rank < 0 && lumps[i].size > 0 &&
+                name_matches(lumps[i].name, patterns[p])) {
+                lumps[i].hot_rank = p;
+            }
+        }
+    }
+}
+
+/**
+ * Load a hot list: one name or prefix* per line, '#' starts a comment
+ * Returns the number of patterns
+ */
+static int load_hot_list(const char *path, char ***out) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Error: Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    
+    char line[128];
+    char **patterns = NULL;
+    int count = 0;
+    while (fgets(line, sizeof(line), f)) {
+        char *p = line;
+        while (*p == ' ' || *p == '\t') {
+            p++;
+        }
+        char *end = p;
+        while (*end && *end != '#' && *end != ' ' && *end != '\t' &&
+               *end != ',' && *end != '\r' && *end != '\n') {
+            end++;
+        }
+        *end = '\0';
+        if (*p == '\0') {
+            continue;
+        }
+        patterns = (char **)realloc(patterns, (count + 1) * sizeof(char *));
+        patterns[count++] = strdup(p);
+    }
+    fclose(f);
+    *out = patterns;
+    return count;
+}
+
+static uint32_t read_u32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * Append an LZ4 length continuation (after a 15 in the token)
+ */
+static uint8_t *put_length(uint8_t *out, uint32_t length) {
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = (uint8_t)length;
+    return out;
+}
+
+/**
+ * Emit one LZ4 sequence (match_len 0 = final literals-only sequence)
+ * Returns the new output position, or NULL if it would pass out_end
+ */
+static uint8_t *put_sequence(uint8_t *out, uint8_t *out_end, const uint8_t *literals,
+                             uint32_t literal_len, uint32_t offset, uint32_t match_len) {
+    // Worst case: token, lengths, literals, offset
+    if (out + 1 + literal_len / 255 + 1 + literal_len + 2 + match_len / 255 + 1 > out_end) {
+        return NULL;
+    }
+    
+    uint32_t ml = match_len ? match_len - LZ4_MIN_MATCH : 0;
+    uint8_t *token = out++;
+    *token = (uint8_t)(((literal_len < 15 ? literal_len : 15) << 4) | (ml < 15 ? ml : 15));
+    if (literal_len >= 15) {
+        out = put_length(out, literal_len - 15);
+    }
+    memcpy(out, literals, literal_len);
+    out += literal_len;
+    
+    if (match_len) {
+        *out++ = offset & 0xFF;
+        *out++ = offset >> 8;
+        if (ml >= 15) {
+            out = put_length(out, ml - 15);
+        }
+    }
+    return out;
+}
+
+/**
+ * Greedy LZ4 block compressor
+ * Returns the compressed size, or 0 if it does not fit in cap
+ */
+static uint32_t lz4_compress(const uint8_t *src, uint32_t size, uint8_t *dst, uint32_t cap) {
+    static uint32_t table[1 << LZ4_HASH_BITS];
+    memset(table, 0xFF, sizeof(table));
+    
+    uint8_t *out = dst;
+    uint8_t *out_end = dst + cap;
+    uint32_t anchor = 0;
+    uint32_t i = 0;
+    
+    if (size > LZ4_MFLIMIT) {
+        uint32_t match_limit = size - LZ4_MFLIMIT;
+        uint32_t end_limit = size - LZ4_LASTLITERALS;
+        
+        while (i < match_limit) {
+            uint32_t seq = read_u32(src + i);
+            uint32_t h = (seq * 2654435761u) >> (32 - LZ4_HASH_BITS);
+            uint32_t candidate = table[h];
+            table[h] = i;
+            
+            if (candidate != 0xFFFFFFFFu && i - candidate <= LZ4_MAX_OFFSET &&
+                read_u32(src + candidate) == seq) {
+                uint32_t length = LZ4_MIN_MATCH;
+                while (i + length < end_limit && src[candidate + length] == src[i + length]) {
+                    length++;
+                }
+                out = put_sequence(out, out_end, src + anchor, i - anchor, i - candidate, length);
+                if (!out) {
+                    return 0;
+                }
+                i += length;
+                anchor = i;
+                continue;
+            }
+            i++;
+        }
+    }
+    
+    out = put_sequence(out, out_end, src + anchor, size - anchor, 0, 0);
+    return out ? (uint32_t)(out - dst) : 0;
+}
+
+/**
+ * Store a lump compressed if that saves enough, after checking that the
+ * firmware's decoder gets the original back
+ */
+static void compress_lump(pack_lump_t *lump) {
+    if (lump->size < COMPRESS_MIN_SIZE || lump->keep_raw) {
+        return;
+    }
+    
+    uint32_t cap = lump->size - lump->size / COMPRESS_MIN_GAIN;
+    uint8_t *packed = (uint8_t *)malloc(cap);
+    uint32_t packed_size = lz4_compress(lump->data, lump->size, packed, cap);
+    if (packed_size == 0) {
+        free(packed);
+        return;
+    }
+    
+    uint8_t *check = (uint8_t *)malloc(lump->size);
+    lz4_stream_t stream;
+    lz4_stream_init(&stream, packed, packed_size, check, lump->size);
+    if (lz4_stream_run(&stream, lump->size) != LZ4_STREAM_DONE ||
+        memcmp(check, lump->data, lump->size) != 0) {
+        fprintf(stderr, "Warning: %.8s: LZ4 round trip failed, storing raw\n", lump->name);
+        free(packed);
+        free(check);
+        return;
+    }
+    free(check);
+    
+    lump->stored = packed;
+    lump->stored_size = packed_size;
+    lump->method = WAD_LUMP_LZ4;
+}
+
+static uint32_t align_up(uint32_t value, uint32_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+static int compare_hot(const void *a, const void *b) {
+    const pack_lump_t *la = *(const pack_lump_t * const *)a;
+    const pack_lump_t *lb = *(const pack_lump_t * const *)b;
+    if (la->hot_rank != lb->hot_rank) {
+        return la->hot_rank - lb->hot_rank;
+    }
+    return (la > lb) - (la < lb);  // Keep directory order within a rank
+}
+
+/**
+ * Write the image as UF2 blocks starting at a flash address
+ */
+static bool write_uf2(const char *path, const uint8_t *image, uint32_t size, uint32_t address) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "Error: Cannot create %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    
+    uint32_t blocks = (size + UF2_PAYLOAD_SIZE - 1) / UF2_PAYLOAD_SIZE;
+    for (uint32_t b = 0; b < blocks; b++) {
+        uint32_t block[128];
+        memset(block, 0, sizeof(block));
+        block[0] = UF2_MAGIC_START0;
+        block[1] = UF2_MAGIC_START1;
+        block[2] = UF2_FLAG_FAMILY_ID;
+        block[3] = address + b * UF2_PAYLOAD_SIZE;
+        block[4] = UF2_PAYLOAD_SIZE;
+        block[5] = b;
+        block[6] = blocks;
+        block[7] = UF2_FAMILY_RP2040;
+        
+        uint32_t chunk = size - b * UF2_PAYLOAD_SIZE;
+        if (chunk > UF2_PAYLOAD_SIZE) {
+            chunk = UF2_PAYLOAD_SIZE;
+        }
+        memcpy(&block[8], image + b * UF2_PAYLOAD_SIZE, chunk);
+        block[127] = UF2_MAGIC_END;
+        
+        if (fwrite(block, 1, sizeof(block), f) != sizeof(block)) {
+            fprintf(stderr, "Error: Cannot write %s\n", path);
+            fclose(f);
+            return false;
+        }
+    }
+    fclose(f);
+    printf("  UF2: %s, %u blocks at 0x%08X\n", path, blocks, address);
+    return true;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+        "Usage: wadpack [options] -o image.bin iwad.wad [pwad.wad ...]\n"
+        "  -o FILE         Raw image output\n"
+        "  --uf2 FILE      Also write a UF2 for drag-and-drop flashing\n"
+        "  --offset N      Flash offset of the image (default 0x%X)\n"
+        "  --align N       Lump data alignment, power of two >= 4 (default %d)\n"
+        "  --hot FILE      Hot lump list, one NAME or PREFIX* per line\n"
+        "                  (replaces the built-in startup list)\n"
+        "  --compress      LZ4-compress lumps that shrink by at least 1/%d\n"
+        "  --profile FILE  Lump profile printed by a PICO_DOOM_LUMP_PROFILE build:\n"
+        "                  stored as the LUMPPROF lump (the firmware pins the\n"
+        "                  lumps it lists) and used as the hot list unless --hot\n"
+        "  --texcols       Composite TEXTURE1/TEXTURE2 into the TEXCOLS column\n"
+        "                  store (always stored uncompressed)\n"
+        "  --levels        Add a compact, preconverted level lump per map\n"
+        "                  (" LEVEL_LUMP_PREFIX "<map>, always stored uncompressed)\n",
+        WAD_IMAGE_DEFAULT_FLASH_OFFSET, WAD_IMAGE_DEFAULT_ALIGN, COMPRESS_MIN_GAIN);
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = NULL;
+    const char *uf2_path = NULL;
+    const char *hot_path = NULL;
+    const char *profile_path = NULL;
+    uint32_t flash_offset = WAD_IMAGE_DEFAULT_FLASH_OFFSET;
+    uint32_t align = WAD_IMAGE_DEFAULT_ALIGN;
+    bool compress = false;
+    bool texcols = false;
+    bool levels = false;
+    const char *inputs[64];
+    int num_inputs = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--uf2") == 0 && i + 1 < argc) {
+            uf2_path = argv[++i];
+        } else if (strcmp(argv[i], "--offset") == 0 && i + 1 < argc) {
+            flash_offset = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--align") == 0 && i + 1 < argc) {
+            align = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--hot") == 0 && i + 1 < argc) {
+            hot_path = argv[++i];
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profile_path = argv[++i];
+        } else if (strcmp(argv[i], "--compress") == 0) {
+            compress = true;
+        } else if (strcmp(argv[i], "--texcols") == 0) {
+            texcols = true;
+        } else if (strcmp(argv[i], "--levels") == 0) {
+            levels = true;
+        } else if (argv[i][0] == '-') {
+            usage();
+            return 1;
+        } else if (num_inputs < 64) {
+            inputs[num_inputs++] = argv[i];
+        }
+    }
+    
+    if (!out_path || num_inputs == 0 || align < 4 || (align & (align - 1))) {
+        usage();
+        return 1;
+    }
+    if (flash_offset & 0xFFF) {
+        fprintf(stderr, "Error: Flash offset must be a multiple of the 4 KB sector\n");
+        return 1;
+    }
+    
+    printf("Packing %d WAD(s):\n", num_inputs);
+    uint16_t flags = 0;
+    for (int i = 0; i < num_inputs; i++) {
+        int type = add_wad(inputs[i]);
+        if (type < 0) {
+            return 1;
+        }
+        if (i == 0) {
+            flags |= type;
+        }
+    }
+    
+    if (profile_path && !add_profile(profile_path)) {
+        return 1;
+    }
+    if (texcols && !add_texcols()) {
+        return 1;
+    }
+    if (levels && !add_levels()) {
+        return 1;
+    }
+    if (num_lumps > 0xFFFF) {
+        fprintf(stderr, "Error: %u lumps; the image index holds at most 65535\n", num_lumps);
+        return 1;
+    }
+    
+    // Hot lumps first, in list order, then everything else in directory order
+    if (!hot_path) {
+        hot_path = profile_path;
+    }
+    if (hot_path) {
+        char **patterns;
+        int count = load_hot_list(hot_path, &patterns);
+        if (count < 0) {
+            return 1;
+        }
+        mark_hot((const char **)patterns, count);
+    } else {
+        int count = 0;
+        while (default_hot[count]) {
+            count++;
+        }
+        mark_hot(default_hot, count);
+    }
+    
+    uint32_t num_compressed = 0;
+    if (compress) {
+        for (uint32_t i = 0; i < num_lumps; i++) {
+            compress_lump(&lumps[i]);
+            num_compressed += (lumps[i].method != WAD_LUMP_RAW);
+        }
+    }
+    
+    pack_lump_t **order = (pack_lump_t **)malloc((num_lumps + 1) * sizeof(pack_lump_t *));
+    uint32_t num_hot = 0;
+    for (uint32_t i = 0; i < num_lumps; i++) {
+        if (lumps[i].hot_rank >= 0) {
+            order[num_hot++] = &lumps[i];
+        }
+    }
+    qsort(order, num_hot, sizeof(pack_lump_t *), compare_hot);
+    uint32_t num_placed = num_hot;
+    for (uint32_t i = 0; i < num_lumps; i++) {
+        if (lumps[i].hot_rank < 0) {
+            order[num_placed++] = &lumps[i];
+        }
+    }
+    
+    // Layout
+    wad_image_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = WAD_IMAGE_MAGIC;
+    header.version = WAD_IMAGE_VERSION;
+    header.flags = flags;
+    header.num_lumps = num_lumps;
+    header.dir_offset = align_up(sizeof(header), 4);
+    header.hash_offset = header.dir_offset + num_lumps * sizeof(wad_image_lump_t);
+    header.hash_slots = wad_hash_slots(num_lumps);
+    header.lump_align = align;
+    
+    uint32_t pos = header.hash_offset + header.hash_slots * sizeof(uint16_t);
+    if (num_compressed) {
+        header.pack_offset = align_up(pos, 4);
+        pos = header.pack_offset + num_lumps * sizeof(wad_image_pack_t);
+    }
+    uint32_t data_bytes = 0;
+    uint32_t raw_bytes = 0;
+    header.hot_offset = align_up(pos, align);
+    for (uint32_t i = 0; i < num_lumps; i++) {
+        pack_lump_t *lump = order[i];
+        if (lump->size == 0) {
+            continue;  // Markers
+        }
+        pos = align_up(pos, align);
+        lump->offset = pos;
+        pos += lump->stored_size;
+        data_bytes += lump->stored_size;
+        raw_bytes += lump->size;
+        if (i + 1 == num_hot) {
+            header.hot_size = pos - header.hot_offset;
+        }
+    }
+    header.image_size = align_up(pos, 4);
+    
+    uint8_t *image = (uint8_t *)calloc(1, header.image_size);
+    if (!image) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return 1;
+    }
+    
+    // Directory, in merged input order
+    wad_image_lump_t *dir = (wad_image_lump_t *)(image + header.dir_offset);
+    for (uint32_t i = 0; i < num_lumps; i++) {
+        dir[i].offset = lumps[i].offset;
+        dir[i].size = lumps[i].size;
+        memcpy(dir[i].name, lumps[i].name, 8);
+        memcpy(image + lumps[i].offset, lumps[i].stored, lumps[i].stored_size);
+    }
+    
+    if (num_compressed) {
+        wad_image_pack_t *pack = (wad_image_pack_t *)(image + header.pack_offset);
+        for (uint32_t i = 0; i < num_lumps; i++) {
+            pack[i].stored_size = lumps[i].stored_size;
+            pack[i].method = lumps[i].method;
+        }
+    }
+    
+    // Index, exactly as the firmware would build it: last lump wins
+    uint16_t *hash = (uint16_t *)(image + header.hash_offset);
+    uint32_t mask = header.hash_slots - 1;
+    for (uint32_t i = 0; i < num_lumps; i++) {
+        uint32_t w0 = wad_name_word(dir[i].name);
+        uint32_t w1 = wad_name_word(dir[i].name + 4);
+        uint32_t slot = wad_hash_name(w0, w1) & mask;
+        while (hash[slot]) {
+            const wad_image_lump_t *other = &dir[hash[slot] - 1];
+            if (wad_name_word(other->name) == w0 && wad_name_word(other->name + 4) == w1) {
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        hash[slot] = i + 1;
+    }
+    
+    header.dir_checksum = wad_image_checksum((const uint8_t *)dir, num_lumps * sizeof(wad_image_lump_t)) ^
+                          wad_image_checksum((const uint8_t *)hash, header.hash_slots * sizeof(uint16_t));
+    if (num_compressed) {
+        header.dir_checksum ^= wad_image_checksum(image + header.pack_offset,
+                                                  num_lumps * sizeof(wad_image_pack_t));
+    }
+    memcpy(image, &header, sizeof(header));
+    
+    FILE *f = fopen(out_path, "wb");
+    if (!f || fwrite(image, 1, header.image_size, f) != header.image_size) {
+        fprintf(stderr, "Error: Cannot write %s\n", out_path);
+        return 1;
+    }
+    fclose(f);
+    
+    printf("Image: %s\n", out_path);
+    printf("  Lumps: %u (%u hot, %u bytes)\n", num_lumps, num_hot, header.hot_size);
+    printf("  Directory + index: %u bytes (%u slots)\n",
+           header.hot_offset - header.dir_offset, header.hash_slots);
+    printf("  Data: %u bytes + %u alignment padding (%u-byte)\n",
+           data_bytes, header.image_size - header.hot_offset - data_bytes, align);
+    if (num_compressed) {
+        printf("  Compressed: %u lumps, %u bytes of data stored in %u (%u%%)\n",
+               num_compressed, raw_bytes, data_bytes,
+               raw_bytes ? (uint32_t)((uint64_t)data_bytes * 100 / raw_bytes) : 100);
+    }
+    printf("  Total: %u bytes at flash offset 0x%X\n", header.image_size, flash_offset);
+    
+    if (uf2_path && !write_uf2(uf2_path, image, header.image_size, XIP_BASE + flash_offset)) {
+        return 1;
+    }
+    
+    return 0;
+}